@@ -36,6 +36,7 @@
 #include "JSGlobalObject.h"
 #include "JSObject.h"
 #include "Operations.h"
+#include "ProfilerDatabase.h"
 #include "SourceProvider.h"
 #include <wtf/text/StringBuilder.h>
 #include <wtf/text/StringHash.h>
@@ -107,6 +108,15 @@ void JSContextGroupClearExecutionTimeLimit(JSContextGroupRef group)
     watchdog.setTimeLimit(vm, std::numeric_limits<double>::infinity());
 }
 
+JSStringRef JSContextGroupCopyInlineCacheStatistics(JSContextGroupRef group)
+{
+    VM& vm = *toJS(group);
+    APIEntryShim entryShim(&vm);
+    if (!vm.m_perBytecodeProfiler || !Options::recordInlineCacheStatistics())
+        return 0;
+    return OpaqueJSString::create(vm.m_perBytecodeProfiler->inlineCachesToJSON()).leakRef();
+}
+
 // From the API's perspective, a global context remains alive iff it has been JSGlobalContextRetained.
 
 JSGlobalContextRef JSGlobalContextCreate(JSClassRef globalObjectClass)
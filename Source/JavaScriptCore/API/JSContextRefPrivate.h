@@ -103,6 +103,17 @@ JS_EXPORT void JSContextGroupSetExecutionTimeLimit(JSContextGroupRef, double lim
 */
 JS_EXPORT void JSContextGroupClearExecutionTimeLimit(JSContextGroupRef) AVAILABLE_IN_WEBKIT_VERSION_4_0;
 
+/*!
+@function
+@abstract Describes the property access inline caches of a context group.
+@param group The JavaScript context group whose inline caches should be described.
+@result A JSON array with one entry per get_by_id or put_by_id site, giving its
+ inline cache state, repatch count and slow path hit count, hottest slow paths first.
+ Returns NULL unless JavaScriptCore was started with the recordInlineCacheStatistics
+ option. Ownership follows the Create Rule.
+*/
+JS_EXPORT JSStringRef JSContextGroupCopyInlineCacheStatistics(JSContextGroupRef group) AVAILABLE_IN_WEBKIT_VERSION_4_0;
+
 #ifdef __cplusplus
 }
 #endif
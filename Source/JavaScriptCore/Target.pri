@@ -78,6 +78,7 @@ SOURCES += \
     bytecode/StructureStubClearingWatchpoint.cpp \
     bytecode/StructureStubInfo.cpp \
     bytecode/UnlinkedCodeBlock.cpp \
+    bytecode/UnlinkedCodeBlockSerializer.cpp \
     bytecode/Watchpoint.cpp \
     bytecompiler/BytecodeGenerator.cpp \
     bytecompiler/NodesCodegen.cpp \
@@ -95,6 +96,7 @@ SOURCES += \
     heap/GCThreadSharedData.cpp \
     heap/GCThread.cpp \
     heap/Heap.cpp \
+    heap/HeapSnapshotBuilder.cpp \
     heap/HeapStatistics.cpp \
     heap/HeapTimer.cpp \
     heap/IncrementalSweeper.cpp \
@@ -214,6 +216,8 @@ SOURCES += \
     profiler/ProfilerDatabase.cpp \
     profiler/ProfilerDatabase.h \
     profiler/ProfilerExecutionCounter.h \
+    profiler/ProfilerInlineCache.cpp \
+    profiler/ProfilerInlineCache.h \
     profiler/ProfilerOrigin.cpp \
     profiler/ProfilerOrigin.h \
     profiler/ProfilerOriginStack.cpp \
@@ -225,6 +229,7 @@ SOURCES += \
     profiler/ProfileGenerator.cpp \
     profiler/ProfileNode.cpp \
     profiler/LegacyProfiler.cpp \
+    profiler/SamplingProfiler.cpp \
     runtime/ArgList.cpp \
     runtime/Arguments.cpp \
     runtime/ArrayConstructor.cpp \
@@ -232,6 +237,7 @@ SOURCES += \
     runtime/BooleanConstructor.cpp \
     runtime/BooleanObject.cpp \
     runtime/BooleanPrototype.cpp \
+    runtime/BytecodeCache.cpp \
     runtime/CallData.cpp \
     runtime/CodeCache.cpp \
     runtime/CodeSpecializationKind.cpp \
@@ -287,6 +293,7 @@ SOURCES += \
     runtime/LiteralParser.cpp \
     runtime/Lookup.cpp \
     runtime/MathObject.cpp \
+    runtime/MegamorphicCache.cpp \
     runtime/MemoryStatistics.cpp \
     runtime/NameConstructor.cpp \
     runtime/NameInstance.cpp \
@@ -299,6 +306,7 @@ SOURCES += \
     runtime/ObjectConstructor.cpp \
     runtime/ObjectPrototype.cpp \
     runtime/Operations.cpp \
+    runtime/ProgramPrecompiler.cpp \
     runtime/PropertyDescriptor.cpp \
     runtime/PropertyNameArray.cpp \
     runtime/PropertySlot.cpp \
@@ -195,10 +195,10 @@ public:
         putIntegralUnchecked(value.low);
     }
 
-    PassRefPtr<ExecutableMemoryHandle> executableCopy(VM& vm, void* ownerUID, JITCompilationEffort effort)
+    PassRefPtr<ExecutableMemoryHandle> executableCopy(VM& vm, void* ownerUID, JITCompilationEffort effort, ExecutableMemoryKind kind)
     {
         flushConstantPool(false);
-        return AssemblerBuffer::executableCopy(vm, ownerUID, effort);
+        return AssemblerBuffer::executableCopy(vm, ownerUID, effort, kind);
     }
 
     void putShortWithConstantInt(uint16_t insn, uint32_t constant, bool isReusable = false)
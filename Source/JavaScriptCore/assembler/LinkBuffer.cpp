@@ -58,11 +58,11 @@ LinkBuffer::CodeRef LinkBuffer::finalizeCodeWithDisassembly(const char* format,
     return result;
 }
 
-void LinkBuffer::linkCode(void* ownerUID, JITCompilationEffort effort)
+void LinkBuffer::linkCode(void* ownerUID, JITCompilationEffort effort, ExecutableMemoryKind kind)
 {
     ASSERT(!m_code);
 #if !ENABLE(BRANCH_COMPACTION)
-    m_executableMemory = m_assembler->m_assembler.executableCopy(*m_vm, ownerUID, effort);
+    m_executableMemory = m_assembler->m_assembler.executableCopy(*m_vm, ownerUID, effort, kind);
     if (!m_executableMemory)
         return;
     m_code = m_executableMemory->start();
@@ -70,7 +70,7 @@ void LinkBuffer::linkCode(void* ownerUID, JITCompilationEffort effort)
     ASSERT(m_code);
 #else
     m_initialSize = m_assembler->m_assembler.codeSize();
-    m_executableMemory = m_vm->executableAllocator.allocate(*m_vm, m_initialSize, ownerUID, effort);
+    m_executableMemory = m_vm->executableAllocator.allocate(*m_vm, m_initialSize, ownerUID, effort, kind);
     if (!m_executableMemory)
         return;
     m_code = (uint8_t*)m_executableMemory->start();
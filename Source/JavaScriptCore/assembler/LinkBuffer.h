@@ -76,7 +76,7 @@ class LinkBuffer {
 #endif
 
 public:
-    LinkBuffer(VM& vm, MacroAssembler* masm, void* ownerUID, JITCompilationEffort effort = JITCompilationMustSucceed)
+    LinkBuffer(VM& vm, MacroAssembler* masm, void* ownerUID, JITCompilationEffort effort = JITCompilationMustSucceed, ExecutableMemoryKind kind = StubJITMemory)
         : m_size(0)
 #if ENABLE(BRANCH_COMPACTION)
         , m_initialSize(0)
@@ -89,7 +89,7 @@ public:
         , m_effort(effort)
 #endif
     {
-        linkCode(ownerUID, effort);
+        linkCode(ownerUID, effort, kind);
     }
 
     ~LinkBuffer()
@@ -237,7 +237,7 @@ private:
         return m_code;
     }
 
-    void linkCode(void* ownerUID, JITCompilationEffort);
+    void linkCode(void* ownerUID, JITCompilationEffort, ExecutableMemoryKind);
 
     void performFinalization();
 
@@ -744,6 +744,12 @@ public:
         store8(src, setupArmAddress(address));
     }
     
+    void store8(TrustedImm32 imm, BaseIndex address)
+    {
+        move(imm, dataTempRegister);
+        store8(dataTempRegister, setupArmAddress(address));
+    }
+    
     void store8(RegisterID src, void* address)
     {
         move(TrustedImmPtr(address), addressTempRegister);
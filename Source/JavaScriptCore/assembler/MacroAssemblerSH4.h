@@ -898,6 +898,19 @@ public:
         releaseScratch(scr);
     }
 
+    void store8(TrustedImm32 imm, BaseIndex address)
+    {
+        RegisterID destptr = claimScratch();
+
+        loadEffectiveAddress(address, destptr);
+
+        RegisterID srcval = claimScratch();
+        move(imm, srcval);
+        m_assembler.movbRegMem(srcval, destptr);
+        releaseScratch(srcval);
+        releaseScratch(destptr);
+    }
+
     void store8(TrustedImm32 imm, void* address)
     {
         RegisterID srcval = claimScratch();
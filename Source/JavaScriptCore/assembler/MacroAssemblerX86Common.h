@@ -247,6 +247,11 @@ public:
         m_assembler.negl_m(srcDest.offset, srcDest.base);
     }
 
+    void byteSwap32(RegisterID srcDest)
+    {
+        m_assembler.bswapl_r(srcDest);
+    }
+
     void or32(RegisterID src, RegisterID dest)
     {
         m_assembler.orl_rr(src, dest);
@@ -717,6 +722,18 @@ public:
         m_assembler.cvtss2sd_rr(src, dst);
     }
 
+    void move32ToFloat(RegisterID src, FPRegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.movd_rr(src, dest);
+    }
+
+    void moveFloatTo32(FPRegisterID src, RegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.movd_rr(src, dest);
+    }
+
     void addDouble(FPRegisterID src, FPRegisterID dest)
     {
         ASSERT(isSSE2Present());
@@ -372,6 +372,11 @@ public:
         m_assembler.movq_rr(src, dest);
     }
 
+    void byteSwap64(RegisterID srcDest)
+    {
+        m_assembler.bswapq_r(srcDest);
+    }
+
     void compare64(RelationalCondition cond, RegisterID left, TrustedImm32 right, RegisterID dest)
     {
         if (((cond == Equal) || (cond == NotEqual)) && !right.m_value)
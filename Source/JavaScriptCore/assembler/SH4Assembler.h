@@ -1615,9 +1615,9 @@ public:
         return reinterpret_cast<void*>(readPCrelativeAddress((*instructionPtr & 0xff), instructionPtr));
     }
 
-    PassRefPtr<ExecutableMemoryHandle> executableCopy(VM& vm, void* ownerUID, JITCompilationEffort effort)
+    PassRefPtr<ExecutableMemoryHandle> executableCopy(VM& vm, void* ownerUID, JITCompilationEffort effort, ExecutableMemoryKind kind)
     {
-        return m_buffer.executableCopy(vm, ownerUID, effort);
+        return m_buffer.executableCopy(vm, ownerUID, effort, kind);
     }
 
     static void cacheFlush(void* code, size_t size)
@@ -44,6 +44,7 @@
 #include "JSCJSValue.h"
 #include "JSFunction.h"
 #include "JSNameScope.h"
+#include "LLIntData.h"
 #include "LowLevelInterpreter.h"
 #include "Operations.h"
 #include "ReduceWhitespace.h"
@@ -709,7 +710,11 @@ void CodeBlock::dumpBytecode(PrintStream& out, ExecState* exec, const Instructio
 {
     int location = it - begin;
     bool hasPrintedProfiling = false;
-    switch (exec->interpreter()->getOpcodeID(it->u.opcode)) {
+    OpcodeID opcodeID = exec->interpreter()->getOpcodeID(it->u.opcode);
+#if ENABLE(LLINT_C_LOOP)
+    opcodeID = LLInt::firstComponentOf(opcodeID);
+#endif
+    switch (opcodeID) {
         case op_enter: {
             out.printf("[%4d] enter", location);
             break;
@@ -1958,6 +1963,13 @@ CodeBlock::CodeBlock(ScriptExecutable* ownerExecutable, UnlinkedCodeBlock* unlin
         default:
             break;
         }
+
+#if ENABLE(LLINT_C_LOOP)
+        OpcodeID superinstruction;
+        if (Options::useLLIntSuperinstructions() && i + opLength < instructionCount
+            && LLInt::superinstructionFor(pc[i].u.opcode, pc[i + opLength].u.opcode, superinstruction))
+            instructions[i] = vm()->interpreter->getOpcode(superinstruction);
+#endif
         i += opLength;
     }
     m_instructions = WTF::RefCountedArray<Instruction>(instructions);
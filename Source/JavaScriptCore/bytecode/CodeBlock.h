@@ -188,6 +188,12 @@ public:
         return *(binarySearch<StructureStubInfo, void*>(m_structureStubInfos, m_structureStubInfos.size(), returnAddress.value(), getStructureStubInfoReturnLocation));
     }
 
+    // Returns 0 if the call at the return address does not belong to a property access.
+    StructureStubInfo* tryGetStubInfo(ReturnAddressPtr returnAddress)
+    {
+        return tryBinarySearch<StructureStubInfo, void*>(m_structureStubInfos, m_structureStubInfos.size(), returnAddress.value(), getStructureStubInfoReturnLocation);
+    }
+
     StructureStubInfo& getStubInfo(unsigned bytecodeIndex)
     {
         return *(binarySearch<StructureStubInfo, unsigned>(m_structureStubInfos, m_structureStubInfos.size(), bytecodeIndex, getStructureStubInfoBytecodeIndex));
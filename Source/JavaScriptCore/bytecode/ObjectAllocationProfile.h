@@ -42,6 +42,9 @@ public:
 
     ObjectAllocationProfile()
         : m_allocator(0)
+        , m_sample(0)
+        , m_sampleCount(0)
+        , m_survivorCount(0)
     {
     }
 
@@ -97,10 +100,54 @@ public:
     Structure* structure() { return m_structure.get(); }
     unsigned inlineCapacity() { return m_structure->inlineCapacity(); }
 
+    // Allocation from a slow path, which is taken roughly once per free list
+    // refill. This makes it a cheap place to sample objects for estimating
+    // how many of this site's objects survive a collection.
+    JSObject* allocate(ExecState* exec)
+    {
+        ASSERT(!isNull());
+        JSFinalObject* object = JSFinalObject::create(exec, m_structure.get(), *m_allocator);
+        if (!m_sample && Options::usePretenuring()) {
+            m_sample = object;
+            exec->heap()->addAllocationSample(this);
+        }
+        return object;
+    }
+
+    // Called by the heap after marking, if this profile has a sample. Once
+    // enough samples are in, sites whose objects nearly always survive move
+    // to the pretenured subspace, so that long-lived objects do not keep
+    // mostly-dead blocks alive, and sites that stop surviving move back.
+    void didCollect(Heap& heap)
+    {
+        if (!m_sample)
+            return;
+
+        bool survived = Heap::isMarked(m_sample);
+        m_sample = 0;
+
+        ++m_sampleCount;
+        if (survived)
+            ++m_survivorCount;
+        if (m_sampleCount < Options::pretenuringSampleCount())
+            return;
+
+        size_t cellSize = m_allocator->cellSize();
+        if (m_survivorCount >= m_sampleCount * Options::pretenuringSurvivalRate())
+            m_allocator = &heap.allocatorForPretenuredObjectWithoutDestructor(cellSize);
+        else
+            m_allocator = &heap.allocatorForObjectWithoutDestructor(cellSize);
+        m_sampleCount = 0;
+        m_survivorCount = 0;
+    }
+
     void clear()
     {
         m_allocator = 0;
         m_structure.clear();
+        m_sample = 0;
+        m_sampleCount = 0;
+        m_survivorCount = 0;
         ASSERT(isNull());
     }
 
@@ -135,6 +182,12 @@ private:
 
     MarkedAllocator* m_allocator; // Precomputed to make things easier for generated code.
     WriteBarrier<Structure> m_structure;
+
+    // The sample is not visited; the heap checks its mark bit before the sweep
+    // and then forgets it.
+    JSObject* m_sample;
+    unsigned m_sampleCount;
+    unsigned m_survivorCount;
 };
 
 } // namespace JSC
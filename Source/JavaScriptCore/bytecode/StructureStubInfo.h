@@ -98,6 +98,9 @@ struct StructureStubInfo {
         : accessType(access_unset)
         , seen(false)
         , resetByGC(false)
+        , tookGenericPath(false)
+        , repatchCount(0)
+        , slowPathCount(0)
     {
     }
 
@@ -178,6 +181,13 @@ struct StructureStubInfo {
         watchpoints.clear();
     }
 
+    void clearStatistics()
+    {
+        tookGenericPath = false;
+        repatchCount = 0;
+        slowPathCount = 0;
+    }
+
     void deref();
 
     bool visitWeakReferences();
@@ -204,6 +214,12 @@ struct StructureStubInfo {
     bool seen : 1;
     bool resetByGC : 1;
 
+    // Inline cache statistics, reported by Profiler::Database when
+    // Options::recordInlineCacheStatistics() is set. They survive reset().
+    bool tookGenericPath : 1;
+    unsigned repatchCount;
+    unsigned slowPathCount;
+
 #if ENABLE(DFG_JIT)
     CodeOrigin codeOrigin;
 #endif // ENABLE(DFG_JIT)
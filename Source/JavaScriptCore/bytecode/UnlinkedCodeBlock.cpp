@@ -100,6 +100,23 @@ UnlinkedFunctionExecutable::UnlinkedFunctionExecutable(VM* vm, Structure* struct
 {
 }
 
+UnlinkedFunctionExecutable::UnlinkedFunctionExecutable(VM* vm, Structure* structure)
+    : Base(*vm, structure)
+    , m_numCapturedVariables(0)
+    , m_forceUsesArguments(false)
+    , m_isInStrictContext(false)
+    , m_hasCapturedVariables(false)
+    , m_firstLineOffset(0)
+    , m_lineCount(0)
+    , m_functionStartOffset(0)
+    , m_functionStartColumn(0)
+    , m_startOffset(0)
+    , m_sourceLength(0)
+    , m_features(0)
+    , m_functionNameIsInScopeToggle(FunctionNameIsNotInScope)
+{
+}
+
 size_t UnlinkedFunctionExecutable::parameterCount() const
 {
     return m_parameters->size();
@@ -81,6 +81,7 @@ struct ExecutableInfo {
 class UnlinkedFunctionExecutable : public JSCell {
 public:
     friend class CodeCache;
+    friend class UnlinkedCodeBlockSerializer;
     typedef JSCell Base;
     static UnlinkedFunctionExecutable* create(VM* vm, const SourceCode& source, FunctionBodyNode* node)
     {
@@ -143,6 +144,7 @@ public:
 
 private:
     UnlinkedFunctionExecutable(VM*, Structure*, const SourceCode&, FunctionBodyNode*);
+    UnlinkedFunctionExecutable(VM*, Structure*);
     WriteBarrier<UnlinkedFunctionCodeBlock> m_codeBlockForCall;
     WriteBarrier<UnlinkedFunctionCodeBlock> m_codeBlockForConstruct;
 
@@ -234,6 +236,7 @@ struct UnlinkedInstruction {
 
 class UnlinkedCodeBlock : public JSCell {
 public:
+    friend class UnlinkedCodeBlockSerializer;
     typedef JSCell Base;
     static const bool needsDestruction = true;
     static const bool hasImmortalStructure = true;
@@ -593,6 +596,7 @@ protected:
 class UnlinkedProgramCodeBlock : public UnlinkedGlobalCodeBlock {
 private:
     friend class CodeCache;
+    friend class UnlinkedCodeBlockSerializer;
     static UnlinkedProgramCodeBlock* create(VM* vm, const ExecutableInfo& info)
     {
         UnlinkedProgramCodeBlock* instance = new (NotNull, allocateCell<UnlinkedProgramCodeBlock>(vm->heap)) UnlinkedProgramCodeBlock(vm, vm->unlinkedProgramCodeBlockStructure.get(), info);
@@ -0,0 +1,1133 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "UnlinkedCodeBlockSerializer.h"
+
+#include "BytecodeConventions.h"
+#include "JSStack.h"
+#include "JSString.h"
+#include "Nodes.h"
+#include "Operations.h"
+#include "RegExp.h"
+#include "SpecialPointer.h"
+#include "UnlinkedCodeBlock.h"
+#include <wtf/BitVector.h>
+#include <wtf/HashMap.h>
+#include <wtf/StringHasher.h>
+
+namespace JSC {
+
+enum ValueTag {
+    EmptyValueTag,
+    UndefinedValueTag,
+    NullValueTag,
+    TrueValueTag,
+    FalseValueTag,
+    Int32ValueTag,
+    DoubleValueTag,
+    StringValueTag,
+    ConstantRegisterValueTag
+};
+
+class UnlinkedCodeBlockSerializer::Encoder {
+public:
+    Encoder(Vector<uint8_t>& buffer)
+        : m_buffer(buffer)
+        , m_failed(false)
+    {
+    }
+
+    bool failed() const { return m_failed; }
+    void fail() { m_failed = true; }
+
+    void writeBytes(const void* data, size_t size)
+    {
+        m_buffer.append(static_cast<const uint8_t*>(data), size);
+    }
+
+    template <typename T> void write(const T& value)
+    {
+        writeBytes(&value, sizeof(T));
+    }
+
+    void writeBool(bool value)
+    {
+        write<uint8_t>(value);
+    }
+
+    template <typename T, size_t inlineCapacity, typename OverflowHandler>
+    void writeVector(const Vector<T, inlineCapacity, OverflowHandler>& vector)
+    {
+        write<uint32_t>(vector.size());
+        writeBytes(vector.data(), vector.size() * sizeof(T));
+    }
+
+    void writeString(StringImpl* string)
+    {
+        writeBool(string);
+        if (!string)
+            return;
+        write<uint32_t>(string->length());
+        writeBool(string->is8Bit());
+        if (string->is8Bit())
+            writeBytes(string->characters8(), string->length() * sizeof(LChar));
+        else
+            writeBytes(string->characters16(), string->length() * sizeof(UChar));
+    }
+
+    void writeIdentifier(const Identifier& identifier)
+    {
+        // Private names are only meaningful within the process that created them.
+        if (identifier.impl() && identifier.impl()->isEmptyUnique())
+            fail();
+        writeString(identifier.impl());
+    }
+
+    void writeValue(JSValue value)
+    {
+        if (!value)
+            write<uint8_t>(EmptyValueTag);
+        else if (value.isUndefined())
+            write<uint8_t>(UndefinedValueTag);
+        else if (value.isNull())
+            write<uint8_t>(NullValueTag);
+        else if (value.isBoolean())
+            write<uint8_t>(value.asBoolean() ? TrueValueTag : FalseValueTag);
+        else if (value.isInt32()) {
+            write<uint8_t>(Int32ValueTag);
+            write<int32_t>(value.asInt32());
+        } else if (value.isDouble()) {
+            write<uint8_t>(DoubleValueTag);
+            write<double>(value.asDouble());
+        } else if (value.isString()) {
+            write<uint8_t>(StringValueTag);
+            writeString(asString(value)->tryGetValue().impl());
+        } else
+            fail();
+    }
+
+    // Returns true the first time a given executable is seen.
+    bool addFunctionExecutable(UnlinkedFunctionExecutable* executable, uint32_t& index)
+    {
+        HashMap<UnlinkedFunctionExecutable*, uint32_t>::AddResult result = m_functionExecutables.add(executable, m_functionExecutables.size());
+        index = result.iterator->value;
+        return result.isNewEntry;
+    }
+
+private:
+    Vector<uint8_t>& m_buffer;
+    HashMap<UnlinkedFunctionExecutable*, uint32_t> m_functionExecutables;
+    bool m_failed;
+};
+
+class UnlinkedCodeBlockSerializer::Decoder {
+public:
+    Decoder(VM& vm, const uint8_t* data, size_t size)
+        : m_vm(vm)
+        , m_cursor(data)
+        , m_end(data + size)
+        , m_failed(false)
+    {
+    }
+
+    VM& vm() { return m_vm; }
+    bool failed() const { return m_failed; }
+    bool atEnd() const { return m_cursor == m_end; }
+
+    bool readBytes(void* data, size_t size)
+    {
+        if (m_failed || size > static_cast<size_t>(m_end - m_cursor)) {
+            m_failed = true;
+            return false;
+        }
+        memcpy(data, m_cursor, size);
+        m_cursor += size;
+        return true;
+    }
+
+    template <typename T> bool read(T& value)
+    {
+        return readBytes(&value, sizeof(T));
+    }
+
+    bool readBool(bool& value)
+    {
+        uint8_t byte;
+        if (!read(byte) || byte > 1) {
+            m_failed = true;
+            return false;
+        }
+        value = byte;
+        return true;
+    }
+
+    // Reads an element count and checks that that many elements could possibly follow,
+    // so that corrupt data cannot make us allocate huge buffers.
+    bool readLength(uint32_t& length, size_t minimumElementSize)
+    {
+        if (!read(length))
+            return false;
+        if (minimumElementSize && length > static_cast<size_t>(m_end - m_cursor) / minimumElementSize) {
+            m_failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    template <typename T, size_t inlineCapacity, typename OverflowHandler>
+    bool readVector(Vector<T, inlineCapacity, OverflowHandler>& vector)
+    {
+        uint32_t size;
+        if (!readLength(size, sizeof(T)))
+            return false;
+        vector.resize(size);
+        return readBytes(vector.data(), size * sizeof(T));
+    }
+
+    bool readString(String& string)
+    {
+        bool hasString;
+        if (!readBool(hasString))
+            return false;
+        if (!hasString) {
+            string = String();
+            return true;
+        }
+        uint32_t length;
+        bool is8Bit;
+        if (!read(length) || !readBool(is8Bit))
+            return false;
+        size_t characterSize = is8Bit ? sizeof(LChar) : sizeof(UChar);
+        if (length > static_cast<size_t>(m_end - m_cursor) / characterSize) {
+            m_failed = true;
+            return false;
+        }
+        if (is8Bit) {
+            LChar* characters;
+            string = String::createUninitialized(length, characters);
+            return readBytes(characters, length * sizeof(LChar));
+        }
+        UChar* characters;
+        string = String::createUninitialized(length, characters);
+        return readBytes(characters, length * sizeof(UChar));
+    }
+
+    bool readIdentifier(Identifier& identifier)
+    {
+        String string;
+        if (!readString(string))
+            return false;
+        identifier = string.isNull() ? Identifier() : Identifier(&m_vm, string);
+        return true;
+    }
+
+    bool readValue(JSValue& value)
+    {
+        uint8_t tag;
+        if (!read(tag))
+            return false;
+        return readValue(tag, value);
+    }
+
+    bool readValue(uint8_t tag, JSValue& value)
+    {
+        switch (tag) {
+        case EmptyValueTag:
+            value = JSValue();
+            return true;
+        case UndefinedValueTag:
+            value = jsUndefined();
+            return true;
+        case NullValueTag:
+            value = jsNull();
+            return true;
+        case TrueValueTag:
+            value = jsBoolean(true);
+            return true;
+        case FalseValueTag:
+            value = jsBoolean(false);
+            return true;
+        case Int32ValueTag: {
+            int32_t number;
+            if (!read(number))
+                return false;
+            value = jsNumber(number);
+            return true;
+        }
+        case DoubleValueTag: {
+            double number;
+            if (!read(number))
+                return false;
+            value = JSValue(JSValue::EncodeAsDouble, number);
+            return true;
+        }
+        case StringValueTag: {
+            String string;
+            if (!readString(string) || string.isNull()) {
+                m_failed = true;
+                return false;
+            }
+            value = jsString(&m_vm, string);
+            return true;
+        }
+        default:
+            m_failed = true;
+            return false;
+        }
+    }
+
+    size_t functionExecutableCount() const { return m_functionExecutables.size(); }
+    UnlinkedFunctionExecutable* functionExecutable(size_t index) const { return m_functionExecutables[index]; }
+    void addFunctionExecutable(UnlinkedFunctionExecutable* executable) { m_functionExecutables.append(executable); }
+
+private:
+    VM& m_vm;
+    const uint8_t* m_cursor;
+    const uint8_t* m_end;
+    Vector<UnlinkedFunctionExecutable*> m_functionExecutables;
+    bool m_failed;
+};
+
+uint32_t UnlinkedCodeBlockSerializer::layoutFingerprint()
+{
+    StringHasher hasher;
+    for (unsigned i = 0; i < numOpcodeIDs; ++i) {
+        hasher.addCharacters(reinterpret_cast<const LChar*>(opcodeNames[i]), strlen(opcodeNames[i]));
+        hasher.addCharacter(opcodeLengths[i]);
+    }
+    hasher.addCharacter(sizeof(UnlinkedInstruction));
+    hasher.addCharacter(sizeof(UnlinkedHandlerInfo));
+    hasher.addCharacter(sizeof(ExpressionRangeInfo));
+    hasher.addCharacter(sizeof(ExpressionRangeInfo::FatPosition));
+    hasher.addCharacter(JSStack::CallFrameHeaderSize);
+    hasher.addCharacter(FirstConstantRegisterIndex >> 16);
+    hasher.addCharacter(Special::TableSize);
+    hasher.addCharacter(formatVersion);
+    return hasher.hash();
+}
+
+// Describes the operands of the opcodes that the bytecode generator emits for program
+// code, one character per operand:
+//   r  a register or a constant            L  a local register
+//   k  a constant                          n  a number that needs no checking
+//   i  an identifier                       j  a jump offset
+//   f  a function declaration              F  a function expression
+//   x  a regular expression                b  a constant buffer
+//   v  a value profile                     a  an array profile
+//   A  an array allocation profile         o  an object allocation profile
+//   R  a resolve operation                 P  a put to base operation
+//   l  an LLInt call link info             p  a special pointer
+//   s  an immediate switch table           c  a character switch table
+//   S  a string switch table
+// Opcodes that only appear in linked code, and the scoped variable accesses, which
+// index into an enclosing function's activation that program code never has, are
+// rejected.
+static const char* operandKinds(OpcodeID opcodeID)
+{
+    switch (opcodeID) {
+    case op_enter:
+    case op_loop_hint:
+    case op_pop_scope:
+        return "";
+    case op_create_activation:
+    case op_init_lazy_reg:
+    case op_create_arguments:
+    case op_inc:
+    case op_dec:
+    case op_tear_off_activation:
+    case op_ret:
+    case op_push_with_scope:
+    case op_catch:
+    case op_throw:
+    case op_profile_will_call:
+    case op_profile_did_call:
+    case op_end:
+        return "r";
+    case op_mov:
+    case op_not:
+    case op_eq_null:
+    case op_neq_null:
+    case op_to_number:
+    case op_negate:
+    case op_typeof:
+    case op_is_undefined:
+    case op_is_boolean:
+    case op_is_number:
+    case op_is_string:
+    case op_is_object:
+    case op_is_function:
+    case op_tear_off_arguments:
+    case op_ret_object_or_this:
+    case op_to_primitive:
+        return "rr";
+    case op_eq:
+    case op_neq:
+    case op_stricteq:
+    case op_nstricteq:
+    case op_less:
+    case op_lesseq:
+    case op_greater:
+    case op_greatereq:
+    case op_mod:
+    case op_lshift:
+    case op_rshift:
+    case op_urshift:
+    case op_instanceof:
+    case op_in:
+    case op_del_by_val:
+        return "rrr";
+    case op_add:
+    case op_mul:
+    case op_div:
+    case op_sub:
+    case op_bitand:
+    case op_bitxor:
+    case op_bitor:
+        return "rrrn";
+    case op_get_callee:
+    case op_convert_this:
+    case op_call_put_result:
+        return "rv";
+    case op_create_this:
+        return "rrn";
+    case op_new_object:
+        return "rno";
+    case op_new_array:
+        return "rLnA";
+    case op_new_array_with_size:
+        return "rrA";
+    case op_new_array_buffer:
+        return "rbnA";
+    case op_new_regexp:
+        return "rx";
+    case op_check_has_instance:
+        return "rrrj";
+    case op_resolve:
+        return "riRv";
+    case op_resolve_base:
+        return "rinRPv";
+    case op_resolve_with_base:
+        return "rriRPv";
+    case op_resolve_with_this:
+        return "rriRv";
+    case op_put_to_base:
+        return "rirP";
+    case op_init_global_const_nop:
+        return "nrni";
+    case op_get_by_id:
+        return "rrinnnnv";
+    case op_get_arguments_length:
+    case op_del_by_id:
+        return "rri";
+    case op_put_by_id:
+        return "rirnnnnn";
+    case op_get_by_val:
+    case op_get_argument_by_val:
+        return "rrrav";
+    case op_get_by_pname:
+        return "rrrrrr";
+    case op_put_by_val:
+        return "rrra";
+    case op_put_by_index:
+        return "rnr";
+    case op_put_getter_setter:
+        return "rirr";
+    case op_jmp:
+        return "j";
+    case op_jtrue:
+    case op_jfalse:
+    case op_jeq_null:
+    case op_jneq_null:
+        return "rj";
+    case op_jneq_ptr:
+        return "rpj";
+    case op_jless:
+    case op_jlesseq:
+    case op_jgreater:
+    case op_jgreatereq:
+    case op_jnless:
+    case op_jnlesseq:
+    case op_jngreater:
+    case op_jngreatereq:
+        return "rrj";
+    case op_switch_imm:
+        return "sjr";
+    case op_switch_char:
+        return "cjr";
+    case op_switch_string:
+        return "Sjr";
+    case op_new_func:
+        return "rfn";
+    case op_new_func_exp:
+        return "rF";
+    case op_call:
+    case op_call_eval:
+        return "rnnla";
+    case op_construct:
+        return "rnnln";
+    case op_call_varargs:
+        return "rrrL";
+    case op_strcat:
+        return "rLn";
+    case op_get_pnames:
+        return "rrrrj";
+    case op_next_pname:
+        return "rrrrrj";
+    case op_push_name_scope:
+        return "irn";
+    case op_throw_static_error:
+        return "kn";
+    case op_debug:
+        return "nnnn";
+    default:
+        return 0;
+    }
+}
+
+static bool isValidRegister(UnlinkedProgramCodeBlock* codeBlock, int index)
+{
+    if (index >= FirstConstantRegisterIndex)
+        return static_cast<size_t>(index - FirstConstantRegisterIndex) < codeBlock->constantRegisters().size();
+    return index >= -(static_cast<int>(codeBlock->numParameters()) + JSStack::CallFrameHeaderSize) && index < codeBlock->m_numCalleeRegisters;
+}
+
+static bool isValidLocalRange(UnlinkedProgramCodeBlock* codeBlock, int first, int count)
+{
+    if (count < 0)
+        return false;
+    if (!count)
+        return true;
+    return first >= 0 && first < codeBlock->m_numCalleeRegisters && count <= codeBlock->m_numCalleeRegisters - first;
+}
+
+static bool isValidJumpTarget(const BitVector& instructionStarts, size_t bytecodeOffset, int offset)
+{
+    int64_t target = static_cast<int64_t>(bytecodeOffset) + offset;
+    return target >= 0 && static_cast<uint64_t>(target) < instructionStarts.size() && instructionStarts.quickGet(target);
+}
+
+static bool isValidSimpleJumpTable(const BitVector& instructionStarts, size_t bytecodeOffset, const UnlinkedSimpleJumpTable& table)
+{
+    for (size_t i = 0; i < table.branchOffsets.size(); ++i) {
+        if (table.branchOffsets[i] && !isValidJumpTarget(instructionStarts, bytecodeOffset, table.branchOffsets[i]))
+            return false;
+    }
+    return true;
+}
+
+// The decoder only checks that the data is well formed. This checks that every index the
+// linker and the interpreters will follow stays within the code block, so that a corrupt
+// or forged cache file cannot make them read or write outside of it.
+bool UnlinkedCodeBlockSerializer::validateProgramCodeBlock(UnlinkedProgramCodeBlock* codeBlock)
+{
+    if (codeBlock->m_numCalleeRegisters < 0 || codeBlock->m_numVars < 0 || codeBlock->m_numVars > codeBlock->m_numCalleeRegisters
+        || codeBlock->m_numParameters < 1 || codeBlock->m_numParameters > std::numeric_limits<uint16_t>::max())
+        return false;
+    if (!isValidRegister(codeBlock, codeBlock->m_thisRegister)
+        || (codeBlock->m_argumentsRegister != -1 && !isValidRegister(codeBlock, codeBlock->m_argumentsRegister))
+        || (codeBlock->m_globalObjectRegister != -1 && !isValidRegister(codeBlock, codeBlock->m_globalObjectRegister)))
+        return false;
+
+    const RefCountedArray<UnlinkedInstruction>& instructions = codeBlock->m_unlinkedInstructions;
+    size_t instructionCount = instructions.size();
+    BitVector instructionStarts(instructionCount);
+    for (size_t i = 0; i < instructionCount; ) {
+        if (static_cast<unsigned>(instructions[i].u.opcode) >= numOpcodeIDs)
+            return false;
+        size_t length = opcodeLengths[instructions[i].u.opcode];
+        if (length > instructionCount - i)
+            return false;
+        instructionStarts.quickSet(i);
+        i += length;
+    }
+
+    UnlinkedCodeBlock::RareData* rareData = codeBlock->m_rareData.get();
+    for (size_t i = 0; i < instructionCount; i += opcodeLengths[instructions[i].u.opcode]) {
+        OpcodeID opcodeID = instructions[i].u.opcode;
+        const char* kinds = operandKinds(opcodeID);
+        if (!kinds || strlen(kinds) != static_cast<size_t>(opcodeLengths[opcodeID] - 1))
+            return false;
+        for (size_t j = 0; kinds[j]; ++j) {
+            int operand = instructions[i + 1 + j].u.operand;
+            unsigned index = operand;
+            bool isValid;
+            switch (kinds[j]) {
+            case 'r':
+                isValid = isValidRegister(codeBlock, operand);
+                break;
+            case 'L':
+                isValid = isValidLocalRange(codeBlock, operand, 1);
+                break;
+            case 'k':
+                isValid = operand >= FirstConstantRegisterIndex && isValidRegister(codeBlock, operand);
+                break;
+            case 'n':
+                isValid = true;
+                break;
+            case 'i':
+                isValid = index < codeBlock->m_identifiers.size();
+                break;
+            case 'j':
+                isValid = isValidJumpTarget(instructionStarts, i, operand);
+                break;
+            case 'f':
+                isValid = index < codeBlock->m_functionDecls.size();
+                break;
+            case 'F':
+                isValid = index < codeBlock->m_functionExprs.size();
+                break;
+            case 'x':
+                isValid = rareData && index < rareData->m_regexps.size();
+                break;
+            case 'b':
+                isValid = rareData && index < rareData->m_constantBuffers.size();
+                break;
+            case 'v':
+                isValid = index < codeBlock->m_valueProfileCount;
+                break;
+            case 'a':
+                isValid = index < codeBlock->m_arrayProfileCount;
+                break;
+            case 'A':
+                isValid = index < codeBlock->m_arrayAllocationProfileCount;
+                break;
+            case 'o':
+                isValid = index < codeBlock->m_objectAllocationProfileCount;
+                break;
+            case 'R':
+                isValid = index < codeBlock->m_resolveOperationCount;
+                break;
+            case 'P':
+                isValid = index < codeBlock->m_putToBaseOperationCount;
+                break;
+            case 'l':
+                isValid = index < codeBlock->m_llintCallLinkInfoCount;
+                break;
+            case 'p':
+                isValid = index < Special::TableSize;
+                break;
+            case 's':
+                isValid = rareData && index < rareData->m_immediateSwitchJumpTables.size()
+                    && isValidSimpleJumpTable(instructionStarts, i, rareData->m_immediateSwitchJumpTables[index]);
+                break;
+            case 'c':
+                isValid = rareData && index < rareData->m_characterSwitchJumpTables.size()
+                    && isValidSimpleJumpTable(instructionStarts, i, rareData->m_characterSwitchJumpTables[index]);
+                break;
+            case 'S': {
+                isValid = rareData && index < rareData->m_stringSwitchJumpTables.size();
+                if (!isValid)
+                    break;
+                const UnlinkedStringJumpTable::StringOffsetTable& offsetTable = rareData->m_stringSwitchJumpTables[index].offsetTable;
+                UnlinkedStringJumpTable::StringOffsetTable::const_iterator end = offsetTable.end();
+                for (UnlinkedStringJumpTable::StringOffsetTable::const_iterator iter = offsetTable.begin(); isValid && iter != end; ++iter)
+                    isValid = isValidJumpTarget(instructionStarts, i, iter->value);
+                break;
+            }
+            default:
+                RELEASE_ASSERT_NOT_REACHED();
+                isValid = false;
+            }
+            if (!isValid)
+                return false;
+        }
+
+        // Operands that describe a range of registers, or that depend on each other.
+        const UnlinkedInstruction* pc = &instructions[i];
+        switch (opcodeID) {
+        case op_new_array:
+            if (!isValidLocalRange(codeBlock, pc[2].u.operand, pc[3].u.operand))
+                return false;
+            break;
+        case op_strcat:
+            if (!isValidLocalRange(codeBlock, pc[2].u.operand, pc[3].u.operand))
+                return false;
+            break;
+        case op_new_array_buffer:
+            if (pc[3].u.operand < 0 || static_cast<unsigned>(pc[3].u.operand) > rareData->m_constantBuffers[pc[2].u.operand].size())
+                return false;
+            break;
+        case op_call:
+        case op_call_eval:
+        case op_construct: {
+            // The arguments, 'this' last, sit in the registers just below the callee's
+            // call frame header.
+            int argumentCountIncludingThis = pc[2].u.operand;
+            int registerOffset = pc[3].u.operand;
+            if (argumentCountIncludingThis < 1 || argumentCountIncludingThis > codeBlock->m_numCalleeRegisters
+                || !isValidLocalRange(codeBlock, registerOffset - CallFrame::offsetFor(argumentCountIncludingThis), argumentCountIncludingThis))
+                return false;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < codeBlock->m_jumpTargets.size(); ++i) {
+        if (!isValidJumpTarget(instructionStarts, codeBlock->m_jumpTargets[i], 0))
+            return false;
+    }
+    for (size_t i = 0; i < codeBlock->m_propertyAccessInstructions.size(); ++i) {
+        if (!isValidJumpTarget(instructionStarts, codeBlock->m_propertyAccessInstructions[i], 0))
+            return false;
+    }
+    if (rareData) {
+        for (size_t i = 0; i < rareData->m_exceptionHandlers.size(); ++i) {
+            const UnlinkedHandlerInfo& handler = rareData->m_exceptionHandlers[i];
+            if (handler.start > handler.end || handler.end > instructionCount || !isValidJumpTarget(instructionStarts, handler.target, 0))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Function executables can be referenced from more than one place in a code block, so
+// each one is written out in full at its first reference and by index after that.
+void UnlinkedCodeBlockSerializer::encodeFunctionExecutable(Encoder& encoder, UnlinkedFunctionExecutable* executable)
+{
+    uint32_t index;
+    bool isNewEntry = encoder.addFunctionExecutable(executable, index);
+    encoder.write<uint32_t>(index);
+    if (!isNewEntry)
+        return;
+
+    encoder.write<uint32_t>(executable->m_numCapturedVariables);
+    encoder.writeBool(executable->m_forceUsesArguments);
+    encoder.writeBool(executable->m_isInStrictContext);
+    encoder.writeBool(executable->m_hasCapturedVariables);
+    encoder.writeIdentifier(executable->m_name);
+    encoder.writeIdentifier(executable->m_inferredName);
+
+    FunctionParameters* parameters = executable->parameters();
+    encoder.write<uint32_t>(parameters->size());
+    for (unsigned i = 0; i < parameters->size(); ++i)
+        encoder.writeIdentifier(parameters->at(i));
+
+    encoder.write<uint32_t>(executable->m_firstLineOffset);
+    encoder.write<uint32_t>(executable->m_lineCount);
+    encoder.write<uint32_t>(executable->m_functionStartOffset);
+    encoder.write<uint32_t>(executable->m_functionStartColumn);
+    encoder.write<uint32_t>(executable->m_startOffset);
+    encoder.write<uint32_t>(executable->m_sourceLength);
+    encoder.write<uint32_t>(executable->m_features);
+    encoder.write<uint8_t>(executable->m_functionNameIsInScopeToggle);
+}
+
+bool UnlinkedCodeBlockSerializer::decodeFunctionExecutable(Decoder& decoder, UnlinkedFunctionExecutable*& executable)
+{
+    VM& vm = decoder.vm();
+    uint32_t index;
+    if (!decoder.read(index))
+        return false;
+    if (index < decoder.functionExecutableCount()) {
+        executable = decoder.functionExecutable(index);
+        return true;
+    }
+    if (index != decoder.functionExecutableCount())
+        return false;
+
+    uint32_t numCapturedVariables;
+    bool forceUsesArguments;
+    bool isInStrictContext;
+    bool hasCapturedVariables;
+    Identifier name;
+    Identifier inferredName;
+    if (!decoder.read(numCapturedVariables) || !decoder.readBool(forceUsesArguments) || !decoder.readBool(isInStrictContext) || !decoder.readBool(hasCapturedVariables)
+        || !decoder.readIdentifier(name) || !decoder.readIdentifier(inferredName))
+        return false;
+
+    uint32_t parameterCount;
+    if (!decoder.readLength(parameterCount, 1))
+        return false;
+    Vector<Identifier> parameters(parameterCount);
+    for (unsigned i = 0; i < parameterCount; ++i) {
+        if (!decoder.readIdentifier(parameters[i]))
+            return false;
+    }
+
+    uint32_t firstLineOffset;
+    uint32_t lineCount;
+    uint32_t functionStartOffset;
+    uint32_t functionStartColumn;
+    uint32_t startOffset;
+    uint32_t sourceLength;
+    uint32_t features;
+    uint8_t functionNameIsInScopeToggle;
+    if (!decoder.read(firstLineOffset) || !decoder.read(lineCount) || !decoder.read(functionStartOffset) || !decoder.read(functionStartColumn)
+        || !decoder.read(startOffset) || !decoder.read(sourceLength) || !decoder.read(features) || !decoder.read(functionNameIsInScopeToggle))
+        return false;
+    if (functionNameIsInScopeToggle > FunctionNameIsInScope)
+        return false;
+
+    executable = new (NotNull, allocateCell<UnlinkedFunctionExecutable>(vm.heap)) UnlinkedFunctionExecutable(&vm, vm.unlinkedFunctionExecutableStructure.get());
+    executable->m_numCapturedVariables = numCapturedVariables;
+    executable->m_forceUsesArguments = forceUsesArguments;
+    executable->m_isInStrictContext = isInStrictContext;
+    executable->m_hasCapturedVariables = hasCapturedVariables;
+    executable->m_name = name;
+    executable->m_inferredName = inferredName;
+    executable->m_parameters = FunctionParameters::create(parameters);
+    executable->m_firstLineOffset = firstLineOffset;
+    executable->m_lineCount = lineCount;
+    executable->m_functionStartOffset = functionStartOffset;
+    executable->m_functionStartColumn = functionStartColumn;
+    executable->m_startOffset = startOffset;
+    executable->m_sourceLength = sourceLength;
+    executable->m_features = features;
+    executable->m_functionNameIsInScopeToggle = static_cast<FunctionNameIsInScopeToggle>(functionNameIsInScopeToggle);
+    executable->finishCreation(vm);
+
+    decoder.addFunctionExecutable(executable);
+    return true;
+}
+
+void UnlinkedCodeBlockSerializer::encodeSimpleJumpTables(Encoder& encoder, const Vector<UnlinkedSimpleJumpTable>& tables)
+{
+    encoder.write<uint32_t>(tables.size());
+    for (size_t i = 0; i < tables.size(); ++i) {
+        encoder.writeVector(tables[i].branchOffsets);
+        encoder.write<int32_t>(tables[i].min);
+    }
+}
+
+bool UnlinkedCodeBlockSerializer::decodeSimpleJumpTables(Decoder& decoder, Vector<UnlinkedSimpleJumpTable>& tables)
+{
+    uint32_t count;
+    if (!decoder.readLength(count, sizeof(uint32_t) + sizeof(int32_t)))
+        return false;
+    tables.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (!decoder.readVector(tables[i].branchOffsets) || !decoder.read(tables[i].min))
+            return false;
+    }
+    return true;
+}
+
+bool UnlinkedCodeBlockSerializer::encode(UnlinkedProgramCodeBlock* codeBlock, Vector<uint8_t>& buffer)
+{
+    Encoder encoder(buffer);
+
+    encoder.writeBool(codeBlock->m_needsFullScopeChain);
+    encoder.writeBool(codeBlock->m_usesEval);
+    encoder.writeBool(codeBlock->m_isStrictMode);
+    encoder.writeBool(codeBlock->m_isConstructor);
+    encoder.writeBool(codeBlock->m_isNumericCompareFunction);
+    encoder.writeBool(codeBlock->m_hasCapturedVariables);
+    encoder.write<uint32_t>(codeBlock->m_firstLine);
+    encoder.write<uint32_t>(codeBlock->m_lineCount);
+    encoder.write<uint32_t>(codeBlock->m_features);
+
+    encoder.write<int32_t>(codeBlock->m_numParameters);
+    encoder.write<int32_t>(codeBlock->m_numVars);
+    encoder.write<int32_t>(codeBlock->m_numCapturedVars);
+    encoder.write<int32_t>(codeBlock->m_numCalleeRegisters);
+    encoder.write<int32_t>(codeBlock->m_thisRegister);
+    encoder.write<int32_t>(codeBlock->m_argumentsRegister);
+    encoder.write<int32_t>(codeBlock->m_activationRegister);
+    encoder.write<int32_t>(codeBlock->m_globalObjectRegister);
+
+    encoder.write<uint32_t>(codeBlock->m_resolveOperationCount);
+    encoder.write<uint32_t>(codeBlock->m_putToBaseOperationCount);
+    encoder.write<uint32_t>(codeBlock->m_arrayProfileCount);
+    encoder.write<uint32_t>(codeBlock->m_arrayAllocationProfileCount);
+    encoder.write<uint32_t>(codeBlock->m_objectAllocationProfileCount);
+    encoder.write<uint32_t>(codeBlock->m_valueProfileCount);
+    encoder.write<uint32_t>(codeBlock->m_llintCallLinkInfoCount);
+
+    const RefCountedArray<UnlinkedInstruction>& instructions = codeBlock->m_unlinkedInstructions;
+    encoder.write<uint32_t>(instructions.size());
+    encoder.writeBytes(instructions.data(), instructions.size() * sizeof(UnlinkedInstruction));
+    encoder.writeVector(codeBlock->m_jumpTargets);
+    encoder.writeVector(codeBlock->m_propertyAccessInstructions);
+    encoder.writeVector(codeBlock->m_expressionInfo);
+
+    encoder.write<uint32_t>(codeBlock->m_identifiers.size());
+    for (size_t i = 0; i < codeBlock->m_identifiers.size(); ++i)
+        encoder.writeIdentifier(codeBlock->m_identifiers[i]);
+
+    encoder.write<uint32_t>(codeBlock->m_constantRegisters.size());
+    for (size_t i = 0; i < codeBlock->m_constantRegisters.size(); ++i)
+        encoder.writeValue(codeBlock->m_constantRegisters[i].get());
+
+    encoder.write<uint32_t>(codeBlock->m_functionDecls.size());
+    for (size_t i = 0; i < codeBlock->m_functionDecls.size(); ++i)
+        encodeFunctionExecutable(encoder, codeBlock->m_functionDecls[i].get());
+    encoder.write<uint32_t>(codeBlock->m_functionExprs.size());
+    for (size_t i = 0; i < codeBlock->m_functionExprs.size(); ++i)
+        encodeFunctionExecutable(encoder, codeBlock->m_functionExprs[i].get());
+
+    UnlinkedCodeBlock::RareData* rareData = codeBlock->m_rareData.get();
+    encoder.writeBool(rareData);
+    if (rareData) {
+        encoder.writeVector(rareData->m_exceptionHandlers);
+
+        encoder.write<uint32_t>(rareData->m_regexps.size());
+        for (size_t i = 0; i < rareData->m_regexps.size(); ++i) {
+            RegExp* regExp = rareData->m_regexps[i].get();
+            unsigned flags = NoFlags;
+            if (regExp->global())
+                flags |= FlagGlobal;
+            if (regExp->ignoreCase())
+                flags |= FlagIgnoreCase;
+            if (regExp->multiline())
+                flags |= FlagMultiline;
+            encoder.writeString(regExp->pattern().impl());
+            encoder.write<uint8_t>(flags);
+        }
+
+        // Strings in constant buffers are also constant registers of the code block, which
+        // is what keeps them alive, so write them as references to those registers.
+        encoder.write<uint32_t>(rareData->m_constantBuffers.size());
+        for (size_t i = 0; i < rareData->m_constantBuffers.size(); ++i) {
+            const UnlinkedCodeBlock::ConstantBuffer& constantBuffer = rareData->m_constantBuffers[i];
+            encoder.write<uint32_t>(constantBuffer.size());
+            for (size_t j = 0; j < constantBuffer.size(); ++j) {
+                JSValue value = constantBuffer[j];
+                if (!value.isCell()) {
+                    encoder.writeValue(value);
+                    continue;
+                }
+                size_t index = 0;
+                while (index < codeBlock->m_constantRegisters.size() && codeBlock->m_constantRegisters[index].get() != value)
+                    ++index;
+                if (index == codeBlock->m_constantRegisters.size())
+                    encoder.fail();
+                encoder.write<uint8_t>(ConstantRegisterValueTag);
+                encoder.write<uint32_t>(index);
+            }
+        }
+
+        encodeSimpleJumpTables(encoder, rareData->m_immediateSwitchJumpTables);
+        encodeSimpleJumpTables(encoder, rareData->m_characterSwitchJumpTables);
+        encoder.write<uint32_t>(rareData->m_stringSwitchJumpTables.size());
+        for (size_t i = 0; i < rareData->m_stringSwitchJumpTables.size(); ++i) {
+            const UnlinkedStringJumpTable::StringOffsetTable& offsetTable = rareData->m_stringSwitchJumpTables[i].offsetTable;
+            encoder.write<uint32_t>(offsetTable.size());
+            UnlinkedStringJumpTable::StringOffsetTable::const_iterator end = offsetTable.end();
+            for (UnlinkedStringJumpTable::StringOffsetTable::const_iterator iter = offsetTable.begin(); iter != end; ++iter) {
+                encoder.writeString(iter->key.get());
+                encoder.write<int32_t>(iter->value);
+            }
+        }
+
+        encoder.writeVector(rareData->m_expressionInfoFatPositions);
+    }
+
+    encoder.write<uint32_t>(codeBlock->m_varDeclarations.size());
+    for (size_t i = 0; i < codeBlock->m_varDeclarations.size(); ++i) {
+        encoder.writeIdentifier(codeBlock->m_varDeclarations[i].first);
+        encoder.writeBool(codeBlock->m_varDeclarations[i].second);
+    }
+    encoder.write<uint32_t>(codeBlock->m_functionDeclarations.size());
+    for (size_t i = 0; i < codeBlock->m_functionDeclarations.size(); ++i) {
+        encoder.writeIdentifier(codeBlock->m_functionDeclarations[i].first);
+        encodeFunctionExecutable(encoder, codeBlock->m_functionDeclarations[i].second.get());
+    }
+
+    return !encoder.failed();
+}
+
+bool UnlinkedCodeBlockSerializer::decodeProgramCodeBlock(Decoder& decoder, UnlinkedProgramCodeBlock* codeBlock)
+{
+    VM& vm = decoder.vm();
+
+    bool isNumericCompareFunction;
+    bool hasCapturedVariables;
+    if (!decoder.readBool(isNumericCompareFunction) || !decoder.readBool(hasCapturedVariables)
+        || !decoder.read(codeBlock->m_firstLine) || !decoder.read(codeBlock->m_lineCount) || !decoder.read(codeBlock->m_features))
+        return false;
+    codeBlock->m_isNumericCompareFunction = isNumericCompareFunction;
+    codeBlock->m_hasCapturedVariables = hasCapturedVariables;
+
+    if (!decoder.read(codeBlock->m_numParameters) || !decoder.read(codeBlock->m_numVars)
+        || !decoder.read(codeBlock->m_numCapturedVars) || !decoder.read(codeBlock->m_numCalleeRegisters)
+        || !decoder.read(codeBlock->m_thisRegister) || !decoder.read(codeBlock->m_argumentsRegister)
+        || !decoder.read(codeBlock->m_activationRegister) || !decoder.read(codeBlock->m_globalObjectRegister))
+        return false;
+
+    if (!decoder.read(codeBlock->m_resolveOperationCount) || !decoder.read(codeBlock->m_putToBaseOperationCount)
+        || !decoder.read(codeBlock->m_arrayProfileCount) || !decoder.read(codeBlock->m_arrayAllocationProfileCount)
+        || !decoder.read(codeBlock->m_objectAllocationProfileCount) || !decoder.read(codeBlock->m_valueProfileCount)
+        || !decoder.read(codeBlock->m_llintCallLinkInfoCount))
+        return false;
+
+    // The instructions are checked by validateProgramCodeBlock() once everything they
+    // refer to has been decoded.
+    Vector<UnlinkedInstruction> instructions;
+    if (!decoder.readVector(instructions))
+        return false;
+    codeBlock->m_unlinkedInstructions = RefCountedArray<UnlinkedInstruction>(instructions);
+
+    if (!decoder.readVector(codeBlock->m_jumpTargets) || !decoder.readVector(codeBlock->m_propertyAccessInstructions)
+        || !decoder.readVector(codeBlock->m_expressionInfo))
+        return false;
+
+    uint32_t count;
+    if (!decoder.readLength(count, 1))
+        return false;
+    codeBlock->m_identifiers.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (!decoder.readIdentifier(codeBlock->m_identifiers[i]))
+            return false;
+    }
+
+    if (!decoder.readLength(count, 1))
+        return false;
+    for (size_t i = 0; i < count; ++i) {
+        JSValue value;
+        if (!decoder.readValue(value))
+            return false;
+        codeBlock->addConstant(value);
+    }
+
+    if (!decoder.readLength(count, sizeof(uint32_t)))
+        return false;
+    for (size_t i = 0; i < count; ++i) {
+        UnlinkedFunctionExecutable* executable;
+        if (!decodeFunctionExecutable(decoder, executable))
+            return false;
+        codeBlock->addFunctionDecl(executable);
+    }
+    if (!decoder.readLength(count, sizeof(uint32_t)))
+        return false;
+    for (size_t i = 0; i < count; ++i) {
+        UnlinkedFunctionExecutable* executable;
+        if (!decodeFunctionExecutable(decoder, executable))
+            return false;
+        codeBlock->addFunctionExpr(executable);
+    }
+
+    bool hasRareData;
+    if (!decoder.readBool(hasRareData))
+        return false;
+    if (hasRareData) {
+        codeBlock->createRareDataIfNecessary();
+        UnlinkedCodeBlock::RareData* rareData = codeBlock->m_rareData.get();
+
+        if (!decoder.readVector(rareData->m_exceptionHandlers))
+            return false;
+
+        if (!decoder.readLength(count, 2))
+            return false;
+        for (size_t i = 0; i < count; ++i) {
+            String pattern;
+            uint8_t flags;
+            if (!decoder.readString(pattern) || pattern.isNull() || !decoder.read(flags))
+                return false;
+            if (flags & ~(FlagGlobal | FlagIgnoreCase | FlagMultiline))
+                return false;
+            codeBlock->addRegExp(RegExp::create(vm, pattern, static_cast<RegExpFlags>(flags)));
+        }
+
+        if (!decoder.readLength(count, sizeof(uint32_t)))
+            return false;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t length;
+            if (!decoder.readLength(length, 1))
+                return false;
+            UnlinkedCodeBlock::ConstantBuffer& constantBuffer = codeBlock->constantBuffer(codeBlock->addConstantBuffer(length));
+            for (size_t j = 0; j < length; ++j) {
+                uint8_t tag;
+                if (!decoder.read(tag))
+                    return false;
+                if (tag == ConstantRegisterValueTag) {
+                    uint32_t index;
+                    if (!decoder.read(index) || index >= codeBlock->m_constantRegisters.size())
+                        return false;
+                    constantBuffer[j] = codeBlock->m_constantRegisters[index].get();
+                    continue;
+                }
+                if (tag == StringValueTag || !decoder.readValue(tag, constantBuffer[j]))
+                    return false;
+            }
+        }
+
+        if (!decodeSimpleJumpTables(decoder, rareData->m_immediateSwitchJumpTables)
+            || !decodeSimpleJumpTables(decoder, rareData->m_characterSwitchJumpTables))
+            return false;
+        if (!decoder.readLength(count, sizeof(uint32_t)))
+            return false;
+        rareData->m_stringSwitchJumpTables.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t size;
+            if (!decoder.readLength(size, 1 + sizeof(int32_t)))
+                return false;
+            for (size_t j = 0; j < size; ++j) {
+                String key;
+                int32_t offset;
+                if (!decoder.readString(key) || key.isNull() || !decoder.read(offset))
+                    return false;
+                rareData->m_stringSwitchJumpTables[i].offsetTable.add(key.impl(), offset);
+            }
+        }
+
+        if (!decoder.readVector(rareData->m_expressionInfoFatPositions))
+            return false;
+    }
+
+    if (!decoder.readLength(count, 2))
+        return false;
+    for (size_t i = 0; i < count; ++i) {
+        Identifier name;
+        bool isConstant;
+        if (!decoder.readIdentifier(name) || !decoder.readBool(isConstant))
+            return false;
+        codeBlock->addVariableDeclaration(name, isConstant);
+    }
+    if (!decoder.readLength(count, 1 + sizeof(uint32_t)))
+        return false;
+    for (size_t i = 0; i < count; ++i) {
+        Identifier name;
+        UnlinkedFunctionExecutable* executable;
+        if (!decoder.readIdentifier(name) || !decodeFunctionExecutable(decoder, executable))
+            return false;
+        codeBlock->addFunctionDeclaration(vm, name, executable);
+    }
+
+    return decoder.atEnd();
+}
+
+UnlinkedProgramCodeBlock* UnlinkedCodeBlockSerializer::decode(VM& vm, const uint8_t* data, size_t size)
+{
+    Decoder decoder(vm, data, size);
+
+    bool needsFullScopeChain;
+    bool usesEval;
+    bool isStrictMode;
+    bool isConstructor;
+    if (!decoder.readBool(needsFullScopeChain) || !decoder.readBool(usesEval) || !decoder.readBool(isStrictMode) || !decoder.readBool(isConstructor))
+        return 0;
+
+    // Everything decoded below is reachable from the code block as soon as it is created,
+    // and the code block itself is kept alive by the conservative stack scan.
+    UnlinkedProgramCodeBlock* codeBlock = UnlinkedProgramCodeBlock::create(&vm, ExecutableInfo(needsFullScopeChain, usesEval, isStrictMode, isConstructor));
+    if (!decodeProgramCodeBlock(decoder, codeBlock) || !validateProgramCodeBlock(codeBlock))
+        return 0;
+    return codeBlock;
+}
+
+} // namespace JSC
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef UnlinkedCodeBlockSerializer_h
+#define UnlinkedCodeBlockSerializer_h
+
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class UnlinkedFunctionExecutable;
+class UnlinkedProgramCodeBlock;
+struct UnlinkedSimpleJumpTable;
+class VM;
+
+// Flattens unlinked program code into a byte buffer that does not contain any pointers,
+// so it can be kept in a file and handed to another process built from the same sources.
+// Function bodies are not included; they are still parsed lazily from source when they
+// are first called.
+class UnlinkedCodeBlockSerializer {
+public:
+    // Bump this whenever the encoding changes. Changes to the opcodes are caught by
+    // layoutFingerprint().
+    static const uint32_t formatVersion = 2;
+
+    // Identifies the opcode numbering and lengths, and the layout of the structures that
+    // are written out as they are in memory.
+    static uint32_t layoutFingerprint();
+
+    // Returns false if the code block refers to something that cannot be written out,
+    // such as a constant that is neither a primitive nor a string.
+    static bool encode(UnlinkedProgramCodeBlock*, Vector<uint8_t>&);
+
+    // Returns 0 if the data is malformed, or if any of the code's operands is out of range.
+    static UnlinkedProgramCodeBlock* decode(VM&, const uint8_t* data, size_t);
+
+private:
+    class Encoder;
+    class Decoder;
+
+    static void encodeFunctionExecutable(Encoder&, UnlinkedFunctionExecutable*);
+    static bool decodeFunctionExecutable(Decoder&, UnlinkedFunctionExecutable*&);
+    static bool decodeProgramCodeBlock(Decoder&, UnlinkedProgramCodeBlock*);
+    static bool validateProgramCodeBlock(UnlinkedProgramCodeBlock*);
+    static void encodeSimpleJumpTables(Encoder&, const Vector<UnlinkedSimpleJumpTable>&);
+    static bool decodeSimpleJumpTables(Decoder&, Vector<UnlinkedSimpleJumpTable>&);
+};
+
+} // namespace JSC
+
+#endif // UnlinkedCodeBlockSerializer_h
@@ -874,6 +874,20 @@ bool AbstractState::executeEffects(unsigned indexInBlock, Node* node)
         node->setCanExit(true);
         forNode(node).set(m_graph.m_vm.stringStructure.get());
         break;
+        
+    case DataViewGetInt:
+        node->setCanExit(true);
+        forNode(node).set(SpecInt32);
+        break;
+        
+    case DataViewGetFloat:
+        node->setCanExit(true);
+        forNode(node).set(SpecDouble);
+        break;
+        
+    case DataViewSet:
+        node->setCanExit(true);
+        break;
             
     case GetByVal: {
         node->setCanExit(true);
@@ -214,6 +214,23 @@ private:
             break;
         }
             
+        case DataViewGetInt:
+        case DataViewGetFloat: {
+            node->child1()->mergeFlags(NodeUsedAsValue);
+            node->child2()->mergeFlags(NodeUsedAsValue | NodeUsedAsInt);
+            break;
+        }
+            
+        case DataViewSet: {
+            node->child1()->mergeFlags(NodeUsedAsValue);
+            node->child2()->mergeFlags(NodeUsedAsValue | NodeUsedAsInt);
+            if (node->dataViewType() == TypedArrayFloat32 || node->dataViewType() == TypedArrayFloat64)
+                node->child3()->mergeFlags(NodeUsedAsValue);
+            else
+                node->child3()->mergeFlags(NodeUsedAsValue | NodeUsedAsInt);
+            break;
+        }
+            
         case Identity: 
         case UInt32ToNumber: {
             node->child1()->mergeFlags(flags);
@@ -172,6 +172,7 @@ private:
     void setIntrinsicResult(bool usesResult, int resultOperand, Node*);
     // Handle intrinsic functions. Return true if it succeeded, false if we need to plant a call.
     bool handleIntrinsic(bool usesResult, int resultOperand, Intrinsic, int registerOffset, int argumentCountIncludingThis, SpeculatedType prediction);
+    bool handleDataViewAccess(bool usesResult, int resultOperand, Intrinsic, int registerOffset, int argumentCountIncludingThis, SpeculatedType prediction);
     bool handleConstantInternalFunction(bool usesResult, int resultOperand, InternalFunction*, int registerOffset, int argumentCountIncludingThis, SpeculatedType prediction, CodeSpecializationKind);
     Node* handleGetByOffset(SpeculatedType, Node* base, unsigned identifierNumber, PropertyOffset);
     void handleGetByOffset(
@@ -1624,12 +1625,144 @@ bool ByteCodeParser::handleIntrinsic(bool usesResult, int resultOperand, Intrins
         setIntrinsicResult(usesResult, resultOperand, addToGraph(ArithIMul, left, right));
         return true;
     }
+
+    case DataViewGetInt8Intrinsic:
+    case DataViewGetUint8Intrinsic:
+    case DataViewGetInt16Intrinsic:
+    case DataViewGetUint16Intrinsic:
+    case DataViewGetInt32Intrinsic:
+    case DataViewGetUint32Intrinsic:
+    case DataViewGetFloat32Intrinsic:
+    case DataViewGetFloat64Intrinsic:
+    case DataViewSetInt8Intrinsic:
+    case DataViewSetUint8Intrinsic:
+    case DataViewSetInt16Intrinsic:
+    case DataViewSetUint16Intrinsic:
+    case DataViewSetInt32Intrinsic:
+    case DataViewSetUint32Intrinsic:
+    case DataViewSetFloat32Intrinsic:
+    case DataViewSetFloat64Intrinsic:
+        return handleDataViewAccess(usesResult, resultOperand, intrinsic, registerOffset, argumentCountIncludingThis, prediction);
         
     default:
         return false;
     }
 }
 
+#if CPU(X86) || CPU(X86_64)
+static TypedArrayType dataViewAccessType(Intrinsic intrinsic)
+{
+    switch (intrinsic) {
+    case DataViewGetInt8Intrinsic:
+    case DataViewSetInt8Intrinsic:
+        return TypedArrayInt8;
+    case DataViewGetUint8Intrinsic:
+    case DataViewSetUint8Intrinsic:
+        return TypedArrayUint8;
+    case DataViewGetInt16Intrinsic:
+    case DataViewSetInt16Intrinsic:
+        return TypedArrayInt16;
+    case DataViewGetUint16Intrinsic:
+    case DataViewSetUint16Intrinsic:
+        return TypedArrayUint16;
+    case DataViewGetInt32Intrinsic:
+    case DataViewSetInt32Intrinsic:
+        return TypedArrayInt32;
+    case DataViewGetUint32Intrinsic:
+    case DataViewSetUint32Intrinsic:
+        return TypedArrayUint32;
+    case DataViewGetFloat32Intrinsic:
+    case DataViewSetFloat32Intrinsic:
+        return TypedArrayFloat32;
+    case DataViewGetFloat64Intrinsic:
+    case DataViewSetFloat64Intrinsic:
+        return TypedArrayFloat64;
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+        return TypedArrayNone;
+    }
+}
+#endif
+
+bool ByteCodeParser::handleDataViewAccess(bool usesResult, int resultOperand, Intrinsic intrinsic, int registerOffset, int argumentCountIncludingThis, SpeculatedType prediction)
+{
+#if CPU(X86) || CPU(X86_64)
+    // DataView accesses are unaligned and may need a byte swap, which we only emit on x86.
+    
+    // The descriptor is registered when the first DataView wrapper is created. Without one
+    // there's no class to check |this| against.
+    if (!m_vm->hasDataViewDescriptor())
+        return false;
+    
+    if (m_inlineStackTop->m_exitProfile.hasExitSite(m_currentIndex, BadType)
+        || m_inlineStackTop->m_exitProfile.hasExitSite(m_currentIndex, OutOfBounds))
+        return false;
+    
+    TypedArrayType type = dataViewAccessType(intrinsic);
+    bool isSet = intrinsic >= DataViewSetInt8Intrinsic;
+    
+    // getFoo(byteOffset, littleEndian) and setFoo(byteOffset, value, littleEndian). The call
+    // throws if any of the required arguments are missing, so leave that to the generic path.
+    int endiannessArgument = isSet ? 3 : 2;
+    if (argumentCountIncludingThis < endiannessArgument)
+        return false;
+    
+    // We only handle a byte order that's known at compile time, which is the common case for
+    // protocol decoders: either the argument is absent (big endian) or it's a literal.
+    bool littleEndian = false;
+    if (elementSizeForTypedArrayType(type) > 1 && argumentCountIncludingThis > endiannessArgument) {
+        Node* endianness = get(registerOffset + argumentToOperand(endiannessArgument));
+        if (!isJSConstant(endianness))
+            return false;
+        JSValue value = valueOfJSConstant(endianness);
+        if (value.isBoolean())
+            littleEndian = value.asBoolean();
+        else if (value.isInt32())
+            littleEndian = !!value.asInt32();
+        else if (!value.isUndefinedOrNull())
+            return false;
+    }
+    
+#if USE(JSVALUE32_64)
+    // Byte-swapping a double needs a 64-bit GPR.
+    if (type == TypedArrayFloat64 && !littleEndian)
+        return false;
+#endif
+    
+    Node* base = get(registerOffset + argumentToOperand(0));
+    Node* byteOffset = getToInt32(registerOffset + argumentToOperand(1));
+    
+    if (isSet) {
+        int valueOperand = registerOffset + argumentToOperand(2);
+        Node* value;
+        if (type == TypedArrayFloat32 || type == TypedArrayFloat64)
+            value = get(valueOperand);
+        else
+            value = getToInt32(valueOperand);
+        addToGraph(DataViewSet, OpInfo(type), OpInfo(littleEndian), base, byteOffset, value);
+        setIntrinsicResult(usesResult, resultOperand, constantUndefined());
+        return true;
+    }
+    
+    NodeType op = DataViewGetInt;
+    if (type == TypedArrayFloat32 || type == TypedArrayFloat64)
+        op = DataViewGetFloat;
+    else if (type == TypedArrayUint32
+        && (!isInt32Speculation(prediction) || m_inlineStackTop->m_exitProfile.hasExitSite(m_currentIndex, Overflow)))
+        op = DataViewGetFloat;
+    setIntrinsicResult(usesResult, resultOperand, addToGraph(op, OpInfo(type), OpInfo(littleEndian), base, byteOffset));
+    return true;
+#else
+    UNUSED_PARAM(usesResult);
+    UNUSED_PARAM(resultOperand);
+    UNUSED_PARAM(intrinsic);
+    UNUSED_PARAM(registerOffset);
+    UNUSED_PARAM(argumentCountIncludingThis);
+    UNUSED_PARAM(prediction);
+    return false;
+#endif
+}
+
 bool ByteCodeParser::handleConstantInternalFunction(
     bool usesResult, int resultOperand, InternalFunction* function, int registerOffset,
     int argumentCountIncludingThis, SpeculatedType prediction, CodeSpecializationKind kind)
@@ -3299,7 +3432,7 @@ bool ByteCodeParser::parseBlock(unsigned limit)
             if (!m_inlineStackTop->m_caller)
                 m_currentBlock->isOSRTarget = true;
 
-            if (m_vm->watchdog.isEnabled())
+            if (m_vm->watchdog.needsPollingChecks())
                 addToGraph(CheckWatchdogTimer);
             else {
                 // Emit a phantom node to ensure that there is a placeholder
@@ -383,6 +383,9 @@ private:
                 // typed arrays!  An Int32Array can alias a Float64Array for example, and so on.
                 return 0;
             }
+            case DataViewSet:
+                // A DataView can alias any typed array.
+                return 0;
             case PutStructure:
             case PutByOffset:
                 // GetByVal currently always speculates that it's accessing an
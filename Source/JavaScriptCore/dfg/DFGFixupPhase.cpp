@@ -380,6 +380,23 @@ private:
             setUseKindAndUnboxIfProfitable<Int32Use>(node->child2());
             break;
         }
+            
+        case DataViewGetInt:
+        case DataViewGetFloat: {
+            setUseKindAndUnboxIfProfitable<CellUse>(node->child1());
+            setUseKindAndUnboxIfProfitable<Int32Use>(node->child2());
+            break;
+        }
+            
+        case DataViewSet: {
+            setUseKindAndUnboxIfProfitable<CellUse>(node->child1());
+            setUseKindAndUnboxIfProfitable<Int32Use>(node->child2());
+            if (node->dataViewType() == TypedArrayFloat32 || node->dataViewType() == TypedArrayFloat64)
+                fixDoubleEdge<NumberUse>(node->child3());
+            else
+                setUseKindAndUnboxIfProfitable<Int32Use>(node->child3());
+            break;
+        }
 
         case GetByVal: {
             node->setArrayMode(
@@ -183,6 +183,8 @@ void Graph::dump(PrintStream& out, const char* prefix, Node* node)
         out.print(comma, NodeFlagsDump(node->flags()));
     if (node->hasArrayMode())
         out.print(comma, node->arrayMode());
+    if (node->hasDataViewAccess())
+        out.print(comma, "type", static_cast<unsigned>(node->dataViewType()), "/", node->dataViewIsLittleEndian() ? "LittleEndian" : "BigEndian");
     if (node->hasVarNumber())
         out.print(comma, node->varNumber());
     if (node->hasRegisterPointer())
@@ -199,6 +199,8 @@ void JITCompiler::link(LinkBuffer& linkBuffer)
         m_propertyAccesses[i].m_usedRegisters.copyInfo(info.patch.dfg.usedRegisters);
         info.patch.dfg.registersFlushed = m_propertyAccesses[i].m_registerMode == PropertyAccessRecord::RegistersFlushed;
     }
+    if (m_vm->m_perBytecodeProfiler && Options::recordInlineCacheStatistics())
+        m_vm->m_perBytecodeProfiler->addInlineCaches(m_codeBlock, Profiler::DFG);
     
     m_codeBlock->setNumberOfCallLinkInfos(m_jsCalls.size());
     for (unsigned i = 0; i < m_jsCalls.size(); ++i) {
@@ -258,7 +260,7 @@ bool JITCompiler::compile(JITCode& entry)
     speculative.createOSREntries();
     setEndOfCode();
 
-    LinkBuffer linkBuffer(*m_vm, this, m_codeBlock, JITCompilationCanFail);
+    LinkBuffer linkBuffer(*m_vm, this, m_codeBlock, JITCompilationCanFail, DFGJITMemory);
     if (linkBuffer.didFailToAllocate())
         return false;
     link(linkBuffer);
@@ -348,7 +350,7 @@ bool JITCompiler::compileFunction(JITCode& entry, MacroAssemblerCodePtr& entryWi
     setEndOfCode();
 
     // === Link ===
-    LinkBuffer linkBuffer(*m_vm, this, m_codeBlock, JITCompilationCanFail);
+    LinkBuffer linkBuffer(*m_vm, this, m_codeBlock, JITCompilationCanFail, DFGJITMemory);
     if (linkBuffer.didFailToAllocate())
         return false;
     link(linkBuffer);
@@ -949,6 +949,30 @@ struct Node {
         return true;
     }
     
+    bool hasDataViewAccess()
+    {
+        switch (op()) {
+        case DataViewGetInt:
+        case DataViewGetFloat:
+        case DataViewSet:
+            return true;
+        default:
+            return false;
+        }
+    }
+    
+    TypedArrayType dataViewType()
+    {
+        ASSERT(hasDataViewAccess());
+        return static_cast<TypedArrayType>(m_opInfo);
+    }
+    
+    bool dataViewIsLittleEndian()
+    {
+        ASSERT(hasDataViewAccess());
+        return m_opInfo2;
+    }
+    
     bool hasVirtualRegister()
     {
         return m_virtualRegister != InvalidVirtualRegister;
@@ -184,6 +184,12 @@ namespace JSC { namespace DFG {
     macro(StringCharAt, NodeResultJS) \
     macro(StringFromCharCode, NodeResultJS) \
     \
+    /* Optimizations for DataView access. These are MustGenerate because the calls */\
+    /* they replace throw on out-of-bounds offsets. */\
+    macro(DataViewGetInt, NodeResultInt32 | NodeMustGenerate) \
+    macro(DataViewGetFloat, NodeResultNumber | NodeMustGenerate) \
+    macro(DataViewSet, NodeMustGenerate) \
+    \
     /* Nodes for comparison operations. */\
     macro(CompareLess, NodeResultBoolean | NodeMustGenerate | NodeMightClobber) \
     macro(CompareLessEq, NodeResultBoolean | NodeMustGenerate | NodeMightClobber) \
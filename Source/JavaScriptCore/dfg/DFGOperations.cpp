@@ -406,7 +406,7 @@ JSCell* DFG_OPERATION operationCreateThis(ExecState* exec, JSObject* constructor
     ASSERT(jsCast<JSFunction*>(constructor)->methodTable()->getConstructData(jsCast<JSFunction*>(constructor), constructData) == ConstructTypeJS);
 #endif
     
-    return constructEmptyObject(exec, jsCast<JSFunction*>(constructor)->allocationProfile(exec, inlineCapacity)->structure());
+    return jsCast<JSFunction*>(constructor)->allocationProfile(exec, inlineCapacity)->allocate(exec);
 }
 
 JSCell* DFG_OPERATION operationNewObject(ExecState* exec, Structure* structure)
@@ -537,9 +537,7 @@ EncodedJSValue DFG_OPERATION operationGetById(ExecState* exec, EncodedJSValue ba
     VM* vm = &exec->vm();
     NativeCallFrameTracer tracer(vm, exec);
     
-    JSValue baseValue = JSValue::decode(base);
-    PropertySlot slot(baseValue);
-    return JSValue::encode(baseValue.get(exec, *propertyName, slot));
+    return JSValue::encode(vm->megamorphicCache.get(exec, JSValue::decode(base), *propertyName));
 }
 
 J_FUNCTION_WRAPPER_WITH_RETURN_ADDRESS_EJI(operationGetByIdBuildList);
@@ -550,6 +548,7 @@ EncodedJSValue DFG_OPERATION operationGetByIdBuildListWithReturnAddress(ExecStat
     
     StructureStubInfo& stubInfo = exec->codeBlock()->getStubInfo(returnAddress);
     AccessType accessType = static_cast<AccessType>(stubInfo.accessType);
+    stubInfo.slowPathCount++;
 
     JSValue baseValue = JSValue::decode(base);
     PropertySlot slot(baseValue);
@@ -569,6 +568,7 @@ EncodedJSValue DFG_OPERATION operationGetByIdProtoBuildListWithReturnAddress(Exe
     
     StructureStubInfo& stubInfo = exec->codeBlock()->getStubInfo(returnAddress);
     AccessType accessType = static_cast<AccessType>(stubInfo.accessType);
+    stubInfo.slowPathCount++;
 
     JSValue baseValue = JSValue::decode(base);
     PropertySlot slot(baseValue);
@@ -588,6 +588,7 @@ EncodedJSValue DFG_OPERATION operationGetByIdOptimizeWithReturnAddress(ExecState
     
     StructureStubInfo& stubInfo = exec->codeBlock()->getStubInfo(returnAddress);
     AccessType accessType = static_cast<AccessType>(stubInfo.accessType);
+    stubInfo.slowPathCount++;
 
     JSValue baseValue = JSValue::decode(base);
     PropertySlot slot(baseValue);
@@ -831,6 +832,7 @@ void DFG_OPERATION operationPutByIdStrictOptimizeWithReturnAddress(ExecState* ex
     
     StructureStubInfo& stubInfo = exec->codeBlock()->getStubInfo(returnAddress);
     AccessType accessType = static_cast<AccessType>(stubInfo.accessType);
+    stubInfo.slowPathCount++;
 
     JSValue value = JSValue::decode(encodedValue);
     JSValue baseValue(base);
@@ -855,6 +857,7 @@ void DFG_OPERATION operationPutByIdNonStrictOptimizeWithReturnAddress(ExecState*
     
     StructureStubInfo& stubInfo = exec->codeBlock()->getStubInfo(returnAddress);
     AccessType accessType = static_cast<AccessType>(stubInfo.accessType);
+    stubInfo.slowPathCount++;
 
     JSValue value = JSValue::decode(encodedValue);
     JSValue baseValue(base);
@@ -879,6 +882,7 @@ void DFG_OPERATION operationPutByIdDirectStrictOptimizeWithReturnAddress(ExecSta
     
     StructureStubInfo& stubInfo = exec->codeBlock()->getStubInfo(returnAddress);
     AccessType accessType = static_cast<AccessType>(stubInfo.accessType);
+    stubInfo.slowPathCount++;
 
     JSValue value = JSValue::decode(encodedValue);
     PutPropertySlot slot(true);
@@ -903,6 +907,7 @@ void DFG_OPERATION operationPutByIdDirectNonStrictOptimizeWithReturnAddress(Exec
     
     StructureStubInfo& stubInfo = exec->codeBlock()->getStubInfo(returnAddress);
     AccessType accessType = static_cast<AccessType>(stubInfo.accessType);
+    stubInfo.slowPathCount++;
 
     JSValue value = JSValue::decode(encodedValue);
     PutPropertySlot slot(false);
@@ -927,6 +932,7 @@ void DFG_OPERATION operationPutByIdStrictBuildListWithReturnAddress(ExecState* e
     
     StructureStubInfo& stubInfo = exec->codeBlock()->getStubInfo(returnAddress);
     AccessType accessType = static_cast<AccessType>(stubInfo.accessType);
+    stubInfo.slowPathCount++;
 
     JSValue value = JSValue::decode(encodedValue);
     JSValue baseValue(base);
@@ -948,6 +954,7 @@ void DFG_OPERATION operationPutByIdNonStrictBuildListWithReturnAddress(ExecState
     
     StructureStubInfo& stubInfo = exec->codeBlock()->getStubInfo(returnAddress);
     AccessType accessType = static_cast<AccessType>(stubInfo.accessType);
+    stubInfo.slowPathCount++;
 
     JSValue value = JSValue::decode(encodedValue);
     JSValue baseValue(base);
@@ -969,6 +976,7 @@ void DFG_OPERATION operationPutByIdDirectStrictBuildListWithReturnAddress(ExecSt
     
     StructureStubInfo& stubInfo = exec->codeBlock()->getStubInfo(returnAddress);
     AccessType accessType = static_cast<AccessType>(stubInfo.accessType);
+    stubInfo.slowPathCount++;
     
     JSValue value = JSValue::decode(encodedValue);
     PutPropertySlot slot(true);
@@ -990,6 +998,7 @@ void DFG_OPERATION operationPutByIdDirectNonStrictBuildListWithReturnAddress(Exe
     
     StructureStubInfo& stubInfo = exec->codeBlock()->getStubInfo(returnAddress);
     AccessType accessType = static_cast<AccessType>(stubInfo.accessType);
+    stubInfo.slowPathCount++;
 
     JSValue value = JSValue::decode(encodedValue);
     PutPropertySlot slot(false);
@@ -199,6 +199,16 @@ private:
             changed |= setPrediction(SpecInt32);
             break;
         }
+            
+        case DataViewGetInt: {
+            changed |= setPrediction(SpecInt32);
+            break;
+        }
+            
+        case DataViewGetFloat: {
+            changed |= setPrediction(SpecDouble);
+            break;
+        }
 
         case UInt32ToNumber: {
             if (nodeCanSpeculateInteger(node->arithNodeFlags()))
@@ -539,6 +549,7 @@ private:
         case PutGlobalVar:
         case PutGlobalVarCheck:
         case CheckWatchdogTimer:
+        case DataViewSet:
             break;
             
         // These gets ignored because it doesn't do anything.
@@ -699,6 +710,15 @@ private:
             break;
         }
             
+        case DataViewSet:
+            m_graph.voteNode(node->child1(), VoteValue);
+            m_graph.voteNode(node->child2(), VoteValue);
+            if (node->dataViewType() == TypedArrayFloat32 || node->dataViewType() == TypedArrayFloat64)
+                m_graph.voteNode(node->child3(), VoteDouble);
+            else
+                m_graph.voteNode(node->child3(), VoteValue);
+            break;
+            
         default:
             m_graph.voteChildren(node, VoteValue);
             break;
@@ -362,9 +362,12 @@ static bool tryCacheGetByID(ExecState* exec, JSValue baseValue, const Identifier
 
 void dfgRepatchGetByID(ExecState* exec, JSValue baseValue, const Identifier& propertyName, const PropertySlot& slot, StructureStubInfo& stubInfo)
 {
+    stubInfo.repatchCount++;
     bool cached = tryCacheGetByID(exec, baseValue, propertyName, slot, stubInfo);
-    if (!cached)
+    if (!cached) {
+        stubInfo.tookGenericPath = true;
         dfgRepatchCall(exec->codeBlock(), stubInfo.callReturnLocation, operationGetById);
+    }
 }
 
 static bool tryBuildGetByIDList(ExecState* exec, JSValue baseValue, const Identifier& ident, const PropertySlot& slot, StructureStubInfo& stubInfo)
@@ -435,6 +438,7 @@ static bool tryBuildGetByIDList(ExecState* exec, JSValue baseValue, const Identi
         
         if (slot.cachedPropertyType() == PropertySlot::Getter
             || slot.cachedPropertyType() == PropertySlot::Custom) {
+            PropertySlot::DirectGetValueFunc directGetter = 0;
             if (slot.cachedPropertyType() == PropertySlot::Getter) {
                 ASSERT(scratchGPR != InvalidGPRReg);
                 ASSERT(baseGPR != scratchGPR);
@@ -454,6 +458,12 @@ static bool tryBuildGetByIDList(ExecState* exec, JSValue baseValue, const Identi
                 }
                 stubJit.setupArgumentsWithExecState(baseGPR, scratchGPR);
                 operationFunction = operationCallGetter;
+            } else if ((directGetter = slot.directCustomGetter())) {
+                // Direct getters are called without going through an operation, so
+                // we have to publish the call frame ourselves.
+                stubJit.storePtr(GPRInfo::callFrameRegister, &vm->topCallFrame);
+                stubJit.setupArgumentsWithExecState(baseGPR);
+                operationFunction = FunctionPtr(directGetter);
             } else {
                 stubJit.setupArgumentsWithExecState(
                     baseGPR,
@@ -552,9 +562,12 @@ static bool tryBuildGetByIDList(ExecState* exec, JSValue baseValue, const Identi
 
 void dfgBuildGetByIDList(ExecState* exec, JSValue baseValue, const Identifier& propertyName, const PropertySlot& slot, StructureStubInfo& stubInfo)
 {
+    stubInfo.repatchCount++;
     bool dontChangeCall = tryBuildGetByIDList(exec, baseValue, propertyName, slot, stubInfo);
-    if (!dontChangeCall)
+    if (!dontChangeCall) {
+        stubInfo.tookGenericPath = true;
         dfgRepatchCall(exec->codeBlock(), stubInfo.callReturnLocation, operationGetById);
+    }
 }
 
 static bool tryBuildGetByIDProtoList(ExecState* exec, JSValue baseValue, const Identifier& propertyName, const PropertySlot& slot, StructureStubInfo& stubInfo)
@@ -617,9 +630,12 @@ static bool tryBuildGetByIDProtoList(ExecState* exec, JSValue baseValue, const I
 
 void dfgBuildGetByIDProtoList(ExecState* exec, JSValue baseValue, const Identifier& propertyName, const PropertySlot& slot, StructureStubInfo& stubInfo)
 {
+    stubInfo.repatchCount++;
     bool dontChangeCall = tryBuildGetByIDProtoList(exec, baseValue, propertyName, slot, stubInfo);
-    if (!dontChangeCall)
+    if (!dontChangeCall) {
+        stubInfo.tookGenericPath = true;
         dfgRepatchCall(exec->codeBlock(), stubInfo.callReturnLocation, operationGetById);
+    }
 }
 
 static V_DFGOperation_EJCI appropriateGenericPutByIdFunction(const PutPropertySlot &slot, PutKind putKind)
@@ -665,7 +681,7 @@ static void emitPutReplaceStub(
     GPRReg valueGPR = static_cast<GPRReg>(stubInfo.patch.dfg.valueGPR);
     GPRReg scratchGPR = RegisterSet(stubInfo.patch.dfg.usedRegisters).getFreeGPR();
     bool needToRestoreScratch = false;
-#if ENABLE(WRITE_BARRIER_PROFILING)
+#if ENABLE(WRITE_BARRIER_PROFILING) || ENABLE(GGC)
     GPRReg scratchGPR2;
     const bool writeBarrierNeeded = true;
 #else
@@ -689,7 +705,7 @@ static void emitPutReplaceStub(
         MacroAssembler::Address(baseGPR, JSCell::structureOffset()),
         MacroAssembler::TrustedImmPtr(structure));
     
-#if ENABLE(WRITE_BARRIER_PROFILING)
+#if ENABLE(WRITE_BARRIER_PROFILING) || ENABLE(GGC)
 #if USE(JSVALUE64)
     scratchGPR2 = SpeculativeJIT::selectScratchGPR(baseGPR, valueGPR, scratchGPR);
 #else
@@ -780,7 +796,7 @@ static void emitPutTransitionStub(
     
     bool needSecondScratch = false;
     bool needThirdScratch = false;
-#if ENABLE(WRITE_BARRIER_PROFILING)
+#if ENABLE(WRITE_BARRIER_PROFILING) || ENABLE(GGC)
     needSecondScratch = true;
 #endif
     if (structure->outOfLineCapacity() != oldStructure->outOfLineCapacity()
@@ -827,7 +843,7 @@ static void emitPutTransitionStub(
         }
     }
 
-#if ENABLE(WRITE_BARRIER_PROFILING)
+#if ENABLE(WRITE_BARRIER_PROFILING) || ENABLE(GGC)
     ASSERT(needSecondScratch);
     ASSERT(scratchGPR2 != InvalidGPRReg);
     // Must always emit this write barrier as the structure transition itself requires it
@@ -1017,9 +1033,12 @@ static bool tryCachePutByID(ExecState* exec, JSValue baseValue, const Identifier
 
 void dfgRepatchPutByID(ExecState* exec, JSValue baseValue, const Identifier& propertyName, const PutPropertySlot& slot, StructureStubInfo& stubInfo, PutKind putKind)
 {
+    stubInfo.repatchCount++;
     bool cached = tryCachePutByID(exec, baseValue, propertyName, slot, stubInfo, putKind);
-    if (!cached)
+    if (!cached) {
+        stubInfo.tookGenericPath = true;
         dfgRepatchCall(exec->codeBlock(), stubInfo.callReturnLocation, appropriateGenericPutByIdFunction(slot, putKind));
+    }
 }
 
 static bool tryBuildPutByIdList(ExecState* exec, JSValue baseValue, const Identifier& propertyName, const PutPropertySlot& slot, StructureStubInfo& stubInfo, PutKind putKind)
@@ -1110,9 +1129,12 @@ static bool tryBuildPutByIdList(ExecState* exec, JSValue baseValue, const Identi
 
 void dfgBuildPutByIdList(ExecState* exec, JSValue baseValue, const Identifier& propertyName, const PutPropertySlot& slot, StructureStubInfo& stubInfo, PutKind putKind)
 {
+    stubInfo.repatchCount++;
     bool cached = tryBuildPutByIdList(exec, baseValue, propertyName, slot, stubInfo, putKind);
-    if (!cached)
+    if (!cached) {
+        stubInfo.tookGenericPath = true;
         dfgRepatchCall(exec->codeBlock(), stubInfo.callReturnLocation, appropriateGenericPutByIdFunction(slot, putKind));
+    }
 }
 
 static void linkSlowFor(RepatchBuffer& repatchBuffer, VM* vm, CallLinkInfo& callLinkInfo, CodeSpecializationKind kind)
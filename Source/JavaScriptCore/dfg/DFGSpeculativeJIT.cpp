@@ -929,6 +929,22 @@ void SpeculativeJIT::useChildren(Node* node)
     }
 }
 
+#if ENABLE(GGC)
+void SpeculativeJIT::markCellCard(MacroAssembler& jit, GPRReg owner, GPRReg scratch1, GPRReg scratch2)
+{
+    ASSERT(owner != scratch1);
+    ASSERT(owner != scratch2);
+    ASSERT(scratch1 != scratch2);
+
+    jit.move(owner, scratch1);
+    jit.andPtr(MacroAssembler::TrustedImm32(static_cast<int32_t>(MarkedBlock::blockMask)), scratch1);
+    jit.move(owner, scratch2);
+    jit.rshift32(MacroAssembler::TrustedImm32(MarkedBlock::cardShift), scratch2);
+    jit.and32(MacroAssembler::TrustedImm32(MarkedBlock::cardMask), scratch2);
+    jit.store8(MacroAssembler::TrustedImm32(1), MacroAssembler::BaseIndex(scratch1, scratch2, MacroAssembler::TimesOne, MarkedBlock::offsetOfCards()));
+}
+#endif
+
 void SpeculativeJIT::writeBarrier(MacroAssembler& jit, GPRReg owner, GPRReg scratch1, GPRReg scratch2, WriteBarrierUseKind useKind)
 {
     UNUSED_PARAM(jit);
@@ -943,6 +959,10 @@ void SpeculativeJIT::writeBarrier(MacroAssembler& jit, GPRReg owner, GPRReg scra
 #if ENABLE(WRITE_BARRIER_PROFILING)
     JITCompiler::emitCount(jit, WriteBarrierCounters::jitCounterFor(useKind));
 #endif
+
+#if ENABLE(GGC)
+    markCellCard(jit, owner, scratch1, scratch2);
+#endif
 }
 
 void SpeculativeJIT::writeBarrier(GPRReg ownerGPR, GPRReg valueGPR, Edge valueUse, WriteBarrierUseKind useKind, GPRReg scratch1, GPRReg scratch2)
@@ -959,6 +979,29 @@ void SpeculativeJIT::writeBarrier(GPRReg ownerGPR, GPRReg valueGPR, Edge valueUs
 #if ENABLE(WRITE_BARRIER_PROFILING)
     JITCompiler::emitCount(m_jit, WriteBarrierCounters::jitCounterFor(useKind));
 #endif
+
+#if ENABLE(GGC)
+    GPRTemporary temp1;
+    GPRTemporary temp2;
+    if (scratch1 == InvalidGPRReg) {
+        GPRTemporary scratchGPR(this);
+        temp1.adopt(scratchGPR);
+        scratch1 = temp1.gpr();
+    }
+    if (scratch2 == InvalidGPRReg) {
+        GPRTemporary scratchGPR(this);
+        temp2.adopt(scratchGPR);
+        scratch2 = temp2.gpr();
+    }
+
+    JITCompiler::Jump valueNotCell;
+    bool needsCellCheck = !isKnownCell(valueUse.node());
+    if (needsCellCheck)
+        valueNotCell = m_jit.branchIfNotCell(valueGPR);
+    markCellCard(m_jit, ownerGPR, scratch1, scratch2);
+    if (needsCellCheck)
+        valueNotCell.link(&m_jit);
+#endif
 }
 
 void SpeculativeJIT::writeBarrier(GPRReg ownerGPR, JSCell* value, WriteBarrierUseKind useKind, GPRReg scratch1, GPRReg scratch2)
@@ -975,6 +1018,23 @@ void SpeculativeJIT::writeBarrier(GPRReg ownerGPR, JSCell* value, WriteBarrierUs
 #if ENABLE(WRITE_BARRIER_PROFILING)
     JITCompiler::emitCount(m_jit, WriteBarrierCounters::jitCounterFor(useKind));
 #endif
+
+#if ENABLE(GGC)
+    GPRTemporary temp1;
+    GPRTemporary temp2;
+    if (scratch1 == InvalidGPRReg) {
+        GPRTemporary scratchGPR(this);
+        temp1.adopt(scratchGPR);
+        scratch1 = temp1.gpr();
+    }
+    if (scratch2 == InvalidGPRReg) {
+        GPRTemporary scratchGPR(this);
+        temp2.adopt(scratchGPR);
+        scratch2 = temp2.gpr();
+    }
+
+    markCellCard(m_jit, ownerGPR, scratch1, scratch2);
+#endif
 }
 
 void SpeculativeJIT::writeBarrier(JSCell* owner, GPRReg valueGPR, Edge valueUse, WriteBarrierUseKind useKind, GPRReg scratch)
@@ -990,6 +1050,16 @@ void SpeculativeJIT::writeBarrier(JSCell* owner, GPRReg valueGPR, Edge valueUse,
 #if ENABLE(WRITE_BARRIER_PROFILING)
     JITCompiler::emitCount(m_jit, WriteBarrierCounters::jitCounterFor(useKind));
 #endif
+
+#if ENABLE(GGC)
+    JITCompiler::Jump valueNotCell;
+    bool needsCellCheck = !isKnownCell(valueUse.node());
+    if (needsCellCheck)
+        valueNotCell = m_jit.branchIfNotCell(valueGPR);
+    m_jit.store8(JITCompiler::TrustedImm32(1), Heap::addressOfCardFor(owner));
+    if (needsCellCheck)
+        valueNotCell.link(&m_jit);
+#endif
 }
 
 bool SpeculativeJIT::nonSpeculativeCompare(Node* node, MacroAssembler::RelationalCondition cond, S_DFGOperation_EJJ helperFunction)
@@ -2778,6 +2848,229 @@ void SpeculativeJIT::compilePutByValForFloatTypedArray(const TypedArrayDescripto
     noResult(node);
 }
 
+// Checks that the base is a DataView and that the access is in bounds, and leaves the
+// view's base address in storage.
+void SpeculativeJIT::emitDataViewAccessChecks(Node* node, GPRReg baseReg, GPRReg byteOffsetReg, GPRReg storageReg)
+{
+    const TypedArrayDescriptor& descriptor = m_jit.vm()->dataViewDescriptor();
+    
+    m_jit.loadPtr(MacroAssembler::Address(baseReg, JSCell::structureOffset()), storageReg);
+    speculationCheck(
+        BadType, JSValueSource::unboxedCell(baseReg), node->child1(),
+        m_jit.branchPtr(
+            MacroAssembler::NotEqual,
+            MacroAssembler::Address(storageReg, Structure::classInfoOffset()),
+            MacroAssembler::TrustedImmPtr(descriptor.m_classInfo)));
+    
+    // The call converts the offset with ToUint32, so a negative int32 is an offset that is
+    // always out of bounds. Once that's excluded, adding the element size cannot wrap.
+    speculationCheck(
+        OutOfBounds, JSValueRegs(), 0,
+        m_jit.branch32(MacroAssembler::LessThan, byteOffsetReg, TrustedImm32(0)));
+    m_jit.add32(TrustedImm32(elementSizeForTypedArrayType(node->dataViewType())), byteOffsetReg, storageReg);
+    speculationCheck(
+        OutOfBounds, JSValueRegs(), 0,
+        m_jit.branch32(
+            MacroAssembler::Above, storageReg, MacroAssembler::Address(baseReg, descriptor.m_lengthOffset)));
+    
+    m_jit.loadPtr(MacroAssembler::Address(baseReg, descriptor.m_storageOffset), storageReg);
+}
+
+void SpeculativeJIT::compileDataViewGet(Node* node)
+{
+#if CPU(X86) || CPU(X86_64)
+    SpeculateCellOperand base(this, node->child1());
+    SpeculateStrictInt32Operand byteOffset(this, node->child2());
+    GPRTemporary storage(this);
+    GPRTemporary result(this);
+    
+    GPRReg baseReg = base.gpr();
+    GPRReg byteOffsetReg = byteOffset.gpr();
+    GPRReg storageReg = storage.gpr();
+    GPRReg resultReg = result.gpr();
+    
+    emitDataViewAccessChecks(node, baseReg, byteOffsetReg, storageReg);
+    
+    MacroAssembler::BaseIndex address(storageReg, byteOffsetReg, MacroAssembler::TimesOne);
+    bool littleEndian = node->dataViewIsLittleEndian();
+    
+    switch (node->dataViewType()) {
+    case TypedArrayInt8:
+        m_jit.load8Signed(address, resultReg);
+        integerResult(resultReg, node);
+        return;
+    case TypedArrayUint8:
+        m_jit.load8(address, resultReg);
+        integerResult(resultReg, node);
+        return;
+    case TypedArrayInt16:
+        if (littleEndian)
+            m_jit.load16Signed(address, resultReg);
+        else {
+            m_jit.load16(address, resultReg);
+            m_jit.byteSwap32(resultReg);
+            m_jit.rshift32(TrustedImm32(16), resultReg);
+        }
+        integerResult(resultReg, node);
+        return;
+    case TypedArrayUint16:
+        m_jit.load16(address, resultReg);
+        if (!littleEndian) {
+            m_jit.byteSwap32(resultReg);
+            m_jit.urshift32(TrustedImm32(16), resultReg);
+        }
+        integerResult(resultReg, node);
+        return;
+    case TypedArrayInt32:
+        m_jit.load32(address, resultReg);
+        if (!littleEndian)
+            m_jit.byteSwap32(resultReg);
+        integerResult(resultReg, node);
+        return;
+    case TypedArrayUint32: {
+        m_jit.load32(address, resultReg);
+        if (!littleEndian)
+            m_jit.byteSwap32(resultReg);
+        if (node->op() == DataViewGetInt) {
+            // The call hasn't had any effects yet, so it's fine to exit back to it.
+            speculationCheck(Overflow, JSValueRegs(), 0, m_jit.branch32(MacroAssembler::LessThan, resultReg, TrustedImm32(0)));
+            integerResult(resultReg, node);
+            return;
+        }
+        FPRTemporary fresult(this);
+        m_jit.convertInt32ToDouble(resultReg, fresult.fpr());
+        JITCompiler::Jump positive = m_jit.branch32(MacroAssembler::GreaterThanOrEqual, resultReg, TrustedImm32(0));
+        m_jit.addDouble(JITCompiler::AbsoluteAddress(&AssemblyHelpers::twoToThe32), fresult.fpr());
+        positive.link(&m_jit);
+        doubleResult(fresult.fpr(), node);
+        return;
+    }
+    case TypedArrayFloat32:
+    case TypedArrayFloat64: {
+        FPRTemporary fresult(this);
+        FPRReg fresultReg = fresult.fpr();
+        if (node->dataViewType() == TypedArrayFloat32) {
+            if (littleEndian)
+                m_jit.loadFloat(address, fresultReg);
+            else {
+                m_jit.load32(address, resultReg);
+                m_jit.byteSwap32(resultReg);
+                m_jit.move32ToFloat(resultReg, fresultReg);
+            }
+            m_jit.convertFloatToDouble(fresultReg, fresultReg);
+        } else if (littleEndian)
+            m_jit.loadDouble(address, fresultReg);
+        else {
+#if USE(JSVALUE64)
+            m_jit.load64(address, resultReg);
+            m_jit.byteSwap64(resultReg);
+            m_jit.move64ToDouble(resultReg, fresultReg);
+#else
+            RELEASE_ASSERT_NOT_REACHED();
+#endif
+        }
+        
+        MacroAssembler::Jump notNaN = m_jit.branchDouble(MacroAssembler::DoubleEqual, fresultReg, fresultReg);
+        static const double NaN = QNaN;
+        m_jit.loadDouble(&NaN, fresultReg);
+        notNaN.link(&m_jit);
+        
+        doubleResult(fresultReg, node);
+        return;
+    }
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+#else
+    UNUSED_PARAM(node);
+    RELEASE_ASSERT_NOT_REACHED();
+#endif
+}
+
+void SpeculativeJIT::compileDataViewSet(Node* node)
+{
+#if CPU(X86) || CPU(X86_64)
+    SpeculateCellOperand base(this, node->child1());
+    SpeculateStrictInt32Operand byteOffset(this, node->child2());
+    GPRTemporary storage(this);
+    GPRTemporary scratch(this);
+    
+    GPRReg baseReg = base.gpr();
+    GPRReg byteOffsetReg = byteOffset.gpr();
+    GPRReg storageReg = storage.gpr();
+    GPRReg scratchReg = scratch.gpr();
+    
+    TypedArrayType type = node->dataViewType();
+    bool littleEndian = node->dataViewIsLittleEndian();
+    MacroAssembler::BaseIndex address(storageReg, byteOffsetReg, MacroAssembler::TimesOne);
+    
+    if (type == TypedArrayFloat32 || type == TypedArrayFloat64) {
+        SpeculateDoubleOperand value(this, node->child3());
+        FPRTemporary floatScratch(this);
+        FPRReg valueReg = value.fpr();
+        FPRReg floatScratchReg = floatScratch.fpr();
+        
+        emitDataViewAccessChecks(node, baseReg, byteOffsetReg, storageReg);
+        
+        if (type == TypedArrayFloat32) {
+            m_jit.convertDoubleToFloat(valueReg, floatScratchReg);
+            if (littleEndian)
+                m_jit.storeFloat(floatScratchReg, address);
+            else {
+                m_jit.moveFloatTo32(floatScratchReg, scratchReg);
+                m_jit.byteSwap32(scratchReg);
+                m_jit.store32(scratchReg, address);
+            }
+        } else if (littleEndian)
+            m_jit.storeDouble(valueReg, address);
+        else {
+#if USE(JSVALUE64)
+            m_jit.moveDoubleTo64(valueReg, scratchReg);
+            m_jit.byteSwap64(scratchReg);
+            m_jit.store64(scratchReg, address);
+#else
+            RELEASE_ASSERT_NOT_REACHED();
+#endif
+        }
+        noResult(node);
+        return;
+    }
+    
+    SpeculateIntegerOperand value(this, node->child3());
+    GPRReg valueReg = value.gpr();
+    
+    emitDataViewAccessChecks(node, baseReg, byteOffsetReg, storageReg);
+    
+    m_jit.move(valueReg, scratchReg);
+    switch (type) {
+    case TypedArrayInt8:
+    case TypedArrayUint8:
+        m_jit.store8(scratchReg, address);
+        break;
+    case TypedArrayInt16:
+    case TypedArrayUint16:
+        if (!littleEndian) {
+            m_jit.byteSwap32(scratchReg);
+            m_jit.urshift32(TrustedImm32(16), scratchReg);
+        }
+        m_jit.store16(scratchReg, address);
+        break;
+    case TypedArrayInt32:
+    case TypedArrayUint32:
+        if (!littleEndian)
+            m_jit.byteSwap32(scratchReg);
+        m_jit.store32(scratchReg, address);
+        break;
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+    noResult(node);
+#else
+    UNUSED_PARAM(node);
+    RELEASE_ASSERT_NOT_REACHED();
+#endif
+}
+
 void SpeculativeJIT::compileInstanceOfForObject(Node*, GPRReg valueReg, GPRReg prototypeReg, GPRReg scratchReg)
 {
     // Check that prototype is an object.
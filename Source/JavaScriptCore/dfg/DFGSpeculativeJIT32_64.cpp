@@ -2247,6 +2247,15 @@ void SpeculativeJIT::compile(Node* node)
     case ArithIMul:
         compileArithIMul(node);
         break;
+        
+    case DataViewGetInt:
+    case DataViewGetFloat:
+        compileDataViewGet(node);
+        break;
+        
+    case DataViewSet:
+        compileDataViewSet(node);
+        break;
 
     case ArithDiv: {
         switch (node->binaryUseKind()) {
@@ -4064,7 +4073,7 @@ void SpeculativeJIT::compile(Node* node)
             node->structureTransitionData().previousStructure,
             node->structureTransitionData().newStructure);
         
-#if ENABLE(WRITE_BARRIER_PROFILING)
+#if ENABLE(WRITE_BARRIER_PROFILING) || ENABLE(GGC)
         // Must always emit this write barrier as the structure transition itself requires it
         writeBarrier(baseGPR, node->structureTransitionData().newStructure, WriteBarrierForGenericAccess);
 #endif
@@ -4120,7 +4129,7 @@ void SpeculativeJIT::compile(Node* node)
     }
         
     case PutByOffset: {
-#if ENABLE(WRITE_BARRIER_PROFILING)
+#if ENABLE(WRITE_BARRIER_PROFILING) || ENABLE(GGC)
         SpeculateCellOperand base(this, node->child2());
 #endif
         StorageOperand storage(this, node->child1());
@@ -4130,7 +4139,7 @@ void SpeculativeJIT::compile(Node* node)
         GPRReg valueTagGPR = value.tagGPR();
         GPRReg valuePayloadGPR = value.payloadGPR();
         
-#if ENABLE(WRITE_BARRIER_PROFILING)
+#if ENABLE(WRITE_BARRIER_PROFILING) || ENABLE(GGC)
         writeBarrier(base.gpr(), valueTagGPR, node->child3(), WriteBarrierForPropertyAccess);
 #endif
 
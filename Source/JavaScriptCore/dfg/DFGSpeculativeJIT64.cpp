@@ -2185,6 +2185,15 @@ void SpeculativeJIT::compile(Node* node)
     case ArithIMul:
         compileArithIMul(node);
         break;
+        
+    case DataViewGetInt:
+    case DataViewGetFloat:
+        compileDataViewGet(node);
+        break;
+        
+    case DataViewSet:
+        compileDataViewSet(node);
+        break;
 
     case ArithDiv: {
         switch (node->binaryUseKind()) {
@@ -3971,7 +3980,7 @@ void SpeculativeJIT::compile(Node* node)
             node->structureTransitionData().previousStructure,
             node->structureTransitionData().newStructure);
         
-#if ENABLE(WRITE_BARRIER_PROFILING)
+#if ENABLE(WRITE_BARRIER_PROFILING) || ENABLE(GGC)
         // Must always emit this write barrier as the structure transition itself requires it
         writeBarrier(baseGPR, node->structureTransitionData().newStructure, WriteBarrierForGenericAccess);
 #endif
@@ -4024,7 +4033,7 @@ void SpeculativeJIT::compile(Node* node)
     }
         
     case PutByOffset: {
-#if ENABLE(WRITE_BARRIER_PROFILING)
+#if ENABLE(WRITE_BARRIER_PROFILING) || ENABLE(GGC)
         SpeculateCellOperand base(this, node->child2());
 #endif
         StorageOperand storage(this, node->child1());
@@ -4033,7 +4042,7 @@ void SpeculativeJIT::compile(Node* node)
         GPRReg storageGPR = storage.gpr();
         GPRReg valueGPR = value.gpr();
         
-#if ENABLE(WRITE_BARRIER_PROFILING)
+#if ENABLE(WRITE_BARRIER_PROFILING) || ENABLE(GGC)
         writeBarrier(base.gpr(), value.gpr(), node->child3(), WriteBarrierForPropertyAccess);
 #endif
 
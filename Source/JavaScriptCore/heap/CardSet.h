@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef CardSet_h
+#define CardSet_h
+
+#include <stdint.h>
+#include <string.h>
+#include <wtf/Assertions.h>
+#include <wtf/Noncopyable.h>
+
+namespace JSC {
+
+// A card set divides a block into fixed-size cards and keeps one byte per
+// card. Write barriers mark the card containing the owner of a store, so an
+// eden collection only has to rescan old objects whose cards are dirty.
+// Marking is a single byte store so that the JIT and LLInt can inline it.
+
+template <size_t cardSize, size_t blockSize> class CardSet {
+    WTF_MAKE_NONCOPYABLE(CardSet);
+
+public:
+    static const size_t cardCount = (blockSize + cardSize - 1) / cardSize;
+
+    CardSet()
+    {
+        clearAll();
+    }
+
+    bool isCardMarkedForAtom(const void*);
+    void markCardForAtom(const void*);
+    uint8_t& cardForAtom(const void*);
+    bool isCardMarked(size_t);
+    bool testAndClear(size_t);
+    bool isEmpty();
+    void clearAll();
+
+private:
+    uint8_t m_cards[cardCount];
+    COMPILE_ASSERT(!(cardSize & (cardSize - 1)), cardSet_cardSize_is_power_of_two);
+    COMPILE_ASSERT(!(cardCount & (cardCount - 1)), cardSet_cardCount_is_power_of_two);
+    COMPILE_ASSERT(!(cardCount % sizeof(uintptr_t)), cardSet_cardCount_is_word_multiple);
+};
+
+template <size_t cardSize, size_t blockSize> uint8_t& CardSet<cardSize, blockSize>::cardForAtom(const void* ptr)
+{
+    ASSERT(ptr > this && ptr < (reinterpret_cast<const char*>(this) + cardCount * cardSize));
+    uintptr_t card = (reinterpret_cast<uintptr_t>(ptr) / cardSize) % cardCount;
+    return m_cards[card];
+}
+
+template <size_t cardSize, size_t blockSize> bool CardSet<cardSize, blockSize>::isCardMarkedForAtom(const void* ptr)
+{
+    return cardForAtom(ptr);
+}
+
+template <size_t cardSize, size_t blockSize> void CardSet<cardSize, blockSize>::markCardForAtom(const void* ptr)
+{
+    cardForAtom(ptr) = 1;
+}
+
+template <size_t cardSize, size_t blockSize> bool CardSet<cardSize, blockSize>::isCardMarked(size_t i)
+{
+    ASSERT(i < cardCount);
+    return m_cards[i];
+}
+
+template <size_t cardSize, size_t blockSize> bool CardSet<cardSize, blockSize>::testAndClear(size_t i)
+{
+    ASSERT(i < cardCount);
+    bool result = m_cards[i];
+    m_cards[i] = 0;
+    return result;
+}
+
+template <size_t cardSize, size_t blockSize> bool CardSet<cardSize, blockSize>::isEmpty()
+{
+    const uintptr_t* words = reinterpret_cast<const uintptr_t*>(m_cards);
+    for (size_t i = 0; i < cardCount / sizeof(uintptr_t); ++i) {
+        if (words[i])
+            return false;
+    }
+    return true;
+}
+
+template <size_t cardSize, size_t blockSize> void CardSet<cardSize, blockSize>::clearAll()
+{
+    memset(m_cards, 0, cardCount);
+}
+
+} // namespace JSC
+
+#endif // CardSet_h
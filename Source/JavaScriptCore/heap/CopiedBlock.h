@@ -82,6 +82,11 @@ public:
     bool hasWorkList();
     CopyWorkList& workList();
 
+    // The segments of a block's work list may be copied by several threads. The thread
+    // that finishes the last one is responsible for recycling the block.
+    void willCopySegments(unsigned);
+    bool didCopySegment();
+
 private:
     CopiedBlock(Region*);
     void zeroFillWilderness(); // Can be called at any time to zero-fill to the end of the block.
@@ -94,6 +99,7 @@ private:
     size_t m_remaining;
     uintptr_t m_isPinned;
     unsigned m_liveBytes;
+    int m_segmentsLeftToCopy;
 };
 
 inline CopiedBlock* CopiedBlock::createNoZeroFill(DeadBlock* block)
@@ -126,6 +132,7 @@ inline CopiedBlock::CopiedBlock(Region* region)
     , m_remaining(payloadCapacity())
     , m_isPinned(false)
     , m_liveBytes(0)
+    , m_segmentsLeftToCopy(0)
 {
 #if ENABLE(PARALLEL_GC)
     m_workListLock.Init();
@@ -143,8 +150,16 @@ inline void CopiedBlock::didSurviveGC()
 
 inline void CopiedBlock::didEvacuateBytes(unsigned bytes)
 {
+#if ENABLE(PARALLEL_GC)
+    unsigned oldLiveBytes;
+    do {
+        oldLiveBytes = m_liveBytes;
+        ASSERT(oldLiveBytes >= bytes);
+    } while (!WTF::weakCompareAndSwap(&m_liveBytes, oldLiveBytes, oldLiveBytes - bytes));
+#else
     ASSERT(m_liveBytes >= bytes);
     m_liveBytes -= bytes;
+#endif
 }
 
 inline bool CopiedBlock::canBeRecycled()
@@ -244,6 +259,22 @@ inline CopyWorkList& CopiedBlock::workList()
     return *m_workList;
 }
 
+inline void CopiedBlock::willCopySegments(unsigned count)
+{
+    ASSERT(count);
+    m_segmentsLeftToCopy = count;
+}
+
+inline bool CopiedBlock::didCopySegment()
+{
+    ASSERT(m_segmentsLeftToCopy > 0);
+#if ENABLE(PARALLEL_GC)
+    return !WTF::atomicDecrement(&m_segmentsLeftToCopy);
+#else
+    return !--m_segmentsLeftToCopy;
+#endif
+}
+
 } // namespace JSC
 
 #endif
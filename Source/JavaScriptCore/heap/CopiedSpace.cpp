@@ -259,6 +259,23 @@ void CopiedSpace::doneCopying()
     m_shouldDoCopyPhase = false;
 }
 
+#if ENABLE(GGC)
+void CopiedSpace::didSkipCopying()
+{
+    // An eden collection does not visit old objects, so the live byte counts
+    // gathered while marking do not cover all live storage. Keep every block
+    // and forget what marking reported.
+    ASSERT(!m_inCopyingPhase);
+    ASSERT(m_fromSpace->isEmpty());
+
+    for (CopiedBlock* block = m_toSpace->head(); block; block = block->next())
+        block->didSurviveGC();
+
+    for (CopiedBlock* block = m_oversizeBlocks.head(); block; block = block->next())
+        block->didSurviveGC();
+}
+#endif
+
 size_t CopiedSpace::size()
 {
     size_t calculatedSize = 0;
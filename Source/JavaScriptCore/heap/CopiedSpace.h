@@ -62,6 +62,9 @@ public:
 
     void startedCopying();
     void doneCopying();
+#if ENABLE(GGC)
+    void didSkipCopying();
+#endif
     bool isInCopyPhase() { return m_inCopyingPhase; }
 
     void pin(CopiedBlock*);
@@ -38,29 +38,68 @@ namespace JSC {
 
 CopyVisitor::CopyVisitor(GCThreadSharedData& shared)
     : m_shared(shared)
+    , m_bytesCopied(0)
+    , m_segmentsStolen(0)
 {
+    m_workLock.Init();
 }
 
 void CopyVisitor::copyFromShared()
 {
-    size_t next, end;
-    m_shared.getNextBlocksToCopy(next, end);
-    while (next < end) {
-        for (; next < end; ++next) {
-            CopiedBlock* block = m_shared.m_blocksToCopy[next];
-            if (!block->hasWorkList())
-                continue;
+    // No new work shows up while copying, so once every queue is empty we are done,
+    // even if other threads are still finishing the segments they took.
+    CopyWorkItem item;
+    do {
+        while (takeWork(item))
+            copySegment(item);
+    } while (m_shared.stealCopyWork(*this));
+}
+
+void CopyVisitor::copySegment(const CopyWorkItem& item)
+{
+    CopyWorkListSegment* segment = item.segment;
+    for (size_t i = 0; i < segment->size(); ++i)
+        visitCell(segment->get(i));
+
+    if (!item.block->didCopySegment())
+        return;
+    ASSERT(!item.block->liveBytes());
+    m_shared.m_copiedSpace->recycleEvacuatedBlock(item.block);
+}
+
+void CopyVisitor::addWork(const CopyWorkItem& item)
+{
+    SpinLockHolder locker(&m_workLock);
+    m_workItems.append(item);
+}
 
-            CopyWorkList& workList = block->workList();
-            for (CopyWorkList::iterator it = workList.begin(); it != workList.end(); ++it)
-                visitCell(*it);
+bool CopyVisitor::takeWork(CopyWorkItem& item)
+{
+    SpinLockHolder locker(&m_workLock);
+    if (m_workItems.isEmpty())
+        return false;
+    item = m_workItems.takeLast();
+    return true;
+}
 
-            ASSERT(!block->liveBytes());
-            m_shared.m_copiedSpace->recycleEvacuatedBlock(block);
-        }
-        m_shared.getNextBlocksToCopy(next, end);
+bool CopyVisitor::stealWorkFrom(CopyVisitor& victim)
+{
+    ASSERT(&victim != this);
+    Vector<CopyWorkItem, 32> stolenItems;
+    {
+        SpinLockHolder locker(&victim.m_workLock);
+        size_t count = (victim.m_workItems.size() + 1) / 2;
+        for (size_t i = 0; i < count; ++i)
+            stolenItems.append(victim.m_workItems.takeFirst());
     }
-    ASSERT(next == end);
+    if (stolenItems.isEmpty())
+        return false;
+
+    SpinLockHolder locker(&m_workLock);
+    for (size_t i = 0; i < stolenItems.size(); ++i)
+        m_workItems.append(stolenItems[i]);
+    m_segmentsStolen += stolenItems.size();
+    return true;
 }
 
 } // namespace JSC
@@ -27,16 +27,39 @@
 #define CopyVisitor_h
 
 #include "CopiedSpace.h"
+#include <wtf/Deque.h>
+#include <wtf/TCSpinLock.h>
 
 namespace JSC {
 
+class CopiedBlock;
+class CopyWorkListSegment;
 class GCThreadSharedData;
 class JSCell;
 
+struct CopyWorkItem {
+    CopyWorkItem()
+        : block(0)
+        , segment(0)
+    {
+    }
+
+    CopyWorkItem(CopiedBlock* block, CopyWorkListSegment* segment)
+        : block(block)
+        , segment(segment)
+    {
+    }
+
+    CopiedBlock* block;
+    CopyWorkListSegment* segment;
+};
+
 class CopyVisitor {
 public:
     CopyVisitor(GCThreadSharedData&);
 
+    // Copies the segments that were handed to this visitor, then steals segments
+    // from the other visitors until there are none left anywhere.
     void copyFromShared();
 
     void startCopying();
@@ -49,12 +72,29 @@ public:
     void* allocateNewSpace(size_t);
     void didCopy(void*, size_t);
 
+    size_t bytesCopied() const { return m_bytesCopied; }
+    size_t segmentsStolen() const { return m_segmentsStolen; }
+
 private:
+    friend class GCThreadSharedData;
+
     void* allocateNewSpaceSlow(size_t);
     void visitCell(JSCell*);
 
+    void addWork(const CopyWorkItem&);
+    bool takeWork(CopyWorkItem&);
+    bool stealWorkFrom(CopyVisitor&);
+    void copySegment(const CopyWorkItem&);
+
     GCThreadSharedData& m_shared;
     CopiedAllocator m_copiedAllocator;
+
+    // The owner takes work from the back of the queue and thieves take from the front.
+    SpinLock m_workLock;
+    Deque<CopyWorkItem> m_workItems;
+
+    size_t m_bytesCopied;
+    size_t m_segmentsStolen;
 };
 
 } // namespace JSC
@@ -74,6 +74,8 @@ inline void* CopyVisitor::allocateNewSpaceSlow(size_t bytes)
 inline void CopyVisitor::startCopying()
 {
     ASSERT(!m_copiedAllocator.isValid());
+    m_bytesCopied = 0;
+    m_segmentsStolen = 0;
     CopiedBlock* block = 0;
     m_shared.m_copiedSpace->doneFillingBlock(m_copiedAllocator.resetCurrentBlock(), &block);
     m_copiedAllocator.setCurrentBlock(block);
@@ -94,7 +96,7 @@ inline void CopyVisitor::didCopy(void* ptr, size_t bytes)
     ASSERT(!block->isPinned());
 
     block->didEvacuateBytes(bytes);
-
+    m_bytesCopied += bytes;
 }
 
 } // namespace JSC
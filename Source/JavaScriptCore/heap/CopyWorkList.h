@@ -124,6 +124,9 @@ public:
     iterator begin();
     iterator end();
 
+    // Segments can be handed to different threads during the copying phase.
+    CopyWorkListSegment* head() { return m_segments.head(); }
+
 private:
     DoublyLinkedList<CopyWorkListSegment> m_segments;
     BlockAllocator& m_blockAllocator;
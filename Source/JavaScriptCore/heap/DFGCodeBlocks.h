@@ -78,6 +78,7 @@ public:
 
 private:
     friend class CodeBlock;
+    friend class SamplingProfiler;
     
     HashSet<CodeBlock*> m_set;
 };
@@ -118,6 +118,16 @@ void GCThread::gcThreadMain()
                 // returns our borrowed CopiedBlock, allowing the copying phase to finish.
                 m_copyVisitor->doneCopying();
                 break;
+            case ConcurrentSweep:
+#if ENABLE(PARALLEL_GC)
+                // We're done sweeping when there are no more queued blocks, or when the main thread 
+                // stops handing them out in didFinishSweeping(). Blocks that we don't get to are 
+                // swept by the mutator when it allocates from them.
+                m_shared.sweepFromShared();
+#else
+                RELEASE_ASSERT_NOT_REACHED();
+#endif
+                break;
             case NoPhase:
                 RELEASE_ASSERT_NOT_REACHED();
                 break;
@@ -26,13 +26,17 @@
 #include "config.h"
 #include "GCThreadSharedData.h"
 
+#include "CopiedBlock.h"
 #include "CopyVisitor.h"
 #include "CopyVisitorInlines.h"
+#include "CopyWorkList.h"
 #include "GCThread.h"
 #include "VM.h"
 #include "MarkStack.h"
+#include "Options.h"
 #include "SlotVisitor.h"
 #include "SlotVisitorInlines.h"
+#include <wtf/DataLog.h>
 
 namespace JSC {
 
@@ -59,13 +63,16 @@ GCThreadSharedData::GCThreadSharedData(VM* vm)
     , m_sharedMarkStack(vm->heap.blockAllocator())
     , m_numberOfActiveParallelMarkers(0)
     , m_parallelMarkersShouldExit(false)
-    , m_copyIndex(0)
+#if ENABLE(PARALLEL_GC)
+    , m_sweepIndex(0)
+#endif
     , m_numberOfActiveGCThreads(0)
     , m_gcThreadsShouldWait(false)
     , m_currentPhase(NoPhase)
 {
-    m_copyLock.Init();
 #if ENABLE(PARALLEL_GC)
+    m_sweepLock.Init();
+
     // Grab the lock so the new GC threads can be properly initialized before they start running.
     MutexLocker locker(m_phaseLock);
     for (unsigned i = 1; i < Options::numberOfGCMarkers(); ++i) {
@@ -163,10 +170,29 @@ void GCThreadSharedData::didFinishMarking()
 
 void GCThreadSharedData::didStartCopying()
 {
-    {
-        SpinLockHolder locker(&m_copyLock);
-        WTF::copyToVector(m_copiedSpace->m_blockSet, m_blocksToCopy);
-        m_copyIndex = 0;
+    m_copyVisitors.clear();
+    m_copyVisitors.append(&m_vm->heap.m_copyVisitor);
+    for (size_t i = 0; i < m_gcThreads.size(); i++)
+        m_copyVisitors.append(m_gcThreads[i]->copyVisitor());
+
+    // Deal out whole blocks so that each thread starts out copying from blocks of its own.
+    // Blocks with long work lists get split up by stealing their segments later on.
+    size_t nextVisitor = 0;
+    HashSet<CopiedBlock*>::iterator end = m_copiedSpace->m_blockSet.end();
+    for (HashSet<CopiedBlock*>::iterator it = m_copiedSpace->m_blockSet.begin(); it != end; ++it) {
+        CopiedBlock* block = *it;
+        if (!block->hasWorkList())
+            continue;
+
+        unsigned segmentCount = 0;
+        for (CopyWorkListSegment* segment = block->workList().head(); segment; segment = segment->next())
+            segmentCount++;
+        block->willCopySegments(segmentCount);
+
+        CopyVisitor* visitor = m_copyVisitors[nextVisitor];
+        for (CopyWorkListSegment* segment = block->workList().head(); segment; segment = segment->next())
+            visitor->addWork(CopyWorkItem(block, segment));
+        nextVisitor = (nextVisitor + 1) % m_copyVisitors.size();
     }
 
     // We do this here so that we avoid a race condition where the main thread can 
@@ -183,6 +209,104 @@ void GCThreadSharedData::didFinishCopying()
 {
     ASSERT(m_currentPhase == Copy);
     endCurrentPhase();
+
+    if (Options::logCopyingStatistics()) {
+        for (size_t i = 0; i < m_copyVisitors.size(); ++i)
+            dataLogF("Copy visitor %lu: copied %lu bytes, stole %lu segments\n", static_cast<unsigned long>(i), static_cast<unsigned long>(m_copyVisitors[i]->bytesCopied()), static_cast<unsigned long>(m_copyVisitors[i]->segmentsStolen()));
+    }
 }
 
+bool GCThreadSharedData::stealCopyWork(CopyVisitor& thief)
+{
+    // Start looking at the thief's neighbor so that the threads don't all go after the same victim.
+    size_t thiefIndex = m_copyVisitors.find(&thief);
+    ASSERT(thiefIndex != notFound);
+    for (size_t i = 1; i < m_copyVisitors.size(); ++i) {
+        if (thief.stealWorkFrom(*m_copyVisitors[(thiefIndex + i) % m_copyVisitors.size()]))
+            return true;
+    }
+    return false;
+}
+
+#if ENABLE(PARALLEL_GC)
+void GCThreadSharedData::didStartSweeping(Vector<MarkedBlock*>& blocks)
+{
+    ASSERT(m_currentPhase == NoPhase);
+    {
+        SpinLockHolder locker(&m_sweepLock);
+        m_blocksToSweep.swap(blocks);
+        m_sweepIndex = 0;
+    }
+
+    startNextPhase(ConcurrentSweep);
+}
+
+void GCThreadSharedData::didFinishSweeping()
+{
+    if (!isSweeping())
+        return;
+
+    // Don't hand out any more blocks, and wait for the GCThreads to finish the
+    // blocks they are sweeping right now.
+    {
+        SpinLockHolder locker(&m_sweepLock);
+        m_sweepIndex = m_blocksToSweep.size();
+    }
+    endCurrentPhase();
+
+    // Blocks whose free lists the mutator never took have to go back to the Marked
+    // state, so that the collector and heap iteration see accurate liveness data.
+    for (size_t i = 0; i < m_blocksToSweep.size(); ++i) {
+        MarkedBlock* block = m_blocksToSweep[i];
+        if (block->concurrentSweepState() == MarkedBlock::Swept)
+            block->canonicalizeCellLivenessData(block->takeSweptFreeList());
+        block->setConcurrentSweepState(MarkedBlock::NotQueuedForSweep);
+    }
+    m_blocksToSweep.clear();
+}
+
+bool GCThreadSharedData::takeSweptFreeList(MarkedBlock* block, MarkedBlock::FreeList& freeList)
+{
+    while (true) {
+        {
+            SpinLockHolder locker(&m_sweepLock);
+            MarkedBlock::ConcurrentSweepState state = block->concurrentSweepState();
+            if (state != MarkedBlock::BeingSwept) {
+                // If no GCThread got to this block yet, the mutator sweeps it itself.
+                block->setConcurrentSweepState(MarkedBlock::NotQueuedForSweep);
+                if (state != MarkedBlock::Swept)
+                    return false;
+                freeList = block->takeSweptFreeList();
+                return true;
+            }
+        }
+        // A GCThread is sweeping this block right now, which won't take long.
+        yield();
+    }
+}
+
+MarkedBlock* GCThreadSharedData::getNextBlockToSweep()
+{
+    SpinLockHolder locker(&m_sweepLock);
+    while (m_sweepIndex < m_blocksToSweep.size()) {
+        MarkedBlock* block = m_blocksToSweep[m_sweepIndex++];
+        if (block->concurrentSweepState() != MarkedBlock::QueuedForSweep)
+            continue;
+        block->setConcurrentSweepState(MarkedBlock::BeingSwept);
+        return block;
+    }
+    return 0;
+}
+
+void GCThreadSharedData::sweepFromShared()
+{
+    while (MarkedBlock* block = getNextBlockToSweep()) {
+        block->sweepConcurrently();
+
+        SpinLockHolder locker(&m_sweepLock);
+        block->setConcurrentSweepState(MarkedBlock::Swept);
+    }
+}
+#endif
+
 } // namespace JSC
@@ -47,6 +47,7 @@ enum GCPhase {
     NoPhase,
     Mark,
     Copy,
+    ConcurrentSweep,
     Exit
 };
 
@@ -62,6 +63,15 @@ public:
     void didStartCopying();
     void didFinishCopying();
 
+#if ENABLE(PARALLEL_GC)
+    // Unlike the other phases, sweeping keeps running after the collection has
+    // returned to the mutator, until didFinishSweeping() is called.
+    void didStartSweeping(Vector<MarkedBlock*>&);
+    void didFinishSweeping();
+    bool isSweeping() const { return m_currentPhase == ConcurrentSweep; }
+    bool takeSweptFreeList(MarkedBlock*, MarkedBlock::FreeList&);
+#endif
+
 #if ENABLE(PARALLEL_GC)
     void resetChildren();
     size_t childVisitCount();
@@ -73,7 +83,11 @@ private:
     friend class SlotVisitor;
     friend class CopyVisitor;
 
-    void getNextBlocksToCopy(size_t&, size_t&);
+    bool stealCopyWork(CopyVisitor&);
+#if ENABLE(PARALLEL_GC)
+    MarkedBlock* getNextBlockToSweep();
+    void sweepFromShared();
+#endif
     void startNextPhase(GCPhase);
     void endCurrentPhase();
 
@@ -93,10 +107,14 @@ private:
     Mutex m_opaqueRootsLock;
     HashSet<void*> m_opaqueRoots;
 
-    SpinLock m_copyLock;
-    Vector<CopiedBlock*> m_blocksToCopy;
-    size_t m_copyIndex;
-    static const size_t s_blockFragmentLength = 32;
+    // The main thread's visitor first, followed by the GC threads' visitors.
+    Vector<CopyVisitor*> m_copyVisitors;
+
+#if ENABLE(PARALLEL_GC)
+    SpinLock m_sweepLock;
+    Vector<MarkedBlock*> m_blocksToSweep;
+    size_t m_sweepIndex;
+#endif
 
     Mutex m_phaseLock;
     ThreadCondition m_phaseCondition;
@@ -109,14 +127,6 @@ private:
     ListableHandler<UnconditionalFinalizer>::List m_unconditionalFinalizers;
 };
 
-inline void GCThreadSharedData::getNextBlocksToCopy(size_t& start, size_t& end)
-{
-    SpinLockHolder locker(&m_copyLock);
-    start = m_copyIndex;
-    end = std::min(m_blocksToCopy.size(), m_copyIndex + s_blockFragmentLength);
-    m_copyIndex = end;
-}
-
 } // namespace JSC
 
 #endif
@@ -35,7 +35,9 @@
 #include "JSGlobalObject.h"
 #include "JSLock.h"
 #include "JSONObject.h"
+#include "ObjectAllocationProfile.h"
 #include "Operations.h"
+#include "SamplingProfiler.h"
 #include "Tracing.h"
 #include "UnlinkedCodeBlock.h"
 #include "WeakSetInlines.h"
@@ -246,6 +248,8 @@ Heap::Heap(VM* vm, HeapType heapType)
     , m_ramSize(ramSize())
     , m_minBytesPerCycle(minHeapSize(m_heapType, m_ramSize))
     , m_sizeAfterLastCollect(0)
+    , m_sizeAfterLastFullCollect(0)
+    , m_isEdenCollection(false)
     , m_bytesAllocatedLimit(m_minBytesPerCycle)
     , m_bytesAllocated(0)
     , m_bytesAbandoned(0)
@@ -257,6 +261,7 @@ Heap::Heap(VM* vm, HeapType heapType)
     , m_sharedData(vm)
     , m_slotVisitor(m_sharedData)
     , m_copyVisitor(m_sharedData)
+    , m_heapSnapshotBuilder(0)
     , m_handleSet(vm)
     , m_isSafeToCollect(false)
     , m_vm(vm)
@@ -374,6 +379,17 @@ void Heap::popTempSortVector(Vector<ValueStringPair, 0, UnsafeVectorOverflow>* t
     m_tempSortingVectors.removeLast();
 }
 
+void Heap::pushTempSortVector(Vector<JSValue, 0, UnsafeVectorOverflow>* tempVector)
+{
+    m_tempValueSortingVectors.append(tempVector);
+}
+
+void Heap::popTempSortVector(Vector<JSValue, 0, UnsafeVectorOverflow>* tempVector)
+{
+    ASSERT_UNUSED(tempVector, tempVector == m_tempValueSortingVectors.last());
+    m_tempValueSortingVectors.removeLast();
+}
+
 void Heap::markTempSortVectors(HeapRootVisitor& heapRootVisitor)
 {
     typedef Vector<Vector<ValueStringPair, 0, UnsafeVectorOverflow>* > VectorOfValueStringVectors;
@@ -388,6 +404,14 @@ void Heap::markTempSortVectors(HeapRootVisitor& heapRootVisitor)
                 heapRootVisitor.visit(&vectorIt->first);
         }
     }
+
+    for (size_t i = 0; i < m_tempValueSortingVectors.size(); ++i) {
+        Vector<JSValue, 0, UnsafeVectorOverflow>& values = *m_tempValueSortingVectors[i];
+        for (size_t j = 0; j < values.size(); ++j) {
+            if (values[j])
+                heapRootVisitor.visit(&values[j]);
+        }
+    }
 }
 
 void Heap::harvestWeakReferences()
@@ -400,6 +424,15 @@ void Heap::finalizeUnconditionalFinalizers()
     m_slotVisitor.finalizeUnconditionalFinalizers();
 }
 
+void Heap::updateAllocationProfiles()
+{
+    // This must run before the sweep, while the mark bits still tell whether a
+    // sampled object survived, and while the profiles' owners are still around.
+    for (size_t i = 0; i < m_allocationSamples.size(); ++i)
+        m_allocationSamples[i]->didCollect(*this);
+    m_allocationSamples.clear();
+}
+
 inline JSStack& Heap::stack()
 {
     return m_vm->interpreter->stack();
@@ -461,6 +494,15 @@ void Heap::markRoots()
     }
 #endif
 
+#if ENABLE(GGC)
+    MarkedBlock::DirtyCellVector dirtyCells;
+    if (m_isEdenCollection) {
+        // Gather dirty cells while the mark bits still tell old cells apart.
+        GCPHASE(GatherDirtyCells);
+        m_objectSpace.gatherDirtyCells(dirtyCells);
+        m_objectSpace.clearMarksForEdenCollection();
+    } else
+#endif
     {
         GCPHASE(clearMarks);
         m_objectSpace.clearMarks();
@@ -474,6 +516,17 @@ void Heap::markRoots()
     {
         ParallelModeEnabler enabler(visitor);
 
+#if ENABLE(GGC)
+        if (size_t dirtyCellCount = dirtyCells.size()) {
+            GCPHASE(VisitDirtyCells);
+            GCCOUNTER(DirtyCellCount, dirtyCellCount);
+            MARK_LOG_ROOT(visitor, "Dirty Cells");
+            for (size_t i = 0; i < dirtyCellCount; ++i)
+                heapRootVisitor.visitDirtyCell(dirtyCells[i]);
+            visitor.donateAndDrain();
+        }
+#endif
+
         if (m_vm->codeBlocksBeingCompiled.size()) {
             GCPHASE(VisitActiveCodeBlock);
             for (size_t i = 0; i < m_vm->codeBlocksBeingCompiled.size(); i++)
@@ -600,6 +653,15 @@ void Heap::markRoots()
 
 void Heap::copyBackingStores()
 {
+#if ENABLE(GGC)
+    // Old objects do not report their backing stores during an eden collection,
+    // so we cannot tell which copied blocks are still in use.
+    if (m_isEdenCollection) {
+        m_storageSpace.didSkipCopying();
+        return;
+    }
+#endif
+
     m_storageSpace.startedCopying();
     if (m_storageSpace.shouldDoCopyPhase()) {
         m_sharedData.didStartCopying();
@@ -661,6 +723,11 @@ void Heap::deleteAllCompiledCode()
     if (m_vm->dynamicGlobalObject)
         return;
 
+#if ENABLE(SAMPLING_PROFILER)
+    if (SamplingProfiler* samplingProfiler = m_vm->samplingProfiler())
+        samplingProfiler->processRawSamples();
+#endif
+
     for (ExecutableBase* current = m_compiledCode.head(); current; current = current->next()) {
         if (!current->isFunctionExecutable())
             continue;
@@ -699,6 +766,23 @@ void Heap::collectAllGarbage()
 
 static double minute = 60.0;
 
+#if ENABLE(GGC)
+bool Heap::shouldDoFullCollection(SweepToggle sweepToggle)
+{
+    // Callers that ask for a sweep want as much memory back as possible.
+    if (sweepToggle == DoSweep || !Options::useGenerationalGC())
+        return true;
+
+    if (!m_sizeAfterLastFullCollect)
+        return true;
+
+    // Mark bits are sticky between full collections, so dead old objects and
+    // the copied space are only reclaimed by a full collection. Do one once the
+    // heap has grown enough since the last one.
+    return m_sizeAfterLastCollect > m_sizeAfterLastFullCollect * Options::oldGenerationGrowthFactorForFullCollection();
+}
+#endif
+
 void Heap::collect(SweepToggle sweepToggle)
 {
     SamplingRegion samplingRegion("Garbage Collection");
@@ -713,6 +797,12 @@ void Heap::collect(SweepToggle sweepToggle)
 
     m_activityCallback->willCollect();
 
+#if ENABLE(SAMPLING_PROFILER)
+    // Raw samples point at code blocks that this collection may destroy.
+    if (SamplingProfiler* samplingProfiler = m_vm->samplingProfiler())
+        samplingProfiler->processRawSamples();
+#endif
+
     double lastGCStartTime = WTF::currentTime();
     if (lastGCStartTime - m_lastCodeDiscardTime > minute) {
         deleteAllCompiledCode();
@@ -724,6 +814,10 @@ void Heap::collect(SweepToggle sweepToggle)
         m_objectSpace.canonicalizeCellLivenessData();
     }
 
+#if ENABLE(GGC)
+    m_isEdenCollection = !shouldDoFullCollection(sweepToggle);
+#endif
+
     markRoots();
     
     {
@@ -746,11 +840,21 @@ void Heap::collect(SweepToggle sweepToggle)
         finalizeUnconditionalFinalizers();
     }
 
+    {
+        GCPHASE(UpdateAllocationProfiles);
+        updateAllocationProfiles();
+    }
+
     {
         GCPHASE(finalizeSmallStrings);
         m_vm->smallStrings.finalizeSmallStrings();
     }
 
+    {
+        GCPHASE(ClearMegamorphicCache);
+        m_vm->megamorphicCache.clear();
+    }
+
     {
         GCPHASE(DeleteCodeBlocks);
         deleteUnmarkedCompiledCode();
@@ -781,6 +885,9 @@ void Heap::collect(SweepToggle sweepToggle)
         HeapStatistics::exitWithFailure();
 
     m_sizeAfterLastCollect = currentHeapSize;
+    if (!m_isEdenCollection)
+        m_sizeAfterLastFullCollect = currentHeapSize;
+    m_isEdenCollection = false;
 
     // To avoid pathological GC churn in very small and very large heaps, we set
     // the new allocation limit based on the current size of the heap, with a
@@ -807,6 +914,13 @@ void Heap::collect(SweepToggle sweepToggle)
 
     if (Options::showObjectStatistics())
         HeapStatistics::showObjectStatistics(this);
+
+#if ENABLE(PARALLEL_GC)
+    // Let the GCThreads build free lists for blocks without destructors, so that
+    // the mutator's slow path only has to pick them up.
+    if (Options::enableConcurrentSweeping() && Options::numberOfGCMarkers() > 1)
+        m_objectSpace.startConcurrentSweeping();
+#endif
 }
 
 void Heap::markDeadObjects()
@@ -52,6 +52,7 @@ namespace JSC {
     class GlobalCodeBlock;
     class Heap;
     class HeapRootVisitor;
+    class HeapSnapshotBuilder;
     class IncrementalSweeper;
     class JITStubRoutine;
     class JSCell;
@@ -61,6 +62,7 @@ namespace JSC {
     class LiveObjectIterator;
     class LLIntOffsetsExtractor;
     class MarkedArgumentBuffer;
+    class ObjectAllocationProfile;
     class WeakGCHandlePool;
     class SlotVisitor;
 
@@ -114,6 +116,7 @@ namespace JSC {
         inline bool isBusy();
         
         MarkedAllocator& allocatorForObjectWithoutDestructor(size_t bytes) { return m_objectSpace.allocatorFor(bytes); }
+        MarkedAllocator& allocatorForPretenuredObjectWithoutDestructor(size_t bytes) { return m_objectSpace.pretenuredAllocatorFor(bytes); }
         MarkedAllocator& allocatorForObjectWithNormalDestructor(size_t bytes) { return m_objectSpace.normalDestructorAllocatorFor(bytes); }
         MarkedAllocator& allocatorForObjectWithImmortalStructureDestructor(size_t bytes) { return m_objectSpace.immortalStructureDestructorAllocatorFor(bytes); }
         CopiedAllocator& storageAllocator() { return m_storageSpace.allocator(); }
@@ -124,6 +127,11 @@ namespace JSC {
         JS_EXPORT_PRIVATE void addFinalizer(JSCell*, Finalizer);
         void addCompiledCode(ExecutableBase*);
 
+        // Profiles registered here have an object sampled from their slow path
+        // allocation, and learn whether it survived at the end of the next
+        // mark phase.
+        void addAllocationSample(ObjectAllocationProfile* profile) { m_allocationSamples.append(profile); }
+
         void notifyIsSafeToCollect() { m_isSafeToCollect = true; }
         bool isSafeToCollect() const { return m_isSafeToCollect; }
 
@@ -132,6 +140,11 @@ namespace JSC {
         bool shouldCollect();
         void collect(SweepToggle);
 
+        // True while an eden collection is in progress. Eden collections only
+        // trace objects allocated since the last collection, plus old objects
+        // whose cards were dirtied by a write barrier.
+        bool isEdenCollection() const { return m_isEdenCollection; }
+
         void reportExtraMemoryCost(size_t cost);
         JS_EXPORT_PRIVATE void reportAbandonedObjectGraph();
 
@@ -152,6 +165,8 @@ namespace JSC {
 
         void pushTempSortVector(Vector<ValueStringPair, 0, UnsafeVectorOverflow>*);
         void popTempSortVector(Vector<ValueStringPair, 0, UnsafeVectorOverflow>*);
+        void pushTempSortVector(Vector<JSValue, 0, UnsafeVectorOverflow>*);
+        void popTempSortVector(Vector<JSValue, 0, UnsafeVectorOverflow>*);
     
         HashSet<MarkedArgumentBuffer*>& markListSet() { if (!m_markListSet) m_markListSet = adoptPtr(new HashSet<MarkedArgumentBuffer*>); return *m_markListSet; }
         
@@ -191,6 +206,8 @@ namespace JSC {
         friend class SlotVisitor;
         friend class SuperRegion;
         friend class IncrementalSweeper;
+        friend class HeapSnapshotBuilder;
+        friend class SamplingProfiler;
         friend class HeapStatistics;
         friend class WeakSet;
         template<typename T> friend void* allocateCell(Heap&);
@@ -211,11 +228,15 @@ namespace JSC {
         JS_EXPORT_PRIVATE void reportExtraMemoryCostSlowCase(size_t);
 
         void markRoots();
+#if ENABLE(GGC)
+        bool shouldDoFullCollection(SweepToggle);
+#endif
         void markProtectedObjects(HeapRootVisitor&);
         void markTempSortVectors(HeapRootVisitor&);
         void copyBackingStores();
         void harvestWeakReferences();
         void finalizeUnconditionalFinalizers();
+        void updateAllocationProfiles();
         void deleteUnmarkedCompiledCode();
         void zombifyDeadObjects();
         void markDeadObjects();
@@ -227,6 +248,8 @@ namespace JSC {
         const size_t m_ramSize;
         const size_t m_minBytesPerCycle;
         size_t m_sizeAfterLastCollect;
+        size_t m_sizeAfterLastFullCollect;
+        bool m_isEdenCollection;
 
         size_t m_bytesAllocatedLimit;
         size_t m_bytesAllocated;
@@ -243,6 +266,7 @@ namespace JSC {
 
         ProtectCountSet m_protectedValues;
         Vector<Vector<ValueStringPair, 0, UnsafeVectorOverflow>* > m_tempSortingVectors;
+        Vector<Vector<JSValue, 0, UnsafeVectorOverflow>* > m_tempValueSortingVectors;
         OwnPtr<HashSet<MarkedArgumentBuffer*> > m_markListSet;
 
         MachineThreads m_machineThreads;
@@ -250,6 +274,7 @@ namespace JSC {
         GCThreadSharedData m_sharedData;
         SlotVisitor m_slotVisitor;
         CopyVisitor m_copyVisitor;
+        HeapSnapshotBuilder* m_heapSnapshotBuilder;
 
         HandleSet m_handleSet;
         HandleStack m_handleStack;
@@ -264,6 +289,7 @@ namespace JSC {
         double m_lastCodeDiscardTime;
 
         DoublyLinkedList<ExecutableBase> m_compiledCode;
+        Vector<ObjectAllocationProfile*> m_allocationSamples;
         
         OwnPtr<GCActivityCallback> m_activityCallback;
         OwnPtr<IncrementalSweeper> m_sweeper;
@@ -329,13 +355,42 @@ namespace JSC {
 
     inline bool Heap::isWriteBarrierEnabled()
     {
-#if ENABLE(WRITE_BARRIER_PROFILING)
+#if ENABLE(WRITE_BARRIER_PROFILING) || ENABLE(GGC)
         return true;
 #else
         return false;
 #endif
     }
 
+#if ENABLE(GGC)
+    inline uint8_t* Heap::addressOfCardFor(JSCell* cell)
+    {
+        return MarkedBlock::blockFor(cell)->addressOfCardFor(cell);
+    }
+
+    inline void Heap::writeBarrier(const JSCell* owner, JSCell* cell)
+    {
+        WriteBarrierCounters::countWriteBarrier();
+        if (!cell)
+            return;
+
+        // Mark bits are sticky between full collections, so a marked owner is
+        // old. Only a store of a young cell into an old owner creates a pointer
+        // that an eden collection would otherwise miss.
+        MarkedBlock* block = MarkedBlock::blockFor(owner);
+        if (block->isMarked(owner) && !isMarked(cell))
+            block->setDirtyObject(owner);
+    }
+
+    inline void Heap::writeBarrier(const JSCell* owner, JSValue value)
+    {
+        if (!value.isCell()) {
+            WriteBarrierCounters::countWriteBarrier();
+            return;
+        }
+        writeBarrier(owner, value.asCell());
+    }
+#else
     inline void Heap::writeBarrier(const JSCell*, JSCell*)
     {
         WriteBarrierCounters::countWriteBarrier();
@@ -345,6 +400,7 @@ namespace JSC {
     {
         WriteBarrierCounters::countWriteBarrier();
     }
+#endif
 
     inline void Heap::reportExtraMemoryCost(size_t cost)
     {
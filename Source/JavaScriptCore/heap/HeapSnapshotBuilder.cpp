@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "HeapSnapshotBuilder.h"
+
+#include "Butterfly.h"
+#include "Heap.h"
+#include "IndexingHeaderInlines.h"
+#include "JSObject.h"
+#include "Operations.h"
+#include <wtf/FilePrintStream.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace JSC {
+
+static const unsigned undefinedNodeIndex = UINT_MAX;
+
+// The cell itself, plus the out-of-line property and indexed storage that it
+// owns in the copied space.
+static size_t sizeOfCell(const JSCell* cell)
+{
+    size_t size = MarkedBlock::blockFor(cell)->cellSize();
+    if (!cell->isObject())
+        return size;
+
+    const JSObject* object = asObject(cell);
+    Butterfly* butterfly = const_cast<Butterfly*>(object->butterfly());
+    if (!butterfly)
+        return size;
+
+    Structure* structure = object->structure();
+    if (!hasIndexingHeader(structure->indexingType()))
+        return size + Butterfly::totalSize(0, structure->outOfLineCapacity(), false, 0);
+
+    IndexingHeader* header = butterfly->indexingHeader();
+    return size + Butterfly::totalSize(header->preCapacity(structure), structure->outOfLineCapacity(), true, header->indexingPayloadSizeInBytes(structure));
+}
+
+HeapSnapshotBuilder::HeapSnapshotBuilder(Heap& heap)
+    : m_heap(heap)
+{
+}
+
+HeapSnapshotBuilder::~HeapSnapshotBuilder()
+{
+    ASSERT(m_heap.m_heapSnapshotBuilder != this);
+}
+
+void HeapSnapshotBuilder::buildSnapshot()
+{
+    RELEASE_ASSERT(!m_heap.m_heapSnapshotBuilder);
+    RELEASE_ASSERT(!m_heap.isBusy());
+
+    m_nodes.clear();
+    m_edges.clear();
+    m_nodes.append(Node(0, "<root>", 0));
+
+    m_heap.m_heapSnapshotBuilder = this;
+    m_heap.collectAllGarbage();
+    m_heap.m_heapSnapshotBuilder = 0;
+
+    resolveEdges();
+    computeDominators();
+}
+
+void HeapSnapshotBuilder::appendNode(const JSCell* cell)
+{
+    Node node(cell, cell->classInfo()->className, sizeOfCell(cell));
+    MutexLocker locker(m_lock);
+    m_nodes.append(node);
+}
+
+void HeapSnapshotBuilder::appendEdge(const JSCell* from, const JSCell* to)
+{
+    MutexLocker locker(m_lock);
+    m_cellEdges.append(std::make_pair(from, to));
+}
+
+void HeapSnapshotBuilder::resolveEdges()
+{
+    HashMap<const JSCell*, unsigned> nodeIndices;
+    for (unsigned i = rootNodeIndex + 1; i < m_nodes.size(); ++i)
+        nodeIndices.add(m_nodes[i].cell, i);
+
+    m_edges.reserveCapacity(m_cellEdges.size());
+    for (size_t i = 0; i < m_cellEdges.size(); ++i) {
+        // Cells without a structure are marked, but never visited, so they
+        // have no node.
+        HashMap<const JSCell*, unsigned>::iterator to = nodeIndices.find(m_cellEdges[i].second);
+        if (to == nodeIndices.end())
+            continue;
+
+        unsigned from = rootNodeIndex;
+        if (m_cellEdges[i].first) {
+            HashMap<const JSCell*, unsigned>::iterator iter = nodeIndices.find(m_cellEdges[i].first);
+            ASSERT(iter != nodeIndices.end());
+            from = iter->value;
+        }
+        m_edges.append(Edge(from, to->value));
+    }
+    m_cellEdges.clear();
+}
+
+static unsigned intersect(unsigned a, unsigned b, const Vector<unsigned>& dominators, const Vector<unsigned>& postorderNumbers)
+{
+    while (a != b) {
+        while (postorderNumbers[a] < postorderNumbers[b])
+            a = dominators[a];
+        while (postorderNumbers[b] < postorderNumbers[a])
+            b = dominators[b];
+    }
+    return a;
+}
+
+// This is the iterative algorithm from Cooper, Harvey and Kennedy, "A Simple,
+// Fast Dominance Algorithm". It converges in a couple of passes over object
+// graphs, which are mostly trees.
+void HeapSnapshotBuilder::computeDominators()
+{
+    unsigned nodeCount = m_nodes.size();
+
+    // Successors and predecessors of node i are at [start[i], start[i + 1]).
+    Vector<unsigned> successorStarts(nodeCount + 1, 0);
+    Vector<unsigned> predecessorStarts(nodeCount + 1, 0);
+    for (size_t i = 0; i < m_edges.size(); ++i) {
+        successorStarts[m_edges[i].first + 1]++;
+        predecessorStarts[m_edges[i].second + 1]++;
+    }
+    for (unsigned i = 0; i < nodeCount; ++i) {
+        successorStarts[i + 1] += successorStarts[i];
+        predecessorStarts[i + 1] += predecessorStarts[i];
+    }
+    Vector<unsigned> successors(m_edges.size());
+    Vector<unsigned> predecessors(m_edges.size());
+    {
+        Vector<unsigned> successorEnds(successorStarts);
+        Vector<unsigned> predecessorEnds(predecessorStarts);
+        for (size_t i = 0; i < m_edges.size(); ++i) {
+            successors[successorEnds[m_edges[i].first]++] = m_edges[i].second;
+            predecessors[predecessorEnds[m_edges[i].second]++] = m_edges[i].first;
+        }
+    }
+
+    // Number the nodes in postorder with an explicit stack, since object
+    // graphs can be far deeper than the native stack.
+    Vector<unsigned> postorder;
+    Vector<unsigned> postorderNumbers(nodeCount, undefinedNodeIndex);
+    {
+        Vector<bool> visited(nodeCount, false);
+        Vector<std::pair<unsigned, unsigned> > stack;
+        visited[rootNodeIndex] = true;
+        stack.append(std::make_pair(rootNodeIndex, successorStarts[rootNodeIndex]));
+        while (!stack.isEmpty()) {
+            unsigned node = stack.last().first;
+            unsigned next = stack.last().second;
+            if (next < successorStarts[node + 1]) {
+                stack.last().second++;
+                unsigned successor = successors[next];
+                if (!visited[successor]) {
+                    visited[successor] = true;
+                    stack.append(std::make_pair(successor, successorStarts[successor]));
+                }
+                continue;
+            }
+            postorderNumbers[node] = postorder.size();
+            postorder.append(node);
+            stack.removeLast();
+        }
+    }
+    ASSERT(postorder.last() == rootNodeIndex);
+
+    Vector<unsigned> dominators(nodeCount, undefinedNodeIndex);
+    dominators[rootNodeIndex] = rootNodeIndex;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        // Walk in reverse postorder, skipping the root.
+        for (size_t i = postorder.size() - 1; i--;) {
+            unsigned node = postorder[i];
+            unsigned newDominator = undefinedNodeIndex;
+            for (unsigned j = predecessorStarts[node]; j < predecessorStarts[node + 1]; ++j) {
+                unsigned predecessor = predecessors[j];
+                if (dominators[predecessor] == undefinedNodeIndex)
+                    continue;
+                if (newDominator == undefinedNodeIndex)
+                    newDominator = predecessor;
+                else
+                    newDominator = intersect(predecessor, newDominator, dominators, postorderNumbers);
+            }
+            if (dominators[node] != newDominator) {
+                dominators[node] = newDominator;
+                changed = true;
+            }
+        }
+    }
+
+    // A node's dominator comes after it in postorder, so one pass in postorder
+    // accumulates every dominator subtree.
+    for (size_t i = 0; i + 1 < postorder.size(); ++i) {
+        Node& node = m_nodes[postorder[i]];
+        node.dominator = dominators[postorder[i]];
+        m_nodes[node.dominator].retainedSize += node.retainedSize;
+    }
+
+    // Nodes that the root cannot reach (which tracing should not produce) are
+    // attributed to the root directly.
+    for (unsigned i = 0; i < nodeCount; ++i) {
+        if (postorderNumbers[i] != undefinedNodeIndex)
+            continue;
+        m_nodes[i].dominator = rootNodeIndex;
+        m_nodes[rootNodeIndex].retainedSize += m_nodes[i].retainedSize;
+    }
+}
+
+// Node i is written as the five integers nodes[5 * i] to nodes[5 * i + 4],
+// which are its index, an index into classNames, its size, its retained size
+// and the index of its immediate dominator. Edges are written as pairs of
+// node indices.
+String HeapSnapshotBuilder::json() const
+{
+    typedef HashMap<const char*, unsigned, PtrHash<const char*> > ClassNameMap;
+    ClassNameMap classNameIndices;
+    Vector<const char*> classNames;
+
+    StringBuilder nodes;
+    for (unsigned i = 0; i < m_nodes.size(); ++i) {
+        const Node& node = m_nodes[i];
+        ClassNameMap::AddResult result = classNameIndices.add(node.className, classNames.size());
+        if (result.isNewEntry)
+            classNames.append(node.className);
+        if (i)
+            nodes.append(',');
+        nodes.appendNumber(i);
+        nodes.append(',');
+        nodes.appendNumber(result.iterator->value);
+        nodes.append(',');
+        nodes.appendNumber(static_cast<unsigned long long>(node.size));
+        nodes.append(',');
+        nodes.appendNumber(static_cast<unsigned long long>(node.retainedSize));
+        nodes.append(',');
+        nodes.appendNumber(node.dominator);
+    }
+
+    StringBuilder builder;
+    builder.appendLiteral("{\"version\":1,\"nodeFields\":[\"id\",\"className\",\"size\",\"retainedSize\",\"dominator\"],\"classNames\":[");
+    for (size_t i = 0; i < classNames.size(); ++i) {
+        if (i)
+            builder.append(',');
+        builder.append('"');
+        builder.append(classNames[i]);
+        builder.append('"');
+    }
+    builder.appendLiteral("],\"nodes\":[");
+    builder.append(nodes);
+    builder.appendLiteral("],\"edgeFields\":[\"from\",\"to\"],\"edges\":[");
+    for (size_t i = 0; i < m_edges.size(); ++i) {
+        if (i)
+            builder.append(',');
+        builder.appendNumber(m_edges[i].first);
+        builder.append(',');
+        builder.appendNumber(m_edges[i].second);
+    }
+    builder.appendLiteral("]}");
+    return builder.toString();
+}
+
+bool HeapSnapshotBuilder::writeJSON(const char* filename) const
+{
+    OwnPtr<FilePrintStream> out = FilePrintStream::open(filename, "w");
+    if (!out)
+        return false;
+
+    out->print(json());
+    return true;
+}
+
+} // namespace JSC
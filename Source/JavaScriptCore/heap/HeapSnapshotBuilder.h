@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HeapSnapshotBuilder_h
+#define HeapSnapshotBuilder_h
+
+#include "JSExportMacros.h"
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class Heap;
+class JSCell;
+
+// Records the object graph seen by a full collection. Every cell that is
+// visited becomes a node, and every cell appended while visiting it becomes
+// one of its edges. Cells appended while visiting roots hang off a synthetic
+// root node. Once the graph is recorded, we compute its dominator tree, which
+// gives each node a retained size: the number of bytes that would become
+// garbage if that node were no longer referenced.
+class HeapSnapshotBuilder {
+    WTF_MAKE_NONCOPYABLE(HeapSnapshotBuilder);
+public:
+    static const unsigned rootNodeIndex = 0;
+
+    struct Node {
+        Node() { }
+        Node(const JSCell* cell, const char* className, size_t size)
+            : cell(cell)
+            , className(className)
+            , size(size)
+            , retainedSize(size)
+            , dominator(rootNodeIndex)
+        {
+        }
+
+        const JSCell* cell;
+        const char* className;
+        size_t size;
+        size_t retainedSize;
+        unsigned dominator;
+    };
+
+    JS_EXPORT_PRIVATE HeapSnapshotBuilder(Heap&);
+    JS_EXPORT_PRIVATE ~HeapSnapshotBuilder();
+
+    // Performs a full collection and records the graph it traces. Must be
+    // called with the API lock held and outside of any collection.
+    JS_EXPORT_PRIVATE void buildSnapshot();
+
+    // Node 0 is the synthetic root. Its size is 0 and its retained size is
+    // the size of everything reachable.
+    const Vector<Node>& nodes() const { return m_nodes; }
+    size_t edgeCount() const { return m_edges.size(); }
+
+    // Compact JSON: parallel arrays of integers, plus a table of class names.
+    JS_EXPORT_PRIVATE String json() const;
+    JS_EXPORT_PRIVATE bool writeJSON(const char* filename) const;
+
+    // Called by SlotVisitor while building the snapshot, possibly from several
+    // marking threads at once.
+    void appendNode(const JSCell*);
+    void appendEdge(const JSCell* from, const JSCell* to);
+
+private:
+    typedef std::pair<unsigned, unsigned> Edge;
+
+    void resolveEdges();
+    void computeDominators();
+
+    Heap& m_heap;
+    Mutex m_lock;
+    Vector<Node> m_nodes;
+    Vector<std::pair<const JSCell*, const JSCell*> > m_cellEdges;
+    Vector<Edge> m_edges;
+};
+
+} // namespace JSC
+
+#endif // HeapSnapshotBuilder_h
@@ -48,6 +48,9 @@ MarkedBlock::MarkedBlock(Region* region, MarkedAllocator* allocator, size_t cell
     , m_allocator(allocator)
     , m_state(New) // All cells start out unmarked.
     , m_weakSet(allocator->heap()->vm())
+#if ENABLE(PARALLEL_GC)
+    , m_concurrentSweepState(NotQueuedForSweep)
+#endif
 {
     ASSERT(allocator);
     HEAP_LOG_BLOCK_STATE_TRANSITION(this);
@@ -108,6 +111,17 @@ MarkedBlock::FreeList MarkedBlock::sweep(SweepMode sweepMode)
 {
     HEAP_LOG_BLOCK_STATE_TRANSITION(this);
 
+#if ENABLE(PARALLEL_GC)
+    if (m_concurrentSweepState != NotQueuedForSweep) {
+        ASSERT(sweepMode == SweepToFreeList);
+        FreeList freeList;
+        if (heap()->m_sharedData.takeSweptFreeList(this, freeList)) {
+            m_weakSet.sweep();
+            return freeList;
+        }
+    }
+#endif
+
     m_weakSet.sweep();
 
     if (sweepMode == SweepOnly && m_destructorType == MarkedBlock::None)
@@ -120,6 +134,20 @@ MarkedBlock::FreeList MarkedBlock::sweep(SweepMode sweepMode)
     return sweepHelper<MarkedBlock::None>(sweepMode);
 }
 
+#if ENABLE(PARALLEL_GC)
+void MarkedBlock::sweepConcurrently()
+{
+    ASSERT(m_concurrentSweepState == BeingSwept);
+    ASSERT(m_destructorType == None);
+    ASSERT(m_state == Marked);
+
+    // Unlike sweep(), this leaves the weak set alone, since only the mutator may
+    // run weak handle finalizers. The weak set was empty when the block was queued,
+    // and the mutator sweeps it when it takes the free list.
+    m_sweptFreeList = specializedSweep<Marked, SweepToFreeList, MarkedBlock::None>();
+}
+#endif
+
 template<MarkedBlock::DestructorType dtorType>
 MarkedBlock::FreeList MarkedBlock::sweepHelper(SweepMode sweepMode)
 {
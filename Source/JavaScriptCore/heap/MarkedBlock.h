@@ -23,6 +23,7 @@
 #define MarkedBlock_h
 
 #include "BlockAllocator.h"
+#include "CardSet.h"
 #include "HeapBlock.h"
 
 #include "WeakSet.h"
@@ -52,6 +53,7 @@ namespace JSC {
     
     class Heap;
     class JSCell;
+    class LLIntOffsetsExtractor;
     class MarkedAllocator;
 
     typedef uintptr_t Bits;
@@ -69,6 +71,8 @@ namespace JSC {
     // size.
 
     class MarkedBlock : public HeapBlock<MarkedBlock> {
+        friend class LLIntOffsetsExtractor;
+
     public:
         static const size_t atomSize = 8; // bytes
         static const size_t blockSize = 64 * KB;
@@ -77,6 +81,14 @@ namespace JSC {
         static const size_t atomsPerBlock = blockSize / atomSize;
         static const size_t atomMask = atomsPerBlock - 1;
 
+#if ENABLE(GGC)
+        static const size_t bytesPerCard = 512;
+        static const size_t cardCount = blockSize / bytesPerCard;
+        static const size_t cardShift = 9;
+        static const size_t cardMask = cardCount - 1;
+        static const size_t atomsPerCard = bytesPerCard / atomSize;
+#endif
+
         struct FreeCell {
             FreeCell* next;
         };
@@ -135,6 +147,19 @@ namespace JSC {
         void canonicalizeCellLivenessData(const FreeList&);
 
         void clearMarks();
+#if ENABLE(GGC)
+        // Unlike clearMarks(), this keeps the mark bits of cells that survived
+        // earlier collections. Those cells are old, and an eden collection only
+        // revisits them if their card was dirtied by a write barrier.
+        void clearMarksForEdenCollection();
+
+        void setDirtyObject(const void*);
+        uint8_t* addressOfCardFor(const void*);
+        static ptrdiff_t offsetOfCards() { return OBJECT_OFFSETOF(MarkedBlock, m_cards); }
+
+        typedef Vector<JSCell*, 32> DirtyCellVector;
+        void gatherDirtyCells(DirtyCellVector&);
+#endif
         size_t markCount();
         bool isEmpty();
 
@@ -157,6 +182,18 @@ namespace JSC {
 
         bool needsSweeping();
 
+#if ENABLE(PARALLEL_GC)
+        // Blocks without destructors or weak handles can be swept into a free list
+        // by a GC thread while the mutator runs. The sweep state is guarded by
+        // GCThreadSharedData::m_sweepLock.
+        enum ConcurrentSweepState { NotQueuedForSweep, QueuedForSweep, BeingSwept, Swept };
+        bool canSweepConcurrently();
+        ConcurrentSweepState concurrentSweepState() const { return m_concurrentSweepState; }
+        void setConcurrentSweepState(ConcurrentSweepState state) { m_concurrentSweepState = state; }
+        void sweepConcurrently();
+        FreeList takeSweptFreeList();
+#endif
+
         template <typename Functor> void forEachCell(Functor&);
         template <typename Functor> void forEachLiveCell(Functor&);
         template <typename Functor> void forEachDeadCell(Functor&);
@@ -175,6 +212,10 @@ namespace JSC {
         void callDestructor(JSCell*);
         template<BlockState, SweepMode, DestructorType> FreeList specializedSweep();
         
+#if ENABLE(GGC)
+        CardSet<bytesPerCard, blockSize> m_cards;
+#endif
+
         size_t m_atomsPerCell;
         size_t m_endAtom; // This is a fuzzy end. Always test for < m_endAtom.
 #if ENABLE(PARALLEL_GC)
@@ -188,6 +229,10 @@ namespace JSC {
         MarkedAllocator* m_allocator;
         BlockState m_state;
         WeakSet m_weakSet;
+#if ENABLE(PARALLEL_GC)
+        ConcurrentSweepState m_concurrentSweepState;
+        FreeList m_sweptFreeList;
+#endif
     };
 
     inline MarkedBlock::FreeList::FreeList()
@@ -280,12 +325,69 @@ namespace JSC {
         ASSERT(m_state != New && m_state != FreeListed);
         m_marks.clearAll();
         m_newlyAllocated.clear();
+#if ENABLE(GGC)
+        // A full collection traces everything, so no card needs to be revisited.
+        m_cards.clearAll();
+#endif
 
         // This will become true at the end of the mark phase. We set it now to
         // avoid an extra pass to do so later.
         m_state = Marked;
     }
 
+#if ENABLE(GGC)
+    inline void MarkedBlock::clearMarksForEdenCollection()
+    {
+        HEAP_LOG_BLOCK_STATE_TRANSITION(this);
+
+        ASSERT(m_state != New && m_state != FreeListed);
+        // Cells allocated since the last collection are young: they are live
+        // only if this collection marks them.
+        m_newlyAllocated.clear();
+        m_state = Marked;
+    }
+
+    inline void MarkedBlock::setDirtyObject(const void* atom)
+    {
+        ASSERT(MarkedBlock::blockFor(atom) == this);
+        m_cards.markCardForAtom(atom);
+    }
+
+    inline uint8_t* MarkedBlock::addressOfCardFor(const void* atom)
+    {
+        ASSERT(MarkedBlock::blockFor(atom) == this);
+        return &m_cards.cardForAtom(atom);
+    }
+
+    inline void MarkedBlock::gatherDirtyCells(DirtyCellVector& dirtyCells)
+    {
+        if (m_cards.isEmpty())
+            return;
+
+        size_t firstAtom = this->firstAtom();
+        for (size_t card = 0; card < cardCount; ++card) {
+            if (!m_cards.testAndClear(card))
+                continue;
+
+            size_t startAtom = std::max(card * atomsPerCard, firstAtom);
+            size_t endAtom = std::min((card + 1) * atomsPerCard, m_endAtom);
+
+            // A cell belongs to the card that contains its first atom.
+            size_t cellOffset = (startAtom - firstAtom) % m_atomsPerCell;
+            if (cellOffset)
+                startAtom += m_atomsPerCell - cellOffset;
+
+            for (size_t i = startAtom; i < endAtom; i += m_atomsPerCell) {
+                // Unmarked cells are either young, and will be found by tracing
+                // if they are live, or dead.
+                if (!m_marks.get(i))
+                    continue;
+                dirtyCells.append(reinterpret_cast_ptr<JSCell*>(&atoms()[i]));
+            }
+        }
+    }
+#endif
+
     inline size_t MarkedBlock::markCount()
     {
         return m_marks.count();
@@ -423,9 +525,29 @@ namespace JSC {
 
     inline bool MarkedBlock::needsSweeping()
     {
+#if ENABLE(PARALLEL_GC)
+        // Queued blocks belong to the GC threads until the mutator takes their free list.
+        if (m_concurrentSweepState != NotQueuedForSweep)
+            return false;
+#endif
         return m_state == Marked;
     }
 
+#if ENABLE(PARALLEL_GC)
+    inline bool MarkedBlock::canSweepConcurrently()
+    {
+        // Empty blocks are left to the IncrementalSweeper, which can give them back.
+        return m_destructorType == None && m_state == Marked && m_weakSet.isEmpty() && !isEmpty();
+    }
+
+    inline MarkedBlock::FreeList MarkedBlock::takeSweptFreeList()
+    {
+        FreeList result = m_sweptFreeList;
+        m_sweptFreeList = FreeList();
+        return result;
+    }
+#endif
+
 } // namespace JSC
 
 namespace WTF {
@@ -77,22 +77,46 @@ struct ReapWeakSet : MarkedBlock::VoidFunctor {
     void operator()(MarkedBlock* block) { block->reapWeakSet(); }
 };
 
+#if ENABLE(PARALLEL_GC)
+class QueueForConcurrentSweep : public MarkedBlock::VoidFunctor {
+public:
+    QueueForConcurrentSweep(Vector<MarkedBlock*>& blocks)
+        : m_blocks(blocks)
+    {
+    }
+
+    void operator()(MarkedBlock* block)
+    {
+        if (!block->canSweepConcurrently())
+            return;
+        block->setConcurrentSweepState(MarkedBlock::QueuedForSweep);
+        m_blocks.append(block);
+    }
+
+private:
+    Vector<MarkedBlock*>& m_blocks;
+};
+#endif
+
 MarkedSpace::MarkedSpace(Heap* heap)
     : m_heap(heap)
 {
     for (size_t cellSize = preciseStep; cellSize <= preciseCutoff; cellSize += preciseStep) {
         allocatorFor(cellSize).init(heap, this, cellSize, MarkedBlock::None);
+        pretenuredAllocatorFor(cellSize).init(heap, this, cellSize, MarkedBlock::None);
         normalDestructorAllocatorFor(cellSize).init(heap, this, cellSize, MarkedBlock::Normal);
         immortalStructureDestructorAllocatorFor(cellSize).init(heap, this, cellSize, MarkedBlock::ImmortalStructure);
     }
 
     for (size_t cellSize = impreciseStep; cellSize <= impreciseCutoff; cellSize += impreciseStep) {
         allocatorFor(cellSize).init(heap, this, cellSize, MarkedBlock::None);
+        pretenuredAllocatorFor(cellSize).init(heap, this, cellSize, MarkedBlock::None);
         normalDestructorAllocatorFor(cellSize).init(heap, this, cellSize, MarkedBlock::Normal);
         immortalStructureDestructorAllocatorFor(cellSize).init(heap, this, cellSize, MarkedBlock::ImmortalStructure);
     }
 
     m_normalSpace.largeAllocator.init(heap, this, 0, MarkedBlock::None);
+    m_pretenuredSpace.largeAllocator.init(heap, this, 0, MarkedBlock::None);
     m_normalDestructorSpace.largeAllocator.init(heap, this, 0, MarkedBlock::Normal);
     m_immortalStructureDestructorSpace.largeAllocator.init(heap, this, 0, MarkedBlock::ImmortalStructure);
 }
@@ -115,25 +139,51 @@ void MarkedSpace::lastChanceToFinalize()
 
 void MarkedSpace::sweep()
 {
+    finishConcurrentSweeping();
     m_heap->sweeper()->willFinishSweeping();
     forEachBlock<Sweep>();
 }
 
+#if ENABLE(PARALLEL_GC)
+void MarkedSpace::startConcurrentSweeping()
+{
+    ASSERT(!m_heap->m_sharedData.isSweeping());
+
+    Vector<MarkedBlock*> blocks;
+    QueueForConcurrentSweep functor(blocks);
+    forEachBlock(functor);
+    if (blocks.isEmpty())
+        return;
+
+    m_heap->m_sharedData.didStartSweeping(blocks);
+}
+#endif
+
+void MarkedSpace::finishConcurrentSweeping()
+{
+#if ENABLE(PARALLEL_GC)
+    m_heap->m_sharedData.didFinishSweeping();
+#endif
+}
+
 void MarkedSpace::resetAllocators()
 {
     for (size_t cellSize = preciseStep; cellSize <= preciseCutoff; cellSize += preciseStep) {
         allocatorFor(cellSize).reset();
+        pretenuredAllocatorFor(cellSize).reset();
         normalDestructorAllocatorFor(cellSize).reset();
         immortalStructureDestructorAllocatorFor(cellSize).reset();
     }
 
     for (size_t cellSize = impreciseStep; cellSize <= impreciseCutoff; cellSize += impreciseStep) {
         allocatorFor(cellSize).reset();
+        pretenuredAllocatorFor(cellSize).reset();
         normalDestructorAllocatorFor(cellSize).reset();
         immortalStructureDestructorAllocatorFor(cellSize).reset();
     }
 
     m_normalSpace.largeAllocator.reset();
+    m_pretenuredSpace.largeAllocator.reset();
     m_normalDestructorSpace.largeAllocator.reset();
     m_immortalStructureDestructorSpace.largeAllocator.reset();
 }
@@ -151,19 +201,24 @@ void MarkedSpace::reapWeakSets()
 
 void MarkedSpace::canonicalizeCellLivenessData()
 {
+    finishConcurrentSweeping();
+
     for (size_t cellSize = preciseStep; cellSize <= preciseCutoff; cellSize += preciseStep) {
         allocatorFor(cellSize).canonicalizeCellLivenessData();
+        pretenuredAllocatorFor(cellSize).canonicalizeCellLivenessData();
         normalDestructorAllocatorFor(cellSize).canonicalizeCellLivenessData();
         immortalStructureDestructorAllocatorFor(cellSize).canonicalizeCellLivenessData();
     }
 
     for (size_t cellSize = impreciseStep; cellSize <= impreciseCutoff; cellSize += impreciseStep) {
         allocatorFor(cellSize).canonicalizeCellLivenessData();
+        pretenuredAllocatorFor(cellSize).canonicalizeCellLivenessData();
         normalDestructorAllocatorFor(cellSize).canonicalizeCellLivenessData();
         immortalStructureDestructorAllocatorFor(cellSize).canonicalizeCellLivenessData();
     }
 
     m_normalSpace.largeAllocator.canonicalizeCellLivenessData();
+    m_pretenuredSpace.largeAllocator.canonicalizeCellLivenessData();
     m_normalDestructorSpace.largeAllocator.canonicalizeCellLivenessData();
     m_immortalStructureDestructorSpace.largeAllocator.canonicalizeCellLivenessData();
 }
@@ -172,6 +227,7 @@ bool MarkedSpace::isPagedOut(double deadline)
 {
     for (size_t cellSize = preciseStep; cellSize <= preciseCutoff; cellSize += preciseStep) {
         if (allocatorFor(cellSize).isPagedOut(deadline) 
+            || pretenuredAllocatorFor(cellSize).isPagedOut(deadline) 
             || normalDestructorAllocatorFor(cellSize).isPagedOut(deadline) 
             || immortalStructureDestructorAllocatorFor(cellSize).isPagedOut(deadline))
             return true;
@@ -179,12 +235,14 @@ bool MarkedSpace::isPagedOut(double deadline)
 
     for (size_t cellSize = impreciseStep; cellSize <= impreciseCutoff; cellSize += impreciseStep) {
         if (allocatorFor(cellSize).isPagedOut(deadline) 
+            || pretenuredAllocatorFor(cellSize).isPagedOut(deadline) 
             || normalDestructorAllocatorFor(cellSize).isPagedOut(deadline) 
             || immortalStructureDestructorAllocatorFor(cellSize).isPagedOut(deadline))
             return true;
     }
 
     if (m_normalSpace.largeAllocator.isPagedOut(deadline)
+        || m_pretenuredSpace.largeAllocator.isPagedOut(deadline)
         || m_normalDestructorSpace.largeAllocator.isPagedOut(deadline)
         || m_immortalStructureDestructorSpace.largeAllocator.isPagedOut(deadline))
         return true;
@@ -219,6 +277,7 @@ struct Shrink : MarkedBlock::VoidFunctor {
 
 void MarkedSpace::shrink()
 {
+    finishConcurrentSweeping();
     Free freeOrShrink(Free::FreeOrShrink, this);
     forEachBlock(freeOrShrink);
 }
@@ -47,6 +47,25 @@ struct ClearMarks : MarkedBlock::VoidFunctor {
     void operator()(MarkedBlock* block) { block->clearMarks(); }
 };
 
+#if ENABLE(GGC)
+struct ClearMarksForEdenCollection : MarkedBlock::VoidFunctor {
+    void operator()(MarkedBlock* block) { block->clearMarksForEdenCollection(); }
+};
+
+class GatherDirtyCells : public MarkedBlock::VoidFunctor {
+public:
+    GatherDirtyCells(MarkedBlock::DirtyCellVector& dirtyCells)
+        : m_dirtyCells(dirtyCells)
+    {
+    }
+
+    void operator()(MarkedBlock* block) { block->gatherDirtyCells(m_dirtyCells); }
+
+private:
+    MarkedBlock::DirtyCellVector& m_dirtyCells;
+};
+#endif
+
 struct Sweep : MarkedBlock::VoidFunctor {
     void operator()(MarkedBlock* block) { block->sweep(); }
 };
@@ -72,6 +91,7 @@ public:
 
     MarkedAllocator& firstAllocator();
     MarkedAllocator& allocatorFor(size_t);
+    MarkedAllocator& pretenuredAllocatorFor(size_t);
     MarkedAllocator& immortalStructureDestructorAllocatorFor(size_t);
     MarkedAllocator& normalDestructorAllocatorFor(size_t);
     void* allocateWithNormalDestructor(size_t);
@@ -104,7 +124,15 @@ public:
     void didConsumeFreeList(MarkedBlock*);
 
     void clearMarks();
+#if ENABLE(GGC)
+    void clearMarksForEdenCollection();
+    void gatherDirtyCells(MarkedBlock::DirtyCellVector&);
+#endif
     void sweep();
+#if ENABLE(PARALLEL_GC)
+    void startConcurrentSweeping();
+#endif
+    void finishConcurrentSweeping();
     size_t objectCount();
     size_t size();
     size_t capacity();
@@ -133,6 +161,7 @@ private:
     Subspace m_normalDestructorSpace;
     Subspace m_immortalStructureDestructorSpace;
     Subspace m_normalSpace;
+    Subspace m_pretenuredSpace;
 
     Heap* m_heap;
     MarkedBlockSet m_blocks;
@@ -180,6 +209,16 @@ inline MarkedAllocator& MarkedSpace::allocatorFor(size_t bytes)
     return m_normalSpace.largeAllocator;
 }
 
+inline MarkedAllocator& MarkedSpace::pretenuredAllocatorFor(size_t bytes)
+{
+    ASSERT(bytes);
+    if (bytes <= preciseCutoff)
+        return m_pretenuredSpace.preciseAllocators[(bytes - 1) / preciseStep];
+    if (bytes <= impreciseCutoff)
+        return m_pretenuredSpace.impreciseAllocators[(bytes - 1) / impreciseStep];
+    return m_pretenuredSpace.largeAllocator;
+}
+
 inline MarkedAllocator& MarkedSpace::immortalStructureDestructorAllocatorFor(size_t bytes)
 {
     ASSERT(bytes);
@@ -219,17 +258,20 @@ template <typename Functor> inline typename Functor::ReturnType MarkedSpace::for
 {
     for (size_t i = 0; i < preciseCount; ++i) {
         m_normalSpace.preciseAllocators[i].forEachBlock(functor);
+        m_pretenuredSpace.preciseAllocators[i].forEachBlock(functor);
         m_normalDestructorSpace.preciseAllocators[i].forEachBlock(functor);
         m_immortalStructureDestructorSpace.preciseAllocators[i].forEachBlock(functor);
     }
 
     for (size_t i = 0; i < impreciseCount; ++i) {
         m_normalSpace.impreciseAllocators[i].forEachBlock(functor);
+        m_pretenuredSpace.impreciseAllocators[i].forEachBlock(functor);
         m_normalDestructorSpace.impreciseAllocators[i].forEachBlock(functor);
         m_immortalStructureDestructorSpace.impreciseAllocators[i].forEachBlock(functor);
     }
 
     m_normalSpace.largeAllocator.forEachBlock(functor);
+    m_pretenuredSpace.largeAllocator.forEachBlock(functor);
     m_normalDestructorSpace.largeAllocator.forEachBlock(functor);
     m_immortalStructureDestructorSpace.largeAllocator.forEachBlock(functor);
 
@@ -252,6 +294,19 @@ inline void MarkedSpace::clearMarks()
     forEachBlock<ClearMarks>();
 }
 
+#if ENABLE(GGC)
+inline void MarkedSpace::clearMarksForEdenCollection()
+{
+    forEachBlock<ClearMarksForEdenCollection>();
+}
+
+inline void MarkedSpace::gatherDirtyCells(MarkedBlock::DirtyCellVector& dirtyCells)
+{
+    GatherDirtyCells functor(dirtyCells);
+    forEachBlock(functor);
+}
+#endif
+
 inline size_t MarkedSpace::objectCount()
 {
     return forEachBlock<MarkCount>();
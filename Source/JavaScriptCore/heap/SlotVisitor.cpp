@@ -6,6 +6,7 @@
 #include "CopiedSpace.h"
 #include "CopiedSpaceInlines.h"
 #include "GCThread.h"
+#include "HeapSnapshotBuilder.h"
 #include "JSArray.h"
 #include "JSDestructibleObject.h"
 #include "VM.h"
@@ -22,6 +23,8 @@ SlotVisitor::SlotVisitor(GCThreadSharedData& shared)
     , m_isInParallelMode(false)
     , m_shared(shared)
     , m_shouldHashCons(false)
+    , m_heapSnapshotBuilder(0)
+    , m_currentCell(0)
 #if !ASSERT_DISABLED
     , m_isCheckingForDefaultMarkViolation(false)
     , m_isDraining(false)
@@ -38,9 +41,12 @@ void SlotVisitor::setup()
 {
     m_shared.m_shouldHashCons = m_shared.m_vm->haveEnoughNewStringsToHashCons();
     m_shouldHashCons = m_shared.m_shouldHashCons;
+    m_heapSnapshotBuilder = m_shared.m_vm->heap.m_heapSnapshotBuilder;
 #if ENABLE(PARALLEL_GC)
-    for (unsigned i = 0; i < m_shared.m_gcThreads.size(); ++i)
+    for (unsigned i = 0; i < m_shared.m_gcThreads.size(); ++i) {
         m_shared.m_gcThreads[i]->slotVisitor()->m_shouldHashCons = m_shared.m_shouldHashCons;
+        m_shared.m_gcThreads[i]->slotVisitor()->m_heapSnapshotBuilder = m_heapSnapshotBuilder;
+    }
 #endif
 }
 
@@ -57,6 +63,7 @@ void SlotVisitor::reset()
         m_uniqueStrings.clear();
         m_shouldHashCons = false;
     }
+    m_heapSnapshotBuilder = 0;
 }
 
 void SlotVisitor::append(ConservativeRoots& conservativeRoots)
@@ -76,6 +83,11 @@ ALWAYS_INLINE static void visitChildren(SlotVisitor& visitor, const JSCell* cell
 #endif
 
     ASSERT(Heap::isMarked(cell));
+
+    if (UNLIKELY(visitor.isBuildingHeapSnapshot())) {
+        visitor.visitChildrenForHeapSnapshot(cell);
+        return;
+    }
     
     if (isJSString(cell)) {
         JSString::visitChildren(const_cast<JSCell*>(cell), visitor);
@@ -95,6 +107,22 @@ ALWAYS_INLINE static void visitChildren(SlotVisitor& visitor, const JSCell* cell
     cell->methodTable()->visitChildren(const_cast<JSCell*>(cell), visitor);
 }
 
+void SlotVisitor::visitChildrenForHeapSnapshot(const JSCell* cell)
+{
+    // Every cell that is appended while visiting this one is recorded as one of
+    // its references. Anything appended outside of here is recorded as a root.
+    ASSERT(!m_currentCell);
+    m_heapSnapshotBuilder->appendNode(cell);
+    m_currentCell = cell;
+    cell->methodTable()->visitChildren(const_cast<JSCell*>(cell), *this);
+    m_currentCell = 0;
+}
+
+void SlotVisitor::appendToHeapSnapshot(JSCell* cell)
+{
+    m_heapSnapshotBuilder->appendEdge(m_currentCell, cell);
+}
+
 void SlotVisitor::donateKnownParallel()
 {
     StackStats::probe();
@@ -36,6 +36,7 @@ namespace JSC {
 class ConservativeRoots;
 class GCThreadSharedData;
 class Heap;
+class HeapSnapshotBuilder;
 template<typename T> class Weak;
 template<typename T> class WriteBarrierBase;
 template<typename T> class JITWriteBarrier;
@@ -92,6 +93,9 @@ public:
     void addWeakReferenceHarvester(WeakReferenceHarvester*);
     void addUnconditionalFinalizer(UnconditionalFinalizer*);
 
+    bool isBuildingHeapSnapshot() const { return m_heapSnapshotBuilder; }
+    void visitChildrenForHeapSnapshot(const JSCell*);
+
 #if ENABLE(OBJECT_MARK_LOGGING)
     inline void resetChildCount() { m_logChildCount = 0; }
     inline unsigned childCount() { return m_logChildCount; }
@@ -106,10 +110,15 @@ private:
     void append(JSValue*);
     void append(JSValue*, size_t count);
     void append(JSCell**);
+#if ENABLE(GGC)
+    void appendDirtyCell(JSCell*);
+#endif
 
     void internalAppend(JSCell*);
     void internalAppend(JSValue);
     void internalAppend(JSValue*);
+
+    void appendToHeapSnapshot(JSCell*);
     
     JS_EXPORT_PRIVATE void mergeOpaqueRoots();
     void mergeOpaqueRootsIfNecessary();
@@ -129,6 +138,9 @@ private:
     typedef HashMap<StringImpl*, JSValue> UniqueStringMap;
     UniqueStringMap m_uniqueStrings;
 
+    HeapSnapshotBuilder* m_heapSnapshotBuilder; // Local per-thread copy of Heap::m_heapSnapshotBuilder.
+    const JSCell* m_currentCell; // The cell whose children are being visited, if building a heap snapshot.
+
 #if ENABLE(OBJECT_MARK_LOGGING)
     unsigned m_logChildCount;
 #endif
@@ -69,6 +69,17 @@ ALWAYS_INLINE void SlotVisitor::append(JSCell** slot)
     internalAppend(*slot);
 }
 
+#if ENABLE(GGC)
+inline void SlotVisitor::appendDirtyCell(JSCell* cell)
+{
+    // Dirty cells are old, so they are already marked. Push them anyway so that
+    // their children get traced again.
+    ASSERT(Heap::isMarked(cell));
+    m_visitCount++;
+    m_stack.append(cell);
+}
+#endif
+
 template<typename T>
 ALWAYS_INLINE void SlotVisitor::appendUnbarrieredWeak(Weak<T>* weak)
 {
@@ -105,6 +105,16 @@ void WeakBlock::visit(HeapRootVisitor& heapRootVisitor)
         if (!weakHandleOwner)
             continue;
 
+#if ENABLE(GGC)
+        // Opaque roots are only added by objects that get visited, and an eden
+        // collection does not visit most old objects. Keep the handle alive
+        // until a full collection can answer the question.
+        if (Heap::heap(jsValue)->isEdenCollection()) {
+            heapRootVisitor.visit(&const_cast<JSValue&>(jsValue));
+            continue;
+        }
+#endif
+
         if (!weakHandleOwner->isReachableFromOpaqueRoots(Handle<Unknown>::wrapSlot(&const_cast<JSValue&>(jsValue)), weakImpl->context(), visitor))
             continue;
 
@@ -212,7 +212,7 @@ double ExecutableAllocator::memoryPressureMultiplier(size_t addedMemoryUsage)
 
 }
 
-PassRefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(VM&, size_t sizeInBytes, void* ownerUID, JITCompilationEffort effort)
+PassRefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(VM&, size_t sizeInBytes, void* ownerUID, JITCompilationEffort effort, ExecutableMemoryKind)
 {
     RefPtr<ExecutableMemoryHandle> result = allocator()->allocate(sizeInBytes, ownerUID);
     RELEASE_ASSERT(result || effort != JITCompilationMustSucceed);
@@ -224,6 +224,28 @@ size_t ExecutableAllocator::committedByteCount()
     return DemandExecutableAllocator::bytesCommittedByAllocactors();
 }
 
+MetaAllocator::Statistics ExecutableAllocator::statistics(ExecutableMemoryKind)
+{
+    MetaAllocator::Statistics result;
+    result.bytesAllocated = 0;
+    result.bytesReserved = 0;
+    result.bytesCommitted = 0;
+    return result;
+}
+
+MetaAllocator::FreeSpaceStatistics ExecutableAllocator::freeSpaceStatistics(ExecutableMemoryKind)
+{
+    MetaAllocator::FreeSpaceStatistics result;
+    result.bytesFree = 0;
+    result.largestFreeChunk = 0;
+    result.numberOfFreeChunks = 0;
+    return result;
+}
+
+void ExecutableAllocator::dumpStatistics()
+{
+}
+
 #if ENABLE(META_ALLOCATOR_PROFILE)
 void ExecutableAllocator::dumpProfile()
 {
@@ -78,6 +78,17 @@ void releaseExecutableMemory(VM&);
 
 static const unsigned jitAllocationGranule = 32;
 
+// Code of different kinds lives for very different amounts of time, so the
+// fixed pool gives each kind its own region to keep them from fragmenting each
+// other.
+enum ExecutableMemoryKind {
+    BaselineJITMemory,
+    DFGJITMemory,
+    RegExpJITMemory,
+    StubJITMemory // Thunks, inline cache stubs and OSR exits.
+};
+static const unsigned numberOfExecutableMemoryKinds = StubJITMemory + 1;
+
 inline size_t roundUpAllocationSize(size_t request, size_t granularity)
 {
     RELEASE_ASSERT((std::numeric_limits<size_t>::max() - granularity) > request);
@@ -134,7 +145,12 @@ public:
     static void dumpProfile() { }
 #endif
 
-    PassRefPtr<ExecutableMemoryHandle> allocate(VM&, size_t sizeInBytes, void* ownerUID, JITCompilationEffort);
+    PassRefPtr<ExecutableMemoryHandle> allocate(VM&, size_t sizeInBytes, void* ownerUID, JITCompilationEffort, ExecutableMemoryKind = StubJITMemory);
+
+    // Only the fixed pool keeps the kinds apart; elsewhere these report zeros.
+    static WTF::MetaAllocator::Statistics statistics(ExecutableMemoryKind);
+    static WTF::MetaAllocator::FreeSpaceStatistics freeSpaceStatistics(ExecutableMemoryKind);
+    static void dumpStatistics();
 
 #if ENABLE(ASSEMBLER_WX_EXCLUSIVE)
     static void makeWritable(void* start, size_t size)
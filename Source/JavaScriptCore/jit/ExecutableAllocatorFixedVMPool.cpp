@@ -32,6 +32,7 @@
 #include "CodeProfiling.h"
 #include <errno.h>
 #include <unistd.h>
+#include <wtf/DataLog.h>
 #include <wtf/MetaAllocator.h>
 #include <wtf/PageReservation.h>
 #include <wtf/VMTags.h>
@@ -58,23 +59,14 @@ uintptr_t startOfFixedExecutableMemoryPool;
 class FixedVMPoolExecutableAllocator : public MetaAllocator {
     WTF_MAKE_FAST_ALLOCATED;
 public:
-    FixedVMPoolExecutableAllocator()
+    FixedVMPoolExecutableAllocator(PageReservation& reservation, void* start, size_t sizeInBytes)
         : MetaAllocator(jitAllocationGranule) // round up all allocations to 32 bytes
+        , m_reservation(reservation)
     {
-        m_reservation = PageReservation::reserveWithGuardPages(fixedExecutableMemoryPoolSize, OSAllocator::JSJITCodePages, EXECUTABLE_POOL_WRITABLE, true);
-#if !ENABLE(LLINT)
-        RELEASE_ASSERT(m_reservation);
-#endif
-        if (m_reservation) {
-            ASSERT(m_reservation.size() == fixedExecutableMemoryPoolSize);
-            addFreshFreeSpace(m_reservation.base(), m_reservation.size());
-            
-            startOfFixedExecutableMemoryPool = reinterpret_cast<uintptr_t>(m_reservation.base());
-        }
+        if (sizeInBytes)
+            addFreshFreeSpace(start, sizeInBytes);
     }
 
-    virtual ~FixedVMPoolExecutableAllocator();
-    
 protected:
     virtual void* allocateNewSpace(size_t&)
     {
@@ -110,46 +102,108 @@ protected:
     }
 
 private:
-    PageReservation m_reservation;
+    PageReservation& m_reservation;
 };
 
-static FixedVMPoolExecutableAllocator* allocator;
+// The share of the fixed pool, in eighths, that each kind of code starts out
+// with. A kind whose region is full borrows from the others before we resort
+// to throwing code away, so this only decides which code ends up next to
+// which.
+static const size_t poolEighthsForKind[numberOfExecutableMemoryKinds] = {
+    3, // BaselineJITMemory
+    2, // DFGJITMemory
+    1, // RegExpJITMemory
+    2 // StubJITMemory
+};
+
+static PageReservation* reservation;
+static FixedVMPoolExecutableAllocator* allocators[numberOfExecutableMemoryKinds];
+
+static const char* const executableMemoryKindNames[numberOfExecutableMemoryKinds] = {
+    "Baseline",
+    "DFG",
+    "RegExp",
+    "Stubs"
+};
 
 void ExecutableAllocator::initializeAllocator()
 {
-    ASSERT(!allocator);
-    allocator = new FixedVMPoolExecutableAllocator();
-    CodeProfiling::notifyAllocator(allocator);
+    ASSERT(!reservation);
+    reservation = new PageReservation(PageReservation::reserveWithGuardPages(fixedExecutableMemoryPoolSize, OSAllocator::JSJITCodePages, EXECUTABLE_POOL_WRITABLE, true));
+#if !ENABLE(LLINT)
+    RELEASE_ASSERT(*reservation);
+#endif
+    char* start = 0;
+    size_t sizeInBytes = 0;
+    if (*reservation) {
+        ASSERT(reservation->size() == fixedExecutableMemoryPoolSize);
+        start = static_cast<char*>(reservation->base());
+        sizeInBytes = reservation->size();
+        startOfFixedExecutableMemoryPool = reinterpret_cast<uintptr_t>(start);
+    }
+
+    size_t offset = 0;
+    for (unsigned kind = 0; kind < numberOfExecutableMemoryKinds; ++kind) {
+        size_t regionSize = kind == numberOfExecutableMemoryKinds - 1
+            ? sizeInBytes - offset
+            : (sizeInBytes / 8 * poolEighthsForKind[kind]) & ~(pageSize() - 1);
+        allocators[kind] = new FixedVMPoolExecutableAllocator(*reservation, start + offset, regionSize);
+        CodeProfiling::notifyAllocator(allocators[kind]);
+        offset += regionSize;
+    }
 }
 
-ExecutableAllocator::ExecutableAllocator(VM&)
+static MetaAllocator::Statistics totalStatistics()
 {
-    ASSERT(allocator);
+    MetaAllocator::Statistics result;
+    result.bytesAllocated = 0;
+    result.bytesReserved = 0;
+    result.bytesCommitted = 0;
+    for (unsigned kind = 0; kind < numberOfExecutableMemoryKinds; ++kind) {
+        MetaAllocator::Statistics statistics = allocators[kind]->currentStatistics();
+        result.bytesAllocated += statistics.bytesAllocated;
+        result.bytesReserved += statistics.bytesReserved;
+        result.bytesCommitted += statistics.bytesCommitted;
+    }
+    return result;
 }
 
-ExecutableAllocator::~ExecutableAllocator()
+static PassRefPtr<ExecutableMemoryHandle> allocateFromPools(size_t sizeInBytes, void* ownerUID, ExecutableMemoryKind kind)
 {
+    if (RefPtr<ExecutableMemoryHandle> result = allocators[kind]->allocate(sizeInBytes, ownerUID))
+        return result.release();
+    for (unsigned otherKind = 0; otherKind < numberOfExecutableMemoryKinds; ++otherKind) {
+        if (otherKind == static_cast<unsigned>(kind))
+            continue;
+        if (RefPtr<ExecutableMemoryHandle> result = allocators[otherKind]->allocate(sizeInBytes, ownerUID))
+            return result.release();
+    }
+    return 0;
+}
+
+ExecutableAllocator::ExecutableAllocator(VM&)
+{
+    ASSERT(reservation);
 }
 
-FixedVMPoolExecutableAllocator::~FixedVMPoolExecutableAllocator()
+ExecutableAllocator::~ExecutableAllocator()
 {
-    m_reservation.deallocate();
 }
 
 bool ExecutableAllocator::isValid() const
 {
-    return !!allocator->bytesReserved();
+    return !!*reservation;
 }
 
 bool ExecutableAllocator::underMemoryPressure()
 {
-    MetaAllocator::Statistics statistics = allocator->currentStatistics();
+    MetaAllocator::Statistics statistics = totalStatistics();
     return statistics.bytesAllocated > statistics.bytesReserved / 2;
 }
 
 double ExecutableAllocator::memoryPressureMultiplier(size_t addedMemoryUsage)
 {
-    MetaAllocator::Statistics statistics = allocator->currentStatistics();
+    MetaAllocator::Statistics statistics = totalStatistics();
     ASSERT(statistics.bytesAllocated <= statistics.bytesReserved);
     size_t bytesAllocated = statistics.bytesAllocated + addedMemoryUsage;
     if (bytesAllocated >= statistics.bytesReserved)
@@ -163,14 +217,14 @@ double ExecutableAllocator::memoryPressureMultiplier(size_t addedMemoryUsage)
     return result;
 }
 
-PassRefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(VM& vm, size_t sizeInBytes, void* ownerUID, JITCompilationEffort effort)
+PassRefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(VM& vm, size_t sizeInBytes, void* ownerUID, JITCompilationEffort effort, ExecutableMemoryKind kind)
 {
-    RefPtr<ExecutableMemoryHandle> result = allocator->allocate(sizeInBytes, ownerUID);
+    RefPtr<ExecutableMemoryHandle> result = allocateFromPools(sizeInBytes, ownerUID, kind);
     if (!result) {
         if (effort == JITCompilationCanFail)
             return result;
         releaseExecutableMemory(vm);
-        result = allocator->allocate(sizeInBytes, ownerUID);
+        result = allocateFromPools(sizeInBytes, ownerUID, kind);
         RELEASE_ASSERT(result);
     }
     return result.release();
@@ -178,13 +232,42 @@ PassRefPtr<ExecutableMemoryHandle> ExecutableAllocator::allocate(VM& vm, size_t
 
 size_t ExecutableAllocator::committedByteCount()
 {
-    return allocator->bytesCommitted();
+    return totalStatistics().bytesCommitted;
+}
+
+MetaAllocator::Statistics ExecutableAllocator::statistics(ExecutableMemoryKind kind)
+{
+    return allocators[kind]->currentStatistics();
+}
+
+MetaAllocator::FreeSpaceStatistics ExecutableAllocator::freeSpaceStatistics(ExecutableMemoryKind kind)
+{
+    return allocators[kind]->currentFreeSpaceStatistics();
+}
+
+void ExecutableAllocator::dumpStatistics()
+{
+    dataLogF("Executable memory:\n");
+    for (unsigned kind = 0; kind < numberOfExecutableMemoryKinds; ++kind) {
+        MetaAllocator::Statistics statistics = allocators[kind]->currentStatistics();
+        MetaAllocator::FreeSpaceStatistics freeSpace = allocators[kind]->currentFreeSpaceStatistics();
+        dataLogF(
+            "    %s: %lu allocated, %lu committed, %lu free in %lu chunks (largest %lu) out of %lu bytes\n",
+            executableMemoryKindNames[kind],
+            static_cast<unsigned long>(statistics.bytesAllocated),
+            static_cast<unsigned long>(statistics.bytesCommitted),
+            static_cast<unsigned long>(freeSpace.bytesFree),
+            static_cast<unsigned long>(freeSpace.numberOfFreeChunks),
+            static_cast<unsigned long>(freeSpace.largestFreeChunk),
+            static_cast<unsigned long>(statistics.bytesReserved));
+    }
 }
 
 #if ENABLE(META_ALLOCATOR_PROFILE)
 void ExecutableAllocator::dumpProfile()
 {
-    allocator->dumpProfile();
+    for (unsigned kind = 0; kind < numberOfExecutableMemoryKinds; ++kind)
+        allocators[kind]->dumpProfile();
 }
 #endif
 
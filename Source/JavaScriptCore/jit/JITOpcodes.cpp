@@ -591,6 +591,10 @@ void JIT::emit_op_next_pname(Instruction* currentInstruction)
     loadPtr(Address(regT0, JSCell::structureOffset()), regT2);
     callHasProperty.append(branchPtr(NotEqual, regT2, Address(Address(regT1, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedStructure)))));
 
+    // Index keys may have been deleted without a structure change.
+    load32(intPayloadFor(i), regT3);
+    callHasProperty.append(branch32(BelowOrEqual, regT3, Address(regT1, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedIndexedLength))));
+
     // Test base's prototype chain
     loadPtr(Address(Address(regT1, OBJECT_OFFSETOF(JSPropertyNameIterator, m_cachedPrototypeChain))), regT3);
     loadPtr(Address(regT3, OBJECT_OFFSETOF(StructureChain, m_vector)), regT3);
@@ -1270,7 +1274,7 @@ void JIT::emit_op_loop_hint(Instruction*)
             AbsoluteAddress(m_codeBlock->addressOfJITExecuteCounter())));
 
     // Emit the watchdog timer check:
-    if (m_vm->watchdog.isEnabled())
+    if (m_vm->watchdog.needsPollingChecks())
         addSlowCase(branchTest8(NonZero, AbsoluteAddress(m_vm->watchdog.timerDidFireAddress())));
 }
 
@@ -1290,7 +1294,7 @@ void JIT::emitSlow_op_loop_hint(Instruction*, Vector<SlowCaseEntry>::iterator& i
 #endif
 
     // Emit the slow path of the watchdog timer check:
-    if (m_vm->watchdog.isEnabled()) {
+    if (m_vm->watchdog.needsPollingChecks()) {
         linkSlowCase(iter);
 
         JITStubCall stubCall(this, cti_handle_watchdog_timer);
@@ -866,12 +866,7 @@ void JIT::privateCompileGetByIdProto(StructureStubInfo* stubInfo, Structure* str
         stubCall.call();
     } else if (slot.cachedPropertyType() == PropertySlot::Custom) {
         needsStubLink = true;
-        JITStubCall stubCall(this, cti_op_get_by_id_custom_stub);
-        stubCall.addArgument(TrustedImmPtr(protoObject));
-        stubCall.addArgument(TrustedImmPtr(FunctionPtr(slot.customGetter()).executableAddress()));
-        stubCall.addArgument(TrustedImmPtr(const_cast<Identifier*>(&ident)));
-        stubCall.addArgument(TrustedImmPtr(stubInfo->callReturnLocation.executableAddress()));
-        stubCall.call();
+        compileGetByIdCustomCall(protoObject, stubInfo, ident, slot);
     } else
         compileGetDirectOffset(protoObject, regT0, cachedOffset);
     Jump success = jump();
@@ -927,12 +922,7 @@ void JIT::privateCompileGetByIdSelfList(StructureStubInfo* stubInfo, Polymorphic
         stubCall.call();
     } else if (slot.cachedPropertyType() == PropertySlot::Custom) {
         needsStubLink = true;
-        JITStubCall stubCall(this, cti_op_get_by_id_custom_stub);
-        stubCall.addArgument(regT0);
-        stubCall.addArgument(TrustedImmPtr(FunctionPtr(slot.customGetter()).executableAddress()));
-        stubCall.addArgument(TrustedImmPtr(const_cast<Identifier*>(&ident)));
-        stubCall.addArgument(TrustedImmPtr(stubInfo->callReturnLocation.executableAddress()));
-        stubCall.call();
+        compileGetByIdCustomCall(regT0, stubInfo, ident, slot);
     } else {
         isDirect = true;
         compileGetDirectOffset(regT0, regT0, cachedOffset);
@@ -1001,12 +991,7 @@ void JIT::privateCompileGetByIdProtoList(StructureStubInfo* stubInfo, Polymorphi
         stubCall.call();
     } else if (slot.cachedPropertyType() == PropertySlot::Custom) {
         needsStubLink = true;
-        JITStubCall stubCall(this, cti_op_get_by_id_custom_stub);
-        stubCall.addArgument(TrustedImmPtr(protoObject));
-        stubCall.addArgument(TrustedImmPtr(FunctionPtr(slot.customGetter()).executableAddress()));
-        stubCall.addArgument(TrustedImmPtr(const_cast<Identifier*>(&ident)));
-        stubCall.addArgument(TrustedImmPtr(stubInfo->callReturnLocation.executableAddress()));
-        stubCall.call();
+        compileGetByIdCustomCall(protoObject, stubInfo, ident, slot);
     } else {
         isDirect = true;
         compileGetDirectOffset(protoObject, regT0, cachedOffset);
@@ -1080,12 +1065,7 @@ void JIT::privateCompileGetByIdChainList(StructureStubInfo* stubInfo, Polymorphi
         stubCall.call();
     } else if (slot.cachedPropertyType() == PropertySlot::Custom) {
         needsStubLink = true;
-        JITStubCall stubCall(this, cti_op_get_by_id_custom_stub);
-        stubCall.addArgument(TrustedImmPtr(protoObject));
-        stubCall.addArgument(TrustedImmPtr(FunctionPtr(slot.customGetter()).executableAddress()));
-        stubCall.addArgument(TrustedImmPtr(const_cast<Identifier*>(&ident)));
-        stubCall.addArgument(TrustedImmPtr(stubInfo->callReturnLocation.executableAddress()));
-        stubCall.call();
+        compileGetByIdCustomCall(protoObject, stubInfo, ident, slot);
     } else {
         isDirect = true;
         compileGetDirectOffset(protoObject, regT0, cachedOffset);
@@ -1158,12 +1138,7 @@ void JIT::privateCompileGetByIdChain(StructureStubInfo* stubInfo, Structure* str
         stubCall.call();
     } else if (slot.cachedPropertyType() == PropertySlot::Custom) {
         needsStubLink = true;
-        JITStubCall stubCall(this, cti_op_get_by_id_custom_stub);
-        stubCall.addArgument(TrustedImmPtr(protoObject));
-        stubCall.addArgument(TrustedImmPtr(FunctionPtr(slot.customGetter()).executableAddress()));
-        stubCall.addArgument(TrustedImmPtr(const_cast<Identifier*>(&ident)));
-        stubCall.addArgument(TrustedImmPtr(stubInfo->callReturnLocation.executableAddress()));
-        stubCall.call();
+        compileGetByIdCustomCall(protoObject, stubInfo, ident, slot);
     } else
         compileGetDirectOffset(protoObject, regT0, cachedOffset);
     Jump success = jump();
@@ -1306,6 +1281,36 @@ void JIT::resetPatchPutById(RepatchBuffer& repatchBuffer, StructureStubInfo* stu
 
 #endif // USE(JSVALUE64)
 
+template<typename BaseArgument>
+static void compileCustomGetterCall(JIT* jit, BaseArgument base, StructureStubInfo* stubInfo, const Identifier& ident, const PropertySlot& slot)
+{
+    if (PropertySlot::DirectGetValueFunc directGetter = slot.directCustomGetter()) {
+        JITStubCall stubCall(jit, cti_op_get_by_id_direct_custom_stub);
+        stubCall.addArgument(base);
+        stubCall.addArgument(MacroAssembler::TrustedImmPtr(FunctionPtr(directGetter).executableAddress()));
+        stubCall.addArgument(MacroAssembler::TrustedImmPtr(stubInfo->callReturnLocation.executableAddress()));
+        stubCall.call();
+        return;
+    }
+
+    JITStubCall stubCall(jit, cti_op_get_by_id_custom_stub);
+    stubCall.addArgument(base);
+    stubCall.addArgument(MacroAssembler::TrustedImmPtr(FunctionPtr(slot.customGetter()).executableAddress()));
+    stubCall.addArgument(MacroAssembler::TrustedImmPtr(const_cast<Identifier*>(&ident)));
+    stubCall.addArgument(MacroAssembler::TrustedImmPtr(stubInfo->callReturnLocation.executableAddress()));
+    stubCall.call();
+}
+
+void JIT::compileGetByIdCustomCall(RegisterID base, StructureStubInfo* stubInfo, const Identifier& ident, const PropertySlot& slot)
+{
+    compileCustomGetterCall(this, base, stubInfo, ident, slot);
+}
+
+void JIT::compileGetByIdCustomCall(JSObject* base, StructureStubInfo* stubInfo, const Identifier& ident, const PropertySlot& slot)
+{
+    compileCustomGetterCall(this, TrustedImmPtr(base), stubInfo, ident, slot);
+}
+
 void JIT::emitWriteBarrier(RegisterID owner, RegisterID value, RegisterID scratch, RegisterID scratch2, WriteBarrierMode mode, WriteBarrierUseKind useKind)
 {
     UNUSED_PARAM(owner);
@@ -1320,6 +1325,25 @@ void JIT::emitWriteBarrier(RegisterID owner, RegisterID value, RegisterID scratc
 #if ENABLE(WRITE_BARRIER_PROFILING)
     emitCount(WriteBarrierCounters::jitCounterFor(useKind));
 #endif
+
+#if ENABLE(GGC)
+    Jump filterCells;
+    if (mode == ShouldFilterImmediates) {
+#if USE(JSVALUE64)
+        filterCells = emitJumpIfNotJSCell(value);
+#else
+        filterCells = branch32(NotEqual, value, TrustedImm32(JSValue::CellTag));
+#endif
+    }
+    move(owner, scratch);
+    andPtr(TrustedImm32(static_cast<int32_t>(MarkedBlock::blockMask)), scratch);
+    move(owner, scratch2);
+    rshift32(TrustedImm32(MarkedBlock::cardShift), scratch2);
+    and32(TrustedImm32(MarkedBlock::cardMask), scratch2);
+    store8(TrustedImm32(1), BaseIndex(scratch, scratch2, TimesOne, MarkedBlock::offsetOfCards()));
+    if (mode == ShouldFilterImmediates)
+        filterCells.link(this);
+#endif
 }
 
 void JIT::emitWriteBarrier(JSCell* owner, RegisterID value, RegisterID scratch, WriteBarrierMode mode, WriteBarrierUseKind useKind)
@@ -1333,6 +1357,20 @@ void JIT::emitWriteBarrier(JSCell* owner, RegisterID value, RegisterID scratch,
 #if ENABLE(WRITE_BARRIER_PROFILING)
     emitCount(WriteBarrierCounters::jitCounterFor(useKind));
 #endif
+
+#if ENABLE(GGC)
+    Jump filterCells;
+    if (mode == ShouldFilterImmediates) {
+#if USE(JSVALUE64)
+        filterCells = emitJumpIfNotJSCell(value);
+#else
+        filterCells = branch32(NotEqual, value, TrustedImm32(JSValue::CellTag));
+#endif
+    }
+    store8(TrustedImm32(1), Heap::addressOfCardFor(owner));
+    if (mode == ShouldFilterImmediates)
+        filterCells.link(this);
+#endif
 }
 
 JIT::Jump JIT::addStructureTransitionCheck(JSCell* object, Structure* structure, StructureStubInfo* stubInfo, RegisterID scratch)
@@ -927,6 +927,20 @@ void performPlatformSpecificJITAssertions(VM* vm)
 #endif
 }
 
+// Generic stubs do not know their StructureStubInfo, and some of them are also called
+// from code that has no inline cache, so they only look it up when somebody is watching.
+static void recordGenericByIdAccess(CodeBlock* codeBlock, ReturnAddressPtr returnAddress)
+{
+    if (!Options::recordInlineCacheStatistics())
+        return;
+    
+    StructureStubInfo* stubInfo = codeBlock->tryGetStubInfo(returnAddress);
+    if (!stubInfo)
+        return;
+    stubInfo->tookGenericPath = true;
+    stubInfo->slowPathCount++;
+}
+
 NEVER_INLINE static void tryCachePutByID(CallFrame* callFrame, CodeBlock* codeBlock, ReturnAddressPtr returnAddress, JSValue baseValue, const PutPropertySlot& slot, StructureStubInfo* stubInfo, bool direct)
 {
     // The interpreter checks for recursion here; I do not believe this can occur in CTI.
@@ -934,6 +948,8 @@ NEVER_INLINE static void tryCachePutByID(CallFrame* callFrame, CodeBlock* codeBl
     if (!baseValue.isCell())
         return;
 
+    stubInfo->repatchCount++;
+
     // Uncacheable: give up.
     if (!slot.isCacheable()) {
         ctiPatchCallByReturnAddress(codeBlock, returnAddress, FunctionPtr(direct ? cti_op_put_by_id_direct_generic : cti_op_put_by_id_generic));
@@ -986,6 +1002,8 @@ NEVER_INLINE static void tryCacheGetByID(CallFrame* callFrame, CodeBlock* codeBl
     // FIXME: Write a test that proves we need to check for recursion here just
     // like the interpreter does, then add a check for recursion.
 
+    stubInfo->repatchCount++;
+
     // FIXME: Cache property access for immediates.
     if (!baseValue.isCell()) {
         ctiPatchCallByReturnAddress(codeBlock, returnAddress, FunctionPtr(cti_op_get_by_id_generic));
@@ -1461,8 +1479,7 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_create_this)
     ASSERT(constructor->methodTable()->getConstructData(constructor, constructData) == ConstructTypeJS);
 #endif
 
-    Structure* structure = constructor->allocationProfile(callFrame, inlineCapacity)->structure();
-    JSValue result = constructEmptyObject(callFrame, structure);
+    JSValue result = constructor->allocationProfile(callFrame, inlineCapacity)->allocate(callFrame);
 
     return JSValue::encode(result);
 }
@@ -1551,6 +1568,7 @@ DEFINE_STUB_FUNCTION(JSObject*, op_new_object)
 DEFINE_STUB_FUNCTION(void, op_put_by_id_generic)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
+    recordGenericByIdAccess(stackFrame.callFrame->codeBlock(), STUB_RETURN_ADDRESS);
 
     PutPropertySlot slot(stackFrame.callFrame->codeBlock()->isStrictMode());
     stackFrame.args[0].jsValue().put(stackFrame.callFrame, stackFrame.args[1].identifier(), stackFrame.args[2].jsValue(), slot);
@@ -1560,6 +1578,7 @@ DEFINE_STUB_FUNCTION(void, op_put_by_id_generic)
 DEFINE_STUB_FUNCTION(void, op_put_by_id_direct_generic)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
+    recordGenericByIdAccess(stackFrame.callFrame->codeBlock(), STUB_RETURN_ADDRESS);
     
     PutPropertySlot slot(stackFrame.callFrame->codeBlock()->isStrictMode());
     JSValue baseValue = stackFrame.args[0].jsValue();
@@ -1571,13 +1590,13 @@ DEFINE_STUB_FUNCTION(void, op_put_by_id_direct_generic)
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_generic)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
+    recordGenericByIdAccess(stackFrame.callFrame->codeBlock(), STUB_RETURN_ADDRESS);
 
     CallFrame* callFrame = stackFrame.callFrame;
     Identifier& ident = stackFrame.args[1].identifier();
 
     JSValue baseValue = stackFrame.args[0].jsValue();
-    PropertySlot slot(baseValue);
-    JSValue result = baseValue.get(callFrame, ident, slot);
+    JSValue result = callFrame->vm().megamorphicCache.get(callFrame, baseValue, ident);
 
     CHECK_FOR_EXCEPTION_AT_END();
     return JSValue::encode(result);
@@ -1592,6 +1611,7 @@ DEFINE_STUB_FUNCTION(void, op_put_by_id)
     CodeBlock* codeBlock = stackFrame.callFrame->codeBlock();
     StructureStubInfo* stubInfo = &codeBlock->getStubInfo(STUB_RETURN_ADDRESS);
     AccessType accessType = static_cast<AccessType>(stubInfo->accessType);
+    stubInfo->slowPathCount++;
 
     PutPropertySlot slot(callFrame->codeBlock()->isStrictMode());
     stackFrame.args[0].jsValue().put(callFrame, ident, stackFrame.args[2].jsValue(), slot);
@@ -1613,6 +1633,7 @@ DEFINE_STUB_FUNCTION(void, op_put_by_id_direct)
     CodeBlock* codeBlock = stackFrame.callFrame->codeBlock();
     StructureStubInfo* stubInfo = &codeBlock->getStubInfo(STUB_RETURN_ADDRESS);
     AccessType accessType = static_cast<AccessType>(stubInfo->accessType);
+    stubInfo->slowPathCount++;
 
     PutPropertySlot slot(callFrame->codeBlock()->isStrictMode());
     JSValue baseValue = stackFrame.args[0].jsValue();
@@ -1631,6 +1652,7 @@ DEFINE_STUB_FUNCTION(void, op_put_by_id_direct)
 DEFINE_STUB_FUNCTION(void, op_put_by_id_fail)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
+    recordGenericByIdAccess(stackFrame.callFrame->codeBlock(), STUB_RETURN_ADDRESS);
 
     CallFrame* callFrame = stackFrame.callFrame;
     Identifier& ident = stackFrame.args[1].identifier();
@@ -1644,6 +1666,7 @@ DEFINE_STUB_FUNCTION(void, op_put_by_id_fail)
 DEFINE_STUB_FUNCTION(void, op_put_by_id_direct_fail)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
+    recordGenericByIdAccess(stackFrame.callFrame->codeBlock(), STUB_RETURN_ADDRESS);
     
     CallFrame* callFrame = stackFrame.callFrame;
     Identifier& ident = stackFrame.args[1].identifier();
@@ -1686,6 +1709,7 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id)
     CodeBlock* codeBlock = stackFrame.callFrame->codeBlock();
     StructureStubInfo* stubInfo = &codeBlock->getStubInfo(STUB_RETURN_ADDRESS);
     AccessType accessType = static_cast<AccessType>(stubInfo->accessType);
+    stubInfo->slowPathCount++;
 
     JSValue baseValue = stackFrame.args[0].jsValue();
     PropertySlot slot(baseValue);
@@ -1713,6 +1737,7 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_self_fail)
     CodeBlock* codeBlock = callFrame->codeBlock();
     StructureStubInfo* stubInfo = &codeBlock->getStubInfo(STUB_RETURN_ADDRESS);
     AccessType accessType = static_cast<AccessType>(stubInfo->accessType);
+    stubInfo->slowPathCount++;
 
     JSValue baseValue = stackFrame.args[0].jsValue();
     PropertySlot slot(baseValue);
@@ -1723,6 +1748,8 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_self_fail)
 
     CHECK_FOR_EXCEPTION();
 
+    stubInfo->repatchCount++;
+
     if (baseValue.isCell()
         && slot.isCacheable()
         && !baseValue.asCell()->structure()->isUncacheableDictionary()
@@ -1817,6 +1844,19 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_custom_stub)
     return JSValue::encode(result);
 }
 
+DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_direct_custom_stub)
+{
+    STUB_INIT_STACK_FRAME(stackFrame);
+    CallFrame* callFrame = stackFrame.callFrame;
+    JSObject* slotBase = stackFrame.args[0].jsObject();
+    PropertySlot::DirectGetValueFunc getter = reinterpret_cast<PropertySlot::DirectGetValueFunc>(stackFrame.args[1].asPointer);
+    JSValue result = JSValue::decode(getter(callFrame, slotBase));
+    if (callFrame->hadException())
+        returnToThrowTrampoline(&callFrame->vm(), stackFrame.args[2].returnAddress(), STUB_RETURN_ADDRESS);
+
+    return JSValue::encode(result);
+}
+
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
@@ -1827,6 +1867,7 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list)
     CodeBlock* codeBlock = callFrame->codeBlock();
     StructureStubInfo* stubInfo = &codeBlock->getStubInfo(STUB_RETURN_ADDRESS);
     AccessType accessType = static_cast<AccessType>(stubInfo->accessType);
+    stubInfo->slowPathCount++;
 
     JSValue baseValue = stackFrame.args[0].jsValue();
     PropertySlot slot(baseValue);
@@ -1839,10 +1880,12 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list)
         || !slot.isCacheable()
         || baseValue.asCell()->structure()->isDictionary()
         || baseValue.asCell()->structure()->typeInfo().prohibitsPropertyCaching()) {
+        stubInfo->repatchCount++;
         ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_id_proto_fail));
         return JSValue::encode(result);
     }
 
+    stubInfo->repatchCount++;
     Structure* structure = baseValue.asCell()->structure();
 
     ASSERT(slot.slotBase().isObject());
@@ -1901,10 +1944,10 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list)
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list_full)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
+    recordGenericByIdAccess(stackFrame.callFrame->codeBlock(), STUB_RETURN_ADDRESS);
 
     JSValue baseValue = stackFrame.args[0].jsValue();
-    PropertySlot slot(baseValue);
-    JSValue result = baseValue.get(stackFrame.callFrame, stackFrame.args[1].identifier(), slot);
+    JSValue result = stackFrame.callFrame->vm().megamorphicCache.get(stackFrame.callFrame, baseValue, stackFrame.args[1].identifier());
 
     CHECK_FOR_EXCEPTION_AT_END();
     return JSValue::encode(result);
@@ -1913,6 +1956,7 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list_full)
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_fail)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
+    recordGenericByIdAccess(stackFrame.callFrame->codeBlock(), STUB_RETURN_ADDRESS);
 
     JSValue baseValue = stackFrame.args[0].jsValue();
     PropertySlot slot(baseValue);
@@ -1925,6 +1969,7 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_fail)
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_array_fail)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
+    recordGenericByIdAccess(stackFrame.callFrame->codeBlock(), STUB_RETURN_ADDRESS);
 
     JSValue baseValue = stackFrame.args[0].jsValue();
     PropertySlot slot(baseValue);
@@ -1937,6 +1982,7 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_array_fail)
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_string_fail)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
+    recordGenericByIdAccess(stackFrame.callFrame->codeBlock(), STUB_RETURN_ADDRESS);
 
     JSValue baseValue = stackFrame.args[0].jsValue();
     PropertySlot slot(baseValue);
@@ -3267,7 +3313,8 @@ DEFINE_STUB_FUNCTION(JSPropertyNameIterator*, op_get_pnames)
     JSObject* o = stackFrame.args[0].jsObject();
     Structure* structure = o->structure();
     JSPropertyNameIterator* jsPropertyNameIterator = structure->enumerationCache();
-    if (!jsPropertyNameIterator || jsPropertyNameIterator->cachedPrototypeChain() != structure->prototypeChain(callFrame))
+    if (!jsPropertyNameIterator || jsPropertyNameIterator->cachedPrototypeChain() != structure->prototypeChain(callFrame)
+        || !jsPropertyNameIterator->hasMatchingIndexedStorage(o))
         jsPropertyNameIterator = JSPropertyNameIterator::create(callFrame, o);
     return jsPropertyNameIterator;
 }
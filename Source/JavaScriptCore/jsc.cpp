@@ -28,6 +28,8 @@
 #include "Completion.h"
 #include "CopiedSpaceInlines.h"
 #include "ExceptionHelpers.h"
+#include "ExecutableAllocator.h"
+#include "HeapSnapshotBuilder.h"
 #include "HeapStatistics.h"
 #include "InitializeThreading.h"
 #include "Interpreter.h"
@@ -104,6 +106,7 @@ static EncodedJSValue JSC_HOST_CALL functionDebug(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionDescribe(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionJSCStack(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionGC(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionHeapSnapshot(ExecState*);
 #ifndef NDEBUG
 static EncodedJSValue JSC_HOST_CALL functionReleaseExecutableMemory(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionDumpCallFrame(ExecState*);
@@ -114,6 +117,7 @@ static EncodedJSValue JSC_HOST_CALL functionLoad(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionCheckSyntax(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionReadline(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionPreciseTime(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionRegExpJITFallbackCount(ExecState*);
 static NO_RETURN_WITH_VALUE EncodedJSValue JSC_HOST_CALL functionQuit(ExecState*);
 
 #if ENABLE(SAMPLING_FLAGS)
@@ -220,6 +224,7 @@ protected:
         addFunction(vm, "print", functionPrint, 1);
         addFunction(vm, "quit", functionQuit, 0);
         addFunction(vm, "gc", functionGC, 0);
+        addFunction(vm, "heapSnapshot", functionHeapSnapshot, 1);
 #ifndef NDEBUG
         addFunction(vm, "dumpCallFrame", functionDumpCallFrame, 0);
         addFunction(vm, "releaseExecutableMemory", functionReleaseExecutableMemory, 0);
@@ -231,6 +236,7 @@ protected:
         addFunction(vm, "jscStack", functionJSCStack, 1);
         addFunction(vm, "readline", functionReadline, 0);
         addFunction(vm, "preciseTime", functionPreciseTime, 0);
+        addFunction(vm, "regExpJITFallbackCount", functionRegExpJITFallbackCount, 0);
 #if ENABLE(SAMPLING_FLAGS)
         addFunction(vm, "setSamplingFlags", functionSetSamplingFlags, 1);
         addFunction(vm, "clearSamplingFlags", functionClearSamplingFlags, 1);
@@ -360,6 +366,31 @@ EncodedJSValue JSC_HOST_CALL functionGC(ExecState* exec)
     return JSValue::encode(jsUndefined());
 }
 
+// Writes a snapshot of the object graph to the given file, and returns the
+// number of live bytes that it accounts for. Without a file name, returns the
+// snapshot's JSON instead.
+EncodedJSValue JSC_HOST_CALL functionHeapSnapshot(ExecState* exec)
+{
+    if (!exec->argumentCount()) {
+        JSLockHolder lock(exec);
+        HeapSnapshotBuilder builder(*exec->heap());
+        builder.buildSnapshot();
+        return JSValue::encode(jsString(exec, builder.json()));
+    }
+
+    String fileName = exec->argument(0).toString(exec)->value(exec);
+    if (exec->hadException())
+        return JSValue::encode(jsUndefined());
+
+    JSLockHolder lock(exec);
+    HeapSnapshotBuilder builder(*exec->heap());
+    builder.buildSnapshot();
+    if (!builder.writeJSON(fileName.utf8().data()))
+        return JSValue::encode(throwError(exec, createError(exec, "Could not open file.")));
+
+    return JSValue::encode(jsNumber(static_cast<double>(builder.nodes()[HeapSnapshotBuilder::rootNodeIndex].retainedSize)));
+}
+
 #ifndef NDEBUG
 EncodedJSValue JSC_HOST_CALL functionReleaseExecutableMemory(ExecState* exec)
 {
@@ -477,6 +508,11 @@ EncodedJSValue JSC_HOST_CALL functionPreciseTime(ExecState*)
     return JSValue::encode(jsNumber(currentTime()));
 }
 
+EncodedJSValue JSC_HOST_CALL functionRegExpJITFallbackCount(ExecState* exec)
+{
+    return JSValue::encode(jsNumber(exec->vm().m_regExpJITFallbackCount));
+}
+
 EncodedJSValue JSC_HOST_CALL functionQuit(ExecState*)
 {
     exit(EXIT_SUCCESS);
@@ -559,6 +595,10 @@ int main(int argc, char** argv)
     EXCEPT(res = 3)
     if (Options::logHeapStatisticsAtExit())
         HeapStatistics::reportSuccess();
+#if ENABLE(ASSEMBLER)
+    if (Options::logExecutableMemoryStatisticsAtExit())
+        ExecutableAllocator::dumpStatistics();
+#endif
 
 #if PLATFORM(EFL)
     ecore_shutdown();
@@ -701,6 +741,9 @@ static NO_RETURN void printUsageStatement(bool help = false)
     fprintf(stderr, "  -s         Installs signal handlers that exit on a crash (Unix platforms only)\n");
 #endif
     fprintf(stderr, "  -p <file>  Outputs profiling data to a file\n");
+#if ENABLE(SAMPLING_PROFILER)
+    fprintf(stderr, "  -S <file>  Samples the running script and outputs folded stacks to a file\n");
+#endif
     fprintf(stderr, "  -x         Output exit code before terminating\n");
     fprintf(stderr, "\n");
     fprintf(stderr, "  --options                  Dumps all JSC VM options and exits\n");
@@ -746,6 +789,16 @@ void CommandLine::parseArguments(int argc, char** argv)
             m_profilerOutput = argv[i];
             continue;
         }
+#if ENABLE(SAMPLING_PROFILER)
+        if (!strcmp(arg, "-S")) {
+            if (++i == argc)
+                printUsageStatement();
+            // The VM starts the sampling profiler, and saves its output at exit.
+            Options::useSamplingProfiler() = true;
+            Options::samplingProfilerOutputFile() = argv[i];
+            continue;
+        }
+#endif
         if (!strcmp(arg, "-s")) {
 #if HAVE(SIGNAL_H)
             signal(SIGILL, _exit);
@@ -827,6 +880,9 @@ int jscmain(int argc, char** argv)
             fprintf(stderr, "could not save profiler output.\n");
     }
 
+    if (Options::recordInlineCacheStatistics())
+        vm->m_perBytecodeProfiler->dumpInlineCaches(WTF::dataFile());
+
     return result;
 }
 
@@ -111,6 +111,11 @@ void Data::performAssertions(VM& vm)
     ASSERT(GlobalCode == 0);
     ASSERT(EvalCode == 1);
     ASSERT(FunctionCode == 2);
+#if ENABLE(GGC)
+    ASSERT(MarkedBlock::blockSize == 0x10000);
+    ASSERT(MarkedBlock::cardShift == 9);
+    ASSERT(MarkedBlock::cardMask == 127);
+#endif
     
     // FIXME: make these assertions less horrible.
 #if !ASSERT_DISABLED
@@ -121,6 +126,13 @@ void Data::performAssertions(VM& vm)
 #endif
 
     ASSERT(StringImpl::s_hashFlag8BitBuffer == 64);
+
+#if ENABLE(LLINT_C_LOOP)
+#define ASSERT_SUPERINSTRUCTION_LENGTH(opcode, firstOpcode, secondOpcode) \
+    ASSERT(opcodeLengths[opcode] == opcodeLengths[firstOpcode]);
+    FOR_EACH_LLINT_SUPERINSTRUCTION(ASSERT_SUPERINSTRUCTION_LENGTH)
+#undef ASSERT_SUPERINSTRUCTION_LENGTH
+#endif
 }
 #if COMPILER(CLANG)
 #pragma clang diagnostic pop
@@ -87,6 +87,35 @@ ALWAYS_INLINE void* getCodePtr(OpcodeID id)
     return reinterpret_cast<void*>(getOpcode(id));
 }
 
+#if ENABLE(LLINT_C_LOOP)
+inline bool superinstructionFor(OpcodeID first, OpcodeID second, OpcodeID& superinstruction)
+{
+#define SUPERINSTRUCTION_FOR(opcode, firstOpcode, secondOpcode) \
+    if (first == firstOpcode && second == secondOpcode) { \
+        superinstruction = opcode; \
+        return true; \
+    }
+    FOR_EACH_LLINT_SUPERINSTRUCTION(SUPERINSTRUCTION_FOR)
+#undef SUPERINSTRUCTION_FOR
+    return false;
+}
+
+// A superinstruction shares its operands with its first component, so anything
+// that decodes instructions can treat it as that opcode.
+inline OpcodeID firstComponentOf(OpcodeID opcodeID)
+{
+    switch (opcodeID) {
+#define FIRST_COMPONENT_OF(opcode, firstOpcode, secondOpcode) \
+    case opcode: \
+        return firstOpcode;
+    FOR_EACH_LLINT_SUPERINSTRUCTION(FIRST_COMPONENT_OF)
+#undef FIRST_COMPONENT_OF
+    default:
+        return opcodeID;
+    }
+}
+#endif // ENABLE(LLINT_C_LOOP)
+
 #else // !ENABLE(LLINT)
 
 #if COMPILER(CLANG)
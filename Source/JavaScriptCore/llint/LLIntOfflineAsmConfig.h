@@ -140,6 +140,12 @@
 #define OFFLINE_ASM_VALUE_PROFILER 0
 #endif
 
+#if ENABLE(GGC)
+#define OFFLINE_ASM_GGC 1
+#else
+#define OFFLINE_ASM_GGC 0
+#endif
+
 #if CPU(MIPS)
 #ifdef WTF_MIPS_PIC
 #define S(x) #x
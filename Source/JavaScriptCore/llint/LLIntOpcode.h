@@ -32,9 +32,22 @@
 
 #if ENABLE(LLINT_C_LOOP)
 
+// Superinstructions replace the opcode of the first of two instructions that
+// commonly follow each other, and then fall straight into the handler of the
+// second one instead of dispatching to it. The second instruction is left in
+// place, so a superinstruction has the length of its first component, and
+// neither component may be one that the LLInt rewrites for inline caching.
+#define FOR_EACH_LLINT_SUPERINSTRUCTION(macro) \
+    macro(op_inc_jless, op_inc, op_jless) \
+    macro(op_dec_jgreater, op_dec, op_jgreater)
+
 #define FOR_EACH_LLINT_NOJIT_NATIVE_HELPER(macro) \
     macro(getHostCallReturnValue, 1) \
-    macro(ctiOpThrowNotCaught, 1)
+    macro(ctiOpThrowNotCaught, 1) \
+    \
+    /* Superinstructions; the lengths must match their first components. */ \
+    macro(op_inc_jless, 2) \
+    macro(op_dec_jgreater, 2)
 
 #else // !ENABLE(LLINT_C_LOOP)
 
@@ -487,8 +487,7 @@ LLINT_SLOW_PATH_DECL(slow_path_create_this)
 #endif
 
     size_t inlineCapacity = pc[3].u.operand;
-    Structure* structure = constructor->allocationProfile(exec, inlineCapacity)->structure();
-    LLINT_RETURN(constructEmptyObject(exec, structure));
+    LLINT_RETURN(constructor->allocationProfile(exec, inlineCapacity)->allocate(exec));
 }
 
 LLINT_SLOW_PATH_DECL(slow_path_convert_this)
@@ -1534,7 +1533,8 @@ LLINT_SLOW_PATH_DECL(slow_path_get_pnames)
     JSObject* o = v.toObject(exec);
     Structure* structure = o->structure();
     JSPropertyNameIterator* jsPropertyNameIterator = structure->enumerationCache();
-    if (!jsPropertyNameIterator || jsPropertyNameIterator->cachedPrototypeChain() != structure->prototypeChain(exec))
+    if (!jsPropertyNameIterator || jsPropertyNameIterator->cachedPrototypeChain() != structure->prototypeChain(exec)
+        || !jsPropertyNameIterator->hasMatchingIndexedStorage(o))
         jsPropertyNameIterator = JSPropertyNameIterator::create(exec, o);
     
     LLINT_OP(1) = JSValue(jsPropertyNameIterator);
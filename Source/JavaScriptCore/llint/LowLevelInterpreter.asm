@@ -161,6 +161,11 @@ else
     const VectorSizeOffset = 8
 end
 
+# This must match heap/MarkedBlock.h
+const MarkedBlockMask = ~0xffff
+const MarkedBlockCardShift = 9
+const MarkedBlockCardMask = 127
+
 
 # Some common utilities.
 macro crash()
@@ -207,6 +212,19 @@ macro restoreReturnAddressBeforeReturn(sourceRegister)
     end
 end
 
+# Marks the card covering owner so that the next eden collection rescans it.
+macro writeBarrier(owner, scratch1, scratch2)
+    if GGC
+        move owner, scratch1
+        andp MarkedBlockMask, scratch1
+        move owner, scratch2
+        urshiftp MarkedBlockCardShift, scratch2
+        andp MarkedBlockCardMask, scratch2
+        addp scratch2, scratch1
+        storeb 1, MarkedBlock::m_cards[scratch1]
+    end
+end
+
 macro traceExecution()
     if EXECUTION_TRACING
         callSlowPath(_llint_trace)
@@ -546,6 +564,7 @@ end
 macro putToBaseVariableBody(variableOffset, scratch1, scratch2, scratch3)
     loadisFromInstruction(1, scratch1)
     loadp PayloadOffset[cfr, scratch1, 8], scratch1
+    writeBarrier(scratch1, scratch2, scratch3)
     loadp JSVariableObject::m_registers[scratch1], scratch1
     loadisFromInstruction(3, scratch2)
     if JSVALUE64
@@ -1266,6 +1285,25 @@ _llint_op_put_by_id_transition:
 _llint_op_init_global_const_nop:
     dispatch(5)
 
+# Superinstructions (see FOR_EACH_LLINT_SUPERINSTRUCTION in LLIntOpcode.h).
+# The second instruction of each pair is still in the instruction stream, so
+# after running the first one we advance to it and jump straight into its
+# handler rather than doing an indirect dispatch. The slow paths dispatch
+# normally, since they may have redirected the PC to throw.
+if C_LOOP
+_llint_op_inc_jless:
+    preOpWithFastDispatch(
+        macro (value, slow) baddio 1, value, slow end,
+        _llint_slow_path_pre_inc,
+        macro () dispatchTo(2, _llint_op_jless) end)
+
+_llint_op_dec_jgreater:
+    preOpWithFastDispatch(
+        macro (value, slow) bsubio 1, value, slow end,
+        _llint_slow_path_pre_dec,
+        macro () dispatchTo(2, _llint_op_jgreater) end)
+end
+
 # Indicate the end of LLInt.
 _llint_end:
     crash()
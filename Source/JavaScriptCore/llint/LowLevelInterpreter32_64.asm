@@ -88,6 +88,11 @@ macro dispatch(advance)
     jmp [PC]
 end
 
+macro dispatchTo(advance, handler)
+    addp advance * 4, PC
+    jmp handler
+end
+
 macro dispatchBranchWithOffset(pcOffset)
     lshifti 2, pcOffset
     addp pcOffset, PC
@@ -289,10 +294,6 @@ macro loadConstantOrVariablePayloadUnchecked(index, payload)
         payload)
 end
 
-macro writeBarrier(tag, payload)
-    # Nothing to do, since we don't have a generational or incremental collector.
-end
-
 macro valueProfile(tag, payload, profile)
     if VALUE_PROFILER
         storei tag, ValueProfile::m_buckets + TagOffset[profile]
@@ -580,32 +581,34 @@ _llint_op_nstricteq:
     strictEq(macro (left, right, result) cineq left, right, result end, _llint_slow_path_nstricteq)
 
 
-_llint_op_inc:
+macro preOpWithFastDispatch(arithmeticOperation, slowPath, fastDispatch)
     traceExecution()
     loadi 4[PC], t0
-    bineq TagOffset[cfr, t0, 8], Int32Tag, .opIncSlow
+    bineq TagOffset[cfr, t0, 8], Int32Tag, .slow
     loadi PayloadOffset[cfr, t0, 8], t1
-    baddio 1, t1, .opIncSlow
+    arithmeticOperation(t1, .slow)
     storei t1, PayloadOffset[cfr, t0, 8]
-    dispatch(2)
+    fastDispatch()
 
-.opIncSlow:
-    callSlowPath(_llint_slow_path_pre_inc)
+.slow:
+    callSlowPath(slowPath)
     dispatch(2)
+end
 
+macro preOp(arithmeticOperation, slowPath)
+    preOpWithFastDispatch(arithmeticOperation, slowPath, macro () dispatch(2) end)
+end
 
-_llint_op_dec:
-    traceExecution()
-    loadi 4[PC], t0
-    bineq TagOffset[cfr, t0, 8], Int32Tag, .opDecSlow
-    loadi PayloadOffset[cfr, t0, 8], t1
-    bsubio 1, t1, .opDecSlow
-    storei t1, PayloadOffset[cfr, t0, 8]
-    dispatch(2)
+_llint_op_inc:
+    preOp(
+        macro (value, slow) baddio 1, value, slow end,
+        _llint_slow_path_pre_inc)
 
-.opDecSlow:
-    callSlowPath(_llint_slow_path_pre_dec)
-    dispatch(2)
+
+_llint_op_dec:
+    preOp(
+        macro (value, slow) bsubio 1, value, slow end,
+        _llint_slow_path_pre_dec)
 
 
 _llint_op_to_number:
@@ -969,10 +972,12 @@ end
 
 _llint_op_init_global_const:
     traceExecution()
+    loadp CodeBlock[cfr], t0
+    loadp CodeBlock::m_globalObject[t0], t0
+    writeBarrier(t0, t1, t2)
     loadi 8[PC], t1
     loadi 4[PC], t0
     loadConstantOrVariable(t1, t2, t3)
-    writeBarrier(t2, t3)
     storei t2, TagOffset[t0]
     storei t3, PayloadOffset[t0]
     dispatch(5)
@@ -981,11 +986,13 @@ _llint_op_init_global_const:
 _llint_op_init_global_const_check:
     traceExecution()
     loadp 12[PC], t2
+    btbnz [t2], .opInitGlobalConstCheckSlow
+    loadp CodeBlock[cfr], t0
+    loadp CodeBlock::m_globalObject[t0], t0
+    writeBarrier(t0, t1, t2)
     loadi 8[PC], t1
     loadi 4[PC], t0
-    btbnz [t2], .opInitGlobalConstCheckSlow
     loadConstantOrVariable(t1, t2, t3)
-    writeBarrier(t2, t3)
     storei t2, TagOffset[t0]
     storei t3, PayloadOffset[t0]
     dispatch(5)
@@ -1078,6 +1085,7 @@ macro putById(getPropertyStorage)
     loadi 4[PC], t3
     loadi 16[PC], t1
     loadConstantOrVariablePayload(t3, CellTag, t0, .opPutByIdSlow)
+    writeBarrier(t0, t2, t3)
     loadi 12[PC], t2
     getPropertyStorage(
         t0,
@@ -1086,7 +1094,6 @@ macro putById(getPropertyStorage)
             bpneq JSCell::m_structure[t0], t1, .opPutByIdSlow
             loadi 20[PC], t1
             loadConstantOrVariable2Reg(t2, scratch, t2)
-            writeBarrier(scratch, t2)
             storei scratch, TagOffset[propertyStorage, t1]
             storei t2, PayloadOffset[propertyStorage, t1]
             dispatch(9)
@@ -1110,6 +1117,7 @@ macro putByIdTransition(additionalChecks, getPropertyStorage)
     loadi 4[PC], t3
     loadi 16[PC], t1
     loadConstantOrVariablePayload(t3, CellTag, t0, .opPutByIdSlow)
+    writeBarrier(t0, t2, t3)
     loadi 12[PC], t2
     bpneq JSCell::m_structure[t0], t1, .opPutByIdSlow
     additionalChecks(t1, t3)
@@ -1120,7 +1128,6 @@ macro putByIdTransition(additionalChecks, getPropertyStorage)
         macro (propertyStorage, scratch)
             addp t1, propertyStorage, t3
             loadConstantOrVariable2Reg(t2, t1, t2)
-            writeBarrier(t1, t2)
             storei t1, TagOffset[t3]
             loadi 24[PC], t1
             storei t2, PayloadOffset[t3]
@@ -1301,6 +1308,7 @@ _llint_op_put_by_val:
     traceExecution()
     loadi 4[PC], t0
     loadConstantOrVariablePayload(t0, CellTag, t1, .opPutByValSlow)
+    writeBarrier(t1, t2, t3)
     loadp JSCell::m_structure[t1], t2
     loadp 16[PC], t3
     arrayProfile(t2, t3, t0)
@@ -1340,7 +1348,6 @@ _llint_op_put_by_val:
             const tag = scratch
             const payload = operand
             loadConstantOrVariable2Reg(operand, tag, payload)
-            writeBarrier(tag, payload)
             storei tag, TagOffset[base, index, 8]
             storei payload, PayloadOffset[base, index, 8]
         end)
@@ -1352,7 +1359,6 @@ _llint_op_put_by_val:
 .opPutByValArrayStorageStoreResult:
     loadi 12[PC], t2
     loadConstantOrVariable2Reg(t2, t1, t2)
-    writeBarrier(t1, t2)
     storei t1, ArrayStorage::m_vector + TagOffset[t0, t3, 8]
     storei t2, ArrayStorage::m_vector + PayloadOffset[t0, t3, 8]
     dispatch(5)
@@ -1702,6 +1708,7 @@ _llint_op_next_pname:
     loadi PayloadOffset[cfr, t3, 8], t3
     loadp JSCell::m_structure[t3], t1
     bpneq t1, JSPropertyNameIterator::m_cachedStructure[t2], .opNextPnameSlow
+    bibeq t0, JSPropertyNameIterator::m_cachedIndexedLength[t2], .opNextPnameSlow
     loadp JSPropertyNameIterator::m_cachedPrototypeChain[t2], t0
     loadp StructureChain::m_vector[t0], t0
     btpz [t0], .opNextPnameTarget
@@ -1800,10 +1807,10 @@ _llint_op_get_scoped_var:
 _llint_op_put_scoped_var:
     traceExecution()
     getDeBruijnScope(8[PC], macro (scope, scratch) end)
+    writeBarrier(t0, t1, t2)
     loadi 12[PC], t1
     loadConstantOrVariable(t1, t3, t2)
     loadi 4[PC], t1
-    writeBarrier(t3, t2)
     loadp JSVariableObject::m_registers[t0], t0
     storei t3, TagOffset[t0, t1, 8]
     storei t2, PayloadOffset[t0, t1, 8]
@@ -51,6 +51,11 @@ macro dispatchIntIndirect(offset)
     dispatchInt(offset * 8[PB, PC, 8])
 end
 
+macro dispatchTo(advance, handler)
+    addp advance, PC
+    jmp handler
+end
+
 macro dispatchAfterCall()
     loadi ArgumentCount + TagOffset[cfr], PC
     loadp CodeBlock[cfr], PB
@@ -175,10 +180,6 @@ macro loadConstantOrVariableCell(index, value, slow)
     btqnz value, tagMask, slow
 end
 
-macro writeBarrier(value)
-    # Nothing to do, since we don't have a generational or incremental collector.
-end
-
 macro valueProfile(value, profile)
     if VALUE_PROFILER
         storeq value, ValueProfile::m_buckets[profile]
@@ -436,7 +437,7 @@ _llint_op_nstricteq:
         _llint_slow_path_nstricteq)
 
 
-macro preOp(arithmeticOperation, slowPath)
+macro preOpWithFastDispatch(arithmeticOperation, slowPath, fastDispatch)
     traceExecution()
     loadisFromInstruction(1, t0)
     loadq [cfr, t0, 8], t1
@@ -444,13 +445,17 @@ macro preOp(arithmeticOperation, slowPath)
     arithmeticOperation(t1, .slow)
     orq tagTypeNumber, t1
     storeq t1, [cfr, t0, 8]
-    dispatch(2)
+    fastDispatch()
 
 .slow:
     callSlowPath(slowPath)
     dispatch(2)
 end
 
+macro preOp(arithmeticOperation, slowPath)
+    preOpWithFastDispatch(arithmeticOperation, slowPath, macro () dispatch(2) end)
+end
+
 _llint_op_inc:
     preOp(
         macro (value, slow) baddio 1, value, slow end,
@@ -815,10 +820,12 @@ end
 
 _llint_op_init_global_const:
     traceExecution()
+    loadp CodeBlock[cfr], t0
+    loadp CodeBlock::m_globalObject[t0], t0
+    writeBarrier(t0, t1, t2)
     loadisFromInstruction(2, t1)
     loadpFromInstruction(1, t0)
     loadConstantOrVariable(t1, t2)
-    writeBarrier(t2)
     storeq t2, [t0]
     dispatch(5)
 
@@ -826,11 +833,13 @@ _llint_op_init_global_const:
 _llint_op_init_global_const_check:
     traceExecution()
     loadpFromInstruction(3, t2)
+    btbnz [t2], .opInitGlobalConstCheckSlow
+    loadp CodeBlock[cfr], t0
+    loadp CodeBlock::m_globalObject[t0], t0
+    writeBarrier(t0, t1, t2)
     loadisFromInstruction(2, t1)
     loadpFromInstruction(1, t0)
-    btbnz [t2], .opInitGlobalConstCheckSlow
     loadConstantOrVariable(t1, t2)
-    writeBarrier(t2)
     storeq t2, [t0]
     dispatch(5)
 .opInitGlobalConstCheckSlow:
@@ -919,6 +928,7 @@ macro putById(getPropertyStorage)
     loadisFromInstruction(1, t3)
     loadpFromInstruction(4, t1)
     loadConstantOrVariableCell(t3, t0, .opPutByIdSlow)
+    writeBarrier(t0, t2, t3)
     loadisFromInstruction(3, t2)
     getPropertyStorage(
         t0,
@@ -927,7 +937,6 @@ macro putById(getPropertyStorage)
             bpneq JSCell::m_structure[t0], t1, .opPutByIdSlow
             loadisFromInstruction(5, t1)
             loadConstantOrVariable(t2, scratch)
-            writeBarrier(t0)
             storeq scratch, [propertyStorage, t1]
             dispatch(9)
         end)
@@ -950,6 +959,7 @@ macro putByIdTransition(additionalChecks, getPropertyStorage)
     loadisFromInstruction(1, t3)
     loadpFromInstruction(4, t1)
     loadConstantOrVariableCell(t3, t0, .opPutByIdSlow)
+    writeBarrier(t0, t2, t3)
     loadisFromInstruction(3, t2)
     bpneq JSCell::m_structure[t0], t1, .opPutByIdSlow
     additionalChecks(t1, t3)
@@ -960,7 +970,6 @@ macro putByIdTransition(additionalChecks, getPropertyStorage)
         macro (propertyStorage, scratch)
             addp t1, propertyStorage, t3
             loadConstantOrVariable(t2, t1)
-            writeBarrier(t1)
             storeq t1, [t3]
             loadpFromInstruction(6, t1)
             storep t1, JSCell::m_structure[t0]
@@ -1138,6 +1147,7 @@ _llint_op_put_by_val:
     traceExecution()
     loadisFromInstruction(1, t0)
     loadConstantOrVariableCell(t0, t1, .opPutByValSlow)
+    writeBarrier(t1, t2, t3)
     loadp JSCell::m_structure[t1], t2
     loadpFromInstruction(4, t3)
     arrayProfile(t2, t3, t0)
@@ -1175,7 +1185,6 @@ _llint_op_put_by_val:
     contiguousPutByVal(
         macro (operand, scratch, address)
             loadConstantOrVariable(operand, scratch)
-            writeBarrier(scratch)
             storep scratch, address
         end)
 
@@ -1186,7 +1195,6 @@ _llint_op_put_by_val:
 .opPutByValArrayStorageStoreResult:
     loadisFromInstruction(3, t2)
     loadConstantOrVariable(t2, t1)
-    writeBarrier(t1)
     storeq t1, ArrayStorage::m_vector[t0, t3, 8]
     dispatch(5)
 
@@ -1538,6 +1546,7 @@ _llint_op_next_pname:
     loadq [cfr, t3, 8], t3
     loadp JSCell::m_structure[t3], t1
     bpneq t1, JSPropertyNameIterator::m_cachedStructure[t2], .opNextPnameSlow
+    bibeq t0, JSPropertyNameIterator::m_cachedIndexedLength[t2], .opNextPnameSlow
     loadp JSPropertyNameIterator::m_cachedPrototypeChain[t2], t0
     loadp StructureChain::m_vector[t0], t0
     btpz [t0], .opNextPnameTarget
@@ -1659,10 +1668,10 @@ _llint_op_get_scoped_var:
 _llint_op_put_scoped_var:
     traceExecution()
     getDeBruijnScope(16[PB, PC, 8], macro (scope, scratch) end)
+    writeBarrier(t0, t1, t2)
     loadis 24[PB, PC, 8], t1
     loadConstantOrVariable(t1, t3)
     loadis 8[PB, PC, 8], t1
-    writeBarrier(t3)
     loadp JSVariableObject::m_registers[t0], t0
     storep t3, [t0, t1, 8]
     dispatch(4)
@@ -164,6 +164,13 @@ PassRefPtr<FunctionParameters> FunctionParameters::create(ParameterNode* firstPa
     return adoptRef(new (slot) FunctionParameters(firstParameter, parameterCount));
 }
 
+PassRefPtr<FunctionParameters> FunctionParameters::create(const Vector<Identifier>& parameters)
+{
+    size_t objectSize = sizeof(FunctionParameters) - sizeof(void*) + sizeof(StringImpl*) * parameters.size();
+    void* slot = fastMalloc(objectSize);
+    return adoptRef(new (slot) FunctionParameters(parameters));
+}
+
 FunctionParameters::FunctionParameters(ParameterNode* firstParameter, unsigned size)
     : m_size(size)
 {
@@ -172,6 +179,13 @@ FunctionParameters::FunctionParameters(ParameterNode* firstParameter, unsigned s
         new (&identifiers()[i++]) Identifier(parameter->ident());
 }
 
+FunctionParameters::FunctionParameters(const Vector<Identifier>& parameters)
+    : m_size(parameters.size())
+{
+    for (unsigned i = 0; i < m_size; ++i)
+        new (&identifiers()[i]) Identifier(parameters[i]);
+}
+
 FunctionParameters::~FunctionParameters()
 {
     for (unsigned i = 0; i < m_size; ++i)
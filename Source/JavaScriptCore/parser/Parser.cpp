@@ -914,8 +914,10 @@ template <FunctionRequirements requirements, bool nameIsInContainingScope, class
     failIfFalse(popScope(functionScope, TreeBuilder::NeedsFreeVariableInfo));
     matchOrFail(CLOSEBRACE);
     
-    if (newInfo)
-        m_functionCache->add(openBraceOffset, newInfo.release());
+    if (newInfo) {
+        if (unsigned byteSize = m_functionCache->add(openBraceOffset, newInfo.release()))
+            m_source->provider()->notifyCacheSizeChanged(byteSize);
+    }
     
     next();
     return true;
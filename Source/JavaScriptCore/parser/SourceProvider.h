@@ -36,6 +36,8 @@
 
 namespace JSC {
 
+    class SourceProviderCache;
+
     class SourceProvider : public RefCounted<SourceProvider> {
     public:
         static const intptr_t nullID = 1;
@@ -65,6 +67,13 @@ namespace JSC {
         bool isValid() const { return m_validated; }
         void setValid() { m_validated = true; }
 
+        // Providers whose source is kept around by the embedder, for instance in a memory
+        // cache, can return a parser cache that outlives them. Every provider of the same
+        // source then shares the function skip information, and the VM does not throw it
+        // away at each collection. Such caches must only be used from one thread.
+        virtual SourceProviderCache* cache() const { return 0; }
+        virtual void notifyCacheSizeChanged(int delta) { UNUSED_PARAM(delta); }
+
     private:
 
         JS_EXPORT_PRIVATE void getID();
@@ -36,11 +36,16 @@ SourceProviderCache::~SourceProviderCache()
 void SourceProviderCache::clear()
 {
     m_map.clear();
+    m_contentByteSize = 0;
 }
 
-void SourceProviderCache::add(int sourcePosition, PassOwnPtr<SourceProviderCacheItem> item)
+unsigned SourceProviderCache::add(int sourcePosition, PassOwnPtr<SourceProviderCacheItem> item)
 {
-    m_map.add(sourcePosition, item);
+    unsigned byteSize = item->approximateByteSize();
+    if (!m_map.add(sourcePosition, item).isNewEntry)
+        return 0;
+    m_contentByteSize += byteSize;
+    return byteSize;
 }
 
 }
@@ -37,15 +37,22 @@ namespace JSC {
 class SourceProviderCache : public RefCounted<SourceProviderCache> {
     WTF_MAKE_FAST_ALLOCATED;
 public:
-    SourceProviderCache() { }
+    SourceProviderCache()
+        : m_contentByteSize(0)
+    {
+    }
     JS_EXPORT_PRIVATE ~SourceProviderCache();
 
     JS_EXPORT_PRIVATE void clear();
-    void add(int sourcePosition, PassOwnPtr<SourceProviderCacheItem>);
+    // Returns the number of bytes the cache grew by.
+    unsigned add(int sourcePosition, PassOwnPtr<SourceProviderCacheItem>);
     const SourceProviderCacheItem* get(int sourcePosition) const { return m_map.get(sourcePosition); }
 
+    unsigned byteSize() const { return m_contentByteSize + sizeof(*this); }
+
 private:
     HashMap<int, OwnPtr<SourceProviderCacheItem> > m_map;
+    unsigned m_contentByteSize;
 };
 
 }
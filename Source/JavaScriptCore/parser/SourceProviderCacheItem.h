@@ -83,6 +83,11 @@ public:
     unsigned usedVariablesCount;
     unsigned writtenVariablesCount;
 
+    unsigned approximateByteSize() const
+    {
+        return sizeof(*this) + sizeof(StringImpl*) * (usedVariablesCount + writtenVariablesCount);
+    }
+
     StringImpl** usedVariables() const { return const_cast<StringImpl**>(m_variables); }
     StringImpl** writtenVariables() const { return const_cast<StringImpl**>(&m_variables[usedVariablesCount]); }
 
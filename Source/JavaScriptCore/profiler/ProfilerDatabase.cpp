@@ -77,6 +77,55 @@ Bytecodes* Database::ensureBytecodesFor(CodeBlock* codeBlock)
 void Database::notifyDestruction(CodeBlock* codeBlock)
 {
     m_bytecodesMap.remove(codeBlock);
+    
+#if ENABLE(JIT)
+    HashMap<CodeBlock*, Vector<InlineCache*> >::iterator iter = m_liveInlineCaches.find(codeBlock);
+    if (iter == m_liveInlineCaches.end())
+        return;
+    for (unsigned i = 0; i < iter->value.size(); ++i)
+        iter->value[i]->retire(codeBlock->structureStubInfo(i));
+    m_liveInlineCaches.remove(iter);
+#endif
+}
+
+void Database::addInlineCaches(CodeBlock* codeBlock, CompilationKind kind)
+{
+#if ENABLE(JIT)
+    Vector<InlineCache*> caches;
+    for (unsigned i = 0; i < codeBlock->numberOfStructureStubInfos(); ++i) {
+        StructureStubInfo& stubInfo = codeBlock->structureStubInfo(i);
+        OriginStack origin;
+#if ENABLE(DFG_JIT)
+        if (kind == DFG)
+            origin = OriginStack(*this, codeBlock, stubInfo.codeOrigin);
+        else
+#endif
+            origin = OriginStack(Origin(*this, codeBlock, stubInfo.bytecodeIndex));
+        
+        HashMap<OriginStack, InlineCache*>::AddResult result = m_inlineCacheMap.add(origin, 0);
+        if (result.isNewEntry) {
+            m_inlineCaches.append(InlineCache(m_inlineCaches.size(), origin));
+            result.iterator->value = &m_inlineCaches.last();
+        }
+        caches.append(result.iterator->value);
+    }
+    
+    HashMap<CodeBlock*, Vector<InlineCache*> >::AddResult result = m_liveInlineCaches.add(codeBlock, caches);
+    if (!result.isNewEntry) {
+        // The code block was linked again. Its stubs still hold what they counted under the
+        // previous linking, so bank that with the caches it was counted for, and start over.
+        Vector<InlineCache*>& previousCaches = result.iterator->value;
+        for (unsigned i = 0; i < previousCaches.size() && i < codeBlock->numberOfStructureStubInfos(); ++i) {
+            StructureStubInfo& stubInfo = codeBlock->structureStubInfo(i);
+            previousCaches[i]->retire(stubInfo);
+            stubInfo.clearStatistics();
+        }
+        previousCaches.swap(caches);
+    }
+#else
+    UNUSED_PARAM(codeBlock);
+    UNUSED_PARAM(kind);
+#endif
 }
 
 PassRefPtr<Compilation> Database::newCompilation(Bytecodes* bytecodes, CompilationKind kind)
@@ -105,9 +154,84 @@ JSValue Database::toJS(ExecState* exec) const
         compilations->putDirectIndex(exec, i, m_compilations[i]->toJS(exec));
     result->putDirect(exec->vm(), exec->propertyNames().compilations, compilations);
     
+    if (!m_inlineCaches.isEmpty())
+        result->putDirect(exec->vm(), exec->propertyNames().inlineCaches, inlineCachesToJS(exec));
+    
+    return result;
+}
+
+namespace {
+
+struct HotterInlineCache {
+    HotterInlineCache(const Vector<InlineCache::Sample>& samples)
+        : m_samples(samples)
+    {
+    }
+    
+    bool operator()(unsigned a, unsigned b) const
+    {
+        if (m_samples[a].slowPathCount != m_samples[b].slowPathCount)
+            return m_samples[a].slowPathCount > m_samples[b].slowPathCount;
+        return a < b;
+    }
+    
+    const Vector<InlineCache::Sample>& m_samples;
+};
+
+} // anonymous namespace
+
+void Database::sampleInlineCaches(Vector<InlineCache::Sample>& samples, Vector<unsigned>& order) const
+{
+    samples.resize(m_inlineCaches.size());
+    order.resize(m_inlineCaches.size());
+    for (unsigned i = 0; i < m_inlineCaches.size(); ++i) {
+        samples[i] = m_inlineCaches[i].retiredSample();
+        order[i] = i;
+    }
+    
+#if ENABLE(JIT)
+    HashMap<CodeBlock*, Vector<InlineCache*> >::const_iterator end = m_liveInlineCaches.end();
+    for (HashMap<CodeBlock*, Vector<InlineCache*> >::const_iterator iter = m_liveInlineCaches.begin(); iter != end; ++iter) {
+        for (unsigned i = 0; i < iter->value.size(); ++i)
+            samples[iter->value[i]->id()].merge(InlineCache::sample(iter->key->structureStubInfo(i)));
+    }
+#endif
+    
+    std::sort(order.begin(), order.end(), HotterInlineCache(samples));
+}
+
+JSValue Database::inlineCachesToJS(ExecState* exec) const
+{
+    Vector<InlineCache::Sample> samples;
+    Vector<unsigned> order;
+    sampleInlineCaches(samples, order);
+    
+    JSArray* result = constructEmptyArray(exec, 0);
+    for (unsigned i = 0; i < order.size(); ++i)
+        result->putDirectIndex(exec, i, m_inlineCaches[order[i]].toJS(exec, samples[order[i]]));
     return result;
 }
 
+String Database::inlineCachesToJSON() const
+{
+    JSGlobalObject* globalObject = JSGlobalObject::create(
+        m_vm, JSGlobalObject::createStructure(m_vm, jsNull()));
+    
+    return JSONStringify(globalObject->globalExec(), inlineCachesToJS(globalObject->globalExec()), 0);
+}
+
+void Database::dumpInlineCaches(PrintStream& out) const
+{
+    Vector<InlineCache::Sample> samples;
+    Vector<unsigned> order;
+    sampleInlineCaches(samples, order);
+    
+    for (unsigned i = 0; i < order.size(); ++i) {
+        m_inlineCaches[order[i]].dump(out, samples[order[i]]);
+        out.print("\n");
+    }
+}
+
 String Database::toJSON() const
 {
     JSGlobalObject* globalObject = JSGlobalObject::create(
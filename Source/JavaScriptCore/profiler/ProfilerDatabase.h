@@ -30,6 +30,7 @@
 #include "ProfilerBytecodes.h"
 #include "ProfilerCompilation.h"
 #include "ProfilerCompilationKind.h"
+#include "ProfilerInlineCache.h"
 #include <wtf/FastAllocBase.h>
 #include <wtf/HashMap.h>
 #include <wtf/Noncopyable.h>
@@ -53,6 +54,10 @@ public:
     PassRefPtr<Compilation> newCompilation(CodeBlock*, CompilationKind);
     PassRefPtr<Compilation> newCompilation(Bytecodes*, CompilationKind);
     
+    // Starts tracking the property access inline caches of a freshly linked code block,
+    // for Options::recordInlineCacheStatistics().
+    void addInlineCaches(CodeBlock*, CompilationKind);
+    
     // Converts the database to a JavaScript object that is suitable for JSON stringification.
     // Note that it's probably a good idea to use an ExecState* associated with a global
     // object that is "clean" - i.e. array and object prototypes haven't had strange things
@@ -66,6 +71,11 @@ public:
     // Saves the JSON representation (from toJSON()) to the given file. Returns false if the
     // save failed.
     JS_EXPORT_PRIVATE bool save(const char* filename) const;
+    
+    // Describes every inline cache seen so far, hottest slow paths first.
+    JSValue inlineCachesToJS(ExecState*) const;
+    JS_EXPORT_PRIVATE String inlineCachesToJSON() const;
+    JS_EXPORT_PRIVATE void dumpInlineCaches(PrintStream&) const;
 
     void registerToSaveAtExit(const char* filename);
     
@@ -77,11 +87,16 @@ private:
     static Database* removeFirstAtExitDatabase();
     static void atExitCallback();
     
+    void sampleInlineCaches(Vector<InlineCache::Sample>&, Vector<unsigned>& order) const;
+    
     int m_databaseID;
     VM& m_vm;
     SegmentedVector<Bytecodes> m_bytecodes;
     HashMap<CodeBlock*, Bytecodes*> m_bytecodesMap;
     Vector<RefPtr<Compilation> > m_compilations;
+    SegmentedVector<InlineCache> m_inlineCaches;
+    HashMap<OriginStack, InlineCache*> m_inlineCacheMap;
+    HashMap<CodeBlock*, Vector<InlineCache*> > m_liveInlineCaches;
     bool m_shouldSaveAtExit;
     CString m_atExitSaveFilename;
     Database* m_nextRegisteredDatabase;
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "ProfilerInlineCache.h"
+
+#include "JSGlobalObject.h"
+#include "ObjectConstructor.h"
+#include "Operations.h"
+#include "PolymorphicPutByIdList.h"
+#include "ProfilerBytecodes.h"
+#include "StructureStubInfo.h"
+#include <wtf/StringPrintStream.h>
+
+namespace JSC { namespace Profiler {
+
+void InlineCache::Sample::merge(const Sample& other)
+{
+    state = std::max(state, other.state);
+    repatchCount += other.repatchCount;
+    slowPathCount += other.slowPathCount;
+}
+
+InlineCache::InlineCache(unsigned id, const OriginStack& origin)
+    : m_id(id)
+    , m_origin(origin)
+{
+}
+
+InlineCache::~InlineCache()
+{
+}
+
+#if ENABLE(JIT)
+static InlineCache::State stateOf(const StructureStubInfo& stubInfo)
+{
+    if (stubInfo.tookGenericPath)
+        return InlineCache::Megamorphic;
+    
+    switch (stubInfo.accessType) {
+    case access_unset:
+        return InlineCache::Uncached;
+    case access_get_by_id_generic:
+    case access_put_by_id_generic:
+        return InlineCache::Megamorphic;
+    case access_get_by_id_self_list:
+        if (stubInfo.u.getByIdSelfList.listSize >= POLYMORPHIC_LIST_CACHE_SIZE)
+            return InlineCache::Megamorphic;
+        return InlineCache::Polymorphic;
+    case access_get_by_id_proto_list:
+        if (stubInfo.u.getByIdProtoList.listSize >= POLYMORPHIC_LIST_CACHE_SIZE)
+            return InlineCache::Megamorphic;
+        return InlineCache::Polymorphic;
+    case access_put_by_id_list:
+        if (stubInfo.u.putByIdList.list->isFull())
+            return InlineCache::Megamorphic;
+        return InlineCache::Polymorphic;
+    default:
+        return InlineCache::Monomorphic;
+    }
+}
+
+InlineCache::Sample InlineCache::sample(const StructureStubInfo& stubInfo)
+{
+    Sample result;
+    result.state = stateOf(stubInfo);
+    result.repatchCount = stubInfo.repatchCount;
+    result.slowPathCount = stubInfo.slowPathCount;
+    return result;
+}
+#endif
+
+void InlineCache::dump(PrintStream& out, const Sample& sample) const
+{
+    const Origin& origin = m_origin.fromTop(0);
+    out.print(
+        m_origin, ": ", origin.bytecodes()->forBytecodeIndex(origin.bytecodeIndex()).description(),
+        " ", sample.state, ", ", sample.repatchCount, " repatches, ",
+        sample.slowPathCount, " slow path hits");
+}
+
+JSValue InlineCache::toJS(ExecState* exec, const Sample& sample) const
+{
+    const Origin& origin = m_origin.fromTop(0);
+    JSObject* result = constructEmptyObject(exec);
+    result->putDirect(exec->vm(), exec->propertyNames().id, jsNumber(m_id));
+    result->putDirect(exec->vm(), exec->propertyNames().origin, m_origin.toJS(exec));
+    result->putDirect(exec->vm(), exec->propertyNames().description, jsString(exec, String::fromUTF8(origin.bytecodes()->forBytecodeIndex(origin.bytecodeIndex()).description())));
+    result->putDirect(exec->vm(), exec->propertyNames().state, jsString(exec, String::fromUTF8(toCString(sample.state))));
+    result->putDirect(exec->vm(), exec->propertyNames().repatchCount, jsNumber(sample.repatchCount));
+    result->putDirect(exec->vm(), exec->propertyNames().slowPathCount, jsNumber(sample.slowPathCount));
+    return result;
+}
+
+} } // namespace JSC::Profiler
+
+namespace WTF {
+
+void printInternal(PrintStream& out, JSC::Profiler::InlineCache::State state)
+{
+    switch (state) {
+    case JSC::Profiler::InlineCache::Uncached:
+        out.print("uncached");
+        return;
+    case JSC::Profiler::InlineCache::Monomorphic:
+        out.print("monomorphic");
+        return;
+    case JSC::Profiler::InlineCache::Polymorphic:
+        out.print("polymorphic");
+        return;
+    case JSC::Profiler::InlineCache::Megamorphic:
+        out.print("megamorphic");
+        return;
+    }
+    RELEASE_ASSERT_NOT_REACHED();
+}
+
+} // namespace WTF
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef ProfilerInlineCache_h
+#define ProfilerInlineCache_h
+
+#include "JSCJSValue.h"
+#include "ProfilerOriginStack.h"
+#include <wtf/PrintStream.h>
+
+namespace JSC {
+
+struct StructureStubInfo;
+
+namespace Profiler {
+
+// Accumulates the behavior of the get_by_id or put_by_id inline caches compiled for one
+// bytecode origin, across tiers and recompilations.
+
+class InlineCache {
+public:
+    enum State { Uncached, Monomorphic, Polymorphic, Megamorphic };
+    
+    struct Sample {
+        Sample()
+            : state(Uncached)
+            , repatchCount(0)
+            , slowPathCount(0)
+        {
+        }
+        
+        void merge(const Sample&);
+        
+        State state;
+        uint64_t repatchCount;
+        uint64_t slowPathCount;
+    };
+    
+    InlineCache(unsigned id, const OriginStack&);
+    ~InlineCache();
+    
+    unsigned id() const { return m_id; }
+    const OriginStack& origin() const { return m_origin; }
+    
+#if ENABLE(JIT)
+    static Sample sample(const StructureStubInfo&);
+    
+    // Called when the code block that owns the stub is destroyed.
+    void retire(const StructureStubInfo& stubInfo) { m_retired.merge(sample(stubInfo)); }
+#endif
+    const Sample& retiredSample() const { return m_retired; }
+    
+    void dump(PrintStream&, const Sample&) const;
+    JSValue toJS(ExecState*, const Sample&) const;
+
+private:
+    unsigned m_id;
+    OriginStack m_origin;
+    Sample m_retired;
+};
+
+} } // namespace JSC::Profiler
+
+namespace WTF {
+
+void printInternal(PrintStream&, JSC::Profiler::InlineCache::State);
+
+} // namespace WTF
+
+#endif // ProfilerInlineCache_h
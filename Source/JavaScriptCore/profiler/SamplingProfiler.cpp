@@ -0,0 +1,499 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SamplingProfiler.h"
+
+#if ENABLE(SAMPLING_PROFILER)
+
+#include "CodeBlock.h"
+#include "ExecutableAllocator.h"
+#include "Heap.h"
+#include "Interpreter.h"
+#include "JSStack.h"
+#include "LowLevelInterpreter.h"
+#include "Operations.h"
+#include "Options.h"
+#include "VM.h"
+#include <errno.h>
+#include <signal.h>
+#if OS(DARWIN)
+#include <sys/ucontext.h>
+#else
+#include <ucontext.h>
+#endif
+#include <wtf/Atomics.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/FilePrintStream.h>
+#include <wtf/TCSpinLock.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace JSC {
+
+// The signal handler is process wide, so only one profiler samples at a time.
+static SpinLock activeProfilerLock = SPINLOCK_INITIALIZER;
+static SamplingProfiler* volatile activeProfiler;
+static SamplingProfiler* profilerToSaveAtExit;
+
+SamplingProfiler::SamplingProfiler(VM& vm)
+    : m_vm(vm)
+    , m_samplerThread(0)
+    , m_shouldStop(false)
+    , m_isProcessing(false)
+    , m_rawFrameCount(0)
+    , m_rawSampleCount(0)
+    , m_sampleCount(0)
+    , m_droppedSampleCount(0)
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+    if (profilerToSaveAtExit == this) {
+        save(m_atExitSaveFilename.data());
+        profilerToSaveAtExit = 0;
+    }
+}
+
+bool SamplingProfiler::start()
+{
+    ASSERT(!m_samplerThread);
+    {
+        TCMalloc_SpinLockHolder holder(&activeProfilerLock);
+        if (activeProfiler)
+            return false;
+        activeProfiler = this;
+    }
+
+    // The signal handler cannot allocate, so the buffers are allocated up front.
+    m_rawFrames.resize(rawFrameCapacity);
+    m_rawSamples.resize(rawSampleCapacity);
+    m_sampledThread = pthread_self();
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = signalHandler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, &m_previousAction);
+
+    m_vm.watchdog.setSafePointCallback(didReachSafePoint, this);
+
+    m_shouldStop = false;
+    m_samplerThread = createThread(samplerThreadMain, this, "JavaScriptCore::SamplingProfiler");
+    return true;
+}
+
+void SamplingProfiler::stop()
+{
+    if (!m_samplerThread)
+        return;
+    ASSERT(pthread_equal(pthread_self(), m_sampledThread));
+
+    {
+        MutexLocker locker(m_lock);
+        m_shouldStop = true;
+        m_condition.signal();
+    }
+    // Once the sampler thread is gone, any signal that it sent has already been
+    // delivered to us, since joining it returned through the kernel.
+    waitForThreadCompletion(m_samplerThread);
+    m_samplerThread = 0;
+    m_vm.watchdog.setSafePointCallback(0, 0);
+
+    // The default action of SIGPROF is to terminate the process, so don't go
+    // back to it in case anyone else is still sending it.
+    if (!(m_previousAction.sa_flags & SA_SIGINFO) && m_previousAction.sa_handler == SIG_DFL)
+        m_previousAction.sa_handler = SIG_IGN;
+    sigaction(SIGPROF, &m_previousAction, 0);
+
+    {
+        TCMalloc_SpinLockHolder holder(&activeProfilerLock);
+        activeProfiler = 0;
+    }
+
+    processRawSamples();
+    m_rawFrames.clear();
+    m_rawSamples.clear();
+}
+
+void SamplingProfiler::samplerThreadMain(void* profiler)
+{
+    static_cast<SamplingProfiler*>(profiler)->samplerThreadBody();
+}
+
+void SamplingProfiler::samplerThreadBody()
+{
+    double interval = Options::sampleInterval() / 1000000.0;
+    MutexLocker locker(m_lock);
+    while (!m_shouldStop) {
+        m_condition.timedWait(m_lock, currentTime() + interval);
+        if (m_shouldStop)
+            break;
+        pthread_kill(m_sampledThread, SIGPROF);
+        if (rawBuffersAreFillingUp())
+            m_vm.watchdog.requestSafePoint();
+    }
+}
+
+// Runs on the sampler thread, so this races with the signal handler. That is
+// fine for a hint: at worst the safe point is requested one sample late.
+bool SamplingProfiler::rawBuffersAreFillingUp() const
+{
+    return m_rawSampleCount >= rawSampleCapacity / 2 || m_rawFrameCount >= rawFrameCapacity / 2;
+}
+
+void SamplingProfiler::didReachSafePoint(void* profiler)
+{
+    static_cast<SamplingProfiler*>(profiler)->processRawSamples();
+}
+
+void SamplingProfiler::signalHandler(int, siginfo_t*, void* context)
+{
+    int savedErrno = errno;
+    if (SamplingProfiler* profiler = activeProfiler)
+        profiler->takeSample(context);
+    errno = savedErrno;
+}
+
+static bool isJavaScriptCode(uintptr_t pc)
+{
+#if ENABLE(LLINT) && !ENABLE(LLINT_C_LOOP)
+    if (pc >= reinterpret_cast<uintptr_t>(llint_begin) && pc <= reinterpret_cast<uintptr_t>(llint_end))
+        return true;
+#endif
+#if ENABLE(EXECUTABLE_ALLOCATOR_FIXED)
+    if (startOfFixedExecutableMemoryPool && pc - startOfFixedExecutableMemoryPool < fixedExecutableMemoryPoolSize)
+        return true;
+#endif
+    UNUSED_PARAM(pc);
+    return false;
+}
+
+bool SamplingProfiler::isValidCallFrame(ExecState* exec)
+{
+    JSStack& stack = m_vm.interpreter->stack();
+    Register* frame = exec->registers();
+    if (reinterpret_cast<uintptr_t>(frame) & (sizeof(Register) - 1))
+        return false;
+    return frame - JSStack::CallFrameHeaderSize >= stack.begin() && frame < stack.end();
+}
+
+ExecState* SamplingProfiler::topCallFrame(void* context)
+{
+    // VM::topCallFrame is only brought up to date when JavaScript calls out to
+    // C++. If the thread was interrupted in the LLInt or in JIT code, the call
+    // frame register is more accurate.
+#if ENABLE(JIT) && (CPU(X86_64) || CPU(X86))
+    uintptr_t pc;
+    uintptr_t callFrameRegister;
+#if OS(LINUX) && CPU(X86_64)
+    const greg_t* registers = static_cast<ucontext_t*>(context)->uc_mcontext.gregs;
+    pc = registers[REG_RIP];
+    callFrameRegister = registers[REG_R13];
+#elif OS(LINUX)
+    const greg_t* registers = static_cast<ucontext_t*>(context)->uc_mcontext.gregs;
+    pc = registers[REG_EIP];
+    callFrameRegister = registers[REG_EDI];
+#elif CPU(X86_64)
+    pc = static_cast<ucontext_t*>(context)->uc_mcontext->__ss.__rip;
+    callFrameRegister = static_cast<ucontext_t*>(context)->uc_mcontext->__ss.__r13;
+#else
+    pc = static_cast<ucontext_t*>(context)->uc_mcontext->__ss.__eip;
+    callFrameRegister = static_cast<ucontext_t*>(context)->uc_mcontext->__ss.__edi;
+#endif
+    if (isJavaScriptCode(pc)) {
+        ExecState* exec = reinterpret_cast<ExecState*>(callFrameRegister);
+        if (isValidCallFrame(exec))
+            return exec;
+    }
+#else
+    UNUSED_PARAM(context);
+#endif
+
+    ExecState* exec = m_vm.topCallFrame->removeHostCallFrameFlag();
+    if (!exec || !isValidCallFrame(exec))
+        return 0;
+    return exec;
+}
+
+// Runs in the signal handler, on the sampled thread.
+void SamplingProfiler::takeSample(void* context)
+{
+    if (m_isProcessing) {
+        m_droppedSampleCount++;
+        return;
+    }
+
+    ExecState* exec = topCallFrame(context);
+    if (!exec)
+        return; // Not running JavaScript.
+
+    unsigned firstFrame = m_rawFrameCount;
+    unsigned frameCount = 0;
+    while (frameCount < maximumStackDepth) {
+        if (firstFrame + frameCount == rawFrameCapacity) {
+            m_droppedSampleCount++;
+            return;
+        }
+        RawFrame& frame = m_rawFrames[firstFrame + frameCount++];
+        frame.codeBlock = exec->codeBlock();
+        frame.location = exec->registers()[JSStack::ArgumentCount].tag();
+
+        // Callers are below their callees on the JSStack. Anything else means
+        // that we caught a frame half built, or that this was the first one.
+        ExecState* caller = exec->callerFrame()->removeHostCallFrameFlag();
+        if (caller >= exec || !caller || !isValidCallFrame(caller))
+            break;
+        exec = caller;
+    }
+
+    if (m_rawSampleCount) {
+        RawSample& previous = m_rawSamples[m_rawSampleCount - 1];
+        bool isSameStack = previous.frameCount == frameCount;
+        for (unsigned i = 0; isSameStack && i < frameCount; ++i) {
+            const RawFrame& a = m_rawFrames[previous.firstFrame + i];
+            const RawFrame& b = m_rawFrames[firstFrame + i];
+            isSameStack = a.codeBlock == b.codeBlock && a.location == b.location;
+        }
+        if (isSameStack) {
+            previous.count++;
+            m_sampleCount++;
+            return;
+        }
+    }
+
+    if (m_rawSampleCount == rawSampleCapacity) {
+        m_droppedSampleCount++;
+        return;
+    }
+    RawSample& sample = m_rawSamples[m_rawSampleCount];
+    sample.firstFrame = firstFrame;
+    sample.frameCount = frameCount;
+    sample.count = 1;
+    m_rawFrameCount = firstFrame + frameCount;
+    m_rawSampleCount++;
+    m_sampleCount++;
+}
+
+static void addCodeBlockAndAlternatives(CodeBlock* codeBlock, HashSet<CodeBlock*>& codeBlocks)
+{
+    for (; codeBlock; codeBlock = codeBlock->alternative())
+        codeBlocks.add(codeBlock);
+}
+
+void SamplingProfiler::gatherLiveCodeBlocks(HashSet<CodeBlock*>& codeBlocks)
+{
+    Heap& heap = m_vm.heap;
+    for (ExecutableBase* current = heap.m_compiledCode.head(); current; current = current->next()) {
+        switch (current->structure()->typeInfo().type()) {
+        case EvalExecutableType:
+            addCodeBlockAndAlternatives(jsCast<EvalExecutable*>(current)->codeBlock(), codeBlocks);
+            break;
+        case ProgramExecutableType:
+            addCodeBlockAndAlternatives(jsCast<ProgramExecutable*>(current)->codeBlock(), codeBlocks);
+            break;
+        case FunctionExecutableType: {
+            FunctionExecutable* executable = jsCast<FunctionExecutable*>(current);
+            if (executable->isGeneratedForCall())
+                addCodeBlockAndAlternatives(&executable->generatedBytecodeForCall(), codeBlocks);
+            if (executable->isGeneratedForConstruct())
+                addCodeBlockAndAlternatives(&executable->generatedBytecodeForConstruct(), codeBlocks);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+#if ENABLE(DFG_JIT)
+    // Jettisoned optimized code can still be on the stack.
+    HashSet<CodeBlock*>::iterator end = heap.m_dfgCodeBlocks.m_set.end();
+    for (HashSet<CodeBlock*>::iterator iter = heap.m_dfgCodeBlocks.m_set.begin(); iter != end; ++iter)
+        addCodeBlockAndAlternatives(*iter, codeBlocks);
+#endif
+}
+
+// Frames are named "function@url:line". Flame graph tools split stacks on
+// semicolons, so those can't appear in a name.
+static String frameName(const String& name, const String& sourceURL, unsigned line)
+{
+    StringBuilder builder;
+    if (name.isEmpty())
+        builder.appendLiteral("(anonymous)");
+    else
+        builder.append(name);
+    if (!sourceURL.isEmpty()) {
+        builder.append('@');
+        builder.append(sourceURL);
+    }
+    if (line) {
+        builder.append(':');
+        builder.appendNumber(line);
+    }
+    String result = builder.toString();
+    result.replace(';', ',');
+    return result;
+}
+
+static String frameName(CodeBlock* codeBlock, unsigned bytecodeOffset)
+{
+    unsigned line = bytecodeOffset < codeBlock->instructionCount() ? codeBlock->lineNumberForBytecodeOffset(bytecodeOffset) : 0;
+    return frameName(codeBlock->inferredName(), codeBlock->ownerExecutable()->sourceURL(), line);
+}
+
+// Appends the frames that a machine frame stands for, innermost first.
+void SamplingProfiler::appendFrames(CodeBlock* codeBlock, uint32_t location, const HashSet<CodeBlock*>& liveCodeBlocks, Vector<String>& frames)
+{
+    if (!codeBlock) {
+        frames.append(ASCIILiteral("(host)"));
+        return;
+    }
+    if (!liveCodeBlocks.contains(codeBlock)) {
+        frames.append(ASCIILiteral("(unknown)"));
+        return;
+    }
+
+#if ENABLE(DFG_JIT)
+    if (codeBlock->getJITType() == JITCode::DFGJIT) {
+        if (!codeBlock->canGetCodeOrigin(location)) {
+            frames.append(frameName(codeBlock, UINT_MAX));
+            return;
+        }
+        CodeOrigin codeOrigin = codeBlock->codeOrigin(location);
+        while (InlineCallFrame* inlineCallFrame = codeOrigin.inlineCallFrame) {
+            if (CodeBlock* baselineCodeBlock = inlineCallFrame->baselineCodeBlock())
+                frames.append(frameName(baselineCodeBlock, codeOrigin.bytecodeIndex));
+            else
+                frames.append(frameName(inlineCallFrame->inferredName(), jsCast<FunctionExecutable*>(inlineCallFrame->executable.get())->sourceURL(), 0));
+            codeOrigin = inlineCallFrame->caller;
+        }
+        frames.append(frameName(codeBlock, codeOrigin.bytecodeIndex));
+        return;
+    }
+#endif
+
+#if USE(JSVALUE32_64)
+    unsigned bytecodeOffset = bitwise_cast<Instruction*>(location) - codeBlock->instructions().begin();
+#else
+    unsigned bytecodeOffset = location;
+#endif
+    frames.append(frameName(codeBlock, bytecodeOffset));
+}
+
+void SamplingProfiler::processRawSamples()
+{
+    if (!m_rawSampleCount)
+        return;
+    // The signal handler only ever runs on the sampled thread, so that is the
+    // only thread that can safely take the buffers away from it.
+    if (isSampling() && !pthread_equal(pthread_self(), m_sampledThread))
+        return;
+
+    m_isProcessing = true;
+    WTF::compilerFence();
+
+    HashSet<CodeBlock*> liveCodeBlocks;
+    gatherLiveCodeBlocks(liveCodeBlocks);
+
+    Vector<String> frames;
+    for (unsigned i = 0; i < m_rawSampleCount; ++i) {
+        const RawSample& sample = m_rawSamples[i];
+        frames.resize(0);
+        for (unsigned j = 0; j < sample.frameCount; ++j) {
+            const RawFrame& frame = m_rawFrames[sample.firstFrame + j];
+            appendFrames(frame.codeBlock, frame.location, liveCodeBlocks, frames);
+        }
+
+        StringBuilder stack;
+        for (size_t j = frames.size(); j--;) {
+            stack.append(frames[j]);
+            if (j)
+                stack.append(';');
+        }
+        m_stacks.add(stack.toString(), 0).iterator->value += sample.count;
+    }
+    m_rawSampleCount = 0;
+    m_rawFrameCount = 0;
+
+    WTF::compilerFence();
+    m_isProcessing = false;
+}
+
+String SamplingProfiler::foldedStacks()
+{
+    processRawSamples();
+
+    StringBuilder builder;
+    HashMap<String, size_t>::iterator end = m_stacks.end();
+    for (HashMap<String, size_t>::iterator iter = m_stacks.begin(); iter != end; ++iter) {
+        builder.append(iter->key);
+        builder.append(' ');
+        builder.appendNumber(static_cast<unsigned long long>(iter->value));
+        builder.append('\n');
+    }
+    if (m_droppedSampleCount) {
+        builder.appendLiteral("(dropped) ");
+        builder.appendNumber(static_cast<unsigned long long>(m_droppedSampleCount));
+        builder.append('\n');
+    }
+    return builder.toString();
+}
+
+bool SamplingProfiler::save(const char* filename)
+{
+    OwnPtr<FilePrintStream> out = FilePrintStream::open(filename, "w");
+    if (!out)
+        return false;
+
+    out->print(foldedStacks());
+    return true;
+}
+
+void SamplingProfiler::registerToSaveAtExit(const char* filename)
+{
+    ASSERT(isSampling());
+    m_atExitSaveFilename = filename;
+    static bool didRegisterAtExit;
+    if (!didRegisterAtExit) {
+        atexit(saveAtExit);
+        didRegisterAtExit = true;
+    }
+    profilerToSaveAtExit = this;
+}
+
+void SamplingProfiler::saveAtExit()
+{
+    SamplingProfiler* profiler = profilerToSaveAtExit;
+    if (!profiler)
+        return;
+    profilerToSaveAtExit = 0;
+    profiler->stop();
+    profiler->save(profiler->m_atExitSaveFilename.data());
+}
+
+} // namespace JSC
+
+#endif // ENABLE(SAMPLING_PROFILER)
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SamplingProfiler_h
+#define SamplingProfiler_h
+
+#if ENABLE(SAMPLING_PROFILER)
+
+#include "JSExportMacros.h"
+#include <pthread.h>
+#include <signal.h>
+#include <wtf/FastAllocBase.h>
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class CodeBlock;
+class ExecState;
+class VM;
+
+// A statistical profiler that costs nothing per call. A sampler thread sends
+// SIGPROF to the thread that runs JavaScript every Options::sampleInterval()
+// microseconds. The signal handler interrupts that thread wherever it is, and
+// copies the code block and location of each frame on the JSStack into a
+// preallocated buffer. It does not allocate, lock, or follow any pointer that
+// it cannot bounds check.
+//
+// The raw samples are only turned into names later, on the JavaScript thread,
+// once the set of live code blocks is known. The heap does this before it
+// deletes any code, so a raw sample never outlives the code blocks that it
+// points at. Before the buffers fill up, the sampler thread also asks the
+// watchdog for a safe point, where the JavaScript thread drains them. DFG frames are expanded into the functions that were inlined into
+// them using their CodeOrigins, and every frame is attributed to the source
+// line of its bytecode.
+//
+// The result is a set of folded stacks, one "outermost;...;innermost count"
+// line per distinct stack, which is what flame graph tools take as input.
+// Samples that could not be recorded are counted on a "(dropped)" line.
+class SamplingProfiler {
+    WTF_MAKE_FAST_ALLOCATED; WTF_MAKE_NONCOPYABLE(SamplingProfiler);
+public:
+    JS_EXPORT_PRIVATE SamplingProfiler(VM&);
+    JS_EXPORT_PRIVATE ~SamplingProfiler();
+
+    // Samples the calling thread until stop() is called. Only one profiler in
+    // the process can be sampling at a time; start() returns false if another
+    // one already is.
+    JS_EXPORT_PRIVATE bool start();
+    JS_EXPORT_PRIVATE void stop();
+    bool isSampling() const { return m_samplerThread; }
+
+    // Attributes every raw sample taken so far. Must be called on the sampled
+    // thread, before any code block is deleted.
+    void processRawSamples();
+
+    JS_EXPORT_PRIVATE String foldedStacks();
+    JS_EXPORT_PRIVATE bool save(const char* filename);
+    void registerToSaveAtExit(const char* filename);
+
+    size_t sampleCount() const { return m_sampleCount; }
+    size_t droppedSampleCount() const { return m_droppedSampleCount; }
+
+private:
+    static const unsigned maximumStackDepth = 128;
+    static const unsigned rawFrameCapacity = 256 * 1024;
+    static const unsigned rawSampleCapacity = 16 * 1024;
+
+    // A frame as the signal handler found it. A null code block is a host
+    // function. The location is the ArgumentCount tag of the frame: a bytecode
+    // offset, an Instruction* on 32-bit, or a CodeOrigin index for DFG code.
+    struct RawFrame {
+        CodeBlock* codeBlock;
+        uint32_t location;
+    };
+
+    struct RawSample {
+        unsigned firstFrame;
+        unsigned frameCount;
+        unsigned count; // Identical consecutive samples are merged.
+    };
+
+    static void samplerThreadMain(void*);
+    void samplerThreadBody();
+    bool rawBuffersAreFillingUp() const;
+    static void didReachSafePoint(void*);
+
+    static void signalHandler(int, siginfo_t*, void*);
+    void takeSample(void* context);
+    ExecState* topCallFrame(void* context);
+    bool isValidCallFrame(ExecState*);
+
+    void gatherLiveCodeBlocks(HashSet<CodeBlock*>&);
+    void appendFrames(CodeBlock*, uint32_t location, const HashSet<CodeBlock*>&, Vector<String>&);
+
+    static void saveAtExit();
+
+    VM& m_vm;
+    pthread_t m_sampledThread;
+    ThreadIdentifier m_samplerThread;
+    Mutex m_lock;
+    ThreadCondition m_condition;
+    bool m_shouldStop;
+    struct sigaction m_previousAction;
+
+    // Written by the signal handler, and read by processRawSamples() on the same
+    // thread. The handler drops its sample while m_isProcessing is set.
+    volatile bool m_isProcessing;
+    Vector<RawFrame> m_rawFrames;
+    Vector<RawSample> m_rawSamples;
+    unsigned m_rawFrameCount;
+    unsigned m_rawSampleCount;
+    size_t m_sampleCount;
+    size_t m_droppedSampleCount;
+
+    HashMap<String, size_t> m_stacks;
+    CString m_atExitSaveFilename;
+};
+
+} // namespace JSC
+
+#endif // ENABLE(SAMPLING_PROFILER)
+
+#endif // SamplingProfiler_h
@@ -40,6 +40,7 @@
 #include <algorithm>
 #include <wtf/Assertions.h>
 #include <wtf/HashSet.h>
+#include <wtf/StableSort.h>
 
 namespace JSC {
 
@@ -624,60 +625,100 @@ static bool attemptFastSort(ExecState* exec, JSObject* thisObj, JSValue function
     return true;
 }
 
+class SlowSortCompare {
+public:
+    SlowSortCompare(ExecState* exec, JSValue function, CallData& callData, CallType callType)
+        : m_exec(exec)
+        , m_function(function)
+        , m_callData(callData)
+        , m_callType(callType)
+    {
+    }
+
+    bool operator()(const ValueStringPair* a, const ValueStringPair* b)
+    {
+        if (m_exec->hadException())
+            return false;
+        if (m_callType == CallTypeNone)
+            return codePointCompareLessThan(a->second, b->second);
+
+        MarkedArgumentBuffer arguments;
+        arguments.append(a->first);
+        arguments.append(b->first);
+        return call(m_exec, m_function, m_callType, m_callData, jsUndefined(), arguments).toNumber(m_exec) < 0;
+    }
+
+private:
+    ExecState* m_exec;
+    JSValue m_function;
+    CallData& m_callData;
+    CallType m_callType;
+};
+
 static bool performSlowSort(ExecState* exec, JSObject* thisObj, unsigned length, JSValue function, CallData& callData, CallType& callType)
 {
-    // "Min" sort. Not the fastest, but definitely less code than heapsort
-    // or quicksort, and much less swapping than bubblesort/insertionsort.
-    for (unsigned i = 0; i < length - 1; ++i) {
-        JSValue iObj = getOrHole(thisObj, exec, i);
-        if (exec->hadException())
+    // Values other than undefined are read once and stable sorted on the side. They are
+    // written back first, followed by the undefined values, and the remaining indices are
+    // left as holes.
+    Vector<ValueStringPair, 0, UnsafeVectorOverflow> values;
+    Heap* heap = Heap::heap(thisObj);
+    heap->pushTempSortVector(&values);
+
+    unsigned numUndefined = 0;
+    for (unsigned i = 0; i < length; ++i) {
+        JSValue value = getOrHole(thisObj, exec, i);
+        if (exec->hadException()) {
+            heap->popTempSortVector(&values);
             return false;
-        unsigned themin = i;
-        JSValue minObj = iObj;
-        for (unsigned j = i + 1; j < length; ++j) {
-            JSValue jObj = getOrHole(thisObj, exec, j);
-            if (exec->hadException())
-                return false;
-            double compareResult;
-            if (!jObj)
-                compareResult = 1;
-            else if (!minObj)
-                compareResult = -1;
-            else if (jObj.isUndefined())
-                compareResult = 1; // don't check minObj because there's no need to differentiate == (0) from > (1)
-            else if (minObj.isUndefined())
-                compareResult = -1;
-            else if (callType != CallTypeNone) {
-                MarkedArgumentBuffer l;
-                l.append(jObj);
-                l.append(minObj);
-                compareResult = call(exec, function, callType, callData, jsUndefined(), l).toNumber(exec);
-            } else
-                compareResult = codePointCompareLessThan(jObj.toWTFStringInline(exec), minObj.toWTFStringInline(exec)) ? -1 : 1;
-
-            if (compareResult < 0) {
-                themin = j;
-                minObj = jObj;
-            }
         }
-        // Swap themin and i
-        if (themin > i) {
-            if (minObj) {
-                thisObj->methodTable()->putByIndex(thisObj, exec, i, minObj, true);
-                if (exec->hadException())
-                    return false;
-            } else if (!thisObj->methodTable()->deletePropertyByIndex(thisObj, exec, i)) {
-                throwTypeError(exec, "Unable to delete property.");
-                return false;
-            }
-            if (iObj) {
-                thisObj->methodTable()->putByIndex(thisObj, exec, themin, iObj, true);
-                if (exec->hadException())
-                    return false;
-            } else if (!thisObj->methodTable()->deletePropertyByIndex(thisObj, exec, themin)) {
-                throwTypeError(exec, "Unable to delete property.");
-                return false;
-            }
+        if (!value)
+            continue;
+        if (value.isUndefined()) {
+            ++numUndefined;
+            continue;
+        }
+        values.append(ValueStringPair(value, String()));
+    }
+    unsigned numDefined = values.size();
+
+    if (callType == CallTypeNone) {
+        for (unsigned i = 0; i < numDefined; ++i)
+            values[i].second = values[i].first.toWTFStringInline(exec);
+        if (exec->hadException()) {
+            heap->popTempSortVector(&values);
+            return false;
+        }
+    }
+
+    Vector<ValueStringPair*, 0, UnsafeVectorOverflow> sortedValues(numDefined + (numDefined + 1) / 2);
+    for (unsigned i = 0; i < numDefined; ++i)
+        sortedValues[i] = &values[i];
+    SlowSortCompare compareLess(exec, function, callData, callType);
+    stableSort(sortedValues.begin(), numDefined, sortedValues.begin() + numDefined, compareLess);
+    if (exec->hadException()) {
+        heap->popTempSortVector(&values);
+        return false;
+    }
+
+    for (unsigned i = 0; i < numDefined; ++i) {
+        thisObj->methodTable()->putByIndex(thisObj, exec, i, sortedValues[i]->first, true);
+        if (exec->hadException()) {
+            heap->popTempSortVector(&values);
+            return false;
+        }
+    }
+    heap->popTempSortVector(&values);
+
+    unsigned undefinedEnd = numDefined + numUndefined;
+    for (unsigned i = numDefined; i < undefinedEnd; ++i) {
+        thisObj->methodTable()->putByIndex(thisObj, exec, i, jsUndefined(), true);
+        if (exec->hadException())
+            return false;
+    }
+    for (unsigned i = undefinedEnd; i < length; ++i) {
+        if (!thisObj->methodTable()->deletePropertyByIndex(thisObj, exec, i)) {
+            throwTypeError(exec, "Unable to delete property.");
+            return false;
         }
     }
     return true;
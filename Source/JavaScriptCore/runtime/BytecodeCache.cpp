@@ -0,0 +1,474 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "BytecodeCache.h"
+
+#include "CodeCache.h"
+#include "Opcode.h"
+#include "Options.h"
+#include "UnlinkedCodeBlock.h"
+#include "UnlinkedCodeBlockSerializer.h"
+#include <wtf/DataLog.h>
+#include <wtf/SHA1.h>
+#include <wtf/StringHasher.h>
+#include <wtf/Threading.h>
+
+#if OS(UNIX)
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace JSC {
+
+static const uint32_t bytecodeCacheMagic = 0x4342534a; // "JSBC" when read on a little endian machine.
+
+struct BytecodeCacheFileHeader {
+    uint32_t magic;
+    uint32_t formatVersion;
+    uint32_t layoutFingerprint;
+    uint32_t pointerSize;
+};
+
+// Records follow the file header back to back, oldest first. Each record is padded so
+// that the next record header is 4-byte aligned.
+struct BytecodeCacheRecordHeader {
+    uint32_t sourceHash;
+    uint32_t flags;
+    uint32_t sourceLength;
+    uint32_t payloadSize;
+    uint32_t payloadHash;
+    uint8_t sourceDigest[20];
+};
+
+static void initializeFileHeader(BytecodeCacheFileHeader& header)
+{
+    memset(&header, 0, sizeof(header));
+    header.magic = bytecodeCacheMagic;
+    header.formatVersion = UnlinkedCodeBlockSerializer::formatVersion;
+    header.layoutFingerprint = UnlinkedCodeBlockSerializer::layoutFingerprint();
+    header.pointerSize = sizeof(void*);
+}
+
+// Fills in the fields that identify the program a record is for.
+static void initializeRecordHeader(BytecodeCacheRecordHeader& header, const SourceCodeKey& key)
+{
+    String source = key.string();
+    Vector<uint8_t, 20> digest;
+    SHA1 sha1;
+    if (source.is8Bit())
+        sha1.addBytes(source.characters8(), source.length());
+    else
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(source.characters16()), source.length() * sizeof(UChar));
+    sha1.computeHash(digest);
+
+    memset(&header, 0, sizeof(header));
+    header.sourceHash = key.hash();
+    header.flags = key.flags();
+    header.sourceLength = source.length();
+    memcpy(header.sourceDigest, digest.data(), sizeof(header.sourceDigest));
+}
+
+static bool isSameProgram(const BytecodeCacheRecordHeader& a, const BytecodeCacheRecordHeader& b)
+{
+    return a.sourceHash == b.sourceHash
+        && a.flags == b.flags
+        && a.sourceLength == b.sourceLength
+        && !memcmp(a.sourceDigest, b.sourceDigest, sizeof(a.sourceDigest));
+}
+
+static size_t roundUpToRecordAlignment(size_t size)
+{
+    return (size + 3) & ~static_cast<size_t>(3);
+}
+
+// Returns the size of the record, or 0 if it does not fit in the remaining bytes because
+// another process has not finished writing it, or because it is garbage.
+static size_t recordSize(const BytecodeCacheRecordHeader& record, size_t remaining)
+{
+    if (remaining < sizeof(BytecodeCacheRecordHeader))
+        return 0;
+    remaining -= sizeof(BytecodeCacheRecordHeader);
+    if (record.payloadSize > remaining || roundUpToRecordAlignment(record.payloadSize) > remaining)
+        return 0;
+    if (!record.sourceHash || record.sourceHash == std::numeric_limits<unsigned>::max())
+        return 0;
+    return sizeof(BytecodeCacheRecordHeader) + roundUpToRecordAlignment(record.payloadSize);
+}
+
+BytecodeCache* BytecodeCache::shared()
+{
+    // This is not done while initializing threading because embedders and the jsc shell
+    // may set options after that.
+    AtomicallyInitializedStatic(BytecodeCache*, cache = Options::bytecodeCacheFile() ? open(Options::bytecodeCacheFile()) : 0);
+    return cache;
+}
+
+BytecodeCache::BytecodeCache(const char* path, int fd, const uint8_t* data, size_t size)
+    : m_path(path)
+    , m_data(data)
+    , m_size(size)
+    , m_fd(fd)
+    , m_checkedSize(size)
+{
+}
+
+#if OS(UNIX)
+static int openCacheFile(const char* path)
+{
+    return ::open(path, O_RDWR | O_CREAT | O_APPEND | O_NOFOLLOW, S_IRUSR | S_IWUSR);
+}
+
+// The contents of the file end up being run as code, so only use a file that nobody
+// but us could have written.
+static bool isPrivateFile(int fd)
+{
+    struct stat status;
+    if (fstat(fd, &status))
+        return false;
+    return S_ISREG(status.st_mode) && status.st_uid == geteuid() && !(status.st_mode & (S_IWGRP | S_IWOTH));
+}
+
+// Writes the header if the file is empty. Returns false if the file was written by a
+// different build. The file must be locked.
+static bool prepareFileHeader(int fd)
+{
+    BytecodeCacheFileHeader expectedHeader;
+    initializeFileHeader(expectedHeader);
+
+    BytecodeCacheFileHeader header;
+    ssize_t result = pread(fd, &header, sizeof(header), 0);
+    if (!result)
+        return write(fd, &expectedHeader, sizeof(expectedHeader)) == sizeof(expectedHeader);
+    return result == sizeof(header) && !memcmp(&header, &expectedHeader, sizeof(header));
+}
+
+BytecodeCache* BytecodeCache::open(const char* path)
+{
+    int fd = openCacheFile(path);
+    if (fd == -1) {
+        dataLogF("Could not open bytecode cache %s: %s\n", path, strerror(errno));
+        return 0;
+    }
+    if (!isPrivateFile(fd)) {
+        dataLogF("Not using bytecode cache %s: it must be a regular file that only its owner can write.\n", path);
+        close(fd);
+        return 0;
+    }
+    flock(fd, LOCK_EX);
+
+    if (!prepareFileHeader(fd)) {
+        // The file was written by a different build. Replace it rather than truncating
+        // it, since other processes may still have the old one mapped.
+        if (Options::verboseBytecodeCache())
+            dataLogF("Bytecode cache %s was written by a different build, starting over.\n", path);
+        unlink(path);
+        flock(fd, LOCK_UN);
+        close(fd);
+        fd = openCacheFile(path);
+        if (fd == -1) {
+            dataLogF("Could not create bytecode cache %s: %s\n", path, strerror(errno));
+            return 0;
+        }
+        if (!isPrivateFile(fd)) {
+            close(fd);
+            return 0;
+        }
+        flock(fd, LOCK_EX);
+        if (!prepareFileHeader(fd)) {
+            flock(fd, LOCK_UN);
+            close(fd);
+            return 0;
+        }
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) || static_cast<size_t>(status.st_size) < sizeof(BytecodeCacheFileHeader)) {
+        flock(fd, LOCK_UN);
+        close(fd);
+        return 0;
+    }
+    size_t size = status.st_size;
+    void* data = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    flock(fd, LOCK_UN);
+    if (data == MAP_FAILED) {
+        close(fd);
+        return 0;
+    }
+
+    BytecodeCache* cache = new BytecodeCache(path, fd, static_cast<const uint8_t*>(data), size);
+    cache->buildIndex();
+    return cache;
+}
+#else
+BytecodeCache* BytecodeCache::open(const char*)
+{
+    return 0;
+}
+#endif
+
+void BytecodeCache::buildIndex()
+{
+    size_t offset = sizeof(BytecodeCacheFileHeader);
+    while (offset < m_size) {
+        const BytecodeCacheRecordHeader* record = reinterpret_cast<const BytecodeCacheRecordHeader*>(m_data + offset);
+        size_t size = recordSize(*record, m_size - offset);
+        if (!size)
+            break;
+        m_index.add(record->sourceHash, Vector<size_t>()).iterator->value.append(offset);
+        offset += size;
+    }
+    m_checkedSize = offset;
+}
+
+bool BytecodeCache::indexContains(const BytecodeCacheRecordHeader& header) const
+{
+    HashMap<unsigned, Vector<size_t> >::const_iterator iter = m_index.find(header.sourceHash);
+    if (iter == m_index.end())
+        return false;
+    const Vector<size_t>& offsets = iter->value;
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        if (isSameProgram(*reinterpret_cast<const BytecodeCacheRecordHeader*>(m_data + offsets[i]), header))
+            return true;
+    }
+    return false;
+}
+
+UnlinkedProgramCodeBlock* BytecodeCache::programCodeBlock(VM& vm, const SourceCodeKey& key)
+{
+    HashMap<unsigned, Vector<size_t> >::const_iterator iter = m_index.find(key.hash());
+    if (iter == m_index.end())
+        return 0;
+
+    BytecodeCacheRecordHeader header;
+    initializeRecordHeader(header, key);
+
+    const Vector<size_t>& offsets = iter->value;
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        const BytecodeCacheRecordHeader* record = reinterpret_cast<const BytecodeCacheRecordHeader*>(m_data + offsets[i]);
+        if (!isSameProgram(*record, header))
+            continue;
+        const uint8_t* payload = reinterpret_cast<const uint8_t*>(record + 1);
+        if (StringHasher::hashMemory(payload, roundUpToRecordAlignment(record->payloadSize)) == record->payloadHash) {
+            if (UnlinkedProgramCodeBlock* codeBlock = UnlinkedCodeBlockSerializer::decode(vm, payload, record->payloadSize)) {
+                if (Options::verboseBytecodeCache())
+                    dataLogF("Bytecode cache: using cached bytecode for a program of %u characters.\n", header.sourceLength);
+                return codeBlock;
+            }
+        }
+        if (Options::verboseBytecodeCache())
+            dataLogF("Bytecode cache: rejected a corrupt record for a program of %u characters.\n", header.sourceLength);
+    }
+    return 0;
+}
+
+void BytecodeCache::addProgramCodeBlock(const SourceCodeKey& key, UnlinkedProgramCodeBlock* codeBlock)
+{
+    BytecodeCacheRecordHeader header;
+    initializeRecordHeader(header, key);
+    // The program may have been rejected, or it may have been added by another process
+    // after we opened the file. Neither is worth encoding it again for.
+    if (indexContains(header))
+        return;
+
+    Vector<uint8_t> record;
+    record.resize(sizeof(header));
+    if (!UnlinkedCodeBlockSerializer::encode(codeBlock, record))
+        return;
+    size_t payloadSize = record.size() - sizeof(header);
+    record.resize(sizeof(header) + roundUpToRecordAlignment(payloadSize));
+    header.payloadSize = payloadSize;
+    header.payloadHash = StringHasher::hashMemory(record.data() + sizeof(header), record.size() - sizeof(header));
+    memcpy(record.data(), &header, sizeof(header));
+
+    // Leave room for other programs; this also keeps eviction from having to drop
+    // everything to make space.
+    if (sizeof(BytecodeCacheFileHeader) + record.size() > Options::bytecodeCacheMaximumSize() / 2)
+        return;
+
+#if OS(UNIX)
+    MutexLocker locker(m_writeLock);
+    if (!lockFile())
+        return;
+
+    bool shouldWrite = prepareFileHeader(m_fd);
+    if (shouldWrite && fileContains(header)) {
+        if (Options::verboseBytecodeCache())
+            dataLogF("Bytecode cache: a program of %u characters is already cached.\n", header.sourceLength);
+        shouldWrite = false;
+    }
+    struct stat status;
+    if (shouldWrite && !fstat(m_fd, &status) && static_cast<size_t>(status.st_size) + record.size() > Options::bytecodeCacheMaximumSize())
+        shouldWrite = evictOldRecords(status.st_size, record.size());
+
+    // The file is opened for appending, so a single write lands at the end of the file
+    // even if other processes that do not honor the lock are adding records.
+    if (shouldWrite) {
+        if (write(m_fd, record.data(), record.size()) != static_cast<ssize_t>(record.size()))
+            dataLogF("Could not write to bytecode cache %s: %s\n", m_path.data(), strerror(errno));
+        else if (Options::verboseBytecodeCache())
+            dataLogF("Bytecode cache: stored %zu bytes for a program of %u characters.\n", record.size(), header.sourceLength);
+    }
+    flock(m_fd, LOCK_UN);
+#endif
+}
+
+#if OS(UNIX)
+bool BytecodeCache::isReplaced() const
+{
+    // Another process may have replaced the file because it evicted records from it, or
+    // because it was run by a different build.
+    struct stat current;
+    struct stat ours;
+    if (stat(m_path.data(), &current) || fstat(m_fd, &ours))
+        return true;
+    return current.st_dev != ours.st_dev || current.st_ino != ours.st_ino;
+}
+
+bool BytecodeCache::reopen()
+{
+    int fd = openCacheFile(m_path.data());
+    if (fd == -1)
+        return false;
+    if (!isPrivateFile(fd)) {
+        close(fd);
+        return false;
+    }
+    close(m_fd);
+    m_fd = fd;
+    m_checkedSize = 0;
+    return true;
+}
+
+bool BytecodeCache::lockFile()
+{
+    // The file may be replaced while we wait for the lock, in which case we have to
+    // start over with the new one.
+    for (unsigned attempt = 0; attempt < 3; ++attempt) {
+        if (isReplaced() && !reopen())
+            return false;
+        flock(m_fd, LOCK_EX);
+        if (!isReplaced())
+            return true;
+        flock(m_fd, LOCK_UN);
+    }
+    return false;
+}
+
+bool BytecodeCache::fileContains(const BytecodeCacheRecordHeader& header)
+{
+    // Only the records that were appended since we last looked need to be read; the ones
+    // that were there when the file was mapped are in the index.
+    struct stat status;
+    if (fstat(m_fd, &status))
+        return false;
+    size_t fileSize = status.st_size;
+    if (m_checkedSize < sizeof(BytecodeCacheFileHeader))
+        m_checkedSize = sizeof(BytecodeCacheFileHeader);
+    while (m_checkedSize < fileSize) {
+        BytecodeCacheRecordHeader record;
+        size_t size = 0;
+        if (pread(m_fd, &record, sizeof(record), m_checkedSize) == sizeof(record))
+            size = recordSize(record, fileSize - m_checkedSize);
+        if (!size) {
+            // Records are only written with the file locked, so this one was left behind
+            // by a process that died while writing it. Drop it, or the records we append
+            // would never be found.
+            if (ftruncate(m_fd, m_checkedSize))
+                dataLogF("Could not truncate bytecode cache %s: %s\n", m_path.data(), strerror(errno));
+            return false;
+        }
+        if (isSameProgram(record, header))
+            return true;
+        m_checkedSize += size;
+    }
+    return false;
+}
+
+bool BytecodeCache::evictOldRecords(size_t fileSize, size_t bytesNeeded)
+{
+    // Keep the newest records that fit in half of the maximum size, so that we do not
+    // have to do this again for a while. They are copied to a new file that replaces the
+    // old one, since other processes may still have the old one mapped.
+    Vector<uint8_t> contents;
+    contents.resize(fileSize);
+    if (pread(m_fd, contents.data(), fileSize, 0) != static_cast<ssize_t>(fileSize))
+        return false;
+
+    Vector<size_t> offsets;
+    size_t end = sizeof(BytecodeCacheFileHeader);
+    while (end < fileSize) {
+        size_t size = recordSize(*reinterpret_cast<const BytecodeCacheRecordHeader*>(contents.data() + end), fileSize - end);
+        if (!size)
+            break;
+        offsets.append(end);
+        end += size;
+    }
+
+    size_t budget = Options::bytecodeCacheMaximumSize() / 2;
+    size_t firstKept = 0;
+    while (firstKept < offsets.size() && sizeof(BytecodeCacheFileHeader) + end - offsets[firstKept] + bytesNeeded > budget)
+        ++firstKept;
+    size_t keptStart = firstKept < offsets.size() ? offsets[firstKept] : end;
+
+    Vector<char> temporaryPath;
+    temporaryPath.append(m_path.data(), m_path.length());
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%d", static_cast<int>(getpid()));
+    temporaryPath.append(suffix, strlen(suffix) + 1);
+
+    int fd = ::open(temporaryPath.data(), O_RDWR | O_CREAT | O_EXCL | O_APPEND | O_NOFOLLOW, S_IRUSR | S_IWUSR);
+    if (fd == -1)
+        return false;
+    flock(fd, LOCK_EX);
+    BytecodeCacheFileHeader header;
+    initializeFileHeader(header);
+    if (write(fd, &header, sizeof(header)) != sizeof(header)
+        || write(fd, contents.data() + keptStart, end - keptStart) != static_cast<ssize_t>(end - keptStart)
+        || rename(temporaryPath.data(), m_path.data())) {
+        dataLogF("Could not evict records from bytecode cache %s: %s\n", m_path.data(), strerror(errno));
+        unlink(temporaryPath.data());
+        close(fd);
+        return false;
+    }
+
+    if (Options::verboseBytecodeCache())
+        dataLogF("Bytecode cache: evicted %zu of %zu records.\n", firstKept, offsets.size());
+
+    flock(m_fd, LOCK_UN);
+    close(m_fd);
+    m_fd = fd;
+    // We already compared the kept records against the one we are adding.
+    m_checkedSize = sizeof(BytecodeCacheFileHeader) + end - keptStart;
+    return true;
+}
+#endif
+
+} // namespace JSC
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef BytecodeCache_h
+#define BytecodeCache_h
+
+#include <wtf/FastAllocBase.h>
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/ThreadingPrimitives.h>
+#include <wtf/Vector.h>
+#include <wtf/text/CString.h>
+
+namespace JSC {
+
+struct BytecodeCacheRecordHeader;
+class SourceCodeKey;
+class UnlinkedProgramCodeBlock;
+class VM;
+
+// Keeps the unlinked bytecode of top level program code in a file, so that a later
+// process running the same scripts can skip parsing and bytecode generation. The
+// file is mapped read-only when the cache is opened; code blocks generated after that
+// are appended to the file and become visible to the next process that opens it.
+// Once the file would grow past Options::bytecodeCacheMaximumSize(), its oldest records
+// are evicted. All VMs in the process share one cache, which is only enabled when
+// Options::bytecodeCacheFile() names a file. Only a file that nobody but its owner can
+// write is used, and every record is validated before its code is run.
+class BytecodeCache {
+    WTF_MAKE_NONCOPYABLE(BytecodeCache);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    // Opens the file the first time it is called; returns 0 if the cache is disabled.
+    static BytecodeCache* shared();
+
+    UnlinkedProgramCodeBlock* programCodeBlock(VM&, const SourceCodeKey&);
+    void addProgramCodeBlock(const SourceCodeKey&, UnlinkedProgramCodeBlock*);
+
+private:
+    BytecodeCache(const char* path, int fd, const uint8_t* data, size_t size);
+
+    static BytecodeCache* open(const char* path);
+    void buildIndex();
+    bool indexContains(const BytecodeCacheRecordHeader&) const;
+
+    // These are called with m_writeLock held.
+    bool isReplaced() const;
+    bool reopen();
+    bool lockFile();
+    bool fileContains(const BytecodeCacheRecordHeader&);
+    bool evictOldRecords(size_t fileSize, size_t bytesNeeded);
+
+    CString m_path;
+    const uint8_t* m_data;
+    size_t m_size;
+
+    // Maps source hashes to the offsets of the records for them. Built once when the
+    // file is opened, so lookups need no locking.
+    HashMap<unsigned, Vector<size_t> > m_index;
+
+    Mutex m_writeLock;
+    int m_fd;
+    // Records before this offset in the file that m_fd refers to have been compared
+    // against the ones we were about to add.
+    size_t m_checkedSize;
+};
+
+} // namespace JSC
+
+#endif // BytecodeCache_h
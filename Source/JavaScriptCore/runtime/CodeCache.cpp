@@ -27,6 +27,7 @@
 
 #include "CodeCache.h"
 
+#include "BytecodeCache.h"
 #include "BytecodeGenerator.h"
 #include "CodeSpecializationKind.h"
 #include "Operations.h"
@@ -74,11 +75,32 @@ template <typename T> struct CacheTypes { };
 template <> struct CacheTypes<UnlinkedProgramCodeBlock> {
     typedef JSC::ProgramNode RootNode;
     static const SourceCodeKey::CodeType codeType = SourceCodeKey::ProgramType;
+
+    static UnlinkedProgramCodeBlock* loadPrecompiled(VM& vm, CodeCache& codeCache, const SourceCodeKey& key)
+    {
+        if (RefPtr<PrecompiledProgram> program = codeCache.takePrecompiledProgram(key)) {
+            if (UnlinkedProgramCodeBlock* codeBlock = program->takeCodeBlock(vm))
+                return codeBlock;
+        }
+
+        BytecodeCache* cache = BytecodeCache::shared();
+        return cache ? cache->programCodeBlock(vm, key) : 0;
+    }
+
+    static void saveToFile(const SourceCodeKey& key, UnlinkedProgramCodeBlock* codeBlock)
+    {
+        if (BytecodeCache* cache = BytecodeCache::shared())
+            cache->addProgramCodeBlock(key, codeBlock);
+    }
 };
 
 template <> struct CacheTypes<UnlinkedEvalCodeBlock> {
     typedef JSC::EvalNode RootNode;
     static const SourceCodeKey::CodeType codeType = SourceCodeKey::EvalType;
+
+    // Eval code is neither precompiled nor kept on disk.
+    static UnlinkedEvalCodeBlock* loadPrecompiled(VM&, CodeCache&, const SourceCodeKey&) { return 0; }
+    static void saveToFile(const SourceCodeKey&, UnlinkedEvalCodeBlock*) { }
 };
 
 template <class UnlinkedCodeBlockType, class ExecutableType>
@@ -100,6 +122,14 @@ UnlinkedCodeBlockType* CodeCache::generateBytecode(VM& vm, JSScope* scope, Execu
     return unlinkedCode;
 }
 
+template <class UnlinkedCodeBlockType, class ExecutableType>
+static void recordCachedParse(ExecutableType* executable, const SourceCode& source, UnlinkedCodeBlockType* unlinkedCode)
+{
+    unsigned firstLine = source.firstLine() + unlinkedCode->firstLine();
+    unsigned startColumn = source.firstLine() ? source.startColumn() : 0;
+    executable->recordParse(unlinkedCode->codeFeatures(), unlinkedCode->hasCapturedVariables(), firstLine, firstLine + unlinkedCode->lineCount(), startColumn);
+}
+
 template <class UnlinkedCodeBlockType, class ExecutableType>
 UnlinkedCodeBlockType* CodeCache::getCodeBlock(VM& vm, JSScope* scope, ExecutableType* executable, const SourceCode& source, JSParserStrictness strictness, DebuggerMode debuggerMode, ProfilerMode profilerMode, ParserError& error)
 {
@@ -115,11 +145,18 @@ UnlinkedCodeBlockType* CodeCache::getCodeBlock(VM& vm, JSScope* scope, Executabl
 
     if (!addResult.isNewEntry && canCache) {
         UnlinkedCodeBlockType* unlinkedCode = jsCast<UnlinkedCodeBlockType*>(addResult.iterator->value.cell.get());
-        unsigned firstLine = source.firstLine() + unlinkedCode->firstLine();
-        unsigned startColumn = source.firstLine() ? source.startColumn() : 0;
-        executable->recordParse(unlinkedCode->codeFeatures(), unlinkedCode->hasCapturedVariables(), firstLine, firstLine + unlinkedCode->lineCount(), startColumn);
+        recordCachedParse(executable, source, unlinkedCode);
         return unlinkedCode;
     }
+
+    if (canCache) {
+        if (UnlinkedCodeBlockType* unlinkedCode = CacheTypes<UnlinkedCodeBlockType>::loadPrecompiled(vm, *this, key)) {
+            recordCachedParse(executable, source, unlinkedCode);
+            addResult.iterator->value = SourceCodeValue(vm, unlinkedCode, m_sourceCode.age());
+            return unlinkedCode;
+        }
+    }
+
     UnlinkedCodeBlockType* unlinkedCode = generateBytecode<UnlinkedCodeBlockType, ExecutableType>(vm, scope, executable, source, strictness, debuggerMode, profilerMode, error);
 
     if (!canCache || !unlinkedCode) {
@@ -128,6 +165,7 @@ UnlinkedCodeBlockType* CodeCache::getCodeBlock(VM& vm, JSScope* scope, Executabl
     }
 
     addResult.iterator->value = SourceCodeValue(vm, unlinkedCode, m_sourceCode.age());
+    CacheTypes<UnlinkedCodeBlockType>::saveToFile(key, unlinkedCode);
     return unlinkedCode;
 }
 
@@ -136,6 +174,22 @@ UnlinkedProgramCodeBlock* CodeCache::getProgramCodeBlock(VM& vm, ProgramExecutab
     return getCodeBlock<UnlinkedProgramCodeBlock>(vm, 0, executable, source, strictness, debuggerMode, profilerMode, error);
 }
 
+void CodeCache::addPrecompiledProgram(const SourceCode& source, PassRefPtr<PrecompiledProgram> program)
+{
+    SourceCodeKey key(source, String(), SourceCodeKey::ProgramType, JSParseNormal);
+    // Evict one entry, the way CodeCacheMap prunes; the rest may still be about to run.
+    if (m_precompiledPrograms.size() >= maximumPrecompiledPrograms && !m_precompiledPrograms.contains(key))
+        m_precompiledPrograms.remove(m_precompiledPrograms.begin());
+    m_precompiledPrograms.set(key, program);
+}
+
+PassRefPtr<PrecompiledProgram> CodeCache::takePrecompiledProgram(const SourceCodeKey& key)
+{
+    if (m_precompiledPrograms.isEmpty())
+        return 0;
+    return m_precompiledPrograms.take(key);
+}
+
 UnlinkedEvalCodeBlock* CodeCache::getEvalCodeBlock(VM& vm, JSScope* scope, EvalExecutable* executable, const SourceCode& source, JSParserStrictness strictness, DebuggerMode debuggerMode, ProfilerMode profilerMode, ParserError& error)
 {
     return getCodeBlock<UnlinkedEvalCodeBlock>(vm, scope, executable, source, strictness, debuggerMode, profilerMode, error);
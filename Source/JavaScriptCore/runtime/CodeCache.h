@@ -28,6 +28,7 @@
 
 #include "CodeSpecializationKind.h"
 #include "ParserModes.h"
+#include "ProgramPrecompiler.h"
 #include "SourceCode.h"
 #include "Strong.h"
 #include "WeakRandom.h"
@@ -80,6 +81,8 @@ public:
 
     unsigned hash() const { return m_hash; }
 
+    unsigned flags() const { return m_flags; }
+
     size_t length() const { return m_sourceCode.length(); }
 
     bool isNull() const { return m_sourceCode.isNull(); }
@@ -257,9 +260,14 @@ public:
     UnlinkedFunctionExecutable* getFunctionExecutableFromGlobalCode(VM&, const Identifier&, const SourceCode&, ParserError&);
     ~CodeCache();
 
+    // Programs compiled ahead of time on another thread, waiting to be evaluated.
+    void addPrecompiledProgram(const SourceCode&, PassRefPtr<PrecompiledProgram>);
+    JS_EXPORT_PRIVATE PassRefPtr<PrecompiledProgram> takePrecompiledProgram(const SourceCodeKey&);
+
     void clear()
     {
         m_sourceCode.clear();
+        m_precompiledPrograms.clear();
     }
 
 private:
@@ -272,6 +280,11 @@ private:
     UnlinkedCodeBlockType* generateBytecode(VM&, JSScope*, ExecutableType*, const SourceCode&, JSParserStrictness, DebuggerMode, ProfilerMode, ParserError&);
 
     CodeCacheMap m_sourceCode;
+
+    // Scripts that are fetched but never run should not pin their source forever.
+    static const unsigned maximumPrecompiledPrograms = 16;
+    typedef HashMap<SourceCodeKey, RefPtr<PrecompiledProgram>, SourceCodeKeyHash, SourceCodeKeyHashTraits> PrecompiledProgramMap;
+    PrecompiledProgramMap m_precompiledPrograms;
 };
 
 }
@@ -88,6 +88,7 @@
     macro(ignoreCase) \
     macro(index) \
     macro(inferredName) \
+    macro(inlineCaches) \
     macro(input) \
     macro(instructionCount) \
     macro(isArray) \
@@ -111,10 +112,13 @@
     macro(profiledBytecodes) \
     macro(propertyIsEnumerable) \
     macro(prototype) \
+    macro(repatchCount) \
     macro(set) \
+    macro(slowPathCount) \
     macro(source) \
     macro(sourceCode) \
     macro(stack) \
+    macro(state) \
     macro(test) \
     macro(toExponential) \
     macro(toFixed) \
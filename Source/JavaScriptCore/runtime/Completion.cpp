@@ -31,6 +31,7 @@
 #include "JSLock.h"
 #include "Operations.h"
 #include "Parser.h"
+#include "ProgramPrecompiler.h"
 #include <wtf/WTFThreadData.h>
 #include <stdio.h>
 
@@ -94,4 +95,12 @@ JSValue evaluate(ExecState* exec, const SourceCode& source, JSValue thisValue, J
     return result;
 }
 
+void precompileProgram(VM& vm, const SourceCode& source)
+{
+    JSLockHolder lock(vm);
+    RefPtr<PrecompiledProgram> program = PrecompiledProgram::create(source);
+    vm.codeCache()->addPrecompiledProgram(source, program);
+    ProgramPrecompiler::shared().enqueue(program.release());
+}
+
 } // namespace JSC
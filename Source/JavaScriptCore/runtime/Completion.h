@@ -37,6 +37,11 @@ namespace JSC {
     JS_EXPORT_PRIVATE bool checkSyntax(ExecState*, const SourceCode&, JSValue* exception = 0);
     JS_EXPORT_PRIVATE JSValue evaluate(ExecState*, const SourceCode&, JSValue thisValue = JSValue(), JSValue* exception = 0);
 
+    // Starts generating bytecode for the program on a background thread. When the same
+    // source is later evaluated in this VM, the result is picked up from the code cache
+    // instead of parsing the program again.
+    JS_EXPORT_PRIVATE void precompileProgram(VM&, const SourceCode&);
+
 } // namespace JSC
 
 #endif // Completion_h
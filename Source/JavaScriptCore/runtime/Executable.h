@@ -461,6 +461,8 @@ namespace JSC {
             return *m_evalCodeBlock;
         }
 
+        EvalCodeBlock* codeBlock() { return m_evalCodeBlock.get(); }
+
         static EvalExecutable* create(ExecState* exec, PassRefPtr<CodeCache> cache, const SourceCode& source, bool isInStrictContext)
         {
             EvalExecutable* executable = new (NotNull, allocateCell<EvalExecutable>(*exec->heap())) EvalExecutable(exec, cache, source, isInStrictContext);
@@ -539,6 +541,8 @@ namespace JSC {
             return *m_programCodeBlock;
         }
 
+        ProgramCodeBlock* codeBlock() { return m_programCodeBlock.get(); }
+
         JSObject* checkSyntax(ExecState*);
 
 #if ENABLE(JIT)
@@ -145,6 +145,14 @@ PassRefPtr<StringImpl> Identifier::addSlowCase(VM* vm, StringImpl* r)
                 return r;
     }
 
+    // Shared atomic strings are used by every thread, so they cannot carry the flag that
+    // ties an identifier to this thread's table. Use a private copy of the string instead.
+    if (r->isSharedAtomic()) {
+        if (r->is8Bit())
+            return add(vm, r->characters8(), r->length());
+        return add(vm, r->characters16(), r->length());
+    }
+
     return *vm->identifierTable->add(r).iterator;
 }
 
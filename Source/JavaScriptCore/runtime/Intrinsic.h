@@ -48,7 +48,23 @@ enum Intrinsic {
     RegExpExecIntrinsic,
     RegExpTestIntrinsic,
     StringPrototypeValueOfIntrinsic,
-    IMulIntrinsic
+    IMulIntrinsic,
+    DataViewGetInt8Intrinsic,
+    DataViewGetUint8Intrinsic,
+    DataViewGetInt16Intrinsic,
+    DataViewGetUint16Intrinsic,
+    DataViewGetInt32Intrinsic,
+    DataViewGetUint32Intrinsic,
+    DataViewGetFloat32Intrinsic,
+    DataViewGetFloat64Intrinsic,
+    DataViewSetInt8Intrinsic,
+    DataViewSetUint8Intrinsic,
+    DataViewSetInt16Intrinsic,
+    DataViewSetUint16Intrinsic,
+    DataViewSetInt32Intrinsic,
+    DataViewSetUint32Intrinsic,
+    DataViewSetFloat32Intrinsic,
+    DataViewSetFloat64Intrinsic
 };
 
 } // namespace JSC
@@ -34,9 +34,9 @@
 #include "IndexingHeaderInlines.h"
 #include "PropertyNameArray.h"
 #include "Reject.h"
-#include <wtf/AVLTree.h>
 #include <wtf/Assertions.h>
 #include <wtf/OwnPtr.h>
+#include <wtf/StableSort.h>
 #include <Operations.h>
 
 using namespace std;
@@ -940,32 +940,66 @@ bool JSArray::unshiftCountWithAnyIndexingType(ExecState* exec, unsigned startInd
     }
 }
 
-static int compareNumbersForQSortWithInt32(const void* a, const void* b)
-{
-    int32_t ia = static_cast<const JSValue*>(a)->asInt32();
-    int32_t ib = static_cast<const JSValue*>(b)->asInt32();
-    return ia - ib;
-}
+struct CompareInt32ValuesForSort {
+    bool operator()(JSValue a, JSValue b) { return a.asInt32() < b.asInt32(); }
+};
 
-static int compareNumbersForQSortWithDouble(const void* a, const void* b)
-{
-    double da = *static_cast<const double*>(a);
-    double db = *static_cast<const double*>(b);
-    return (da > db) - (da < db);
-}
+struct CompareDoublesForSort {
+    bool operator()(double a, double b) { return a < b; }
+};
 
-static int compareNumbersForQSort(const void* a, const void* b)
+struct CompareNumberValuesForSort {
+    bool operator()(JSValue a, JSValue b) { return a.asNumber() < b.asNumber(); }
+};
+
+static inline unsigned int32DigitsForSort(int32_t value, LChar* digitsEnd)
 {
-    double da = static_cast<const JSValue*>(a)->asNumber();
-    double db = static_cast<const JSValue*>(b)->asNumber();
-    return (da > db) - (da < db);
+    uint32_t magnitude = value < 0 ? -static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+    LChar* digits = digitsEnd;
+    do {
+        *--digits = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude);
+    return digitsEnd - digits;
 }
 
-static int compareByStringPairForQSort(const void* a, const void* b)
+// Orders int32 values the way their decimal strings would be ordered, without creating the strings.
+struct CompareInt32ValuesAsStringsForSort {
+    bool operator()(JSValue a, JSValue b)
+    {
+        int32_t x = a.asInt32();
+        int32_t y = b.asInt32();
+        if (x == y)
+            return false;
+        // '-' orders before every digit.
+        if ((x < 0) != (y < 0))
+            return x < 0;
+
+        const unsigned maximumDigits = 10;
+        LChar xDigits[maximumDigits];
+        LChar yDigits[maximumDigits];
+        unsigned xLength = int32DigitsForSort(x, xDigits + maximumDigits);
+        unsigned yLength = int32DigitsForSort(y, yDigits + maximumDigits);
+        int result = memcmp(xDigits + maximumDigits - xLength, yDigits + maximumDigits - yLength, min(xLength, yLength));
+        if (result)
+            return result < 0;
+        return xLength < yLength;
+    }
+};
+
+struct CompareValueStringPairsForSort {
+    bool operator()(const ValueStringPair* a, const ValueStringPair* b) { return codePointCompare(a->second, b->second) < 0; }
+};
+
+template<typename T, typename Predicate>
+static void sortWithMergeBuffer(ExecState* exec, T* values, unsigned length, Predicate compareLess)
 {
-    const ValueStringPair* va = static_cast<const ValueStringPair*>(a);
-    const ValueStringPair* vb = static_cast<const ValueStringPair*>(b);
-    return codePointCompare(va->second, vb->second);
+    Vector<T, 0, UnsafeVectorOverflow> buffer((length + 1) / 2);
+    if (!buffer.begin()) {
+        throwOutOfMemoryError(exec);
+        return;
+    }
+    stableSort(values, length, buffer.begin(), compareLess);
 }
 
 template<IndexingType indexingType>
@@ -1008,27 +1042,25 @@ void JSArray::sortNumericVector(ExecState* exec, JSValue compareFunction, CallTy
     if (!allValuesAreNumbers)
         return sort(exec, compareFunction, callType, callData);
     
-    // For numeric comparison, which is fast, qsort is faster than mergesort. We
-    // also don't require mergesort's stability, since there's no user visible
-    // side-effect from swapping the order of equal primitive values.
-    int (*compare)(const void*, const void*);
+    // The compare function is known to order numbers numerically, so we sort the storage
+    // in place without calling it. None of the values are cells, so no write barriers are
+    // needed. The sort is stable, which keeps the order of 0 and -0 intact.
+    ASSERT(data.length() >= newRelevantLength);
+    COMPILE_ASSERT(sizeof(WriteBarrier<Unknown>) == sizeof(JSValue), write_barrier_and_value_have_the_same_size);
     switch (indexingType) {
     case ArrayWithInt32:
-        compare = compareNumbersForQSortWithInt32;
+        sortWithMergeBuffer(exec, reinterpret_cast<JSValue*>(data.data()), newRelevantLength, CompareInt32ValuesForSort());
         break;
         
     case ArrayWithDouble:
-        compare = compareNumbersForQSortWithDouble;
         ASSERT(sizeof(WriteBarrier<Unknown>) == sizeof(double));
+        sortWithMergeBuffer(exec, reinterpret_cast<double*>(data.data()), newRelevantLength, CompareDoublesForSort());
         break;
         
     default:
-        compare = compareNumbersForQSort;
+        sortWithMergeBuffer(exec, reinterpret_cast<JSValue*>(data.data()), newRelevantLength, CompareNumberValuesForSort());
         break;
     }
-    ASSERT(data.length() >= newRelevantLength);
-    qsort(data.data(), newRelevantLength, sizeof(WriteBarrier<Unknown>), compare);
-    return;
 }
 
 void JSArray::sortNumeric(ExecState* exec, JSValue compareFunction, CallType callType, const CallData& callData)
@@ -1094,6 +1126,12 @@ void JSArray::sortCompactedVector(ExecState* exec, ContiguousData<StorageType> d
     if (!relevantLength)
         return;
     
+    if (indexingType == ArrayWithInt32) {
+        // Comparing the decimal digits directly avoids converting every element to a string.
+        sortWithMergeBuffer(exec, reinterpret_cast<JSValue*>(data.data()), relevantLength, CompareInt32ValuesAsStringsForSort());
+        return;
+    }
+
     VM& vm = exec->vm();
 
     // Converting JavaScript values to strings can be expensive, so we do it once up front and sort based on that.
@@ -1108,16 +1146,12 @@ void JSArray::sortCompactedVector(ExecState* exec, ContiguousData<StorageType> d
     }
         
     Heap::heap(this)->pushTempSortVector(&values);
-        
-    bool isSortingPrimitiveValues = true;
 
     for (size_t i = 0; i < relevantLength; i++) {
         JSValue value = ContiguousTypeAccessor<indexingType>::getAsValue(data, i);
         ASSERT(indexingType != ArrayWithInt32 || value.isInt32());
         ASSERT(!value.isUndefined());
         values[i].first = value;
-        if (indexingType != ArrayWithDouble && indexingType != ArrayWithInt32)
-            isSortingPrimitiveValues = isSortingPrimitiveValues && value.isPrimitive();
     }
         
     // FIXME: The following loop continues to call toString on subsequent values even after
@@ -1133,17 +1167,19 @@ void JSArray::sortCompactedVector(ExecState* exec, ContiguousData<StorageType> d
         
     // FIXME: Since we sort by string value, a fast algorithm might be to use a radix sort. That would be O(N) rather
     // than O(N log N).
-        
-#if HAVE(MERGESORT)
-    if (isSortingPrimitiveValues)
-        qsort(values.begin(), values.size(), sizeof(ValueStringPair), compareByStringPairForQSort);
-    else
-        mergesort(values.begin(), values.size(), sizeof(ValueStringPair), compareByStringPairForQSort);
-#else
-    // FIXME: The qsort library function is likely to not be a stable sort.
+
     // ECMAScript-262 does not specify a stable sort, but in practice, browsers perform a stable sort.
-    qsort(values.begin(), values.size(), sizeof(ValueStringPair), compareByStringPairForQSort);
-#endif
+    // Sorting pointers keeps the merges from copying the strings around.
+    Vector<ValueStringPair*, 0, UnsafeVectorOverflow> sortedValues(relevantLength + (relevantLength + 1) / 2);
+    if (!sortedValues.begin()) {
+        Heap::heap(this)->popTempSortVector(&values);
+        throwOutOfMemoryError(exec);
+        return;
+    }
+    for (size_t i = 0; i < relevantLength; i++)
+        sortedValues[i] = &values[i];
+    CompareValueStringPairsForSort compareLess;
+    stableSort(sortedValues.begin(), relevantLength, sortedValues.begin() + relevantLength, compareLess);
     
     // If the toString function changed the length of the array or vector storage,
     // increase the length to handle the orignal number of actual values.
@@ -1168,7 +1204,7 @@ void JSArray::sortCompactedVector(ExecState* exec, ContiguousData<StorageType> d
     }
 
     for (size_t i = 0; i < relevantLength; i++)
-        ContiguousTypeAccessor<indexingType>::setWithValue(vm, this, data, i, values[i].first);
+        ContiguousTypeAccessor<indexingType>::setWithValue(vm, this, data, i, sortedValues[i]->first);
     
     Heap::heap(this)->popTempSortVector(&values);
 }
@@ -1232,81 +1268,48 @@ void JSArray::sort(ExecState* exec)
     }
 }
 
-struct AVLTreeNodeForArrayCompare {
-    JSValue value;
-
-    // Child pointers.  The high bit of gt is robbed and used as the
-    // balance factor sign.  The high bit of lt is robbed and used as
-    // the magnitude of the balance factor.
-    int32_t gt;
-    int32_t lt;
-};
-
-struct AVLTreeAbstractorForArrayCompare {
-    typedef int32_t handle; // Handle is an index into m_nodes vector.
-    typedef JSValue key;
-    typedef int32_t size;
-
-    Vector<AVLTreeNodeForArrayCompare, 0, UnsafeVectorOverflow> m_nodes;
-    ExecState* m_exec;
-    JSValue m_compareFunction;
-    CallType m_compareCallType;
-    const CallData* m_compareCallData;
-    OwnPtr<CachedCall> m_cachedCall;
-
-    handle get_less(handle h) { return m_nodes[h].lt & 0x7FFFFFFF; }
-    void set_less(handle h, handle lh) { m_nodes[h].lt &= 0x80000000; m_nodes[h].lt |= lh; }
-    handle get_greater(handle h) { return m_nodes[h].gt & 0x7FFFFFFF; }
-    void set_greater(handle h, handle gh) { m_nodes[h].gt &= 0x80000000; m_nodes[h].gt |= gh; }
-
-    int get_balance_factor(handle h)
-    {
-        if (m_nodes[h].gt & 0x80000000)
-            return -1;
-        return static_cast<unsigned>(m_nodes[h].lt) >> 31;
-    }
-
-    void set_balance_factor(handle h, int bf)
+class CompareFunctionForSort {
+public:
+    CompareFunctionForSort(ExecState* exec, JSValue compareFunction, CallType callType, const CallData& callData)
+        : m_exec(exec)
+        , m_compareFunction(compareFunction)
+        , m_compareCallType(callType)
+        , m_compareCallData(callData)
     {
-        if (bf == 0) {
-            m_nodes[h].lt &= 0x7FFFFFFF;
-            m_nodes[h].gt &= 0x7FFFFFFF;
-        } else {
-            m_nodes[h].lt |= 0x80000000;
-            if (bf < 0)
-                m_nodes[h].gt |= 0x80000000;
-            else
-                m_nodes[h].gt &= 0x7FFFFFFF;
-        }
+        if (callType == CallTypeJS)
+            m_cachedCall = adoptPtr(new CachedCall(exec, jsCast<JSFunction*>(compareFunction), 2));
     }
 
-    int compare_key_key(key va, key vb)
+    bool operator()(JSValue a, JSValue b)
     {
-        ASSERT(!va.isUndefined());
-        ASSERT(!vb.isUndefined());
+        ASSERT(!a.isUndefined());
+        ASSERT(!b.isUndefined());
 
+        // Once the compare function has thrown, leave the remaining elements where they are.
         if (m_exec->hadException())
-            return 1;
+            return false;
 
         double compareResult;
         if (m_cachedCall) {
             m_cachedCall->setThis(jsUndefined());
-            m_cachedCall->setArgument(0, va);
-            m_cachedCall->setArgument(1, vb);
+            m_cachedCall->setArgument(0, a);
+            m_cachedCall->setArgument(1, b);
             compareResult = m_cachedCall->call().toNumber(m_cachedCall->newCallFrame(m_exec));
         } else {
             MarkedArgumentBuffer arguments;
-            arguments.append(va);
-            arguments.append(vb);
-            compareResult = call(m_exec, m_compareFunction, m_compareCallType, *m_compareCallData, jsUndefined(), arguments).toNumber(m_exec);
+            arguments.append(a);
+            arguments.append(b);
+            compareResult = call(m_exec, m_compareFunction, m_compareCallType, m_compareCallData, jsUndefined(), arguments).toNumber(m_exec);
         }
-        return (compareResult < 0) ? -1 : 1; // Not passing equality through, because we need to store all values, even if equivalent.
+        return compareResult < 0;
     }
 
-    int compare_key_node(key k, handle h) { return compare_key_key(k, m_nodes[h].value); }
-    int compare_node_node(handle h1, handle h2) { return compare_key_key(m_nodes[h1].value, m_nodes[h2].value); }
-
-    static handle null() { return 0x7FFFFFFF; }
+private:
+    ExecState* m_exec;
+    JSValue m_compareFunction;
+    CallType m_compareCallType;
+    const CallData& m_compareCallData;
+    OwnPtr<CachedCall> m_cachedCall;
 };
 
 template<IndexingType indexingType>
@@ -1315,86 +1318,62 @@ void JSArray::sortVector(ExecState* exec, JSValue compareFunction, CallType call
     ASSERT(!inSparseIndexingMode());
     ASSERT(indexingType == structure()->indexingType());
     
-    // FIXME: This ignores exceptions raised in the compare function or in toNumber.
-        
-    // The maximum tree depth is compiled in - but the caller is clearly up to no good
-    // if a larger array is passed.
-    ASSERT(m_butterfly->publicLength() <= static_cast<unsigned>(std::numeric_limits<int>::max()));
-    if (m_butterfly->publicLength() > static_cast<unsigned>(std::numeric_limits<int>::max()))
-        return;
-        
+    // FIXME: This ignores exceptions raised in toNumber.
+
     unsigned usedVectorLength = relevantLength<indexingType>();
-    unsigned nodeCount = usedVectorLength;
-        
-    if (!nodeCount)
+    if (!usedVectorLength)
         return;
-        
-    AVLTree<AVLTreeAbstractorForArrayCompare, 44> tree; // Depth 44 is enough for 2^31 items
-    tree.abstractor().m_exec = exec;
-    tree.abstractor().m_compareFunction = compareFunction;
-    tree.abstractor().m_compareCallType = callType;
-    tree.abstractor().m_compareCallData = &callData;
-    tree.abstractor().m_nodes.grow(nodeCount);
-        
-    if (callType == CallTypeJS)
-        tree.abstractor().m_cachedCall = adoptPtr(new CachedCall(exec, jsCast<JSFunction*>(compareFunction), 2));
-        
-    if (!tree.abstractor().m_nodes.begin()) {
+
+    // The defined values are copied out and sorted on the side, so the compare function never
+    // sees a half sorted array. The merge buffer lives in the same vector, right after them,
+    // which lets the collector find every value while the compare function runs.
+    Vector<JSValue, 0, UnsafeVectorOverflow> values(usedVectorLength + (usedVectorLength + 1) / 2);
+    if (!values.begin()) {
         throwOutOfMemoryError(exec);
         return;
     }
         
     // FIXME: If the compare function modifies the array, the vector, map, etc. could be modified
-    // right out from under us while we're building the tree here.
+    // right out from under us while we're sorting here.
         
     unsigned numDefined = 0;
     unsigned numUndefined = 0;
     
-    // Iterate over the array, ignoring missing values, counting undefined ones, and inserting all other ones into the tree.
-    for (; numDefined < usedVectorLength; ++numDefined) {
-        if (numDefined >= m_butterfly->vectorLength())
-            break;
-        JSValue v = getHolyIndexQuickly(numDefined);
-        if (!v || v.isUndefined())
-            break;
-        tree.abstractor().m_nodes[numDefined].value = v;
-        tree.insert(numDefined);
-    }
-    for (unsigned i = numDefined; i < usedVectorLength; ++i) {
+    // Iterate over the array, ignoring missing values and counting undefined ones.
+    for (unsigned i = 0; i < usedVectorLength; ++i) {
         if (i >= m_butterfly->vectorLength())
             break;
         JSValue v = getHolyIndexQuickly(i);
-        if (v) {
-            if (v.isUndefined())
-                ++numUndefined;
-            else {
-                tree.abstractor().m_nodes[numDefined].value = v;
-                tree.insert(numDefined);
-                ++numDefined;
-            }
-        }
+        if (!v)
+            continue;
+        if (v.isUndefined())
+            ++numUndefined;
+        else
+            values[numDefined++] = v;
     }
+
+    Heap::heap(this)->pushTempSortVector(&values);
+    CompareFunctionForSort compareLess(exec, compareFunction, callType, callData);
+    stableSort(values.begin(), numDefined, values.begin() + numDefined, compareLess);
+    Heap::heap(this)->popTempSortVector(&values);
     
     unsigned newUsedVectorLength = numDefined + numUndefined;
         
     // The array size may have changed. Figure out the new bounds.
     unsigned newestUsedVectorLength = currentRelevantLength();
         
-    unsigned elementsToExtractThreshold = min(min(newestUsedVectorLength, numDefined), static_cast<unsigned>(tree.abstractor().m_nodes.size()));
+    unsigned elementsToExtractThreshold = min(newestUsedVectorLength, numDefined);
     unsigned undefinedElementsThreshold = min(newestUsedVectorLength, newUsedVectorLength);
     unsigned clearElementsThreshold = min(newestUsedVectorLength, usedVectorLength);
         
     // Copy the values back into m_storage.
-    AVLTree<AVLTreeAbstractorForArrayCompare, 44>::Iterator iter;
-    iter.start_iter_least(tree);
     VM& vm = exec->vm();
     for (unsigned i = 0; i < elementsToExtractThreshold; ++i) {
         ASSERT(i < butterfly()->vectorLength());
         if (structure()->indexingType() == ArrayWithDouble)
-            butterfly()->contiguousDouble()[i] = tree.abstractor().m_nodes[*iter].value.asNumber();
+            butterfly()->contiguousDouble()[i] = values[i].asNumber();
         else
-            currentIndexingData()[i].set(vm, this, tree.abstractor().m_nodes[*iter].value);
-        ++iter;
+            currentIndexingData()[i].set(vm, this, values[i]);
     }
     // Put undefined values back in.
     switch (structure()->indexingType()) {
@@ -38,7 +38,10 @@
 #include "ObjectConstructor.h"
 #include "Operations.h"
 #include "PropertyNameArray.h"
+#include <wtf/HashMap.h>
 #include <wtf/MathExtras.h>
+#include <wtf/OwnPtr.h>
+#include <wtf/PassOwnPtr.h>
 #include <wtf/text/StringBuilder.h>
 
 namespace JSC {
@@ -107,6 +110,22 @@ private:
 
     friend class Holder;
 
+    // Plain objects and arrays that cannot run any JavaScript while being serialized
+    // are written straight from their storage, skipping the Holder machinery.
+    struct FastPathStructureInfo {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        bool canUseFastPath;
+        // The quoted and escaped property name, followed by ':', for each enumerable property.
+        Vector<std::pair<PropertyOffset, String> > properties;
+    };
+
+    bool canUseFastPath() const { return !m_usingArrayReplacer && m_replacerCallType == CallTypeNone && m_gap.isEmpty(); }
+    const FastPathStructureInfo& fastPathStructureInfo(JSObject*);
+    bool appendFastPathValue(StringBuilder&, JSValue, bool inArray);
+    bool appendFastPathObject(StringBuilder&, JSObject*);
+    bool appendFastPathArray(StringBuilder&, JSArray*);
+
     static void appendQuotedString(StringBuilder&, const String&);
 
     JSValue toJSON(JSValue, const PropertyNameForFunctionCall&);
@@ -130,6 +149,9 @@ private:
     Vector<Holder, 16, UnsafeVectorOverflow> m_holderStack;
     String m_repeatedGap;
     String m_indent;
+
+    Vector<JSObject*, 16> m_fastPathStack;
+    HashMap<Structure*, OwnPtr<FastPathStructureInfo> > m_fastPathStructureInfos;
 };
 
 // ------------------------------ helper functions --------------------------------
@@ -245,6 +267,18 @@ Local<Unknown> Stringifier::stringify(Handle<Unknown> value)
     PropertyNameForFunctionCall emptyPropertyName(m_exec->vm().propertyNames->emptyIdentifier);
     object->putDirect(m_exec->vm(), m_exec->vm().propertyNames->emptyIdentifier, value.get());
 
+    if (canUseFastPath() && value.isObject()) {
+        StringBuilder result;
+        if (appendFastPathValue(result, value.get(), false)) {
+            ASSERT(!m_exec->hadException());
+            return Local<Unknown>(m_exec->vm(), jsString(m_exec, result.toString()));
+        }
+        // The fast path has no side effects, so we can simply start over.
+        m_fastPathStack.clear();
+        if (m_exec->hadException())
+            return Local<Unknown>(m_exec->vm(), jsNull());
+    }
+
     StringBuilder result;
     if (appendStringifiedValue(result, value.get(), object, emptyPropertyName) != StringifySucceeded)
         return Local<Unknown>(m_exec->vm(), jsUndefined());
@@ -430,6 +464,178 @@ Stringifier::StringifyResult Stringifier::appendStringifiedValue(StringBuilder&
     return StringifySucceeded;
 }
 
+// We clamp the recursion of the fast path; deeper values take the regular path.
+static const unsigned maximumFastPathDepth = 128;
+
+const Stringifier::FastPathStructureInfo& Stringifier::fastPathStructureInfo(JSObject* object)
+{
+    Structure* structure = object->structure();
+    HashMap<Structure*, OwnPtr<FastPathStructureInfo> >::AddResult result = m_fastPathStructureInfos.add(structure, nullptr);
+    if (!result.isNewEntry)
+        return *result.iterator->value;
+
+    OwnPtr<FastPathStructureInfo> info = adoptPtr(new FastPathStructureInfo);
+    // No JavaScript runs on the fast path, so the Structure, and thus the prototype chain, of every
+    // object we see stays the same for the whole call.
+    bool isArray = isJSArray(object);
+    info->canUseFastPath = !structure->hasGetterSetterProperties()
+        && (isArray || !hasIndexedProperties(structure->indexingType()))
+        && !object->hasProperty(m_exec, m_exec->vm().propertyNames->toJSON)
+        && !m_exec->hadException();
+
+    if (info->canUseFastPath && !isArray) {
+        PropertyNameArray propertyNames(m_exec);
+        structure->getPropertyNamesFromStructure(m_exec->vm(), propertyNames, ExcludeDontEnumProperties);
+        info->properties.reserveInitialCapacity(propertyNames.size());
+        for (size_t i = 0; i < propertyNames.size(); ++i) {
+            PropertyOffset offset = structure->get(m_exec->vm(), propertyNames[i]);
+            ASSERT(isValidOffset(offset));
+            StringBuilder key;
+            appendQuotedString(key, propertyNames[i].string());
+            key.append(':');
+            info->properties.uncheckedAppend(std::make_pair(offset, key.toString()));
+        }
+    }
+
+    result.iterator->value = info.release();
+    return *result.iterator->value;
+}
+
+bool Stringifier::appendFastPathValue(StringBuilder& builder, JSValue value, bool inArray)
+{
+    if (value.isUndefined()) {
+        ASSERT(inArray);
+        builder.appendLiteral("null");
+        return true;
+    }
+
+    if (value.isNull()) {
+        builder.appendLiteral("null");
+        return true;
+    }
+
+    if (value.isBoolean()) {
+        if (value.isTrue())
+            builder.appendLiteral("true");
+        else
+            builder.appendLiteral("false");
+        return true;
+    }
+
+    if (value.isInt32()) {
+        builder.appendNumber(value.asInt32());
+        return true;
+    }
+
+    if (value.isNumber()) {
+        double number = value.asNumber();
+        if (!std::isfinite(number))
+            builder.appendLiteral("null");
+        else
+            builder.append(String::numberToStringECMAScript(number));
+        return true;
+    }
+
+    if (value.isString()) {
+        const String& string = asString(value)->value(m_exec);
+        if (m_exec->hadException())
+            return false;
+        appendQuotedString(builder, string);
+        return true;
+    }
+
+    if (!value.isObject())
+        return false;
+
+    JSObject* object = asObject(value);
+    const ClassInfo* classInfo = object->classInfo();
+    if (classInfo != &JSFinalObject::s_info && classInfo != &JSArray::s_info)
+        return false;
+
+    // Cycles, and the TypeError they raise, are left to the regular path.
+    if (m_fastPathStack.size() >= maximumFastPathDepth || m_fastPathStack.contains(object))
+        return false;
+
+    if (!fastPathStructureInfo(object).canUseFastPath)
+        return false;
+
+    m_fastPathStack.append(object);
+    bool success = classInfo == &JSArray::s_info ? appendFastPathArray(builder, asArray(object)) : appendFastPathObject(builder, object);
+    m_fastPathStack.removeLast();
+    return success;
+}
+
+bool Stringifier::appendFastPathObject(StringBuilder& builder, JSObject* object)
+{
+    const FastPathStructureInfo& info = fastPathStructureInfo(object);
+
+    builder.append('{');
+    bool needsComma = false;
+    for (size_t i = 0; i < info.properties.size(); ++i) {
+        JSValue value = object->getDirect(info.properties[i].first);
+        // Undefined properties are left out of objects, but functions need the regular path.
+        if (value.isUndefined())
+            continue;
+        if (needsComma)
+            builder.append(',');
+        builder.append(info.properties[i].second);
+        if (!appendFastPathValue(builder, value, false))
+            return false;
+        needsComma = true;
+    }
+    builder.append('}');
+    return true;
+}
+
+bool Stringifier::appendFastPathArray(StringBuilder& builder, JSArray* array)
+{
+    Butterfly* butterfly = array->butterfly();
+    IndexingType indexingType = array->structure()->indexingType();
+    unsigned length;
+    switch (indexingType) {
+    case ArrayClass:
+        length = 0;
+        break;
+
+    case ArrayWithUndecided:
+        if (butterfly->publicLength())
+            return false;
+        length = 0;
+        break;
+
+    case ArrayWithInt32:
+    case ArrayWithDouble:
+    case ArrayWithContiguous:
+        length = butterfly->publicLength();
+        break;
+
+    default:
+        return false;
+    }
+
+    builder.append('[');
+    for (unsigned i = 0; i < length; ++i) {
+        if (i)
+            builder.append(',');
+
+        // Holes would be looked up on the prototype chain, so leave them to the regular path.
+        if (indexingType == ArrayWithDouble) {
+            double number = butterfly->contiguousDouble()[i];
+            if (number != number)
+                return false;
+            if (!appendFastPathValue(builder, JSValue(JSValue::EncodeAsDouble, number), true))
+                return false;
+            continue;
+        }
+
+        JSValue value = butterfly->contiguous()[i].get();
+        if (!value || !appendFastPathValue(builder, value, true))
+            return false;
+    }
+    builder.append(']');
+    return true;
+}
+
 inline bool Stringifier::willIndent() const
 {
     return !m_gap.isEmpty();
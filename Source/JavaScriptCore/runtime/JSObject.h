@@ -83,6 +83,7 @@ enum Attribute {
     DontDelete   = 1 << 3,  // property can't be deleted
     Function     = 1 << 4,  // property is a function - only used by static hashtables
     Accessor     = 1 << 5,  // property is a getter/setter
+    DirectGetter = 1 << 0,  // property getter is a PropertySlot::DirectGetValueFunc - only used by static hashtables
 };
 
 COMPILE_ASSERT(None < FirstInternalAttribute, None_is_below_FirstInternalAttribute);
@@ -91,6 +92,7 @@ COMPILE_ASSERT(DontEnum < FirstInternalAttribute, DontEnum_is_below_FirstInterna
 COMPILE_ASSERT(DontDelete < FirstInternalAttribute, DontDelete_is_below_FirstInternalAttribute);
 COMPILE_ASSERT(Function < FirstInternalAttribute, Function_is_below_FirstInternalAttribute);
 COMPILE_ASSERT(Accessor < FirstInternalAttribute, Accessor_is_below_FirstInternalAttribute);
+COMPILE_ASSERT(DirectGetter < FirstInternalAttribute, DirectGetter_is_below_FirstInternalAttribute);
 
 class JSFinalObject;
 
@@ -1014,6 +1016,7 @@ public:
     }
 
     static JSFinalObject* create(ExecState*, Structure*);
+    static JSFinalObject* create(ExecState*, Structure*, MarkedAllocator&);
     static Structure* createStructure(VM& vm, JSGlobalObject* globalObject, JSValue prototype, unsigned inlineCapacity)
     {
         return Structure::create(vm, globalObject, prototype, TypeInfo(FinalObjectType, StructureFlags), &s_info, NonArray, inlineCapacity);
@@ -1057,6 +1060,19 @@ inline JSFinalObject* JSFinalObject::create(ExecState* exec, Structure* structur
     return finalObject;
 }
 
+inline JSFinalObject* JSFinalObject::create(ExecState* exec, Structure* structure, MarkedAllocator& allocator)
+{
+    size_t size = allocationSize(structure->inlineCapacity());
+    ASSERT(!allocator.cellSize() || size <= allocator.cellSize());
+#if ENABLE(GC_VALIDATION)
+    ASSERT(!exec->vm().isInitializingObject());
+    exec->vm().setInitializingObjectClass(&s_info);
+#endif
+    JSFinalObject* finalObject = new (NotNull, allocator.allocate(size)) JSFinalObject(exec->vm(), structure);
+    finalObject->finishCreation(exec->vm());
+    return finalObject;
+}
+
 inline bool isJSFinalObject(JSCell* cell)
 {
     return cell->classInfo() == &JSFinalObject::s_info;
@@ -29,6 +29,7 @@
 #include "config.h"
 #include "JSPropertyNameIterator.h"
 
+#include "JSArray.h"
 #include "JSGlobalObject.h"
 
 namespace JSC {
@@ -38,16 +39,75 @@ const ClassInfo JSPropertyNameIterator::s_info = { "JSPropertyNameIterator", 0,
 inline JSPropertyNameIterator::JSPropertyNameIterator(ExecState* exec, PropertyNameArrayData* propertyNameArrayData, size_t numCacheableSlots)
     : JSCell(exec->vm(), exec->vm().propertyNameIteratorStructure.get())
     , m_numCacheableSlots(numCacheableSlots)
+    , m_cachedIndexedLength(0)
     , m_jsStringsSize(propertyNameArrayData->propertyNameVector().size())
     , m_jsStrings(adoptArrayPtr(new WriteBarrier<Unknown>[m_jsStringsSize]))
 {
 }
 
+// Returns false if the indexed properties of the object can't be described by
+// a length alone, i.e. the storage has holes or may be sparse.
+static bool denseIndexedLength(JSObject* object, unsigned& length)
+{
+    length = 0;
+    switch (object->structure()->indexingType()) {
+    case ALL_BLANK_INDEXING_TYPES:
+    case ALL_UNDECIDED_INDEXING_TYPES:
+        return true;
+
+    case ALL_INT32_INDEXING_TYPES:
+    case ALL_CONTIGUOUS_INDEXING_TYPES: {
+        Butterfly* butterfly = object->butterfly();
+        unsigned publicLength = butterfly->publicLength();
+        for (unsigned i = 0; i < publicLength; ++i) {
+            if (!butterfly->contiguous()[i])
+                return false;
+        }
+        length = publicLength;
+        return true;
+    }
+
+    case ALL_DOUBLE_INDEXING_TYPES: {
+        Butterfly* butterfly = object->butterfly();
+        unsigned publicLength = butterfly->publicLength();
+        for (unsigned i = 0; i < publicLength; ++i) {
+            double value = butterfly->contiguousDouble()[i];
+            if (value != value)
+                return false;
+        }
+        length = publicLength;
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+// JSArray only overrides getOwnNonIndexPropertyNames to report "length", which
+// is DontEnum, so arrays enumerate as cacheably as plain objects do.
+static bool overridesEnumeration(Structure* structure)
+{
+    if (!structure->typeInfo().overridesGetPropertyNames())
+        return false;
+    const MethodTable& methodTable = structure->classInfo()->methodTable;
+    return methodTable.getPropertyNames != JSObject::getPropertyNames
+        || methodTable.getOwnPropertyNames != JSObject::getOwnPropertyNames
+        || methodTable.getOwnNonIndexPropertyNames != JSArray::s_info.methodTable.getOwnNonIndexPropertyNames;
+}
+
+bool JSPropertyNameIterator::hasMatchingIndexedStorage(JSObject* object)
+{
+    unsigned length;
+    return denseIndexedLength(object, length) && length == m_cachedIndexedLength;
+}
+
 JSPropertyNameIterator* JSPropertyNameIterator::create(ExecState* exec, JSObject* o)
 {
     ASSERT(!o->structure()->enumerationCache() ||
             o->structure()->enumerationCache()->cachedStructure() != o->structure() ||
-            o->structure()->enumerationCache()->cachedPrototypeChain() != o->structure()->prototypeChain(exec));
+            o->structure()->enumerationCache()->cachedPrototypeChain() != o->structure()->prototypeChain(exec) ||
+            !o->structure()->enumerationCache()->hasMatchingIndexedStorage(o));
 
     PropertyNameArray propertyNames(exec);
     o->methodTable()->getPropertyNames(o, exec, propertyNames, ExcludeDontEnumProperties);
@@ -62,20 +122,22 @@ JSPropertyNameIterator* JSPropertyNameIterator::create(ExecState* exec, JSObject
     if (o->structure()->isDictionary())
         return jsPropertyNameIterator;
 
-    if (o->structure()->typeInfo().overridesGetPropertyNames())
+    if (overridesEnumeration(o->structure()))
         return jsPropertyNameIterator;
     
-    if (hasIndexingHeader(o->structure()->indexingType()))
+    unsigned indexedLength;
+    if (!denseIndexedLength(o, indexedLength))
         return jsPropertyNameIterator;
     
     size_t count = normalizePrototypeChain(exec, o);
     StructureChain* structureChain = o->structure()->prototypeChain(exec);
     WriteBarrier<Structure>* structure = structureChain->head();
     for (size_t i = 0; i < count; ++i) {
-        if (structure[i]->typeInfo().overridesGetPropertyNames())
+        if (overridesEnumeration(structure[i].get()))
             return jsPropertyNameIterator;
     }
 
+    jsPropertyNameIterator->m_cachedIndexedLength = indexedLength;
     jsPropertyNameIterator->setCachedPrototypeChain(exec->vm(), structureChain);
     jsPropertyNameIterator->setCachedStructure(exec->vm(), o->structure());
     o->structure()->setEnumerationCache(exec->vm(), jsPropertyNameIterator);
@@ -90,7 +152,7 @@ void JSPropertyNameIterator::destroy(JSCell* cell)
 JSValue JSPropertyNameIterator::get(ExecState* exec, JSObject* base, size_t i)
 {
     JSValue identifier = m_jsStrings[i].get();
-    if (m_cachedStructure.get() == base->structure() && m_cachedPrototypeChain.get() == base->structure()->prototypeChain(exec))
+    if (i >= m_cachedIndexedLength && m_cachedStructure.get() == base->structure() && m_cachedPrototypeChain.get() == base->structure()->prototypeChain(exec))
         return identifier;
 
     if (!base->hasProperty(exec, Identifier(exec, asString(identifier)->value(exec))))
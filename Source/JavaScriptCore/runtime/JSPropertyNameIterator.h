@@ -72,6 +72,13 @@ namespace JSC {
 
         void setCachedPrototypeChain(VM& vm, StructureChain* cachedPrototypeChain) { m_cachedPrototypeChain.set(vm, this, cachedPrototypeChain); }
         StructureChain* cachedPrototypeChain() { return m_cachedPrototypeChain.get(); }
+
+        // Index names always come first, so the first m_cachedIndexedLength
+        // entries of m_jsStrings are "0" ... "length - 1". The cache is only
+        // valid for an object whose indexed storage still has that many
+        // elements and no holes.
+        uint32_t cachedIndexedLength() { return m_cachedIndexedLength; }
+        bool hasMatchingIndexedStorage(JSObject*);
         
         static JS_EXPORTDATA const ClassInfo s_info;
 
@@ -93,6 +100,7 @@ namespace JSC {
         WriteBarrier<Structure> m_cachedStructure;
         WriteBarrier<StructureChain> m_cachedPrototypeChain;
         uint32_t m_numCacheableSlots;
+        uint32_t m_cachedIndexedLength;
         uint32_t m_jsStringsSize;
         unsigned m_cachedStructureInlineCapacity;
         OwnArrayPtr<WriteBarrier<Unknown> > m_jsStrings;
@@ -228,6 +228,9 @@ void JSRopeString::outOfMemory(ExecState* exec) const
 JSString* JSRopeString::getIndexSlowCase(ExecState* exec, unsigned i)
 {
     ASSERT(isRope());
+    UChar character;
+    if (tryGetCharacterAt(i, character))
+        return jsSingleCharacterString(&exec->vm(), character);
     resolveRope(exec);
     // Return a safe no-value result, this should never be used, since the excetion will be thrown.
     if (exec->exception())
@@ -237,6 +240,193 @@ JSString* JSRopeString::getIndexSlowCase(ExecState* exec, unsigned i)
     return jsSingleCharacterSubstring(exec, m_value, i);
 }
 
+// Ropes built by repeated concatenation are deep on one side, so walks down a
+// rope give up past this depth and let the caller resolve the rope instead.
+static const unsigned maximumRopeWalkDepth = 32;
+
+// Matches that straddle fibers are found by keeping the last few characters of the
+// preceding fibers, so searching a rope is only attempted for short search strings.
+static const unsigned maximumRopeSearchLength = 32;
+
+// A search visits every leaf up to the match, so it gives up on ropes with more
+// leaves than this. A rope that keeps being searched is resolved once instead of
+// being walked again each time.
+static const unsigned maximumRopeSearchLeafCount = 64;
+static const unsigned maximumRopeSearchesBeforeResolving = 4;
+
+bool JSRopeString::tryGetCharacterAt(unsigned index, UChar& result) const
+{
+    ASSERT(index < m_length);
+    const JSString* current = this;
+    for (unsigned depth = 0; current->isRope(); ++depth) {
+        if (depth == maximumRopeWalkDepth)
+            return false;
+        const JSRopeString* rope = static_cast<const JSRopeString*>(current);
+        for (size_t i = 0; i < s_maxInternalRopeLength && rope->m_fibers[i]; ++i) {
+            JSString* fiber = rope->m_fibers[i].get();
+            if (index < fiber->length()) {
+                current = fiber;
+                break;
+            }
+            index -= fiber->length();
+        }
+        ASSERT(current != rope);
+    }
+    result = current->m_value[index];
+    return true;
+}
+
+// Builds the substring out of the fibers it covers: whole fibers are shared, and
+// partially covered ones are sliced, so the rope itself is never resolved. Returns
+// 0 if that would need too deep a walk.
+JSString* JSRopeString::tryGetSubstring(VM& vm, unsigned offset, unsigned length, unsigned depth)
+{
+    ASSERT(length && length < m_length);
+    ASSERT(offset + length <= m_length);
+    if (depth == maximumRopeWalkDepth)
+        return 0;
+
+    JSString* pieces[s_maxInternalRopeLength];
+    unsigned pieceCount = 0;
+    unsigned end = offset + length;
+    unsigned fiberStart = 0;
+    for (size_t i = 0; i < s_maxInternalRopeLength && m_fibers[i] && fiberStart < end; ++i) {
+        JSString* fiber = m_fibers[i].get();
+        unsigned fiberLength = fiber->length();
+        unsigned fiberEnd = fiberStart + fiberLength;
+        if (offset < fiberEnd) {
+            unsigned pieceStart = std::max(offset, fiberStart) - fiberStart;
+            unsigned pieceLength = std::min(end, fiberEnd) - fiberStart - pieceStart;
+            JSString* piece;
+            if (pieceLength == fiberLength)
+                piece = fiber;
+            else if (!fiber->isRope())
+                piece = jsSubstring(&vm, fiber->m_value, pieceStart, pieceLength);
+            else if (!(piece = static_cast<JSRopeString*>(fiber)->tryGetSubstring(vm, pieceStart, pieceLength, depth + 1)))
+                return 0;
+            pieces[pieceCount++] = piece;
+        }
+        fiberStart = fiberEnd;
+    }
+
+    ASSERT(pieceCount);
+    if (pieceCount == 1)
+        return pieces[0];
+    if (pieceCount == 2)
+        return JSRopeString::create(vm, pieces[0], pieces[1]);
+    return JSRopeString::create(vm, pieces[0], pieces[1], pieces[2]);
+}
+
+// Visits the leaf fibers in order. Each leaf is searched directly, and the last
+// searchLength - 1 characters seen so far are carried over so that a match
+// spanning the boundary into the next leaf is found as well.
+bool JSRopeString::tryFind(const String& searchString, unsigned start, size_t& result) const
+{
+    unsigned searchLength = searchString.length();
+    if (searchLength > maximumRopeSearchLength)
+        return false;
+    if (!searchLength) {
+        result = std::min(start, m_length);
+        return true;
+    }
+    if (start > m_length || searchLength > m_length - start) {
+        result = notFound;
+        return true;
+    }
+
+    // Each entry is a string still to visit along with its depth in the rope.
+    Vector<std::pair<const JSString*, unsigned>, 32, UnsafeVectorOverflow> workQueue; // There are no GC points in this method.
+    workQueue.append(std::make_pair(static_cast<const JSString*>(this), 0u));
+    Vector<UChar, 2 * maximumRopeSearchLength> window;
+    unsigned windowStart = 0;
+    unsigned leafStart = 0;
+    unsigned leafCount = 0;
+    while (!workQueue.isEmpty()) {
+        const JSString* current = workQueue.last().first;
+        unsigned depth = workQueue.last().second;
+        workQueue.removeLast();
+
+        if (current->isRope()) {
+            if (depth == maximumRopeWalkDepth)
+                return false;
+            const JSRopeString* rope = static_cast<const JSRopeString*>(current);
+            size_t fiberCount = 0;
+            while (fiberCount < s_maxInternalRopeLength && rope->m_fibers[fiberCount])
+                ++fiberCount;
+            for (size_t i = fiberCount; i--;)
+                workQueue.append(std::make_pair(static_cast<const JSString*>(rope->m_fibers[i].get()), depth + 1));
+            continue;
+        }
+
+        if (++leafCount > maximumRopeSearchLeafCount)
+            return false;
+
+        const String& leaf = current->m_value;
+        unsigned leafLength = leaf.length();
+        unsigned leafEnd = leafStart + leafLength;
+
+        // Matches that begin in the carried characters and end in this leaf.
+        if (!window.isEmpty()) {
+            unsigned carried = window.size();
+            for (unsigned i = 0; i < std::min(leafLength, searchLength - 1); ++i)
+                window.append(leaf[i]);
+            for (unsigned i = 0; i < carried && i + searchLength <= window.size(); ++i) {
+                if (windowStart + i < start)
+                    continue;
+                unsigned j = 0;
+                while (j < searchLength && window[i + j] == searchString[j])
+                    ++j;
+                if (j == searchLength) {
+                    result = windowStart + i;
+                    return true;
+                }
+            }
+            window.shrink(carried);
+        }
+
+        // Matches that lie entirely within this leaf.
+        if (leafEnd > start && leafLength >= searchLength) {
+            size_t found = leaf.find(searchString, start > leafStart ? start - leafStart : 0);
+            if (found != notFound) {
+                result = leafStart + found;
+                return true;
+            }
+        }
+
+        // Carry the last searchLength - 1 characters into the next leaf.
+        for (unsigned i = leafLength > searchLength - 1 ? leafLength - (searchLength - 1) : 0; i < leafLength; ++i)
+            window.append(leaf[i]);
+        if (window.size() > searchLength - 1)
+            window.remove(0, window.size() - (searchLength - 1));
+        windowStart = leafEnd - window.size();
+        leafStart = leafEnd;
+    }
+
+    result = notFound;
+    return true;
+}
+
+bool JSRopeString::shouldSearchWithoutResolving()
+{
+    COMPILE_ASSERT(maximumRopeSearchesBeforeResolving <= searchCountMask >> searchCountShift, SearchCountFitsInFlags);
+    unsigned searchCount = (m_flags & searchCountMask) >> searchCountShift;
+    if (searchCount == maximumRopeSearchesBeforeResolving)
+        return false;
+    m_flags = (m_flags & ~searchCountMask) | ((searchCount + 1) << searchCountShift);
+    return true;
+}
+
+size_t JSString::find(ExecState* exec, const String& searchString, unsigned start)
+{
+    size_t result;
+    if (isRope()) {
+        JSRopeString* rope = static_cast<JSRopeString*>(this);
+        if (rope->shouldSearchWithoutResolving() && rope->tryFind(searchString, start, result))
+            return result;
+    }
+    return value(exec).find(searchString, start);
+}
+
 JSValue JSString::toPrimitive(ExecState*, PreferredPrimitiveType) const
 {
     return const_cast<JSString*>(this);
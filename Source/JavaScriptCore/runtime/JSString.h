@@ -153,6 +153,11 @@ public:
     bool canGetIndex(unsigned i) { return i < m_length; }
     JSString* getIndex(ExecState*, unsigned);
 
+    // Read-only queries that walk the fibers of a rope instead of resolving it,
+    // as long as the walk stays short.
+    UChar characterAt(ExecState*, unsigned);
+    size_t find(ExecState*, const String& searchString, unsigned start);
+
     static Structure* createStructure(VM& vm, JSGlobalObject* globalObject, JSValue proto)
     {
         return Structure::create(vm, globalObject, proto, TypeInfo(StringType, OverridesGetOwnPropertySlot | InterceptsGetOwnPropertySlotByIndexEvenWhenLengthIsNotZero), &s_info);
@@ -325,6 +330,18 @@ private:
         
     JSString* getIndexSlowCase(ExecState*, unsigned);
 
+    friend JSString* jsSubstring(ExecState*, JSString*, unsigned offset, unsigned length);
+
+    bool tryGetCharacterAt(unsigned, UChar&) const;
+    JSString* tryGetSubstring(VM&, unsigned offset, unsigned length, unsigned depth = 0);
+    bool tryFind(const String& searchString, unsigned start, size_t& result) const;
+    bool shouldSearchWithoutResolving();
+
+    // The number of times a rope has been searched is kept in the bits of m_flags
+    // above the ones JSString uses.
+    static const unsigned searchCountShift = 3;
+    static const unsigned searchCountMask = 7u << searchCountShift;
+
     mutable FixedArray<WriteBarrier<JSString>, s_maxInternalRopeLength> m_fibers;
 };
 
@@ -387,6 +404,15 @@ inline JSString* JSString::getIndex(ExecState* exec, unsigned i)
     return jsSingleCharacterSubstring(exec, m_value, i);
 }
 
+inline UChar JSString::characterAt(ExecState* exec, unsigned i)
+{
+    ASSERT(i < m_length);
+    UChar result;
+    if (isRope() && static_cast<JSRopeString*>(this)->tryGetCharacterAt(i, result))
+        return result;
+    return value(exec)[i];
+}
+
 inline JSString* jsString(VM* vm, const String& s)
 {
     int size = s.length();
@@ -408,6 +434,12 @@ inline JSString* jsSubstring(ExecState* exec, JSString* s, unsigned offset, unsi
     VM* vm = &exec->vm();
     if (!length)
         return vm->smallStrings.emptyString();
+    if (s->isRope()) {
+        if (length == s->length())
+            return s;
+        if (JSString* substring = static_cast<JSRopeString*>(s)->tryGetSubstring(*vm, offset, length))
+            return substring;
+    }
     return jsSubstring(vm, s->value(exec), offset, length);
 }
 
@@ -540,6 +540,110 @@ TokenType LiteralParser<CharType>::Lexer::lexNumber(LiteralParserToken<CharType>
     return TokNumber;
 }
 
+// Returns the object to fill in, or undefined if the object may follow the cached
+// shape of its depth. Such an object is only allocated once all of its properties
+// are known, since only then do we know which Structure it ends up with.
+template <typename CharType>
+JSValue LiteralParser<CharType>::startObject(unsigned depth, ObjectShapeState& state, unsigned firstRecordedKey, unsigned firstPendingValue)
+{
+    state.depth = depth;
+    state.matchedProperties = 0;
+    state.firstRecordedKey = firstRecordedKey;
+    state.firstPendingValue = firstPendingValue;
+    state.canRecordShape = depth < maximumCachedShapeDepth;
+    state.usesCachedShape = depth < m_objectShapes.size() && m_objectShapes[depth].structure;
+    if (state.usesCachedShape)
+        return jsUndefined();
+    return constructEmptyObject(m_exec);
+}
+
+template <typename CharType>
+ALWAYS_INLINE bool LiteralParser<CharType>::putWithCachedShape(ObjectShapeState& state, const Identifier& ident, JSValue value, MarkedArgumentBuffer& pendingValues)
+{
+    ASSERT(state.usesCachedShape);
+    const CachedObjectShape& shape = m_objectShapes[state.depth];
+    if (state.matchedProperties >= shape.properties.size() || shape.properties[state.matchedProperties].first.impl() != ident.impl())
+        return false;
+    pendingValues.append(value);
+    state.matchedProperties++;
+    return true;
+}
+
+static inline void dropPendingValues(MarkedArgumentBuffer& pendingValues, unsigned firstPendingValue)
+{
+    while (pendingValues.size() > firstPendingValue)
+        pendingValues.removeLast();
+}
+
+// Allocates an object whose keys matched its cached shape exactly, directly with the
+// cached Structure and a butterfly of the right size.
+template <typename CharType>
+JSObject* LiteralParser<CharType>::createObjectWithCachedShape(ObjectShapeState& state, MarkedArgumentBuffer& pendingValues)
+{
+    ASSERT(state.usesCachedShape);
+    VM& vm = m_exec->vm();
+    const CachedObjectShape& shape = m_objectShapes[state.depth];
+    ASSERT(state.matchedProperties == shape.properties.size());
+    Structure* structure = shape.structure.get();
+
+    JSObject* object = constructEmptyObject(m_exec);
+    ASSERT(structure->inlineCapacity() == object->structure()->inlineCapacity());
+    ASSERT(structure->storedPrototype() == object->prototype());
+    Butterfly* butterfly = structure->outOfLineCapacity() ? Butterfly::create(vm, structure) : 0;
+    object->setButterfly(vm, butterfly, structure);
+    for (unsigned i = 0; i < state.matchedProperties; ++i)
+        object->putDirect(vm, shape.properties[i].second, pendingValues.at(state.firstPendingValue + i));
+    dropPendingValues(pendingValues, state.firstPendingValue);
+    return object;
+}
+
+// Builds an object that diverged from its cached shape through the ordinary putDirect
+// path, so the result has exactly the Structure an uncached parse produces.
+template <typename CharType>
+JSObject* LiteralParser<CharType>::despecializeObject(ObjectShapeState& state, Vector<Identifier, 16, UnsafeVectorOverflow>& recordedKeys, MarkedArgumentBuffer& pendingValues)
+{
+    ASSERT(state.usesCachedShape);
+    VM& vm = m_exec->vm();
+    const CachedObjectShape& shape = m_objectShapes[state.depth];
+    JSObject* object = constructEmptyObject(m_exec);
+    for (unsigned i = 0; i < state.matchedProperties; ++i) {
+        object->putDirect(vm, shape.properties[i].first, pendingValues.at(state.firstPendingValue + i));
+        recordedKeys.append(shape.properties[i].first);
+    }
+    dropPendingValues(pendingValues, state.firstPendingValue);
+    state.usesCachedShape = false;
+    return object;
+}
+
+template <typename CharType>
+void LiteralParser<CharType>::recordShape(unsigned depth, JSObject* object, const Identifier* keys, size_t keyCount)
+{
+    ASSERT(depth < maximumCachedShapeDepth);
+    Structure* structure = object->structure();
+    if (!keyCount || structure->isDictionary() || hasIndexedProperties(structure->indexingType()))
+        return;
+    // Duplicate keys leave fewer slots than keys; such objects are not worth caching.
+    if (structure->totalStorageSize() != keyCount)
+        return;
+
+    if (depth >= m_objectShapes.size())
+        m_objectShapes.resize(depth + 1);
+    CachedObjectShape& shape = m_objectShapes[depth];
+    if (shape.structure.get() == structure)
+        return;
+
+    VM& vm = m_exec->vm();
+    shape.structure.clear();
+    shape.properties.resize(keyCount);
+    for (size_t i = 0; i < keyCount; ++i) {
+        PropertyOffset offset = structure->get(vm, keys[i]);
+        if (!isValidOffset(offset))
+            return;
+        shape.properties[i] = std::make_pair(keys[i], offset);
+    }
+    shape.structure.set(vm, structure);
+}
+
 template <typename CharType>
 JSValue LiteralParser<CharType>::parse(ParserState initialState)
 {
@@ -548,6 +652,9 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
     JSValue lastValue;
     Vector<ParserState, 16, UnsafeVectorOverflow> stateStack;
     Vector<Identifier, 16, UnsafeVectorOverflow> identifierStack;
+    Vector<ObjectShapeState, 16, UnsafeVectorOverflow> shapeStack;
+    Vector<Identifier, 16, UnsafeVectorOverflow> recordedKeys;
+    MarkedArgumentBuffer pendingValues;
     while (1) {
         switch(state) {
             startParseArray:
@@ -592,11 +699,10 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
             }
             startParseObject:
             case StartParseObject: {
-                JSObject* object = constructEmptyObject(m_exec);
-                objectStack.append(object);
-
                 TokenType type = m_lexer.next();
                 if (type == TokString || (m_mode != StrictJSON && type == TokIdentifier)) {
+                    shapeStack.append(ObjectShapeState());
+                    objectStack.append(startObject(objectStack.size(), shapeStack.last(), recordedKeys.size(), pendingValues.size()));
                     LiteralParserToken<CharType> identifierToken = m_lexer.currentToken();
 
                     // Check for colon
@@ -618,8 +724,7 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
                     return JSValue();
                 }
                 m_lexer.next();
-                lastValue = objectStack.last();
-                objectStack.removeLast();
+                lastValue = constructEmptyObject(m_exec);
                 break;
             }
             doParseObjectStartExpression:
@@ -647,13 +752,24 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
             }
             case DoParseObjectEndExpression:
             {
-                JSObject* object = asObject(objectStack.last());
-                PropertyName ident = identifierStack.last();
-                unsigned i = ident.asIndex();
-                if (i != PropertyName::NotAnIndex)
-                    object->putDirectIndex(m_exec, i, lastValue);
-                else
-                    object->putDirect(m_exec->vm(), ident, lastValue);
+                ObjectShapeState& shapeState = shapeStack.last();
+                const Identifier& ident = identifierStack.last();
+                if (shapeState.usesCachedShape && !putWithCachedShape(shapeState, ident, lastValue, pendingValues)) {
+                    objectStack.removeLast();
+                    objectStack.append(despecializeObject(shapeState, recordedKeys, pendingValues));
+                }
+                if (!shapeState.usesCachedShape) {
+                    JSObject* object = asObject(objectStack.last());
+                    unsigned i = PropertyName(ident).asIndex();
+                    if (i != PropertyName::NotAnIndex) {
+                        object->putDirectIndex(m_exec, i, lastValue);
+                        shapeState.canRecordShape = false;
+                    } else {
+                        object->putDirect(m_exec->vm(), ident, lastValue);
+                        if (shapeState.canRecordShape)
+                            recordedKeys.append(ident);
+                    }
+                }
                 identifierStack.removeLast();
                 if (m_lexer.currentToken().type == TokComma)
                     goto doParseObjectStartExpression;
@@ -662,6 +778,17 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
                     return JSValue();
                 }
                 m_lexer.next();
+                if (shapeState.usesCachedShape) {
+                    objectStack.removeLast();
+                    if (shapeState.matchedProperties == m_objectShapes[shapeState.depth].properties.size())
+                        objectStack.append(createObjectWithCachedShape(shapeState, pendingValues));
+                    else
+                        objectStack.append(despecializeObject(shapeState, recordedKeys, pendingValues));
+                }
+                if (!shapeState.usesCachedShape && shapeState.canRecordShape)
+                    recordShape(shapeState.depth, asObject(objectStack.last()), recordedKeys.data() + shapeState.firstRecordedKey, recordedKeys.size() - shapeState.firstRecordedKey);
+                recordedKeys.shrink(shapeState.firstRecordedKey);
+                shapeStack.removeLast();
                 lastValue = objectStack.last();
                 objectStack.removeLast();
                 break;
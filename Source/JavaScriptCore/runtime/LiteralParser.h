@@ -29,10 +29,13 @@
 #include "Identifier.h"
 #include "JSCJSValue.h"
 #include "JSGlobalObjectFunctions.h"
+#include "PropertyOffset.h"
 #include <wtf/text/WTFString.h>
 
 namespace JSC {
 
+class MarkedArgumentBuffer;
+
 typedef enum { StrictJSON, NonStrictJSON, JSONP } ParserMode;
 
 enum JSONPPathEntryType {
@@ -150,6 +153,32 @@ private:
     class StackGuard;
     JSValue parse(ParserState);
 
+    // Arrays of records tend to repeat one object shape, so the parser remembers the
+    // final Structure of the last object completed at each nesting depth. The values of
+    // a new object at that depth are held back for as long as its keys arrive in the
+    // remembered order. If all of them match, the object is then allocated once, with
+    // the remembered Structure and a butterfly of the right size.
+    struct CachedObjectShape {
+        Strong<Structure> structure;
+        Vector<std::pair<Identifier, PropertyOffset> > properties;
+    };
+
+    struct ObjectShapeState {
+        unsigned depth;
+        unsigned matchedProperties;
+        unsigned firstRecordedKey;
+        unsigned firstPendingValue;
+        bool usesCachedShape;
+        bool canRecordShape;
+    };
+
+    static const unsigned maximumCachedShapeDepth = 16;
+    JSValue startObject(unsigned depth, ObjectShapeState&, unsigned firstRecordedKey, unsigned firstPendingValue);
+    bool putWithCachedShape(ObjectShapeState&, const Identifier&, JSValue, MarkedArgumentBuffer& pendingValues);
+    JSObject* createObjectWithCachedShape(ObjectShapeState&, MarkedArgumentBuffer& pendingValues);
+    JSObject* despecializeObject(ObjectShapeState&, Vector<Identifier, 16, UnsafeVectorOverflow>& recordedKeys, MarkedArgumentBuffer& pendingValues);
+    void recordShape(unsigned depth, JSObject*, const Identifier* keys, size_t keyCount);
+
     ExecState* m_exec;
     typename LiteralParser<CharType>::Lexer m_lexer;
     ParserMode m_mode;
@@ -157,6 +186,7 @@ private:
     static unsigned const MaximumCachableCharacter = 128;
     FixedArray<Identifier, MaximumCachableCharacter> m_shortIdentifiers;
     FixedArray<Identifier, MaximumCachableCharacter> m_recentIdentifiers;
+    Vector<CachedObjectShape> m_objectShapes;
     ALWAYS_INLINE const Identifier makeIdentifier(const LChar* characters, size_t length);
     ALWAYS_INLINE const Identifier makeIdentifier(const UChar* characters, size_t length);
     };
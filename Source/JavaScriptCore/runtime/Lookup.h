@@ -42,6 +42,7 @@ namespace JSC {
     // FIXME: There is no reason this get function can't be simpler.
     // ie. typedef JSValue (*GetFunction)(ExecState*, JSObject* baseObject)
     typedef PropertySlot::GetValueFunc GetFunction;
+    typedef PropertySlot::DirectGetValueFunc DirectGetFunction;
     typedef void (*PutFunction)(ExecState*, JSObject* baseObject, JSValue value);
 
     class HashEntry {
@@ -71,7 +72,8 @@ namespace JSC {
         NativeFunction function() const { ASSERT(m_attributes & Function); return m_u.function.functionValue; }
         unsigned char functionLength() const { ASSERT(m_attributes & Function); return static_cast<unsigned char>(m_u.function.length); }
 
-        GetFunction propertyGetter() const { ASSERT(!(m_attributes & Function)); return m_u.property.get; }
+        GetFunction propertyGetter() const { ASSERT(!(m_attributes & (Function | DirectGetter))); return m_u.property.get; }
+        DirectGetFunction directPropertyGetter() const { ASSERT(m_attributes & DirectGetter); return m_u.directProperty.get; }
         PutFunction propertyPutter() const { ASSERT(!(m_attributes & Function)); return m_u.property.put; }
 
         intptr_t lexerValue() const { ASSERT(!m_attributes); return m_u.lexer.value; }
@@ -97,6 +99,10 @@ namespace JSC {
                 GetFunction get;
                 PutFunction put;
             } property;
+            struct {
+                DirectGetFunction get;
+                PutFunction put;
+            } directProperty;
             struct {
                 intptr_t value;
                 intptr_t unused;
@@ -234,6 +240,32 @@ namespace JSC {
 
     JS_EXPORT_PRIVATE bool setUpStaticFunctionSlot(ExecState*, const HashEntry*, JSObject* thisObject, PropertyName, PropertySlot&);
 
+    inline void setUpStaticValueSlot(const HashEntry* entry, JSObject* thisObject, PropertySlot& slot)
+    {
+        ASSERT(!(entry->attributes() & Function));
+        if (entry->attributes() & DirectGetter)
+            slot.setCacheableDirectCustom(thisObject, entry->directPropertyGetter());
+        else
+            slot.setCacheableCustom(thisObject, entry->propertyGetter());
+    }
+
+    inline void setUpUncacheableStaticValueSlot(const HashEntry* entry, JSObject* thisObject, PropertySlot& slot)
+    {
+        ASSERT(!(entry->attributes() & Function));
+        if (entry->attributes() & DirectGetter)
+            slot.setDirectCustom(thisObject, entry->directPropertyGetter());
+        else
+            slot.setCustom(thisObject, entry->propertyGetter());
+    }
+
+    inline void setUpStaticValueDescriptor(ExecState* exec, const HashEntry* entry, JSObject* thisObject, PropertyName propertyName, PropertyDescriptor& descriptor)
+    {
+        ASSERT(!(entry->attributes() & Function));
+        PropertySlot slot;
+        setUpUncacheableStaticValueSlot(entry, thisObject, slot);
+        descriptor.setDescriptor(slot.getValue(exec, propertyName), entry->attributes() & ~DirectGetter);
+    }
+
     /**
      * This method does it all (looking in the hashtable, checking for function
      * overrides, creating the function or retrieving from cache, calling
@@ -251,7 +283,7 @@ namespace JSC {
         if (entry->attributes() & Function)
             return setUpStaticFunctionSlot(exec, entry, thisObj, propertyName, slot);
 
-        slot.setCacheableCustom(thisObj, entry->propertyGetter());
+        setUpStaticValueSlot(entry, thisObj, slot);
         return true;
     }
 
@@ -271,8 +303,7 @@ namespace JSC {
             return present;
         }
 
-        slot.setCustom(thisObj, entry->propertyGetter());
-        descriptor.setDescriptor(slot.getValue(exec, propertyName), entry->attributes());
+        setUpStaticValueDescriptor(exec, entry, thisObj, propertyName, descriptor);
         return true;
     }
 
@@ -328,9 +359,7 @@ namespace JSC {
         if (!entry) // not found, forward to parent
             return ParentImp::getOwnPropertySlot(thisObj, exec, propertyName, slot);
 
-        ASSERT(!(entry->attributes() & Function));
-
-        slot.setCacheableCustom(thisObj, entry->propertyGetter());
+        setUpStaticValueSlot(entry, thisObj, slot);
         return true;
     }
 
@@ -346,10 +375,7 @@ namespace JSC {
         if (!entry) // not found, forward to parent
             return ParentImp::getOwnPropertyDescriptor(thisObj, exec, propertyName, descriptor);
         
-        ASSERT(!(entry->attributes() & Function));
-        PropertySlot slot;
-        slot.setCustom(thisObj, entry->propertyGetter());
-        descriptor.setDescriptor(slot.getValue(exec, propertyName), entry->attributes());
+        setUpStaticValueDescriptor(exec, entry, thisObj, propertyName, descriptor);
         return true;
     }
 
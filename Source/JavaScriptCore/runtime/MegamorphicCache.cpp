@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "MegamorphicCache.h"
+
+#include "JSObject.h"
+#include "Operations.h"
+#include "Options.h"
+#include "PropertySlot.h"
+
+namespace JSC {
+
+static inline bool canCacheStructure(Structure* structure)
+{
+    // Dictionaries can change a property's offset or attributes in place, and
+    // objects with impure getOwnPropertySlot may answer differently for the
+    // same structure, so neither can be keyed by structure alone.
+    return !structure->isDictionary()
+        && !structure->typeInfo().prohibitsPropertyCaching()
+        && !structure->typeInfo().hasImpureGetOwnPropertySlot();
+}
+
+JSValue MegamorphicCache::get(ExecState* exec, JSValue base, const Identifier& propertyName)
+{
+    if (!Options::useMegamorphicCache() || !base.isObject()) {
+        PropertySlot slot(base);
+        return base.get(exec, propertyName, slot);
+    }
+
+    JSObject* object = asObject(base);
+    Structure* structure = object->structure();
+    StringImpl* uid = propertyName.impl();
+    Entry& entry = lookup(structure, uid);
+    if (entry.structure == structure && entry.uid == uid)
+        return object->getDirect(entry.offset);
+
+    PropertySlot slot(base);
+    JSValue result = base.get(exec, propertyName, slot);
+    if (!exec->hadException() && structure == object->structure())
+        add(base, structure, uid, slot);
+    return result;
+}
+
+void MegamorphicCache::add(JSValue base, Structure* structure, StringImpl* uid, const PropertySlot& slot)
+{
+    if (!slot.isCacheableValue() || slot.slotBase() != base || !canCacheStructure(structure))
+        return;
+
+    Entry& entry = lookup(structure, uid);
+    entry.structure = structure;
+    entry.uid = uid;
+    entry.offset = slot.cachedOffset();
+}
+
+} // namespace JSC
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef MegamorphicCache_h
+#define MegamorphicCache_h
+
+#include "JSCJSValue.h"
+#include "PropertyOffset.h"
+#include <wtf/FixedArray.h>
+#include <wtf/HashFunctions.h>
+#include <wtf/text/StringImpl.h>
+
+namespace JSC {
+
+class ExecState;
+class Identifier;
+class PropertySlot;
+class Structure;
+
+// A direct-mapped cache of (Structure, property name) -> offset pairs for own
+// data properties. get_by_id sites that have given up on inline caching probe
+// it before doing a full property lookup. Entries hold raw Structure pointers,
+// so the cache is cleared by every garbage collection.
+class MegamorphicCache {
+public:
+    MegamorphicCache()
+    {
+        clear();
+    }
+
+    JSValue get(ExecState*, JSValue base, const Identifier&);
+
+    void clear()
+    {
+        for (size_t i = 0; i < cacheSize; ++i)
+            m_entries[i].structure = 0;
+    }
+
+private:
+    static const size_t cacheSize = 512;
+
+    struct Entry {
+        Structure* structure;
+        StringImpl* uid;
+        PropertyOffset offset;
+    };
+
+    Entry& lookup(Structure* structure, StringImpl* uid)
+    {
+        unsigned hash = WTF::PtrHash<Structure*>::hash(structure) ^ uid->existingHash();
+        return m_entries[hash & (cacheSize - 1)];
+    }
+
+    void add(JSValue base, Structure*, StringImpl* uid, const PropertySlot&);
+
+    FixedArray<Entry, cacheSize> m_entries;
+};
+
+} // namespace JSC
+
+#endif // MegamorphicCache_h
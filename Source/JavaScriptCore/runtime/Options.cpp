@@ -76,6 +76,13 @@ static bool parse(const char* string, OptionRange& value)
     return value.init(string);
 }
 
+// The string is not copied. Option strings come from getenv() or argv, which live as long as the process.
+static bool parse(const char* string, const char*& value)
+{
+    value = string;
+    return true;
+}
+
 template<typename T>
 void overrideOptionWithHeuristic(T& variable, const char* name)
 {
@@ -288,6 +295,9 @@ void Options::dumpOption(OptionID id, FILE* stream, const char* header, const ch
     case optionRangeType:
         fprintf(stream, "%s", s_options[id].u.optionRangeVal.rangeString());
         break;
+    case optionStringType:
+        fprintf(stream, "%s", s_options[id].u.optionStringVal ? s_options[id].u.optionStringVal : "<null>");
+        break;
     }
     fprintf(stream, "%s", footer);
 }
@@ -87,11 +87,14 @@ private:
 };
 
 typedef OptionRange optionRange;
+typedef const char* optionString;
 
 #define JSC_OPTIONS(v) \
     v(bool, useJIT,    true) \
     v(bool, useDFGJIT, true) \
     v(bool, useRegExpJIT, true) \
+    /* Only used by the C loop interpreter. */ \
+    v(bool, useLLIntSuperinstructions, true) \
     \
     v(bool, forceDFGCodeBlockLiveness, false) \
     \
@@ -111,6 +114,18 @@ typedef OptionRange optionRange;
     v(bool, validateGraphAtEachPhase, false) \
     \
     v(bool, enableProfiler, false) \
+    /* The sampling profiler writes folded stacks to samplingProfilerOutputFile at exit. */ \
+    v(bool, useSamplingProfiler, false) \
+    v(unsigned, sampleInterval, 1000) \
+    v(optionString, samplingProfilerOutputFile, 0) \
+    v(bool, recordInlineCacheStatistics, false) \
+    v(bool, useMegamorphicCache, true) \
+    \
+    /* Path of a file that keeps the bytecode of top level scripts across runs. When it \
+       would grow past bytecodeCacheMaximumSize bytes, its oldest records are evicted. */ \
+    v(optionString, bytecodeCacheFile, 0) \
+    v(unsigned, bytecodeCacheMaximumSize, 16 * 1024 * 1024) \
+    v(bool, verboseBytecodeCache, false) \
     \
     v(unsigned, maximumOptimizationCandidateInstructionCount, 10000) \
     \
@@ -158,6 +173,12 @@ typedef OptionRange optionRange;
     v(unsigned, opaqueRootMergeThreshold, 1000) \
     v(double, minHeapUtilization, 0.8) \
     v(double, minCopiedBlockUtilization, 0.9) \
+    v(bool, enableConcurrentSweeping, false) \
+    v(bool, useGenerationalGC, true) \
+    v(bool, usePretenuring, true) \
+    v(unsigned, pretenuringSampleCount, 16) \
+    v(double, pretenuringSurvivalRate, 0.9) \
+    v(double, oldGenerationGrowthFactorForFullCollection, 2.0) \
     \
     v(bool, forceWeakRandomSeed, false) \
     v(unsigned, forcedWeakRandomSeed, 0) \
@@ -168,7 +189,9 @@ typedef OptionRange optionRange;
     \
     v(unsigned, gcMaxHeapSize, 0) \
     v(bool, recordGCPauseTimes, false) \
-    v(bool, logHeapStatisticsAtExit, false) 
+    v(bool, logCopyingStatistics, false) \
+    v(bool, logHeapStatisticsAtExit, false) \
+    v(bool, logExecutableMemoryStatisticsAtExit, false) 
 
 class Options {
 public:
@@ -208,6 +231,7 @@ private:
         doubleType,
         int32Type,
         optionRangeType,
+        optionStringType,
     };
 
     // For storing for an option value:
@@ -218,6 +242,7 @@ private:
             double doubleVal;
             int32 int32Val;
             OptionRange optionRangeVal;
+            const char* optionStringVal;
         } u;
     };
 
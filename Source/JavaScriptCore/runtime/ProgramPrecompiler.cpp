@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "ProgramPrecompiler.h"
+
+#include "CodeCache.h"
+#include "JSGlobalObject.h"
+#include "JSLock.h"
+#include "Operations.h"
+#include "ParserError.h"
+#include "StrongInlines.h"
+#include "UnlinkedCodeBlock.h"
+#include "UnlinkedCodeBlockSerializer.h"
+#include <wtf/WTFThreadData.h>
+
+namespace JSC {
+
+PassRefPtr<PrecompiledProgram> PrecompiledProgram::create(const SourceCode& source)
+{
+    return adoptRef(new PrecompiledProgram(source));
+}
+
+PrecompiledProgram::PrecompiledProgram(const SourceCode& source)
+    : m_source(source.toString().isolatedCopy())
+    , m_url(source.provider()->url().isolatedCopy())
+    , m_firstLine(source.firstLine())
+    , m_startColumn(source.startColumn())
+    , m_state(Queued)
+{
+}
+
+UnlinkedProgramCodeBlock* PrecompiledProgram::takeCodeBlock(VM& vm)
+{
+    {
+        MutexLocker locker(m_lock);
+        if (m_state == Queued) {
+            m_state = Cancelled;
+            return 0;
+        }
+        while (m_state == Compiling)
+            m_condition.wait(m_lock);
+    }
+
+    ASSERT(m_state == Compiled);
+    if (m_bytecode.isEmpty())
+        return 0;
+    return UnlinkedCodeBlockSerializer::decode(vm, m_bytecode.data(), m_bytecode.size());
+}
+
+void PrecompiledProgram::compile(VM& vm, JSGlobalObject* globalObject)
+{
+    String sourceString;
+    String url;
+    sourceString.swap(m_source);
+    url.swap(m_url);
+
+    {
+        MutexLocker locker(m_lock);
+        if (m_state == Cancelled)
+            return;
+        m_state = Compiling;
+    }
+
+    Vector<uint8_t> bytecode;
+    {
+        JSLockHolder lock(vm);
+        TextPosition startPosition(OrdinalNumber::fromOneBasedInt(m_firstLine), OrdinalNumber::fromOneBasedInt(m_startColumn));
+        SourceCode source = makeSource(sourceString, url, startPosition);
+        ProgramExecutable* executable = ProgramExecutable::create(globalObject->globalExec(), source);
+        ParserError error;
+        UnlinkedProgramCodeBlock* codeBlock = vm.codeCache()->getProgramCodeBlock(vm, executable, source, JSParseNormal, DebuggerOff, ProfilerOff, error);
+        if (codeBlock && !UnlinkedCodeBlockSerializer::encode(codeBlock, bytecode))
+            bytecode.clear();
+
+        // Nothing compiled here is used again on this thread.
+        vm.codeCache()->clear();
+        vm.clearSourceProviderCaches();
+    }
+
+    MutexLocker locker(m_lock);
+    m_bytecode.swap(bytecode);
+    m_state = Compiled;
+    m_condition.broadcast();
+}
+
+ProgramPrecompiler& ProgramPrecompiler::shared()
+{
+    AtomicallyInitializedStatic(ProgramPrecompiler&, precompiler = *new ProgramPrecompiler);
+    return precompiler;
+}
+
+ProgramPrecompiler::ProgramPrecompiler()
+    : m_thread(0)
+{
+}
+
+void ProgramPrecompiler::enqueue(PassRefPtr<PrecompiledProgram> program)
+{
+    MutexLocker locker(m_lock);
+    if (!m_thread)
+        m_thread = createThread(threadEntryPoint, this, "JavaScriptCore::ProgramPrecompiler");
+    m_queue.append(program);
+    m_condition.signal();
+}
+
+void ProgramPrecompiler::threadEntryPoint(void* precompiler)
+{
+    static_cast<ProgramPrecompiler*>(precompiler)->runThread();
+}
+
+void ProgramPrecompiler::runThread()
+{
+    // A default VM uses this thread's identifier table, so identifiers made here
+    // never meet the ones made by the thread that queued the program.
+    RefPtr<VM> vm = VM::create(SmallHeap);
+    ASSERT(vm->identifierTable == wtfThreadData().currentIdentifierTable());
+
+    Strong<JSGlobalObject> globalObject;
+    {
+        JSLockHolder lock(vm.get());
+        globalObject.set(*vm, JSGlobalObject::create(*vm, JSGlobalObject::createStructure(*vm, jsNull())));
+    }
+
+    while (true) {
+        RefPtr<PrecompiledProgram> program;
+        {
+            MutexLocker locker(m_lock);
+            while (m_queue.isEmpty())
+                m_condition.wait(m_lock);
+            program = m_queue.takeFirst();
+        }
+        program->compile(*vm, globalObject.get());
+    }
+}
+
+} // namespace JSC
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef ProgramPrecompiler_h
+#define ProgramPrecompiler_h
+
+#include <wtf/Deque.h>
+#include <wtf/PassRefPtr.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+namespace JSC {
+
+class JSGlobalObject;
+class SourceCode;
+class UnlinkedProgramCodeBlock;
+class VM;
+
+// Unlinked bytecode for a program, generated on the precompiler thread. The thread
+// uses a VM of its own, so the result is handed over in the pointer-free form
+// produced by UnlinkedCodeBlockSerializer and decoded into the VM that asked for it.
+class PrecompiledProgram : public ThreadSafeRefCounted<PrecompiledProgram> {
+public:
+    static PassRefPtr<PrecompiledProgram> create(const SourceCode&);
+
+    // Returns 0 if the program could not be compiled. If the precompiler thread has
+    // not started on the program yet, it is cancelled and 0 is returned as well, since
+    // the caller can compile it just as quickly itself. If the thread is working on it,
+    // this waits for the result.
+    UnlinkedProgramCodeBlock* takeCodeBlock(VM&);
+
+private:
+    friend class ProgramPrecompiler;
+
+    PrecompiledProgram(const SourceCode&);
+
+    void compile(VM&, JSGlobalObject*);
+
+    enum State { Queued, Compiling, Compiled, Cancelled };
+
+    // Only the precompiler thread touches these strings once the program has been
+    // queued, so their reference counts are never shared between threads.
+    String m_source;
+    String m_url;
+    int m_firstLine;
+    int m_startColumn;
+
+    Mutex m_lock;
+    ThreadCondition m_condition;
+    State m_state;
+    Vector<uint8_t> m_bytecode;
+};
+
+class ProgramPrecompiler {
+    WTF_MAKE_NONCOPYABLE(ProgramPrecompiler);
+public:
+    static ProgramPrecompiler& shared();
+
+    void enqueue(PassRefPtr<PrecompiledProgram>);
+
+private:
+    ProgramPrecompiler();
+
+    static void threadEntryPoint(void*);
+    void runThread();
+
+    Mutex m_lock;
+    ThreadCondition m_condition;
+    Deque<RefPtr<PrecompiledProgram> > m_queue;
+    ThreadIdentifier m_thread;
+};
+
+} // namespace JSC
+
+#endif // ProgramPrecompiler_h
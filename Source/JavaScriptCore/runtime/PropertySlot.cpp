@@ -38,4 +38,9 @@ JSValue PropertySlot::functionGetter(ExecState* exec) const
     return call(exec, m_data.getterFunc, callType, callData, m_thisValue.isObject() ? m_thisValue.toThisObject(exec) : m_thisValue, exec->emptyList());
 }
 
+JSValue PropertySlot::directGetter(ExecState* exec) const
+{
+    return JSValue::decode(m_data.directGetValue(exec, asObject(m_slotBase)));
+}
+
 } // namespace JSC
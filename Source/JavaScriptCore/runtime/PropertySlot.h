@@ -36,6 +36,7 @@ namespace JSC {
 #define JSC_VALUE_MARKER 0
 #define INDEX_GETTER_MARKER reinterpret_cast<GetValueFunc>(2)
 #define GETTER_FUNCTION_MARKER reinterpret_cast<GetValueFunc>(3)
+#define DIRECT_GETTER_MARKER reinterpret_cast<GetValueFunc>(4)
 
     class PropertySlot {
     public:
@@ -65,6 +66,11 @@ namespace JSC {
         typedef JSValue (*GetValueFunc)(ExecState*, JSValue slotBase, PropertyName);
         typedef JSValue (*GetIndexValueFunc)(ExecState*, JSValue slotBase, unsigned);
 
+        // A direct getter is a custom getter that the JIT may call without a
+        // PropertySlot or a property name. It must not throw and must not have
+        // side effects that are observable from script.
+        typedef EncodedJSValue (*DirectGetValueFunc)(ExecState*, JSObject* slotBase);
+
         JSValue getValue(ExecState* exec, PropertyName propertyName) const
         {
             if (m_getValue == JSC_VALUE_MARKER)
@@ -73,6 +79,8 @@ namespace JSC {
                 return m_getIndexValue(exec, slotBase(), index());
             if (m_getValue == GETTER_FUNCTION_MARKER)
                 return functionGetter(exec);
+            if (m_getValue == DIRECT_GETTER_MARKER)
+                return directGetter(exec);
             return m_getValue(exec, slotBase(), propertyName);
         }
 
@@ -84,6 +92,8 @@ namespace JSC {
                 return m_getIndexValue(exec, m_slotBase, m_data.index);
             if (m_getValue == GETTER_FUNCTION_MARKER)
                 return functionGetter(exec);
+            if (m_getValue == DIRECT_GETTER_MARKER)
+                return directGetter(exec);
             return m_getValue(exec, slotBase(), Identifier::from(exec, propertyName));
         }
 
@@ -143,6 +153,27 @@ namespace JSC {
             m_cachedPropertyType = Custom;
         }
 
+        void setDirectCustom(JSValue slotBase, DirectGetValueFunc directGetValue)
+        {
+            ASSERT(slotBase);
+            ASSERT(directGetValue);
+            m_getValue = DIRECT_GETTER_MARKER;
+            m_getIndexValue = 0;
+            m_slotBase = slotBase;
+            m_data.directGetValue = directGetValue;
+        }
+
+        void setCacheableDirectCustom(JSValue slotBase, DirectGetValueFunc directGetValue)
+        {
+            ASSERT(slotBase);
+            ASSERT(directGetValue);
+            m_getValue = DIRECT_GETTER_MARKER;
+            m_getIndexValue = 0;
+            m_slotBase = slotBase;
+            m_data.directGetValue = directGetValue;
+            m_cachedPropertyType = Custom;
+        }
+
         void setCustomIndex(JSValue slotBase, unsigned index, GetIndexValueFunc getIndexValue)
         {
             ASSERT(slotBase);
@@ -216,10 +247,19 @@ namespace JSC {
         GetValueFunc customGetter() const
         {
             ASSERT(m_cachedPropertyType == Custom);
+            ASSERT(m_getValue != DIRECT_GETTER_MARKER);
             return m_getValue;
         }
+
+        // Returns 0 if the custom getter needs to be called through customGetter().
+        DirectGetValueFunc directCustomGetter() const
+        {
+            ASSERT(m_cachedPropertyType == Custom);
+            return m_getValue == DIRECT_GETTER_MARKER ? m_data.directGetValue : 0;
+        }
     private:
         JS_EXPORT_PRIVATE JSValue functionGetter(ExecState*) const;
+        JS_EXPORT_PRIVATE JSValue directGetter(ExecState*) const;
 
         GetValueFunc m_getValue;
         GetIndexValueFunc m_getIndexValue;
@@ -228,6 +268,7 @@ namespace JSC {
         union {
             JSObject* getterFunc;
             unsigned index;
+            DirectGetValueFunc directGetValue;
         } m_data;
 
         JSValue m_value;
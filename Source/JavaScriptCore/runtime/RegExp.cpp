@@ -224,6 +224,7 @@ RegExp::RegExp(VM& vm, const String& patternString, RegExpFlags flags)
     , m_flags(flags)
     , m_constructionError(0)
     , m_numSubpatterns(0)
+    , m_containsBackreferences(false)
 #if ENABLE(REGEXP_TRACING)
     , m_rtMatchCallCount(0)
     , m_rtMatchFoundCount(0)
@@ -237,8 +238,11 @@ void RegExp::finishCreation(VM& vm)
     Yarr::YarrPattern pattern(m_patternString, ignoreCase(), multiline(), &m_constructionError);
     if (m_constructionError)
         m_state = ParseError;
-    else
+    else {
         m_numSubpatterns = pattern.m_numSubpatterns;
+        m_containsBackreferences = pattern.m_containsBackreferences;
+        m_literalPrefix = pattern.literalPrefix();
+    }
 }
 
 void RegExp::destroy(JSCell* cell)
@@ -279,7 +283,7 @@ void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
     }
 
 #if ENABLE(YARR_JIT)
-    if (!pattern.m_containsBackreferences && vm->canUseRegExpJIT()) {
+    if (vm->canUseRegExpJIT()) {
         Yarr::jitCompile(pattern, charSize, vm, m_regExpJITCode);
 #if ENABLE(YARR_JIT_DEBUG)
         if (!m_regExpJITCode.isFallBack())
@@ -292,6 +296,8 @@ void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
             return;
         }
 #endif
+        if (m_regExpJITCode.isFallBack() && !m_regExpBytecode)
+            vm->m_regExpJITFallbackCount++;
     }
 #else
     UNUSED_PARAM(charSize);
@@ -318,6 +324,19 @@ void RegExp::compileIfNecessary(VM& vm, Yarr::YarrCharSize charSize)
     compile(&vm, charSize);
 }
 
+// Every match of a pattern with a literal prefix starts with that prefix, so the
+// matcher does not need to be entered before the prefix's next occurrence.
+bool RegExp::findLiteralPrefix(const String& s, unsigned& startOffset)
+{
+    if (m_literalPrefix.isNull())
+        return true;
+    size_t candidate = s.find(m_literalPrefix, startOffset);
+    if (candidate == notFound)
+        return false;
+    startOffset = candidate;
+    return true;
+}
+
 int RegExp::match(VM& vm, const String& s, unsigned startOffset, Vector<int, 32>& ovector)
 {
 #if ENABLE(REGEXP_TRACING)
@@ -331,6 +350,12 @@ int RegExp::match(VM& vm, const String& s, unsigned startOffset, Vector<int, 32>
     ovector.resize(offsetVectorSize);
     int* offsetVector = ovector.data();
 
+    if (!findLiteralPrefix(s, startOffset)) {
+        for (int i = 0; i < offsetVectorSize; ++i)
+            offsetVector[i] = -1;
+        return -1;
+    }
+
     int result;
 #if ENABLE(YARR_JIT)
     if (m_state == JITCode) {
@@ -401,8 +426,10 @@ void RegExp::compileMatchOnly(VM* vm, Yarr::YarrCharSize charSize)
     }
 
 #if ENABLE(YARR_JIT)
-    if (!pattern.m_containsBackreferences && vm->canUseRegExpJIT()) {
-        Yarr::jitCompile(pattern, charSize, vm, m_regExpJITCode, Yarr::MatchOnly);
+    if (vm->canUseRegExpJIT()) {
+        // Match-only code does not record subpatterns, which back references need,
+        // so such patterns answer match-only queries with the full matching code.
+        Yarr::jitCompile(pattern, charSize, vm, m_regExpJITCode, m_containsBackreferences ? Yarr::IncludeSubpatterns : Yarr::MatchOnly);
 #if ENABLE(YARR_JIT_DEBUG)
         if (!m_regExpJITCode.isFallBack())
             m_state = JITCode;
@@ -414,6 +441,8 @@ void RegExp::compileMatchOnly(VM* vm, Yarr::YarrCharSize charSize)
             return;
         }
 #endif
+        if (m_regExpJITCode.isFallBack() && !m_regExpBytecode)
+            vm->m_regExpJITFallbackCount++;
     }
 #else
     UNUSED_PARAM(charSize);
@@ -428,9 +457,9 @@ void RegExp::compileIfNecessaryMatchOnly(VM& vm, Yarr::YarrCharSize charSize)
 #if ENABLE(YARR_JIT)
         if (m_state != JITCode)
             return;
-        if ((charSize == Yarr::Char8) && (m_regExpJITCode.has8BitCodeMatchOnly()))
+        if ((charSize == Yarr::Char8) && (m_containsBackreferences ? m_regExpJITCode.has8BitCode() : m_regExpJITCode.has8BitCodeMatchOnly()))
             return;
-        if ((charSize == Yarr::Char16) && (m_regExpJITCode.has16BitCodeMatchOnly()))
+        if ((charSize == Yarr::Char16) && (m_containsBackreferences ? m_regExpJITCode.has16BitCode() : m_regExpJITCode.has16BitCodeMatchOnly()))
             return;
 #else
         return;
@@ -449,7 +478,24 @@ MatchResult RegExp::match(VM& vm, const String& s, unsigned startOffset)
     ASSERT(m_state != ParseError);
     compileIfNecessaryMatchOnly(vm, s.is8Bit() ? Yarr::Char8 : Yarr::Char16);
 
+    if (!findLiteralPrefix(s, startOffset))
+        return MatchResult::failed();
+
 #if ENABLE(YARR_JIT)
+    if (m_state == JITCode && m_containsBackreferences) {
+        // Back references read the captures, so the JIT code needs somewhere to write them even
+        // though we only report the match. Running it cannot reenter this RegExp, so one buffer does.
+        if (m_backreferenceOvector.isEmpty())
+            m_backreferenceOvector.resize((m_numSubpatterns + 1) * 2);
+        MatchResult result = s.is8Bit() ?
+            m_regExpJITCode.execute(s.characters8(), startOffset, s.length(), m_backreferenceOvector.data()) :
+            m_regExpJITCode.execute(s.characters16(), startOffset, s.length(), m_backreferenceOvector.data());
+#if ENABLE(REGEXP_TRACING)
+        if (!result)
+            m_rtMatchFoundCount++;
+#endif
+        return result;
+    }
     if (m_state == JITCode) {
         MatchResult result = s.is8Bit() ?
             m_regExpJITCode.execute(s.characters8(), startOffset, s.length()) :
@@ -106,6 +106,8 @@ namespace JSC {
         void compileMatchOnly(VM*, Yarr::YarrCharSize);
         void compileIfNecessaryMatchOnly(VM&, Yarr::YarrCharSize);
 
+        bool findLiteralPrefix(const String&, unsigned& startOffset);
+
 #if ENABLE(YARR_JIT_DEBUG)
         void matchCompareWithInterpreter(const String&, int startOffset, int* offsetVector, int jitResult);
 #endif
@@ -114,6 +116,8 @@ namespace JSC {
         RegExpFlags m_flags;
         const char* m_constructionError;
         unsigned m_numSubpatterns;
+        bool m_containsBackreferences;
+        String m_literalPrefix;
 #if ENABLE(REGEXP_TRACING)
         unsigned m_rtMatchCallCount;
         unsigned m_rtMatchFoundCount;
@@ -121,6 +125,8 @@ namespace JSC {
 
 #if ENABLE(YARR_JIT)
         Yarr::YarrCodeBlock m_regExpJITCode;
+        // Captures written by match-only calls to JIT code with back references.
+        Vector<int> m_backreferenceOvector;
 #endif
         OwnPtr<Yarr::BytecodePattern> m_regExpBytecode;
     };
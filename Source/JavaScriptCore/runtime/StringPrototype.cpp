@@ -695,18 +695,18 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharAt(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
         return throwVMTypeError(exec);
-    String s = thisValue.toString(exec)->value(exec);
-    unsigned len = s.length();
+    JSString* string = thisValue.toString(exec);
+    unsigned len = string->length();
     JSValue a0 = exec->argument(0);
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
         if (i < len)
-            return JSValue::encode(jsSingleCharacterSubstring(exec, s, i));
+            return JSValue::encode(string->getIndex(exec, i));
         return JSValue::encode(jsEmptyString(exec));
     }
     double dpos = a0.toInteger(exec);
     if (dpos >= 0 && dpos < len)
-        return JSValue::encode(jsSingleCharacterSubstring(exec, s, static_cast<unsigned>(dpos)));
+        return JSValue::encode(string->getIndex(exec, static_cast<unsigned>(dpos)));
     return JSValue::encode(jsEmptyString(exec));
 }
 
@@ -715,21 +715,18 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharCodeAt(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
         return throwVMTypeError(exec);
-    String s = thisValue.toString(exec)->value(exec);
-    unsigned len = s.length();
+    JSString* string = thisValue.toString(exec);
+    unsigned len = string->length();
     JSValue a0 = exec->argument(0);
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
-        if (i < len) {
-            if (s.is8Bit())
-                return JSValue::encode(jsNumber(s.characters8()[i]));
-            return JSValue::encode(jsNumber(s.characters16()[i]));
-        }
+        if (i < len)
+            return JSValue::encode(jsNumber(string->characterAt(exec, i)));
         return JSValue::encode(jsNaN());
     }
     double dpos = a0.toInteger(exec);
     if (dpos >= 0 && dpos < len)
-        return JSValue::encode(jsNumber(s[static_cast<int>(dpos)]));
+        return JSValue::encode(jsNumber(string->characterAt(exec, static_cast<unsigned>(dpos))));
     return JSValue::encode(jsNaN());
 }
 
@@ -749,7 +746,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncIndexOf(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
         return throwVMTypeError(exec);
-    String s = thisValue.toString(exec)->value(exec);
+    JSString* thisString = thisValue.toString(exec);
 
     JSValue a0 = exec->argument(0);
     JSValue a1 = exec->argument(1);
@@ -757,10 +754,10 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncIndexOf(ExecState* exec)
 
     size_t result;
     if (a1.isUndefined())
-        result = s.find(u2);
+        result = thisString->find(exec, u2, 0);
     else {
         unsigned pos;
-        int len = s.length();
+        int len = thisString->length();
         if (a1.isUInt32())
             pos = std::min<uint32_t>(a1.asUInt32(), len);
         else {
@@ -771,7 +768,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncIndexOf(ExecState* exec)
                 dpos = len;
             pos = static_cast<unsigned>(dpos);
         }
-        result = s.find(u2, pos);
+        result = thisString->find(exec, u2, pos);
     }
 
     if (result == notFound)
@@ -902,8 +899,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSlice(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
         return throwVMTypeError(exec);
-    String s = thisValue.toString(exec)->value(exec);
-    int len = s.length();
+    JSString* string = thisValue.toString(exec);
+    int len = string->length();
 
     JSValue a0 = exec->argument(0);
     JSValue a1 = exec->argument(1);
@@ -918,7 +915,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSlice(ExecState* exec)
             from = 0;
         if (to > len)
             to = len;
-        return JSValue::encode(jsSubstring(exec, s, static_cast<unsigned>(from), static_cast<unsigned>(to) - static_cast<unsigned>(from)));
+        return JSValue::encode(jsSubstring(exec, string, static_cast<unsigned>(from), static_cast<unsigned>(to) - static_cast<unsigned>(from)));
     }
 
     return JSValue::encode(jsEmptyString(exec));
@@ -92,6 +92,8 @@ ALWAYS_INLINE void SlotVisitor::internalAppend(JSCell* cell)
 #if ENABLE(GC_VALIDATION)
     validate(cell);
 #endif
+    if (UNLIKELY(isBuildingHeapSnapshot()))
+        appendToHeapSnapshot(cell);
     if (Heap::testAndSetMarked(cell) || !cell->structure())
         return;
 
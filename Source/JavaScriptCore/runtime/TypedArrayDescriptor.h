@@ -70,6 +70,28 @@ enum TypedArrayRounding {
     ClampRounding
 };
 
+inline unsigned elementSizeForTypedArrayType(TypedArrayType type)
+{
+    switch (type) {
+    case TypedArrayNone:
+        return 0;
+    case TypedArrayInt8:
+    case TypedArrayUint8:
+    case TypedArrayUint8Clamped:
+        return 1;
+    case TypedArrayInt16:
+    case TypedArrayUint16:
+        return 2;
+    case TypedArrayInt32:
+    case TypedArrayUint32:
+    case TypedArrayFloat32:
+        return 4;
+    case TypedArrayFloat64:
+        return 8;
+    }
+    return 0;
+}
+
 } // namespace JSC
 
 #endif // TypedArrayDescriptor_h
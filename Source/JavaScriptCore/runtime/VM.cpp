@@ -56,6 +56,7 @@
 #include "ParserArena.h"
 #include "RegExpCache.h"
 #include "RegExpObject.h"
+#include "SamplingProfiler.h"
 #include "SourceProviderCache.h"
 #include "StrictEvalActivation.h"
 #include "StrongInlines.h"
@@ -173,6 +174,7 @@ VM::VM(VMType vmType, HeapType heapType)
     , dynamicGlobalObject(0)
     , m_enabledProfiler(0)
     , m_regExpCache(new RegExpCache(this))
+    , m_regExpJITFallbackCount(0)
 #if ENABLE(REGEXP_TRACING)
     , m_rtTraceList(new RTTraceList())
 #endif
@@ -255,7 +257,19 @@ VM::VM(VMType vmType, HeapType heapType)
 #endif
         pathOut.print("JSCProfile-", getCurrentProcessID(), "-", m_perBytecodeProfiler->databaseID(), ".json");
         m_perBytecodeProfiler->registerToSaveAtExit(pathOut.toCString().data());
+    } else if (Options::recordInlineCacheStatistics())
+        m_perBytecodeProfiler = adoptPtr(new Profiler::Database(*this));
+
+#if ENABLE(SAMPLING_PROFILER)
+    if (Options::useSamplingProfiler()) {
+        // Only one VM in the process can be sampled; the others don't get a profiler.
+        m_samplingProfiler = adoptPtr(new SamplingProfiler(*this));
+        if (!m_samplingProfiler->start())
+            m_samplingProfiler.clear();
+        else if (const char* outputFile = Options::samplingProfilerOutputFile())
+            m_samplingProfiler->registerToSaveAtExit(outputFile);
     }
+#endif
 
 #if ENABLE(DFG_JIT)
     if (canUseJIT())
@@ -267,6 +281,12 @@ VM::~VM()
 {
     // Clear this first to ensure that nobody tries to remove themselves from it.
     m_perBytecodeProfiler.clear();
+
+#if ENABLE(SAMPLING_PROFILER)
+    // This stops the sampler thread, and resolves what it sampled while the code
+    // blocks are still alive.
+    m_samplingProfiler.clear();
+#endif
     
     ASSERT(m_apiLock->currentThreadIsHoldingLock());
     m_apiLock->willDestroyVM(this);
@@ -457,6 +477,9 @@ void VM::dumpSampleData(ExecState* exec)
 
 SourceProviderCache* VM::addSourceProviderCache(SourceProvider* sourceProvider)
 {
+    if (SourceProviderCache* cache = sourceProvider->cache())
+        return cache;
+
     SourceProviderCacheMap::AddResult addResult = sourceProviderCacheMap.add(sourceProvider, 0);
     if (addResult.isNewEntry)
         addResult.iterator->value = adoptRef(new SourceProviderCache);
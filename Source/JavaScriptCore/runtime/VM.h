@@ -40,6 +40,7 @@
 #include "JSLock.h"
 #include "LLIntData.h"
 #include "MacroAssemblerCodeRef.h"
+#include "MegamorphicCache.h"
 #include "NumericStrings.h"
 #include "ProfilerDatabase.h"
 #include "PrivateName.h"
@@ -80,6 +81,7 @@ namespace JSC {
     class NativeExecutable;
     class ParserArena;
     class RegExpCache;
+    class SamplingProfiler;
     class SourceProvider;
     class SourceProviderCache;
     struct StackFrame;
@@ -265,6 +267,7 @@ namespace JSC {
         const MarkedArgumentBuffer* emptyList; // Lists are supposed to be allocated on the stack to have their elements properly marked, which is not the case here - but this list has nothing to mark.
         SmallStrings smallStrings;
         NumericStrings numericStrings;
+        MegamorphicCache megamorphicCache;
         DateInstanceCache dateInstanceCache;
         WTF::SimpleStats machineCodeBytesPerBytecodeWordForBaselineJIT;
         Vector<CodeBlock*> codeBlocksBeingCompiled;
@@ -294,6 +297,10 @@ namespace JSC {
             return m_enabledProfiler;
         }
 
+#if ENABLE(SAMPLING_PROFILER)
+        SamplingProfiler* samplingProfiler() { return m_samplingProfiler.get(); }
+#endif
+
 #if ENABLE(JIT) && ENABLE(LLINT)
         bool canUseJIT() { return m_canUseJIT; }
 #elif ENABLE(JIT)
@@ -380,8 +387,14 @@ namespace JSC {
 
         LegacyProfiler* m_enabledProfiler;
         OwnPtr<Profiler::Database> m_perBytecodeProfiler;
+#if ENABLE(SAMPLING_PROFILER)
+        OwnPtr<SamplingProfiler> m_samplingProfiler;
+#endif
         RegExpCache* m_regExpCache;
         BumpPointerAllocator m_regExpAllocator;
+        // Number of RegExp compilations the Yarr JIT could not handle, which
+        // therefore run in the Yarr interpreter.
+        unsigned m_regExpJITFallbackCount;
 
 #if ENABLE(REGEXP_TRACING)
         typedef ListHashSet<RefPtr<RegExp> > RTTraceList;
@@ -439,6 +452,17 @@ namespace JSC {
         registerTypedArrayFunction(float32, Float32);
         registerTypedArrayFunction(float64, Float64);
 #undef registerTypedArrayFunction
+
+        // DataView has no JSC-side class, so its descriptor is registered by whoever
+        // provides the wrapper. m_lengthOffset refers to the view's byte length.
+        void registerDataViewDescriptor(const TypedArrayDescriptor& descriptor)
+        {
+            ASSERT(!m_dataViewDescriptor.m_classInfo || m_dataViewDescriptor.m_classInfo == descriptor.m_classInfo);
+            m_dataViewDescriptor = descriptor;
+            ASSERT(m_dataViewDescriptor.m_classInfo);
+        }
+        bool hasDataViewDescriptor() const { return m_dataViewDescriptor.m_classInfo; }
+        const TypedArrayDescriptor& dataViewDescriptor() const { ASSERT(m_dataViewDescriptor.m_classInfo); return m_dataViewDescriptor; }
         
         const TypedArrayDescriptor* typedArrayDescriptor(TypedArrayType type) const
         {
@@ -505,6 +529,7 @@ namespace JSC {
         TypedArrayDescriptor m_uint32ArrayDescriptor;
         TypedArrayDescriptor m_float32ArrayDescriptor;
         TypedArrayDescriptor m_float64ArrayDescriptor;
+        TypedArrayDescriptor m_dataViewDescriptor;
     };
 
 #if ENABLE(GC_VALIDATION)
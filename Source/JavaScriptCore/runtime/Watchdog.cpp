@@ -45,6 +45,8 @@ Watchdog::Watchdog()
     , m_callback(0)
     , m_callbackData1(0)
     , m_callbackData2(0)
+    , m_safePointCallback(0)
+    , m_safePointCallbackData(0)
 {
     initTimer();
 }
@@ -95,6 +97,13 @@ bool Watchdog::didFire(ExecState* exec)
     if (!m_timerDidFire)
         return false;
     m_timerDidFire = false;
+
+    if (m_safePointCallback)
+        m_safePointCallback(m_safePointCallbackData);
+
+    // A stopped countdown means that the flag was only set by requestSafePoint().
+    if (m_isStopped)
+        return false;
     stopCountdown();
 
     double currentTime = currentCPUTime();
@@ -135,6 +144,12 @@ bool Watchdog::isEnabled()
     return (m_limit != NO_LIMIT);
 }
 
+void Watchdog::setSafePointCallback(SafePointCallback callback, void* data)
+{
+    m_safePointCallback = callback;
+    m_safePointCallbackData = data;
+}
+
 void Watchdog::fire()
 {
     m_didFire = true;
@@ -51,6 +51,16 @@ public:
 
     bool isEnabled();
 
+    // A safe point callback is called on the script thread at the next loop
+    // hint or VM entry after another thread calls requestSafePoint(). Only code
+    // compiled while a callback is installed has the polling checks for it.
+    typedef void (*SafePointCallback)(void* data);
+    void setSafePointCallback(SafePointCallback, void* data);
+    void requestSafePoint() { m_timerDidFire = true; }
+
+    // Whether compiled code needs to poll timerDidFireAddress().
+    bool needsPollingChecks() { return isEnabled() || m_safePointCallback; }
+
     // This version of didFire() is a more efficient version for when we want
     // to know if the watchdog has fired in the past, and not whether it should
     // fire right now.
@@ -76,8 +86,9 @@ private:
     // m_timerDidFire (above) indicates whether the timer fired. The Watchdog
     // still needs to check if the allowed CPU time has elapsed. If so, then
     // the Watchdog fires and m_didFire will be set.
-    // NOTE: m_timerDidFire is only set by the platform specific timer
-    // (probably from another thread) but is only cleared in the script thread.
+    // NOTE: m_timerDidFire is only set by the platform specific timer or by
+    // requestSafePoint() (probably from another thread) but is only cleared in
+    // the script thread.
     bool m_timerDidFire;
     bool m_didFire;
 
@@ -93,6 +104,9 @@ private:
     void* m_callbackData1;
     void* m_callbackData2;
 
+    SafePointCallback m_safePointCallback;
+    void* m_safePointCallbackData;
+
 #if PLATFORM(MAC) || PLATFORM(IOS)
     dispatch_queue_t m_queue;
     dispatch_source_t m_timer;
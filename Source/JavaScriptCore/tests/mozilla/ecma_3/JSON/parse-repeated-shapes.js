@@ -0,0 +1,157 @@
+/*
+* SUMMARY: JSON.parse of arrays of objects with the same keys
+*
+* The engine may reuse the shape of the last object parsed at a nesting depth
+* for the next one. Check objects whose keys change part way through an array,
+* duplicate keys, keys that are array indices, __proto__ keys and revivers.
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'JSON.parse of arrays of objects with the same keys';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+function describe(value)
+{
+  if (typeof value != 'object' || value === null)
+    return String(value);
+  var parts = [];
+  for (var key in value)
+    parts.push(key + ':' + describe(value[key]));
+  return (value instanceof Array ? '[' : '{') + parts.join(',') + (value instanceof Array ? ']' : '}');
+}
+
+// Keys that diverge from the previous object's after some of them matched.
+status = inSection(1);
+actual = describe(JSON.parse('[{"a":1,"b":2},{"a":3,"b":4},{"a":5,"c":6},{"a":7,"b":8,"d":9},{"a":10},{"b":11,"a":12},{"a":13,"b":14},{}]'));
+expect = '[0:{a:1,b:2},1:{a:3,b:4},2:{a:5,c:6},3:{a:7,b:8,d:9},4:{a:10},5:{b:11,a:12},6:{a:13,b:14},7:{}]';
+addThis();
+
+status = inSection(2);
+actual = describe(JSON.parse('[{"p":{"x":1,"y":2}},{"p":{"x":3,"y":4}},{"p":{"y":5,"x":6}},{"p":{"x":7,"y":8}}]'));
+expect = '[0:{p:{x:1,y:2}},1:{p:{x:3,y:4}},2:{p:{y:5,x:6}},3:{p:{x:7,y:8}}]';
+addThis();
+
+// Objects parsed with the same keys stay independent of each other.
+status = inSection(3);
+var records = JSON.parse('[{"a":1,"b":{"c":2}},{"a":3,"b":{"c":4}}]');
+records[0].a = 'changed';
+records[0].extra = true;
+delete records[0].b.c;
+actual = describe(records);
+expect = '[0:{a:changed,b:{},extra:true},1:{a:3,b:{c:4}}]';
+addThis();
+
+status = inSection(4);
+var text = '[';
+for (var i = 0; i < 1000; i++)
+  text += (i ? ',' : '') + '{"id":' + i + ',"name":"n' + i + '","tags":["t' + i + '"],"next":{"id":' + (i + 1) + '}}';
+text += ']';
+var many = JSON.parse(text);
+actual = 0;
+for (var i = 0; i < many.length; i++) {
+  if (many[i].id == i && many[i].name == 'n' + i && many[i].tags[0] == 't' + i && many[i].next.id == i + 1)
+    actual++;
+}
+expect = 1000;
+addThis();
+
+// The last of several duplicate keys wins, and keeps the position of the first.
+status = inSection(5);
+actual = describe(JSON.parse('[{"a":1,"b":2},{"a":3,"a":4},{"a":5,"b":6,"a":7},{"a":8,"b":9,"b":10},{"a":11,"b":12}]'));
+expect = '[0:{a:1,b:2},1:{a:4},2:{a:7,b:6},3:{a:8,b:10},4:{a:11,b:12}]';
+addThis();
+
+// Keys that are array indices, and keys that only look like them.
+status = inSection(6);
+var indexed = JSON.parse('[{"0":1,"a":2},{"0":3,"a":4},{"a":5,"1":6},{"a":7,"4294967295":8},{"a":9,"4294967294":10},{"a":11,"01":12}]');
+actual = describe(indexed);
+expect = '[0:{0:1,a:2},1:{0:3,a:4},2:{1:6,a:5},3:{a:7,4294967295:8},4:{4294967294:10,a:9},5:{a:11,01:12}]';
+addThis();
+
+status = inSection(7);
+actual = indexed[2][1] + indexed[3]['4294967295'] + indexed[4][4294967294];
+expect = 6 + 8 + 10;
+addThis();
+
+// __proto__ is an ordinary key, and does not change the prototype.
+status = inSection(8);
+var withProto = JSON.parse('[{"__proto__":{"x":1},"a":2},{"__proto__":{"x":3},"a":4},{"a":5,"__proto__":null}]');
+actual = '';
+for (var i = 0; i < withProto.length; i++) {
+  actual += (Object.getPrototypeOf(withProto[i]) === Object.prototype) + ' ';
+  actual += withProto[i].hasOwnProperty('__proto__') + ' ';
+  actual += describe(Object.getOwnPropertyDescriptor(withProto[i], '__proto__').value) + ' ';
+  actual += (withProto[i].x === undefined) + ';';
+}
+expect = 'true true {x:1} true;true true {x:3} true;true true null true;';
+addThis();
+
+// Revivers see, replace and remove properties of objects with the same keys.
+status = inSection(9);
+actual = describe(JSON.parse('[{"a":1,"b":2},{"a":3,"b":4},{"a":5,"b":6}]', function(key, value) {
+  if (key == 'a')
+    return undefined;
+  if (key == 'b')
+    return value * 10;
+  return value;
+}));
+expect = '[0:{b:20},1:{b:40},2:{b:60}]';
+addThis();
+
+status = inSection(10);
+var seen = [];
+JSON.parse('[{"a":1,"b":{"c":2}},{"a":3,"b":{"c":4}}]', function(key, value) {
+  seen.push(key);
+  return value;
+});
+actual = seen.join(',');
+expect = 'a,c,b,0,a,c,b,1,';
+addThis();
+
+status = inSection(11);
+var revived = JSON.parse('[{"a":1,"b":2},{"a":3,"b":4}]', function(key, value) {
+  if (key == 'a')
+    this.added = value;
+  return value;
+});
+actual = describe(revived);
+expect = '[0:{a:1,b:2,added:1},1:{a:3,b:4,added:3}]';
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
@@ -0,0 +1,223 @@
+/*
+* SUMMARY: JSON.stringify of plain objects and arrays
+*
+* The engine may write plain objects and arrays straight from their storage
+* and fall back to the general algorithm for anything it cannot handle that
+* way. Check that property order, skipped values, holes, toJSON, getters,
+* replacers, gaps and cycles all come out as the general algorithm has them.
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'JSON.stringify of plain objects and arrays';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+// Properties come out in the order they were added.
+status = inSection(1);
+actual = JSON.stringify({b: 1, a: 2, c: 3});
+expect = '{"b":1,"a":2,"c":3}';
+addThis();
+
+status = inSection(2);
+var reordered = {a: 1, b: 2, c: 3};
+delete reordered.a;
+reordered.a = 4;
+actual = JSON.stringify(reordered);
+expect = '{"b":2,"c":3,"a":4}';
+addThis();
+
+// Many objects of the same shape, and some with the same names added in another order.
+status = inSection(3);
+var points = [];
+for (var i = 0; i < 100; i++)
+  points.push(i % 2 ? {x: i, y: -i} : {y: -i, x: i});
+actual = JSON.stringify(points).slice(0, 49);
+expect = '[{"y":0,"x":0},{"x":1,"y":-1},{"y":-2,"x":2},{"x"';
+addThis();
+
+status = inSection(4);
+actual = JSON.stringify({'a"b': 1, '\n': 2, '\u2028': 3});
+expect = '{"a\\"b":1,"\\n":2,"\u2028":3}';
+addThis();
+
+// Undefined and function values are left out of objects and become null in arrays.
+status = inSection(5);
+actual = JSON.stringify({a: undefined, b: function() {}, c: 1, d: undefined});
+expect = '{"c":1}';
+addThis();
+
+status = inSection(6);
+actual = JSON.stringify([undefined, function() {}, 1, null]);
+expect = '[null,null,1,null]';
+addThis();
+
+status = inSection(7);
+actual = JSON.stringify({a: [1.5, NaN, Infinity, -0], b: new Number(3), c: new String('s'), d: new Boolean(false)});
+expect = '{"a":[1.5,null,null,0],"b":3,"c":"s","d":false}';
+addThis();
+
+// Holes read through the prototype chain, in every kind of array storage.
+status = inSection(8);
+actual = JSON.stringify([[1, , 3], [1.5, , 2.5], ['a', , 'c']]);
+expect = '[[1,null,3],[1.5,null,2.5],["a",null,"c"]]';
+addThis();
+
+status = inSection(9);
+Array.prototype[1] = 'x';
+actual = JSON.stringify([[1, , 3], [1.5, , 2.5], ['a', , 'c']]);
+delete Array.prototype[1];
+expect = '[[1,"x",3],[1.5,"x",2.5],["a","x","c"]]';
+addThis();
+
+status = inSection(10);
+var sparse = [];
+sparse[3] = 1;
+actual = JSON.stringify(sparse);
+expect = '[null,null,null,1]';
+addThis();
+
+// toJSON found on the prototype chain.
+status = inSection(11);
+function WithToJSON() { this.a = 1; }
+WithToJSON.prototype.toJSON = function(key) { return 'toJSON:' + key; };
+actual = JSON.stringify({x: new WithToJSON(), y: [new WithToJSON()]});
+expect = '{"x":"toJSON:x","y":["toJSON:0"]}';
+addThis();
+
+status = inSection(12);
+Object.prototype.toJSON = function() { return 7; };
+actual = JSON.stringify({a: 1});
+delete Object.prototype.toJSON;
+expect = '7';
+addThis();
+
+status = inSection(13);
+Array.prototype.toJSON = function() { return this.length; };
+actual = JSON.stringify({a: [1, 2, 3], b: {c: []}});
+delete Array.prototype.toJSON;
+expect = '{"a":3,"b":{"c":0}}';
+addThis();
+
+status = inSection(14);
+actual = JSON.stringify({d: new Date(0)});
+expect = '{"d":"1970-01-01T00:00:00.000Z"}';
+addThis();
+
+// Getters run, in property order, and can change properties that have not been written yet.
+status = inSection(15);
+var withGetter = {get a() { withGetter.b = 'changed'; return 5; }, b: 0};
+actual = JSON.stringify(withGetter);
+expect = '{"a":5,"b":"changed"}';
+addThis();
+
+status = inSection(16);
+var inheritsGetter = Object.create({get z() { return 1; }});
+inheritsGetter.own = 2;
+actual = JSON.stringify(inheritsGetter);
+expect = '{"own":2}';
+addThis();
+
+status = inSection(17);
+var hidden = {a: 1};
+Object.defineProperty(hidden, 'b', {value: 2, enumerable: false});
+actual = JSON.stringify(hidden);
+expect = '{"a":1}';
+addThis();
+
+// Replacers and gaps.
+status = inSection(18);
+actual = JSON.stringify({a: 1, b: [1, 2]}, null, 2);
+expect = '{\n  "a": 1,\n  "b": [\n    1,\n    2\n  ]\n}';
+addThis();
+
+status = inSection(19);
+actual = JSON.stringify({a: 1, b: [1, 2]}, function(key, value) { return typeof value == 'number' ? value * 2 : value; });
+expect = '{"a":2,"b":[2,4]}';
+addThis();
+
+status = inSection(20);
+actual = JSON.stringify({a: 1, b: 2, c: {b: 3, d: 4}}, ['b', 'c']);
+expect = '{"b":2,"c":{"b":3}}';
+addThis();
+
+status = inSection(21);
+actual = JSON.stringify({a: [1]}, null, '--');
+expect = '{\n--"a": [\n----1\n--]\n}';
+addThis();
+
+// Cycles throw, while the same object reached twice does not.
+status = inSection(22);
+var cyclic = {a: 1};
+cyclic.self = cyclic;
+try {
+  JSON.stringify(cyclic);
+  actual = 'no exception';
+} catch (e) {
+  actual = e instanceof TypeError;
+}
+expect = true;
+addThis();
+
+status = inSection(23);
+var cyclicArray = [1, 2];
+cyclicArray.push({inner: [cyclicArray]});
+try {
+  JSON.stringify(cyclicArray);
+  actual = 'no exception';
+} catch (e) {
+  actual = e instanceof TypeError;
+}
+expect = true;
+addThis();
+
+status = inSection(24);
+var shared = {v: 1};
+actual = JSON.stringify({x: shared, y: [shared, shared]});
+expect = '{"x":{"v":1},"y":[{"v":1},{"v":1}]}';
+addThis();
+
+// Values nested deeper than the engine may want to handle in one go.
+status = inSection(25);
+var deep = 0;
+for (var i = 0; i < 300; i++)
+  deep = i % 2 ? [deep] : {d: deep};
+actual = JSON.stringify(deep).length;
+expect = 1 + 150 * 2 + 150 * 6;
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
@@ -0,0 +1,175 @@
+/*
+* SUMMARY: Regular expressions that start with literal characters
+*
+* The engine may look for a pattern's leading literal characters before it runs
+* the matcher. Check patterns whose leading literal is followed by other terms,
+* anchors, multiline mode, lastIndex, zero and fixed counts, overlapping and
+* missing prefixes, and start offsets past the first occurrence.
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'Regular expressions that start with literal characters';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+function describe(match)
+{
+  return match ? match.index + ':' + Array.prototype.join.call(match, '|') : 'null';
+}
+
+// A leading literal followed by other terms.
+status = inSection(1);
+actual = describe(/abc(\d+)/.exec('ab1 abc abc42 abc7'));
+expect = '8:abc42|42';
+addThis();
+
+status = inSection(2);
+actual = describe(/aab/.exec('aaaab'));
+expect = '2:aab';
+addThis();
+
+status = inSection(3);
+actual = describe(/ab*c/.exec('xxacabbbc'));
+expect = '2:ac';
+addThis();
+
+status = inSection(4);
+actual = describe(/foo(?=bar)/.exec('foobaz foobar'));
+expect = '7:foo';
+addThis();
+
+status = inSection(5);
+actual = describe(/\.js$/.exec('a.js.map b.js'));
+expect = '10:.js';
+addThis();
+
+status = inSection(6);
+actual = [/xyz/.test('xy'), /xyz/.test(''), /xyz/.exec('abc') === null].join();
+expect = 'false,false,true';
+addThis();
+
+// Prefixes longer than the part that may be searched for.
+status = inSection(7);
+var longLiteral = 'abcdefghijklmnopqrstuvwxyz0123456789';
+actual = describe(new RegExp(longLiteral + '!').exec('-' + longLiteral + longLiteral + '!'));
+expect = (1 + longLiteral.length) + ':' + longLiteral + '!';
+addThis();
+
+status = inSection(8);
+actual = describe(/a{40}b/.exec(new Array(41).join('a') + 'c' + new Array(42).join('a') + 'b'));
+expect = '42:' + new Array(41).join('a') + 'b';
+addThis();
+
+// Zero and fixed counts.
+status = inSection(9);
+actual = [describe(/a{0}b/.exec('aab')), describe(/a{0}/.exec('xyz')), describe(/x{2}y/.exec('xyxxy'))].join(' ');
+expect = '2:b 0: 2:xxy';
+addThis();
+
+status = inSection(10);
+actual = 'bbb'.replace(/a{0}/g, '-');
+expect = '-b-b-b-';
+addThis();
+
+// Anchors, with and without multiline.
+status = inSection(11);
+actual = [describe(/^abc/.exec('xabc')), describe(/^abc/.exec('abcabc')), describe(/^abc/.exec('x\nabc'))].join(' ');
+expect = 'null 0:abc null';
+addThis();
+
+status = inSection(12);
+actual = [describe(/^abc/m.exec('x\nabc')), describe(/abc$/m.exec('abcd\nabc\n')), describe(/\babc/.exec('xabc abc'))].join(' ');
+expect = '2:abc 5:abc 5:abc';
+addThis();
+
+status = inSection(13);
+actual = 'ab\nab\nxab'.match(/^ab/gm).length;
+expect = 2;
+addThis();
+
+// lastIndex and global matching.
+status = inSection(14);
+var global = /ab/g;
+var indices = [];
+var match;
+while ((match = global.exec('ab-ab--ab---')))
+  indices.push(match.index + '/' + global.lastIndex);
+indices.push(global.lastIndex);
+actual = indices.join(' ');
+expect = '0/2 3/5 7/9 0';
+addThis();
+
+status = inSection(15);
+global.lastIndex = 4;
+actual = describe(global.exec('ab-ab--ab')) + ' ' + global.lastIndex;
+expect = '7:ab 9';
+addThis();
+
+status = inSection(16);
+global.lastIndex = 8;
+actual = describe(global.exec('ab-ab--ab')) + ' ' + global.lastIndex;
+expect = 'null 0';
+addThis();
+
+status = inSection(17);
+global.lastIndex = 100;
+actual = global.test('ab') + ' ' + global.lastIndex;
+expect = 'false 0';
+addThis();
+
+status = inSection(18);
+actual = ['a--a-a'.replace(/a-/g, 'X'), 'x,y,,z'.split(/,/).length, 'aXbXXc'.split(/X/).join('|')].join(' ');
+expect = 'X-Xa 4 a|b||c';
+addThis();
+
+// Patterns without a usable literal prefix.
+status = inSection(19);
+actual = [describe(/ab|cd/.exec('xcd')), describe(/abc/i.exec('xABC')), describe(/(ab)c/.exec('abxabc')), describe(/[a]b/.exec('xab'))].join(' ');
+expect = '1:cd 1:ABC 3:abc|ab 1:ab';
+addThis();
+
+// The prefix search sees strings that are not flat, and 16-bit strings.
+status = inSection(20);
+var built = '';
+for (var i = 0; i < 100; i++)
+  built += 'ab' + i;
+actual = [describe(/ab99$/.exec(built)), describe(/\u0100\u0101x/.exec('\u0100\u0101\u0100\u0101x')), describe(/ab\u0100/.exec('abab\u0100'))].join(' ');
+expect = '386:ab99 2:\u0100\u0101x 2:ab\u0100';
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
@@ -0,0 +1,187 @@
+/*
+* SUMMARY: for-in over arrays and objects with indexed properties
+*
+* The engine may reuse the property names it enumerated for an object with the
+* same shape and the same number of elements. Check enumerations of arrays
+* whose elements are deleted, pushed, or changed between and during loops, and
+* of arrays whose prototype has elements too.
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'for-in over arrays and objects with indexed properties';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+function keysOf(object)
+{
+  var keys = [];
+  for (var key in object)
+    keys.push(key);
+  return keys.join();
+}
+
+// Runs keysOf often enough for it to be compiled, and reports the last result.
+function hotKeysOf(object)
+{
+  var keys;
+  for (var i = 0; i < 200; i++)
+    keys = keysOf(object);
+  return keys;
+}
+
+status = inSection(1);
+actual = [hotKeysOf([1, 2, 3]), hotKeysOf([1.5, 2.5]), hotKeysOf(['a', {}, null])].join(' ');
+expect = '0,1,2 0,1 0,1,2';
+addThis();
+
+status = inSection(2);
+var named = [1, 2];
+named.foo = 'bar';
+actual = [hotKeysOf(named), hotKeysOf({0: 'a', 1: 'b', x: 1})].join(' ');
+expect = '0,1,foo 0,1,x';
+addThis();
+
+// Elements deleted, added, or cut off between loops over an array of the same shape.
+status = inSection(3);
+var changing = [10, 20, 30, 40];
+var results = [hotKeysOf(changing)];
+delete changing[1];
+results.push(hotKeysOf(changing));
+changing[1] = 21;
+results.push(hotKeysOf(changing));
+changing.push(50);
+results.push(hotKeysOf(changing));
+changing.length = 2;
+results.push(hotKeysOf(changing));
+changing.length = 0;
+results.push(hotKeysOf(changing));
+actual = results.join(' ');
+expect = '0,1,2,3 0,2,3 0,1,2,3 0,1,2,3,4 0,1 ';
+addThis();
+
+status = inSection(4);
+var counts = [];
+for (var i = 0; i < 200; i++) {
+  var array = [1, 2, 3, 4];
+  if (i % 2)
+    delete array[3];
+  counts.push(keysOf(array).length);
+}
+actual = counts.slice(-4).join();
+expect = '7,5,7,5';
+addThis();
+
+// Elements deleted while the loop runs are not visited.
+status = inSection(5);
+results = [];
+for (var i = 0; i < 200; i++) {
+  var array = [1, 2, 3, 4, 5];
+  var visited = [];
+  for (var key in array) {
+    visited.push(key);
+    if (key == '1')
+      delete array[3];
+  }
+  results.push(visited.join());
+}
+actual = results[0] + ' ' + results[199];
+expect = '0,1,2,4 0,1,2,4';
+addThis();
+
+// Elements pushed while the loop runs do not make it visit any key twice.
+status = inSection(6);
+actual = '';
+for (var i = 0; i < 200; i++) {
+  var array = [1, 2, 3];
+  var seen = {};
+  var repeats = 0;
+  for (var key in array) {
+    if (seen[key])
+      repeats++;
+    seen[key] = true;
+    if (array.length < 10)
+      array.push(key);
+  }
+  if (repeats || !seen[0] || !seen[1] || !seen[2])
+    actual = 'iteration ' + i + ' visited ' + keysOf(seen);
+}
+expect = '';
+addThis();
+
+// Holes, and elements of the prototype chain.
+status = inSection(7);
+actual = [hotKeysOf([1, , 3]), hotKeysOf([, 'b']), hotKeysOf([])].join(' ');
+expect = '0,2 1 ';
+addThis();
+
+status = inSection(8);
+var short = [1, 2];
+hotKeysOf(short);
+Array.prototype[5] = 'inherited';
+actual = hotKeysOf(short);
+delete Array.prototype[5];
+actual += ' ' + hotKeysOf(short);
+expect = '0,1,5 0,1';
+addThis();
+
+status = inSection(9);
+var base = [1, 2, 3];
+var derived = Object.create(base);
+derived.own = true;
+actual = hotKeysOf(derived);
+delete base[0];
+actual += ' ' + hotKeysOf(derived);
+expect = 'own,0,1,2 own,1,2';
+addThis();
+
+// Keys are strings, and look up the right elements.
+status = inSection(10);
+var array = [5, 6, 7];
+var sum = 0;
+var types = '';
+for (var i = 0; i < 200; i++) {
+  for (var key in array) {
+    sum += array[key];
+    types = typeof key;
+  }
+}
+actual = sum + ' ' + types;
+expect = 200 * 18 + ' string';
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
@@ -0,0 +1,104 @@
+/*
+* SUMMARY: indexOf on strings built from many concatenations
+*
+* The engine may answer indexOf without flattening a string that was built by
+* concatenation. Check results for strings made of many pieces, for matches
+* that straddle two pieces, and for the same string searched many times.
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'indexOf on strings built from many concatenations';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+// A string of 1000 pieces built by a += chain, so it is deep on one side.
+var deep = '';
+for (var i = 0; i < 1000; i++)
+  deep += 'ab';
+deep += 'xyz';
+
+// A string of 1024 pieces built by concatenating halves, so it is balanced.
+function balanced(depth)
+{
+  if (!depth)
+    return 'cd';
+  return balanced(depth - 1) + balanced(depth - 1);
+}
+var wide = balanced(10) + 'xyz';
+
+status = inSection(1);
+actual = deep.indexOf('xyz');
+expect = 2000;
+addThis();
+
+status = inSection(2);
+actual = deep.indexOf('ba', 1001);
+expect = 1001;
+addThis();
+
+status = inSection(3);
+actual = wide.indexOf('dc', 7);
+expect = 7;
+addThis();
+
+status = inSection(4);
+actual = wide.indexOf('dx');
+expect = 2047;
+addThis();
+
+status = inSection(5);
+actual = wide.indexOf('cc');
+expect = -1;
+addThis();
+
+// Search the same strings over and over, from different positions.
+status = inSection(6);
+actual = 0;
+for (var i = 0; i < 1000; i++) {
+  actual += deep.indexOf('b', 2 * i) - 2 * i;
+  actual += wide.indexOf('xyz', i);
+}
+expect = 1000 + 1000 * 2048;
+addThis();
+
+status = inSection(7);
+actual = deep.indexOf('abx') + wide.indexOf('cdx');
+expect = 1998 + 2046;
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
@@ -0,0 +1,69 @@
+// Run by run-javascriptcore-tests with and without a bytecode cache file. The output
+// has to be the same whether the program was compiled or loaded from the cache.
+
+var constants = [1, 2.5, "three", true, null];
+
+function fib(n)
+{
+    return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+function classify(value)
+{
+    switch (typeof value) {
+    case "number":
+        return value % 1 ? "fraction" : "integer";
+    case "string":
+        return "string of " + value.length;
+    case "boolean":
+        return "boolean";
+    default:
+        return "other";
+    }
+}
+
+function makeCounter()
+{
+    var count = 0;
+    return function() { return ++count; };
+}
+
+function thrower(value)
+{
+    try {
+        if (value)
+            throw new Error("thrown " + value);
+        return "not thrown";
+    } catch (e) {
+        return e.message;
+    } finally {
+        constants.length = 5;
+    }
+}
+
+var results = [];
+for (var i = 0; i < constants.length; ++i)
+    results.push(classify(constants[i]));
+print(results.join(", "));
+
+print("fib(20) = " + fib(20));
+
+var counter = makeCounter();
+counter();
+counter();
+print("counter = " + counter());
+
+print(thrower(0) + ", " + thrower(42));
+
+var object = { a: 1, b: "two", c: [3, 4] };
+var keys = [];
+for (var key in object)
+    keys.push(key + "=" + object[key]);
+print(keys.join(" "));
+
+print("a1b22c333".replace(/(\d)+/g, "#") + " " + /^(\w+)@(\w+)\.com$/.exec("user@example.com")[2]);
+
+var sum = 0;
+for (var j = 0; j < 1000; ++j)
+    sum += j & 7;
+print("sum = " + sum);
@@ -0,0 +1,92 @@
+// Run by run-javascriptcore-tests, which expects it to print PASS. Fills the copied
+// space with array and property storage of many sizes, drops most of it, and checks
+// that what survives is copied intact, however the copying was shared between threads.
+
+var failures = [];
+
+function check(condition, description)
+{
+    if (!condition && failures.length < 10)
+        failures.push(description);
+}
+
+function makeArray(seed)
+{
+    var length = 1 + seed % 300;
+    var array = new Array(length);
+    for (var i = 0; i < length; ++i)
+        array[i] = seed * 7 + i;
+    return array;
+}
+
+function isIntactArray(array, seed, extra)
+{
+    var length = 1 + seed % 300;
+    if (array.length !== length + extra)
+        return false;
+    for (var i = 0; i < length; ++i) {
+        if (array[i] !== seed * 7 + i)
+            return false;
+    }
+    for (var i = 0; i < extra; ++i) {
+        if (array[length + i] !== "extra" + i)
+            return false;
+    }
+    return true;
+}
+
+// Objects with more properties than fit inline keep the rest in the copied space.
+function makeObject(seed)
+{
+    var object = {};
+    for (var i = 0; i < 5 + seed % 20; ++i)
+        object["p" + i] = seed + i;
+    return object;
+}
+
+function isIntactObject(object, seed)
+{
+    var count = 0;
+    for (var name in object) {
+        if (object[name] !== seed + count || name !== "p" + count)
+            return false;
+        ++count;
+    }
+    return count === 5 + seed % 20;
+}
+
+var arrays = [];
+var objects = [];
+for (var round = 0; round < 10; ++round) {
+    // Keep one in three, so that most blocks end up sparse and get evacuated.
+    for (var i = 0; i < 6000; ++i) {
+        var seed = round * 6000 + i;
+        var array = makeArray(seed);
+        var object = makeObject(seed);
+        if (!(i % 3)) {
+            arrays.push({ seed: seed, extra: 0, array: array });
+            objects.push({ seed: seed, object: object });
+        }
+    }
+    gc();
+
+    // Growing storage after a collection moves it again on the next one.
+    for (var i = round % 2; i < arrays.length; i += 2) {
+        arrays[i].array.push("extra" + arrays[i].extra);
+        ++arrays[i].extra;
+    }
+    gc();
+
+    for (var i = 0; i < arrays.length; ++i)
+        check(isIntactArray(arrays[i].array, arrays[i].seed, arrays[i].extra), "round " + round + ": array " + arrays[i].seed + " is damaged");
+    for (var i = 0; i < objects.length; ++i)
+        check(isIntactObject(objects[i].object, objects[i].seed), "round " + round + ": object " + objects[i].seed + " is damaged");
+
+    // Let half of the survivors go, so that the next round copies from sparse blocks too.
+    if (round % 3 == 2) {
+        arrays = arrays.filter(function(entry, index) { return index % 2; });
+        objects = objects.filter(function(entry, index) { return index % 2; });
+    }
+}
+
+print(failures.length ? failures.join("\n") : "PASS");
@@ -0,0 +1,80 @@
+// Run by run-javascriptcore-tests, which expects it to print PASS. Allocates objects
+// with and without destructors while collecting often, and checks that the objects
+// that stay reachable keep their contents while their blocks are swept and reused.
+
+var failures = [];
+
+function check(condition, description)
+{
+    if (!condition && failures.length < 10)
+        failures.push(description);
+}
+
+function makeRecord(i)
+{
+    // Plain objects and arrays have no destructors; strings, dates and regexps do.
+    return {
+        id: i,
+        tag: "record" + i,
+        values: [i, i + 1, i + 2],
+        date: new Date(i),
+        pattern: new RegExp("r" + i),
+        nested: { parent: i }
+    };
+}
+
+function checkRecord(record, i, description)
+{
+    check(record.id === i, description + ": id is " + record.id);
+    check(record.tag === "record" + i, description + ": tag is " + record.tag);
+    check(record.values.length === 3 && record.values[0] === i && record.values[2] === i + 2, description + ": values are " + record.values);
+    check(record.date.getTime() === i, description + ": date is " + record.date.getTime());
+    check(record.pattern.source === "r" + i, description + ": pattern is " + record.pattern.source);
+    check(record.nested.parent === i, description + ": nested.parent is " + record.nested.parent);
+}
+
+// Every round overwrites each survivor slot, so old records become garbage in blocks
+// that also hold live ones.
+var survivors = new Array(1000);
+var garbage = 0;
+for (var round = 0; round < 40; ++round) {
+    for (var i = 0; i < 5000; ++i) {
+        var record = makeRecord(round * 5000 + i);
+        if (!(i % 5))
+            survivors[i / 5] = record;
+        else
+            garbage += record.values.length;
+    }
+    if (!(round % 4))
+        gc();
+    for (var i = 0; i < survivors.length; ++i)
+        checkRecord(survivors[i], round * 5000 + 5 * i, "round " + round + ", survivor " + i);
+}
+check(garbage === 40 * 4000 * 3, "garbage count is " + garbage);
+
+// Each survivor slot was last written by the final round.
+for (var i = 0; i < survivors.length; ++i)
+    check(survivors[i].id === 39 * 5000 + 5 * i, "survivor " + i + " has id " + survivors[i].id);
+
+// Allocation right after a collection reaches blocks that may still be being swept.
+var chains = [];
+for (var round = 0; round < 20; ++round) {
+    gc();
+    var chain = null;
+    for (var i = 0; i < 2000; ++i)
+        chain = { next: chain, value: round * 2000 + i, text: "t" + i };
+    chains[round % 5] = chain;
+}
+for (var i = 0; i < chains.length; ++i) {
+    var length = 0;
+    var expectedRound = 15 + i;
+    var isIntact = true;
+    for (var node = chains[i]; node; node = node.next) {
+        if (node.value !== expectedRound * 2000 + 1999 - length || node.text !== "t" + (1999 - length))
+            isIntact = false;
+        ++length;
+    }
+    check(isIntact && length === 2000, "chain " + i + " is damaged");
+}
+
+print(failures.length ? failures.join("\n") : "PASS");
@@ -0,0 +1,150 @@
+// Run by run-javascriptcore-tests, which expects it to print PASS. Builds a small
+// object graph out of arguments objects, which are the only cells of their class in
+// this program, and checks their dominators and retained sizes in heapSnapshot().
+//
+//          graph
+//         /     \
+//      left     right
+//      /   \     /
+//    own   shared
+//     |
+//    tag
+
+var failures = [];
+
+function check(condition, description)
+{
+    if (!condition)
+        failures.push(description);
+}
+
+function graphNode()
+{
+    return arguments;
+}
+
+var graph = graphNode();
+graph.left = graphNode();
+graph.right = graphNode();
+graph.left.own = graphNode();
+graph.left.own.tag = graphNode();
+graph.left.shared = graphNode();
+graph.right.shared = graph.left.shared;
+
+// Overwrites the stack, so that stale pointers to the graph are not found by the
+// conservative scan and reported as roots.
+function clobberStack(depth)
+{
+    var a = depth, b = depth + 1, c = depth + 2;
+    return depth ? clobberStack(depth - 1) + a + b + c : 0;
+}
+
+function takeSnapshot()
+{
+    clobberStack(200);
+    var snapshot = JSON.parse(heapSnapshot());
+    var fieldCount = snapshot.nodeFields.length;
+    var nodes = [];
+    for (var i = 0; i < snapshot.nodes.length; i += fieldCount) {
+        nodes.push({
+            id: snapshot.nodes[i],
+            className: snapshot.classNames[snapshot.nodes[i + 1]],
+            size: snapshot.nodes[i + 2],
+            retainedSize: snapshot.nodes[i + 3],
+            dominator: snapshot.nodes[i + 4],
+            children: []
+        });
+    }
+    for (var i = 0; i < snapshot.edges.length; i += 2) {
+        var children = nodes[snapshot.edges[i]].children;
+        var child = snapshot.edges[i + 1];
+        if (children.indexOf(child) == -1)
+            children.push(child);
+    }
+    return nodes;
+}
+
+function argumentsChildren(nodes, index)
+{
+    return nodes[index].children.filter(function(child) { return nodes[child].className == "Arguments"; });
+}
+
+// The retained size of a node is its own size plus the retained sizes of the nodes
+// it immediately dominates, and the root retains everything.
+function checkRetainedSizes(nodes, description)
+{
+    var expected = nodes.map(function(node) { return node.size; });
+    var total = 0;
+    for (var i = 0; i < nodes.length; ++i) {
+        check(nodes[i].id == i, description + ": node " + i + " has id " + nodes[i].id);
+        total += nodes[i].size;
+        if (i)
+            expected[nodes[i].dominator] += nodes[i].retainedSize;
+    }
+    for (var i = 0; i < nodes.length; ++i)
+        check(nodes[i].retainedSize == expected[i], description + ": node " + i + " retains " + nodes[i].retainedSize + " bytes, expected " + expected[i]);
+    check(nodes[0].retainedSize == total, description + ": the root retains " + nodes[0].retainedSize + " bytes of " + total);
+}
+
+// Finds the nodes of the graph by their shape.
+function findGraph(nodes, description)
+{
+    var pointedTo = [];
+    var candidates = [];
+    for (var i = 0; i < nodes.length; ++i) {
+        if (nodes[i].className != "Arguments")
+            continue;
+        candidates.push(i);
+        argumentsChildren(nodes, i).forEach(function(child) { pointedTo[child] = true; });
+    }
+    var roots = candidates.filter(function(index) { return !pointedTo[index]; });
+    check(roots.length == 1, description + ": found " + roots.length + " graph roots");
+    if (roots.length != 1)
+        return null;
+
+    var result = { graph: roots[0] };
+    var children = argumentsChildren(nodes, result.graph);
+    check(children.length == 2, description + ": graph has " + children.length + " children");
+    if (children.length != 2)
+        return null;
+    var leftIsFirst = argumentsChildren(nodes, children[0]).length == 2;
+    result.left = children[leftIsFirst ? 0 : 1];
+    result.right = children[leftIsFirst ? 1 : 0];
+
+    children = argumentsChildren(nodes, result.left);
+    check(children.length == 2, description + ": left has " + children.length + " children");
+    if (children.length != 2)
+        return null;
+    var ownIsFirst = argumentsChildren(nodes, children[0]).length == 1;
+    result.own = children[ownIsFirst ? 0 : 1];
+    result.shared = children[ownIsFirst ? 1 : 0];
+    result.tag = argumentsChildren(nodes, result.own)[0];
+    return result;
+}
+
+var nodes = takeSnapshot();
+checkRetainedSizes(nodes, "first snapshot");
+var found = findGraph(nodes, "first snapshot");
+if (found) {
+    check(nodes[found.left].dominator == found.graph, "left is not dominated by graph");
+    check(nodes[found.right].dominator == found.graph, "right is not dominated by graph");
+    check(nodes[found.shared].dominator == found.graph, "shared is reachable through left and right, but is not dominated by graph");
+    check(nodes[found.own].dominator == found.left, "own is not dominated by left");
+    check(nodes[found.tag].dominator == found.own, "tag is not dominated by own");
+    check(argumentsChildren(nodes, found.right).indexOf(found.shared) != -1, "right does not point to shared");
+    // Nodes also retain their own structures, so only check what is retained from below.
+    check(nodes[found.left].retainedSize >= nodes[found.left].size + nodes[found.own].retainedSize, "left does not retain own");
+    check(nodes[found.graph].retainedSize >= nodes[found.graph].size + nodes[found.left].retainedSize + nodes[found.right].retainedSize + nodes[found.shared].retainedSize, "graph does not retain everything below it");
+}
+
+// Once right no longer points to shared, left dominates it.
+delete graph.right.shared;
+nodes = takeSnapshot();
+checkRetainedSizes(nodes, "second snapshot");
+found = findGraph(nodes, "second snapshot");
+if (found) {
+    check(nodes[found.shared].dominator == found.left, "shared is only reachable through left, but is not dominated by it");
+    check(nodes[found.left].retainedSize >= nodes[found.left].size + nodes[found.own].retainedSize + nodes[found.shared].retainedSize, "left does not retain own and shared");
+}
+
+print(failures.length ? failures.join("\n") : "PASS");
@@ -0,0 +1,31 @@
+// Run by run-javascriptcore-tests with recordInlineCacheStatistics on. The get_by_id of
+// inlineCacheProbe in readProbe sees six shapes, through every tier that compiles it, and
+// should be reported once with everything its code blocks counted.
+
+function makeObjects()
+{
+    return [
+        { inlineCacheProbe: 1 },
+        { a: 0, inlineCacheProbe: 2 },
+        { b: 0, inlineCacheProbe: 3 },
+        { a: 0, b: 0, inlineCacheProbe: 4 },
+        { c: 0, inlineCacheProbe: 5 },
+        { a: 0, c: 0, inlineCacheProbe: 6 }
+    ];
+}
+
+function readProbe(o)
+{
+    return o.inlineCacheProbe;
+}
+
+var objects = makeObjects();
+var sum = 0;
+for (var i = 0; i < 100000; ++i)
+    sum += readProbe(objects[i % objects.length]);
+
+// Values readProbe was not compiled for make optimized code exit, and eventually recompile.
+for (var i = 0; i < 1000; ++i)
+    sum += readProbe(i % 2 ? "string" : objects[i % objects.length]) ? 0 : 1;
+
+print(sum);
@@ -0,0 +1,81 @@
+// Run by run-javascriptcore-tests, which expects it to print PASS. Allocates from
+// constructors whose objects all live, all die, or change from one to the other, and
+// checks the objects that stay reachable while their allocation sites are pretenured
+// and moved back.
+
+var failures = [];
+
+function check(condition, description)
+{
+    if (!condition && failures.length < 10)
+        failures.push(description);
+}
+
+function LongLived(i)
+{
+    this.id = i;
+    this.name = "long" + i;
+    this.pair = [i, -i];
+}
+
+function ShortLived(i)
+{
+    this.id = i;
+    this.name = "short" + i;
+}
+
+function Changing(i)
+{
+    this.id = i;
+    this.next = null;
+}
+
+function isIntactLongLived(object, i)
+{
+    return object instanceof LongLived && object.id === i && object.name === "long" + i && object.pair[0] === i && object.pair[1] === -i;
+}
+
+var kept = [];
+var changing = null;
+var changingCount = 0;
+var sum = 0;
+for (var round = 0; round < 30; ++round) {
+    for (var i = 0; i < 3000; ++i) {
+        kept.push(new LongLived(round * 3000 + i));
+        sum += new ShortLived(i).id;
+
+        // Objects from this site survive in the first third, then die.
+        var object = new Changing(round * 3000 + i);
+        if (round < 10) {
+            object.next = changing;
+            changing = object;
+            ++changingCount;
+        }
+    }
+    if (round == 20) {
+        var expected = 10 * 3000 - 1;
+        for (var node = changing; node; node = node.next) {
+            check(node instanceof Changing && node.id === expected, "changing object " + expected + " is damaged");
+            --expected;
+        }
+        check(expected === -1, "the changing list stops at " + expected);
+        changing = null;
+    }
+    gc();
+
+    for (var i = round * 3000; i < kept.length; i += 97)
+        check(isIntactLongLived(kept[i], i), "round " + round + ": object " + i + " is damaged");
+}
+
+check(sum === 30 * (2999 * 3000 / 2), "sum of short-lived ids is " + sum);
+
+for (var i = 0; i < kept.length; ++i)
+    check(isIntactLongLived(kept[i], i), "object " + i + " is damaged");
+
+// Objects from a site that was pretenured are plain objects in every other way.
+kept[0].added = 1;
+delete kept[1].name;
+check(kept[0].added === 1 && kept[1].name === undefined && kept[1].id === 1, "pretenured objects do not take new properties");
+check(changingCount === 30000, "kept " + changingCount + " objects from the changing site");
+
+print(failures.length ? failures.join("\n") : "PASS");
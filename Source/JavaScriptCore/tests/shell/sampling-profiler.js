@@ -0,0 +1,21 @@
+// Run by run-javascriptcore-tests with the sampling profiler on. Most samples should
+// land in hotFunction, called from driver, called from the program.
+
+function hotFunction(n)
+{
+    var result = 0;
+    for (var i = 0; i < n; ++i)
+        result = (result + i * i) % 1000003;
+    return result;
+}
+
+function driver()
+{
+    var start = Date.now();
+    var result = 0;
+    while (Date.now() - start < 500)
+        result += hotFunction(10000);
+    return result;
+}
+
+print(driver() > 0);
@@ -0,0 +1,124 @@
+// Run by run-javascriptcore-tests, which expects it to print PASS. Runs loops whose
+// conditions are "i++ < n" and "i-- > n", and checks that the fused increment and
+// compare gives the same results as separate instructions when the operands are not
+// int32s, call valueOf, or overflow.
+
+var failures = [];
+
+function check(condition, description)
+{
+    if (!condition && failures.length < 10)
+        failures.push(description);
+}
+
+function countUp(start, limit)
+{
+    var i = start;
+    var count = 0;
+    while (i++ < limit)
+        ++count;
+    return [count, i];
+}
+
+function countDown(start, limit)
+{
+    var i = start;
+    var count = 0;
+    while (i-- > limit)
+        ++count;
+    return [count, i];
+}
+
+function checkLoop(loop, start, limit, expectedCount, expectedEnd, description)
+{
+    var result = loop(start, limit);
+    check(result[0] === expectedCount, description + ": ran " + result[0] + " times");
+    check(result[1] === expectedEnd, description + ": ended at " + result[1]);
+}
+
+// Run often enough that the loops take their int32 fast paths before the other cases.
+for (var round = 0; round < 200; ++round) {
+    checkLoop(countUp, 0, 10, 10, 11, "int32 up");
+    checkLoop(countDown, 10, 0, 10, -1, "int32 down");
+    checkLoop(countUp, 5, 5, 0, 6, "int32 up, empty");
+    checkLoop(countDown, -5, -5, 0, -6, "int32 down, empty");
+}
+
+// Increments and decrements that leave the int32 range.
+checkLoop(countUp, 2147483645, 2147483647, 2, 2147483648, "up to INT_MAX");
+checkLoop(countUp, 2147483646, 2147483649, 3, 2147483650, "up past INT_MAX");
+checkLoop(countDown, -2147483646, -2147483648, 2, -2147483649, "down to INT_MIN");
+checkLoop(countDown, -2147483647, -2147483650, 3, -2147483651, "down past INT_MIN");
+
+// Doubles, strings and other non-int32 operands.
+checkLoop(countUp, 0.5, 3, 3, 4.5, "double counter up");
+checkLoop(countDown, 3.5, 0, 4, -1.5, "double counter down");
+checkLoop(countUp, 0, 2.5, 3, 4, "double limit up");
+checkLoop(countDown, 0, -2.5, 3, -4, "double limit down");
+checkLoop(countUp, "1", "3", 2, 4, "string operands up");
+checkLoop(countDown, "3", "1", 2, 0, "string operands down");
+checkLoop(countUp, 0, NaN, 0, 1, "NaN limit up");
+check(countDown(NaN, 0)[0] === 0 && isNaN(countDown(NaN, 0)[1]), "NaN counter down runs");
+checkLoop(countUp, null, 2, 2, 3, "null counter up");
+checkLoop(countDown, true, 0, 1, -1, "boolean counter down");
+
+// The counter's valueOf runs once, when it is first converted; the limit's runs on
+// every comparison.
+var valueOfCalls = 0;
+function countedNumber(value)
+{
+    return { valueOf: function() { ++valueOfCalls; return value; } };
+}
+
+valueOfCalls = 0;
+checkLoop(countUp, countedNumber(0), 3, 3, 4, "valueOf counter up");
+check(valueOfCalls === 1, "valueOf counter up: valueOf ran " + valueOfCalls + " times");
+
+valueOfCalls = 0;
+checkLoop(countDown, countedNumber(3), 0, 3, -1, "valueOf counter down");
+check(valueOfCalls === 1, "valueOf counter down: valueOf ran " + valueOfCalls + " times");
+
+valueOfCalls = 0;
+checkLoop(countUp, 0, countedNumber(3), 3, 4, "valueOf limit up");
+check(valueOfCalls === 4, "valueOf limit up: valueOf ran " + valueOfCalls + " times");
+
+valueOfCalls = 0;
+checkLoop(countDown, 3, countedNumber(0), 3, -1, "valueOf limit down");
+check(valueOfCalls === 4, "valueOf limit down: valueOf ran " + valueOfCalls + " times");
+
+// The old value is converted before the limit, and the limit's valueOf sees the
+// incremented counter.
+var order = [];
+var limitSeen;
+var counter = { valueOf: function() { order.push("counter"); return 0; } };
+var limit = { valueOf: function() { order.push("limit"); limitSeen = counter; return 1; } };
+check(counter++ < limit, "valueOf order: 0 < 1 was false");
+check(order.join() === "counter,limit", "valueOf order is " + order.join());
+check(limitSeen === 1, "the limit's valueOf saw the counter as " + limitSeen);
+
+// A valueOf that throws ends the loop after the counter was incremented.
+var thrower = { valueOf: function() { throw "thrown"; } };
+var caught;
+var i = 0;
+try {
+    while (i++ < thrower) { }
+} catch (e) {
+    caught = e;
+}
+check(caught === "thrown" && i === 1, "throwing limit: caught " + caught + ", counter is " + i);
+
+// The same loops after the slow paths have run still take the fast path correctly.
+for (var round = 0; round < 200; ++round) {
+    checkLoop(countUp, 0, 10, 10, 11, "int32 up again");
+    checkLoop(countDown, 10, 0, 10, -1, "int32 down again");
+}
+
+// The loop forms in a for statement, with the result used outside the condition too.
+var sum = 0;
+for (var j = 0; j++ < 1000; )
+    sum += j;
+for (var k = 1000; k-- > 0; )
+    sum -= k;
+check(sum === 1000, "for loops sum to " + sum);
+
+print(failures.length ? failures.join("\n") : "PASS");
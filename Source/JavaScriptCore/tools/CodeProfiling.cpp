@@ -116,8 +116,10 @@ void CodeProfiling::notifyAllocator(WTF::MetaAllocator* allocator)
     }
 
     ASSERT(enabled());
-    ASSERT(!s_tracker);
-    s_tracker = new WTF::MetaAllocatorTracker();
+    // The fixed pool executable allocator registers one allocator per pool;
+    // they all share the tracker.
+    if (!s_tracker)
+        s_tracker = new WTF::MetaAllocatorTracker();
     allocator->trackAllocations(s_tracker);
 #endif
 }
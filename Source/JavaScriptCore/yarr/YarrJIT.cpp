@@ -354,6 +354,11 @@ class YarrGenerator : private MacroAssembler {
         // FIXME: should be able to ASSERT(compileMode == IncludeSubpatterns), but then this function is conditionally NORETURN. :-(
         store32(TrustedImm32(-1), Address(output, (subpattern << 1) * sizeof(int)));
     }
+    void clearSubpatternEnd(unsigned subpattern)
+    {
+        ASSERT(subpattern);
+        store32(TrustedImm32(-1), Address(output, ((subpattern << 1) + 1) * sizeof(int)));
+    }
 
     // We use one of three different strategies to track the start of the current match,
     // while matching.
@@ -1204,6 +1209,85 @@ class YarrGenerator : private MacroAssembler {
     {
         backtrackTermDefault(opIndex);
     }
+
+    // Back references are only compiled for a single, case sensitive match of the
+    // referenced subpattern, and only when subpatterns are being recorded (the
+    // match-only code has nowhere to keep the captures). Anything else falls back
+    // to the interpreter.
+    bool canCompileBackReference(PatternTerm* term)
+    {
+        return compileMode == IncludeSubpatterns
+            && term->quantityType == QuantifierFixedCount
+            && term->quantityCount == 1
+            && !m_pattern.m_ignoreCase;
+    }
+
+    void readCharacterAt(RegisterID position, RegisterID reg)
+    {
+        if (m_charSize == Char8)
+            load8(BaseIndex(input, position, TimesOne, 0), reg);
+        else
+            load16(BaseIndex(input, position, TimesTwo, 0), reg);
+    }
+
+    void generateBackReference(size_t opIndex)
+    {
+        YarrOp& op = m_ops[opIndex];
+        PatternTerm* term = op.m_term;
+        unsigned subpatternId = term->backReferenceSubpatternId;
+        ASSERT(canCompileBackReference(term));
+
+        const RegisterID character = regT0;
+        const RegisterID matchPos = regT1;
+        Address matchEnd(output, ((subpatternId << 1) + 1) * sizeof(int));
+        Address characterSlot(stackPointerRegister, (term->frameLocation + 1) * sizeof(void*));
+
+        storeToFrame(index, term->frameLocation);
+
+        // A subpattern that has not participated in the match matches the empty string.
+        load32(Address(output, (subpatternId << 1) * sizeof(int)), matchPos);
+        JumpList matchedEmpty;
+        matchedEmpty.append(branch32(Equal, matchPos, TrustedImm32(-1)));
+
+        load32(matchEnd, character);
+        sub32(matchPos, character);
+        matchedEmpty.append(branch32(LessThanOrEqual, character, TrustedImm32(0)));
+        add32(index, character);
+        op.m_jumps.append(branch32(Above, character, length));
+
+        // Compare the captured characters against the input one at a time, advancing
+        // index as we go. The captured character is spilled to the second frame slot
+        // since there is no third temporary register on every platform.
+        Label loop(this);
+        Jump matched = branch32(Equal, matchPos, matchEnd);
+        readCharacterAt(matchPos, character);
+        storeToFrame(character, term->frameLocation + 1);
+        readCharacter(term->inputPosition - m_checked, character);
+        Jump mismatch = branch32(NotEqual, character, characterSlot);
+        add32(TrustedImm32(1), matchPos);
+        add32(TrustedImm32(1), index);
+        jump(loop);
+
+        mismatch.link(this);
+        loadFromFrame(term->frameLocation, index);
+        op.m_jumps.append(jump());
+
+        matched.link(this);
+        matchedEmpty.link(this);
+    }
+    void backtrackBackReference(size_t opIndex)
+    {
+        YarrOp& op = m_ops[opIndex];
+        PatternTerm* term = op.m_term;
+
+        // There is only one way to match a fixed count back reference, so backtracking
+        // into it just restores the input position it started from.
+        m_backtrackingState.link(this);
+        loadFromFrame(term->frameLocation, index);
+        m_backtrackingState.fallthrough();
+
+        m_backtrackingState.append(op.m_jumps);
+    }
     
     // Code generation/backtracking for simple terms
     // (pattern characters, character classes, and assertions).
@@ -1267,7 +1351,7 @@ class YarrGenerator : private MacroAssembler {
         case PatternTerm::TypeParentheticalAssertion:
             RELEASE_ASSERT_NOT_REACHED();
         case PatternTerm::TypeBackReference:
-            m_shouldFallBack = true;
+            generateBackReference(opIndex);
             break;
         case PatternTerm::TypeDotStarEnclosure:
             generateDotStarEnclosure(opIndex);
@@ -1338,7 +1422,7 @@ class YarrGenerator : private MacroAssembler {
             break;
 
         case PatternTerm::TypeBackReference:
-            m_shouldFallBack = true;
+            backtrackBackReference(opIndex);
             break;
         }
     }
@@ -2144,9 +2228,13 @@ class YarrGenerator : private MacroAssembler {
                 if ((term->capture() && compileMode == IncludeSubpatterns) || term->quantityType == QuantifierGreedy) {
                     m_backtrackingState.link(this);
 
-                    // If capturing, clear the capture (we only need to reset start).
-                    if (term->capture() && compileMode == IncludeSubpatterns)
+                    // If capturing, clear the capture. Only the start needs resetting, unless a
+                    // back reference may read the end.
+                    if (term->capture() && compileMode == IncludeSubpatterns) {
                         clearSubpatternStart(term->parentheses.subpatternId);
+                        if (m_pattern.m_containsBackreferences)
+                            clearSubpatternEnd(term->parentheses.subpatternId);
+                    }
 
                     // If Greedy, jump to the end.
                     if (term->quantityType == QuantifierGreedy) {
@@ -2429,6 +2517,14 @@ class YarrGenerator : private MacroAssembler {
                 opCompileParentheticalAssertion(term);
                 break;
 
+            case PatternTerm::TypeBackReference:
+                if (!canCompileBackReference(term)) {
+                    m_shouldFallBack = true;
+                    return;
+                }
+                m_ops.append(term);
+                break;
+
             default:
                 m_ops.append(term);
             }
@@ -2619,8 +2715,13 @@ public:
         hasInput.link(this);
 
         if (compileMode == IncludeSubpatterns) {
-            for (unsigned i = 0; i < m_pattern.m_numSubpatterns + 1; ++i)
+            for (unsigned i = 0; i < m_pattern.m_numSubpatterns + 1; ++i) {
                 store32(TrustedImm32(-1), Address(output, (i << 1) * sizeof(int)));
+                // Back references read the end of their capture, which the output
+                // vector does not otherwise initialize.
+                if (i && m_pattern.m_containsBackreferences)
+                    clearSubpatternEnd(i);
+            }
         }
 
         if (!m_pattern.m_body->m_hasFixedSize)
@@ -2632,7 +2733,7 @@ public:
         opCompileBody(m_pattern.m_body);
 
         // If we encountered anything we can't handle in the JIT code
-        // (e.g. backreferences) then return early.
+        // (e.g. quantified back references) then return early.
         if (m_shouldFallBack) {
             jitObject.setFallBack(true);
             return;
@@ -2642,7 +2743,7 @@ public:
         backtrack();
 
         // Link & finalize the code.
-        LinkBuffer linkBuffer(*vm, this, REGEXP_CODE_ID);
+        LinkBuffer linkBuffer(*vm, this, REGEXP_CODE_ID, JITCompilationMustSucceed, RegExpJITMemory);
         m_backtrackingState.linkDataLabels(linkBuffer);
 
         if (compileMode == MatchOnly) {
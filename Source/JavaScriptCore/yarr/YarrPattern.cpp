@@ -31,6 +31,7 @@
 #include "YarrCanonicalizeUCS2.h"
 #include "YarrParser.h"
 #include <wtf/Vector.h>
+#include <wtf/text/StringBuilder.h>
 
 using namespace WTF;
 
@@ -859,6 +860,31 @@ const char* YarrPattern::compile(const String& patternString)
     return 0;
 }
 
+static const unsigned maximumLiteralPrefixLength = 32;
+
+String YarrPattern::literalPrefix() const
+{
+    if (m_ignoreCase || m_body->m_alternatives.size() != 1)
+        return String();
+
+    StringBuilder prefix;
+    const Vector<PatternTerm>& terms = m_body->m_alternatives[0]->m_terms;
+    for (unsigned i = 0; i < terms.size(); ++i) {
+        const PatternTerm& term = terms[i];
+        if (term.type != PatternTerm::TypePatternCharacter || term.quantityType != QuantifierFixedCount)
+            break;
+        // A long prefix does not make the search any more selective.
+        unsigned count = std::min(term.quantityCount.unsafeGet(), maximumLiteralPrefixLength - prefix.length());
+        for (unsigned j = 0; j < count; ++j)
+            prefix.append(term.patternCharacter);
+        if (prefix.length() == maximumLiteralPrefixLength)
+            break;
+    }
+    if (prefix.isEmpty())
+        return String();
+    return prefix.toString();
+}
+
 YarrPattern::YarrPattern(const String& pattern, bool ignoreCase, bool multiline, const char** error)
     : m_ignoreCase(ignoreCase)
     , m_multiline(multiline)
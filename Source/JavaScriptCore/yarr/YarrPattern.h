@@ -331,6 +331,10 @@ struct YarrPattern {
         return m_maxBackReference > m_numSubpatterns;
     }
 
+    // Returns the characters every match must start with, or a null string if
+    // matches can start with more than one sequence (or ignoreCase is set).
+    String literalPrefix() const;
+
     CharacterClass* newlineCharacterClass()
     {
         if (!newlineCached)
@@ -131,6 +131,7 @@ HEADERS += \
     SHA1.h \
     SaturatedArithmetic.h \
     Spectrum.h \
+    StableSort.h \
     StackBounds.h \
     StaticConstructors.h \
     StdLibExtras.h \
@@ -148,6 +149,7 @@ HEADERS += \
     text/Base64.h \
     text/CString.h \
     text/IntegerToStringConversion.h \
+    text/SSE2StringKernels.h \
     text/StringBuffer.h \
     text/StringBuilder.h \
     text/StringConcatenate.h \
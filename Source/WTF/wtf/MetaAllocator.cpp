@@ -202,6 +202,21 @@ MetaAllocator::Statistics MetaAllocator::currentStatistics()
     return result;
 }
 
+MetaAllocator::FreeSpaceStatistics MetaAllocator::currentFreeSpaceStatistics()
+{
+    SpinLockHolder locker(&m_lock);
+    FreeSpaceStatistics result;
+    result.bytesFree = 0;
+    result.numberOfFreeChunks = 0;
+    for (FreeSpaceNode* node = m_freeSpaceSizeMap.first(); node; node = node->successor()) {
+        result.bytesFree += node->m_sizeInBytes;
+        result.numberOfFreeChunks++;
+    }
+    FreeSpaceNode* largest = m_freeSpaceSizeMap.last();
+    result.largestFreeChunk = largest ? largest->m_sizeInBytes : 0;
+    return result;
+}
+
 void* MetaAllocator::findAndRemoveFreeSpace(size_t sizeInBytes)
 {
     FreeSpaceNode* node = m_freeSpaceSizeMap.findLeastGreaterThanOrEqual(sizeInBytes);
@@ -88,6 +88,15 @@ public:
     };
     Statistics currentStatistics();
 
+    // Walks all of the free space, so this is meant for reporting how
+    // fragmented the allocator is rather than for allocation decisions.
+    struct FreeSpaceStatistics {
+        size_t bytesFree;
+        size_t largestFreeChunk;
+        size_t numberOfFreeChunks;
+    };
+    WTF_EXPORT_PRIVATE FreeSpaceStatistics currentFreeSpaceStatistics();
+
     // Add more free space to the allocator. Call this directly from
     // the constructor if you wish to operate the allocator within a
     // fixed pool.
@@ -167,6 +167,12 @@
 #define WTF_CPU_X86_64 1
 #endif
 
+/* CPU(X86_SSE2) - SSE2 is available at compile time, which is always true on X86_64 */
+#if CPU(X86_64) \
+    || (CPU(X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#define WTF_CPU_X86_SSE2 1
+#endif
+
 /* CPU(ARM) - ARM, any version*/
 #define WTF_ARM_ARCH_AT_LEAST(N) (CPU(ARM) && WTF_ARM_ARCH_VERSION >= N)
 
@@ -828,6 +834,14 @@
 #define ENABLE_SIMPLE_HEAP_PROFILING 0
 #endif
 
+/* Generational collection: write barriers mark cards in the owner's MarkedBlock so that
+   eden collections only need to rescan dirty old objects instead of the whole heap.
+   This is still a prototype and is off on every port until the barriers have been
+   stress tested in the LLInt, baseline JIT and DFG. */
+#if !defined(ENABLE_GGC)
+#define ENABLE_GGC 0
+#endif
+
 /* Counts uses of write barriers using sampling counters. Be sure to also
    set ENABLE_SAMPLING_COUNTERS to 1. */
 #if !defined(ENABLE_WRITE_BARRIER_PROFILING)
@@ -992,6 +1006,10 @@
 #define ENABLE_GC_VALIDATION 1
 #endif
 
+#if !defined(ENABLE_SAMPLING_PROFILER) && USE(PTHREADS) && (OS(LINUX) || OS(DARWIN))
+#define ENABLE_SAMPLING_PROFILER 1
+#endif
+
 #if !defined(ENABLE_BINDING_INTEGRITY) && !OS(WINDOWS)
 #define ENABLE_BINDING_INTEGRITY 1
 #endif
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef WTF_StableSort_h
+#define WTF_StableSort_h
+
+#include <wtf/Assertions.h>
+
+namespace WTF {
+
+// Runs shorter than this are insertion sorted before being merged.
+static const size_t stableSortInsertionSortThreshold = 16;
+
+template<typename T, typename Predicate>
+inline void insertionSortForStableSort(T* begin, size_t size, Predicate& compareLess)
+{
+    for (size_t i = 1; i < size; ++i) {
+        T value = begin[i];
+        size_t j = i;
+        for (; j && compareLess(value, begin[j - 1]); --j)
+            begin[j] = begin[j - 1];
+        begin[j] = value;
+    }
+}
+
+// Sorts [begin, begin + size) with a top-down merge sort that keeps equal elements in
+// their original order. The caller provides the merge buffer, which must have room for
+// (size + 1) / 2 elements, so the sort itself never allocates. The predicate is taken by
+// reference and may be stateful; an inconsistent predicate still yields a permutation of
+// the input.
+template<typename T, typename Predicate>
+void stableSort(T* begin, size_t size, T* buffer, Predicate& compareLess)
+{
+    if (size <= stableSortInsertionSortThreshold) {
+        insertionSortForStableSort(begin, size, compareLess);
+        return;
+    }
+
+    size_t leftSize = size / 2;
+    stableSort(begin, leftSize, buffer, compareLess);
+    stableSort(begin + leftSize, size - leftSize, buffer, compareLess);
+
+    // Already ordered input needs no merging at all.
+    if (!compareLess(begin[leftSize], begin[leftSize - 1]))
+        return;
+
+    for (size_t i = 0; i < leftSize; ++i)
+        buffer[i] = begin[i];
+
+    T* left = buffer;
+    T* leftEnd = buffer + leftSize;
+    T* right = begin + leftSize;
+    T* rightEnd = begin + size;
+    T* result = begin;
+    while (left < leftEnd && right < rightEnd) {
+        // Only take from the right run when it is strictly smaller, which keeps the sort stable.
+        if (compareLess(*right, *left))
+            *result++ = *right++;
+        else
+            *result++ = *left++;
+    }
+    while (left < leftEnd)
+        *result++ = *left++;
+    ASSERT(result == right);
+}
+
+} // namespace WTF
+
+using WTF::stableSort;
+
+#endif // WTF_StableSort_h
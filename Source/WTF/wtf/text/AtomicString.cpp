@@ -27,12 +27,12 @@
 #include "AtomicStringTable.h"
 #include "StringHash.h"
 #include <wtf/HashSet.h>
+#include <wtf/MainThread.h>
 #include <wtf/Threading.h>
 #include <wtf/WTFThreadData.h>
 #include <wtf/unicode/UTF8.h>
 
 #if USE(WEB_THREAD)
-#include <wtf/MainThread.h>
 #include <wtf/TCSpinLock.h>
 #endif
 
@@ -71,7 +71,7 @@ static ALWAYS_INLINE HashSet<StringImpl*>& stringTable()
 }
 
 template<typename T, typename HashTranslator>
-static inline PassRefPtr<StringImpl> addToStringTable(const T& value)
+static inline PassRefPtr<StringImpl> addToLocalStringTable(const T& value)
 {
     AtomicStringTableLocker locker;
 
@@ -82,6 +82,71 @@ static inline PassRefPtr<StringImpl> addToStringTable(const T& value)
     return addResult.isNewEntry ? adoptRef(*addResult.iterator) : *addResult.iterator;
 }
 
+static ALWAYS_INLINE bool shouldUseSharedStringTable(unsigned length)
+{
+    return UNLIKELY(SharedAtomicStringTable::isEnabled()) && SharedAtomicStringTable::canContain(length);
+}
+
+// A table created before the shared one was enabled may still hold short strings; those
+// are found here first so that they do not get a shared twin.
+template<typename T, typename HashTranslator>
+static inline StringImpl* findInLocalTableCreatedBeforeSharedTable(const T& value)
+{
+    AtomicStringTable* localTable = wtfThreadData().atomicStringTable();
+    if (LIKELY(!localTable->predatesSharedTable()))
+        return 0;
+
+    AtomicStringTableLocker locker;
+    HashSet<StringImpl*>::iterator iterator = localTable->table().find<HashTranslator>(value);
+    if (iterator == localTable->table().end())
+        return 0;
+    return *iterator;
+}
+
+template<typename T, typename HashTranslator>
+static PassRefPtr<StringImpl> addToSharedStringTable(const T& value)
+{
+    SharedAtomicStringTable::Stripe& stripe = SharedAtomicStringTable::shared().stripeForHash(HashTranslator::hash(value));
+    MutexLocker locker(stripe.lock());
+    HashSet<StringImpl*>& table = stripe.table();
+
+    // Once a stripe is full, strings that are not already in it are atomized per-thread.
+    // Since the table only grows, such a string will never be shared later on either.
+    if (stripe.isFull()) {
+        HashSet<StringImpl*>::iterator iterator = table.find<HashTranslator>(value);
+        if (iterator == table.end())
+            return 0;
+        return *iterator;
+    }
+
+    // The table keeps the reference created by the translator forever.
+    HashSet<StringImpl*>::AddResult addResult = table.add<HashTranslator>(value);
+    if (addResult.isNewEntry) {
+        (*addResult.iterator)->setIsSharedAtomic();
+        return *addResult.iterator;
+    }
+    return *addResult.iterator;
+}
+
+// Returns 0 when the string has to be atomized into the local table.
+template<typename T, typename HashTranslator>
+static inline PassRefPtr<StringImpl> addToSharedStringTableUnlessLocal(const T& value)
+{
+    if (StringImpl* string = findInLocalTableCreatedBeforeSharedTable<T, HashTranslator>(value))
+        return string;
+    return addToSharedStringTable<T, HashTranslator>(value);
+}
+
+template<typename T, typename HashTranslator>
+static inline PassRefPtr<StringImpl> addToStringTable(const T& value, unsigned length)
+{
+    if (shouldUseSharedStringTable(length)) {
+        if (RefPtr<StringImpl> string = addToSharedStringTableUnlessLocal<T, HashTranslator>(value))
+            return string.release();
+    }
+    return addToLocalStringTable<T, HashTranslator>(value);
+}
+
 struct CStringTranslator {
     static unsigned hash(const LChar* c)
     {
@@ -108,7 +173,10 @@ PassRefPtr<StringImpl> AtomicString::add(const LChar* c)
     if (!*c)
         return StringImpl::empty();
 
-    return addToStringTable<const LChar*, CStringTranslator>(c);
+    if (UNLIKELY(SharedAtomicStringTable::isEnabled()))
+        return add(c, strlen(reinterpret_cast<const char*>(c)));
+
+    return addToLocalStringTable<const LChar*, CStringTranslator>(c);
 }
 
 template<typename CharacterType>
@@ -241,7 +309,7 @@ PassRefPtr<StringImpl> AtomicString::add(const UChar* s, unsigned length)
         return StringImpl::empty();
     
     UCharBuffer buffer = { s, length };
-    return addToStringTable<UCharBuffer, UCharBufferTranslator>(buffer);
+    return addToStringTable<UCharBuffer, UCharBufferTranslator>(buffer, length);
 }
 
 PassRefPtr<StringImpl> AtomicString::add(const UChar* s, unsigned length, unsigned existingHash)
@@ -253,7 +321,7 @@ PassRefPtr<StringImpl> AtomicString::add(const UChar* s, unsigned length, unsign
         return StringImpl::empty();
 
     HashAndCharacters<UChar> buffer = { existingHash, s, length };
-    return addToStringTable<HashAndCharacters<UChar>, HashAndCharactersTranslator<UChar> >(buffer);
+    return addToStringTable<HashAndCharacters<UChar>, HashAndCharactersTranslator<UChar> >(buffer, length);
 }
 
 PassRefPtr<StringImpl> AtomicString::add(const UChar* s)
@@ -269,7 +337,7 @@ PassRefPtr<StringImpl> AtomicString::add(const UChar* s)
         return StringImpl::empty();
 
     UCharBuffer buffer = { s, length };
-    return addToStringTable<UCharBuffer, UCharBufferTranslator>(buffer);
+    return addToStringTable<UCharBuffer, UCharBufferTranslator>(buffer, length);
 }
 
 struct SubstringLocation {
@@ -312,8 +380,15 @@ PassRefPtr<StringImpl> AtomicString::add(StringImpl* baseString, unsigned start,
         length = maxLength;
     }
 
+    // Shared strings must not keep a per-thread base string alive, so copy the characters.
+    if (shouldUseSharedStringTable(length)) {
+        if (baseString->is8Bit())
+            return add(baseString->characters8() + start, length);
+        return add(baseString->characters16() + start, length);
+    }
+
     SubstringLocation buffer = { baseString, start, length };
-    return addToStringTable<SubstringLocation, SubstringTranslator>(buffer);
+    return addToLocalStringTable<SubstringLocation, SubstringTranslator>(buffer);
 }
     
 typedef HashTranslatorCharBuffer<LChar> LCharBuffer;
@@ -365,7 +440,7 @@ PassRefPtr<StringImpl> AtomicString::add(const LChar* s, unsigned length)
         return StringImpl::empty();
 
     LCharBuffer buffer = { s, length };
-    return addToStringTable<LCharBuffer, LCharBufferTranslator>(buffer);
+    return addToStringTable<LCharBuffer, LCharBufferTranslator>(buffer, length);
 }
 
 PassRefPtr<StringImpl> AtomicString::addFromLiteralData(const char* characters, unsigned length)
@@ -374,7 +449,14 @@ PassRefPtr<StringImpl> AtomicString::addFromLiteralData(const char* characters,
     ASSERT(length);
 
     CharBuffer buffer = { characters, length };
-    return addToStringTable<CharBuffer, CharBufferFromLiteralDataTranslator>(buffer);
+    return addToStringTable<CharBuffer, CharBufferFromLiteralDataTranslator>(buffer, length);
+}
+
+template<typename CharacterType>
+static inline StringImpl* findLocalTwinOfSharedString(StringImpl* string)
+{
+    HashAndCharacters<CharacterType> buffer = { string->existingHash(), string->getCharacters<CharacterType>(), string->length() };
+    return findInLocalTableCreatedBeforeSharedTable<HashAndCharacters<CharacterType>, HashAndCharactersTranslator<CharacterType> >(buffer);
 }
 
 PassRefPtr<StringImpl> AtomicString::addSlowCase(StringImpl* string)
@@ -382,8 +464,30 @@ PassRefPtr<StringImpl> AtomicString::addSlowCase(StringImpl* string)
     if (!string->length())
         return StringImpl::empty();
 
+    // A shared string is atomic on every thread, except on those that atomized the same
+    // characters before the shared table was enabled. Those keep using their own string.
+    if (string->isSharedAtomic()) {
+        if (StringImpl* localString = string->is8Bit() ? findLocalTwinOfSharedString<LChar>(string) : findLocalTwinOfSharedString<UChar>(string))
+            return localString;
+        return string;
+    }
+
     ASSERT_WITH_MESSAGE(!string->isAtomic(), "AtomicString should not hit the slow case if the string is already atomic.");
 
+    // The shared table makes its own copy, as other references to |string| stay on this thread.
+    if (shouldUseSharedStringTable(string->length())) {
+        RefPtr<StringImpl> sharedString;
+        if (string->is8Bit()) {
+            HashAndCharacters<LChar> buffer = { string->hash(), string->characters8(), string->length() };
+            sharedString = addToSharedStringTableUnlessLocal<HashAndCharacters<LChar>, HashAndCharactersTranslator<LChar> >(buffer);
+        } else {
+            HashAndCharacters<UChar> buffer = { string->hash(), string->characters16(), string->length() };
+            sharedString = addToSharedStringTableUnlessLocal<HashAndCharacters<UChar>, HashAndCharactersTranslator<UChar> >(buffer);
+        }
+        if (sharedString)
+            return sharedString.release();
+    }
+
     AtomicStringTableLocker locker;
     HashSet<StringImpl*>::AddResult addResult = stringTable().add(string);
 
@@ -402,6 +506,21 @@ static inline HashSet<StringImpl*>::iterator findString(const StringImpl* string
     return stringTable().find<HashAndCharactersTranslator<CharacterType> >(buffer);
 }
 
+template<typename CharacterType>
+static inline AtomicStringImpl* findSharedString(const StringImpl* stringImpl)
+{
+    HashAndCharacters<CharacterType> buffer = { stringImpl->existingHash(), stringImpl->getCharacters<CharacterType>(), stringImpl->length() };
+    if (StringImpl* localString = findInLocalTableCreatedBeforeSharedTable<HashAndCharacters<CharacterType>, HashAndCharactersTranslator<CharacterType> >(buffer))
+        return static_cast<AtomicStringImpl*>(localString);
+
+    SharedAtomicStringTable::Stripe& stripe = SharedAtomicStringTable::shared().stripeForHash(buffer.hash);
+    MutexLocker locker(stripe.lock());
+    HashSet<StringImpl*>::iterator iterator = stripe.table().find<HashAndCharactersTranslator<CharacterType> >(buffer);
+    if (iterator == stripe.table().end())
+        return 0;
+    return static_cast<AtomicStringImpl*>(*iterator);
+}
+
 AtomicStringImpl* AtomicString::find(const StringImpl* stringImpl)
 {
     ASSERT(stringImpl);
@@ -410,6 +529,11 @@ AtomicStringImpl* AtomicString::find(const StringImpl* stringImpl)
     if (!stringImpl->length())
         return static_cast<AtomicStringImpl*>(StringImpl::empty());
 
+    if (shouldUseSharedStringTable(stringImpl->length())) {
+        if (AtomicStringImpl* sharedString = stringImpl->is8Bit() ? findSharedString<LChar>(stringImpl) : findSharedString<UChar>(stringImpl))
+            return sharedString;
+    }
+
     AtomicStringTableLocker locker;
     HashSet<StringImpl*>::iterator iterator;
     if (stringImpl->is8Bit())
@@ -421,9 +545,27 @@ AtomicStringImpl* AtomicString::find(const StringImpl* stringImpl)
     return static_cast<AtomicStringImpl*>(*iterator);
 }
 
+void AtomicString::enableSharedTable()
+{
+    SharedAtomicStringTable::enable();
+}
+
+PassRefPtr<StringImpl> AtomicString::addToSharedTable(const UChar* s, unsigned length)
+{
+    if (!length || !shouldUseSharedStringTable(length))
+        return 0;
+
+    // A string this thread already holds locally cannot be shared without getting a twin.
+    UCharBuffer buffer = { s, length };
+    if (findInLocalTableCreatedBeforeSharedTable<UCharBuffer, UCharBufferTranslator>(buffer))
+        return 0;
+    return addToSharedStringTable<UCharBuffer, UCharBufferTranslator>(buffer);
+}
+
 void AtomicString::remove(StringImpl* string)
 {
     ASSERT(string->isAtomic());
+    ASSERT(!string->isSharedAtomic());
     AtomicStringTableLocker locker;
     HashSet<StringImpl*>& atomicStringTable = stringTable();
     HashSet<StringImpl*>::iterator iterator = atomicStringTable.find(string);
@@ -457,13 +599,15 @@ AtomicString AtomicString::fromUTF8Internal(const char* charactersStart, const c
         return nullAtom;
 
     AtomicString atomicString;
-    atomicString.m_string = addToStringTable<HashAndUTF8Characters, HashAndUTF8CharactersTranslator>(buffer);
+    atomicString.m_string = addToStringTable<HashAndUTF8Characters, HashAndUTF8CharactersTranslator>(buffer, buffer.utf16Length);
     return atomicString;
 }
 
 #if !ASSERT_DISABLED
 bool AtomicString::isInAtomicStringTable(StringImpl* string)
 {
+    if (string->isSharedAtomic())
+        return true;
     AtomicStringTableLocker locker;
     return stringTable().contains(string);
 }
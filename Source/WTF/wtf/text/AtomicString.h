@@ -89,6 +89,13 @@ public:
 
     WTF_EXPORT_STRING_API static AtomicStringImpl* find(const StringImpl*);
 
+    // Makes every thread atomize short strings into one process-global table, so that the
+    // resulting atomic strings can be handed from one thread to another. This has to be
+    // called on the main thread, before any thread that uses shared strings is started.
+    WTF_EXPORT_STRING_API static void enableSharedTable();
+    // Returns 0 if the shared table is disabled or cannot hold this string.
+    WTF_EXPORT_STRING_API static PassRefPtr<StringImpl> addToSharedTable(const UChar*, unsigned length);
+
     operator const String&() const { return m_string; }
     const String& string() const { return m_string; };
 
@@ -184,7 +191,7 @@ private:
     WTF_EXPORT_STRING_API static PassRefPtr<StringImpl> add(StringImpl*, unsigned offset, unsigned length);
     ALWAYS_INLINE static PassRefPtr<StringImpl> add(StringImpl* string)
     {
-        if (!string || string->isAtomic()) {
+        if (!string || (string->isAtomic() && !string->isSharedAtomic())) {
             ASSERT_WITH_MESSAGE(!string || isInAtomicStringTable(string), "The atomic string comes from an other thread!");
             return string;
         }
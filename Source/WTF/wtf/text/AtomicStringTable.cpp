@@ -23,12 +23,18 @@
 #include "config.h"
 #include "AtomicStringTable.h"
 
+#include <wtf/Atomics.h>
 #include <wtf/HashSet.h>
 #include <wtf/MainThread.h>
 #include <wtf/WTFThreadData.h>
 
 namespace WTF {
 
+AtomicStringTable::AtomicStringTable()
+    : m_predatesSharedTable(!SharedAtomicStringTable::isEnabled())
+{
+}
+
 void AtomicStringTable::create(WTFThreadData& data)
 {
 #if USE(WEB_THREAD)
@@ -51,6 +57,23 @@ void AtomicStringTable::create(WTFThreadData& data)
 #endif // USE(WEB_THREAD)
 }
 
+SharedAtomicStringTable* SharedAtomicStringTable::s_sharedTable;
+
+void SharedAtomicStringTable::enable()
+{
+    ASSERT(isMainThread());
+    if (s_sharedTable)
+        return;
+
+    // Strings this thread has already atomized stay in its own table, and keep being
+    // found there first, since the thread's table predates the shared one.
+    SharedAtomicStringTable* sharedTable = new SharedAtomicStringTable;
+
+    // Other threads may read the stripes as soon as they see the pointer.
+    storeStoreFence();
+    s_sharedTable = sharedTable;
+}
+
 void AtomicStringTable::destroy(AtomicStringTable* table)
 {
     HashSet<StringImpl*>::iterator end = table->m_table.end();
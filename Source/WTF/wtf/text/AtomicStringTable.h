@@ -24,6 +24,7 @@
 #define WTF_AtomicStringTable_h
 
 #include <wtf/HashSet.h>
+#include <wtf/Threading.h>
 #include <wtf/WTFThreadData.h>
 
 namespace WTF {
@@ -37,10 +38,67 @@ public:
     static void create(WTFThreadData&);
     HashSet<StringImpl*>& table() { return m_table; }
 
+    // Set when this table was created before the shared table was enabled. Such a table may
+    // already hold short strings, which must keep being found here rather than get a twin.
+    bool predatesSharedTable() const { return m_predatesSharedTable; }
+
 private:
+    AtomicStringTable();
+
     static void destroy(AtomicStringTable*);
 
     HashSet<StringImpl*> m_table;
+    bool m_predatesSharedTable;
+};
+
+// Once enabled, short strings are atomized into this process-global table instead of the
+// per-thread one, so that atomic strings made on the parser thread or on a worker can be
+// used directly by the main thread. Threads that atomized strings before it was enabled
+// keep using those, and map shared strings with the same contents to them. Entries are
+// immortal and the table is split into stripes, each with its own lock, to keep
+// contention between threads low.
+class SharedAtomicStringTable {
+    WTF_MAKE_NONCOPYABLE(SharedAtomicStringTable); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static const unsigned maximumStringLength = 64;
+    static const unsigned maximumStringsPerStripe = 2048;
+    static const unsigned stripeCount = 32;
+
+    class Stripe {
+        WTF_MAKE_NONCOPYABLE(Stripe);
+    public:
+        Stripe() { }
+
+        Mutex& lock() { return m_lock; }
+        HashSet<StringImpl*>& table() { return m_table; }
+        bool isFull() const { return static_cast<unsigned>(m_table.size()) >= maximumStringsPerStripe; }
+
+    private:
+        Mutex m_lock;
+        HashSet<StringImpl*> m_table;
+    };
+
+    static void enable();
+    static bool isEnabled() { return s_sharedTable; }
+    static SharedAtomicStringTable& shared()
+    {
+        ASSERT(s_sharedTable);
+        return *s_sharedTable;
+    }
+
+    // The decision to share a string must only depend on its contents, otherwise two
+    // threads could atomize equal strings into different tables.
+    static bool canContain(unsigned length) { return length <= maximumStringLength; }
+
+    // The low bits of the hash pick the bucket inside a stripe, so use higher ones here.
+    Stripe& stripeForHash(unsigned hash) { return m_stripes[(hash >> 16) % stripeCount]; }
+
+private:
+    SharedAtomicStringTable() { }
+
+    Stripe m_stripes[stripeCount];
+
+    static SharedAtomicStringTable* s_sharedTable;
 };
 
 }
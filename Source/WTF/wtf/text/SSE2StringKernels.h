@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef SSE2StringKernels_h
+#define SSE2StringKernels_h
+
+#if CPU(X86_SSE2)
+
+#include <emmintrin.h>
+#include <wtf/NotFound.h>
+#include <wtf/unicode/Unicode.h>
+
+#if COMPILER(MSVC)
+#include <intrin.h>
+#endif
+
+// Kernels that look at 16 bytes of characters at a time. Each one handles
+// whole blocks and leaves any remainder to the scalar code that calls it,
+// so all loads stay inside the strings and may be unaligned.
+
+namespace WTF {
+
+ALWAYS_INLINE unsigned indexOfLowestSetBit(unsigned mask)
+{
+    ASSERT(mask);
+#if COMPILER(MSVC)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+ALWAYS_INLINE unsigned indexOfHighestSetBit(unsigned mask)
+{
+    ASSERT(mask);
+#if COMPILER(MSVC)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return index;
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
+
+template<typename CharacterType> struct SSE2CharacterBlock;
+
+template<> struct SSE2CharacterBlock<LChar> {
+    static const unsigned length = 16;
+    static __m128i load(const LChar* characters) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters)); }
+    static __m128i splat(LChar character) { return _mm_set1_epi8(static_cast<char>(character)); }
+    static __m128i compare(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+    // Each character that matches sets one bit of the result.
+    static unsigned matchMask(__m128i a, __m128i b) { return _mm_movemask_epi8(compare(a, b)); }
+};
+
+template<> struct SSE2CharacterBlock<UChar> {
+    static const unsigned length = 8;
+    static __m128i load(const UChar* characters) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters)); }
+    static __m128i splat(UChar character) { return _mm_set1_epi16(static_cast<short>(character)); }
+    static __m128i compare(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+    // Each character that matches sets two adjacent bits of the result.
+    static unsigned matchMask(__m128i a, __m128i b) { return _mm_movemask_epi8(compare(a, b)); }
+};
+
+const unsigned allBlockBitsSet = 0xFFFF;
+
+template<typename CharacterType>
+ALWAYS_INLINE size_t findCharacterSSE2(const CharacterType* characters, unsigned length, CharacterType matchCharacter, unsigned index)
+{
+    typedef SSE2CharacterBlock<CharacterType> Block;
+
+    if (index >= length)
+        return notFound;
+
+    __m128i pattern = Block::splat(matchCharacter);
+    while (length - index >= Block::length) {
+        if (unsigned mask = Block::matchMask(Block::load(characters + index), pattern))
+            return index + indexOfLowestSetBit(mask) / sizeof(CharacterType);
+        index += Block::length;
+    }
+
+    for (; index < length; ++index) {
+        if (characters[index] == matchCharacter)
+            return index;
+    }
+    return notFound;
+}
+
+template<typename CharacterType>
+ALWAYS_INLINE size_t reverseFindCharacterSSE2(const CharacterType* characters, unsigned length, CharacterType matchCharacter, unsigned index)
+{
+    typedef SSE2CharacterBlock<CharacterType> Block;
+
+    if (!length)
+        return notFound;
+    if (index >= length)
+        index = length - 1;
+
+    // Characters [0, end) are still to be searched.
+    unsigned end = index + 1;
+    __m128i pattern = Block::splat(matchCharacter);
+    while (end >= Block::length) {
+        unsigned start = end - Block::length;
+        if (unsigned mask = Block::matchMask(Block::load(characters + start), pattern))
+            return start + indexOfHighestSetBit(mask) / sizeof(CharacterType);
+        end = start;
+    }
+
+    while (end--) {
+        if (characters[end] == matchCharacter)
+            return end;
+    }
+    return notFound;
+}
+
+// Compares whole blocks and advances past them. Returns false on the first
+// mismatch; otherwise fewer than one block's worth of characters remain.
+template<typename CharacterType>
+ALWAYS_INLINE bool equalBlocksSSE2(const CharacterType*& a, const CharacterType*& b, unsigned& length)
+{
+    typedef SSE2CharacterBlock<CharacterType> Block;
+
+    for (; length >= Block::length; length -= Block::length) {
+        if (Block::matchMask(Block::load(a), Block::load(b)) != allBlockBitsSet)
+            return false;
+        a += Block::length;
+        b += Block::length;
+    }
+    return true;
+}
+
+ALWAYS_INLINE bool equalBlocksSSE2(const LChar*& a, const UChar*& b, unsigned& length)
+{
+    typedef SSE2CharacterBlock<LChar> Block;
+
+    __m128i zero = _mm_setzero_si128();
+    for (; length >= Block::length; length -= Block::length) {
+        __m128i aBlock = Block::load(a);
+        __m128i aLow = _mm_unpacklo_epi8(aBlock, zero);
+        __m128i aHigh = _mm_unpackhi_epi8(aBlock, zero);
+        __m128i bLow = SSE2CharacterBlock<UChar>::load(b);
+        __m128i bHigh = SSE2CharacterBlock<UChar>::load(b + SSE2CharacterBlock<UChar>::length);
+        __m128i matches = _mm_and_si128(_mm_cmpeq_epi16(aLow, bLow), _mm_cmpeq_epi16(aHigh, bHigh));
+        if (static_cast<unsigned>(_mm_movemask_epi8(matches)) != allBlockBitsSet)
+            return false;
+        a += Block::length;
+        b += Block::length;
+    }
+    return true;
+}
+
+// Maps 'A'-'Z' to 'a'-'z' and leaves every other ASCII character alone.
+ALWAYS_INLINE __m128i toASCIILowerSSE2(__m128i characters)
+{
+    __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi8(characters, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), characters));
+    return _mm_or_si128(characters, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+}
+
+ALWAYS_INLINE bool isASCIIBlockSSE2(__m128i characters)
+{
+    return !_mm_movemask_epi8(characters);
+}
+
+ALWAYS_INLINE bool equalIgnoringASCIICaseBlockSSE2(__m128i a, __m128i b)
+{
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(toASCIILowerSSE2(a), toASCIILowerSSE2(b)))) == allBlockBitsSet;
+}
+
+// Case folding can map non-ASCII characters to ASCII ones (U+212A KELVIN SIGN
+// folds to 'k', for example), so these stop at the first block that is not
+// all ASCII and leave the rest of the comparison to the caller's scalar loop.
+ALWAYS_INLINE bool equalIgnoringCaseASCIIBlocksSSE2(const LChar*& a, const LChar*& b, unsigned& length)
+{
+    typedef SSE2CharacterBlock<LChar> Block;
+
+    for (; length >= Block::length; length -= Block::length) {
+        __m128i aBlock = Block::load(a);
+        __m128i bBlock = Block::load(b);
+        if (Block::matchMask(aBlock, bBlock) != allBlockBitsSet) {
+            if (!isASCIIBlockSSE2(_mm_or_si128(aBlock, bBlock)))
+                return true;
+            if (!equalIgnoringASCIICaseBlockSSE2(aBlock, bBlock))
+                return false;
+        }
+        a += Block::length;
+        b += Block::length;
+    }
+    return true;
+}
+
+ALWAYS_INLINE bool equalIgnoringCaseASCIIBlocksSSE2(const UChar*& a, const LChar*& b, unsigned& length)
+{
+    typedef SSE2CharacterBlock<LChar> Block;
+
+    __m128i nonASCIIMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+    __m128i zero = _mm_setzero_si128();
+    for (; length >= Block::length; length -= Block::length) {
+        __m128i aLow = SSE2CharacterBlock<UChar>::load(a);
+        __m128i aHigh = SSE2CharacterBlock<UChar>::load(a + SSE2CharacterBlock<UChar>::length);
+        __m128i aNonASCIIBits = _mm_and_si128(_mm_or_si128(aLow, aHigh), nonASCIIMask);
+        if (static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(aNonASCIIBits, zero))) != allBlockBitsSet)
+            return true;
+
+        // Every character of a is ASCII, so packing cannot saturate.
+        __m128i aBlock = _mm_packus_epi16(aLow, aHigh);
+        __m128i bBlock = Block::load(b);
+        if (!isASCIIBlockSSE2(bBlock))
+            return true;
+        if (!equalIgnoringASCIICaseBlockSSE2(aBlock, bBlock))
+            return false;
+        a += Block::length;
+        b += Block::length;
+    }
+    return true;
+}
+
+} // namespace WTF
+
+#endif // CPU(X86_SSE2)
+
+#endif // SSE2StringKernels_h
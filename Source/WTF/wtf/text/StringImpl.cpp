@@ -870,6 +870,10 @@ float StringImpl::toFloat(bool* ok)
 
 bool equalIgnoringCase(const LChar* a, const LChar* b, unsigned length)
 {
+#if CPU(X86_SSE2)
+    if (!equalIgnoringCaseASCIIBlocksSSE2(a, b, length))
+        return false;
+#endif
     while (length--) {
         LChar bc = *b++;
         if (foldCase(*a++) != foldCase(bc))
@@ -880,6 +884,10 @@ bool equalIgnoringCase(const LChar* a, const LChar* b, unsigned length)
 
 bool equalIgnoringCase(const UChar* a, const LChar* b, unsigned length)
 {
+#if CPU(X86_SSE2)
+    if (!equalIgnoringCaseASCIIBlocksSSE2(a, b, length))
+        return false;
+#endif
     while (length--) {
         LChar bc = *b++;
         if (foldCase(*a++) != foldCase(bc))
@@ -1005,6 +1013,55 @@ ALWAYS_INLINE static size_t findInner(const SearchCharacterType* searchCharacter
     return index + i;        
 }
 
+#if CPU(X86_SSE2)
+// Compares the first and last characters of the pattern against a whole block
+// of candidate positions at once, and only calls equal() on the positions
+// where both match.
+template <typename CharacterType>
+ALWAYS_INLINE static size_t findInnerSSE2(const CharacterType* searchCharacters, const CharacterType* matchCharacters, unsigned index, unsigned searchLength, unsigned matchLength)
+{
+    typedef SSE2CharacterBlock<CharacterType> Block;
+
+    ASSERT(matchLength > 1);
+    ASSERT(matchLength <= searchLength);
+
+    __m128i first = Block::splat(matchCharacters[0]);
+    __m128i last = Block::splat(matchCharacters[matchLength - 1]);
+    // Candidate positions [0, positionCount) are still to be tested.
+    unsigned positionCount = searchLength - matchLength + 1;
+    unsigned i = 0;
+    for (; positionCount - i >= Block::length; i += Block::length) {
+        __m128i firstMatches = Block::compare(Block::load(searchCharacters + i), first);
+        __m128i lastMatches = Block::compare(Block::load(searchCharacters + i + matchLength - 1), last);
+        unsigned mask = _mm_movemask_epi8(_mm_and_si128(firstMatches, lastMatches));
+        while (mask) {
+            unsigned bit = indexOfLowestSetBit(mask);
+            unsigned position = i + bit / sizeof(CharacterType);
+            if (equal(searchCharacters + position + 1, matchCharacters + 1, matchLength - 2))
+                return index + position;
+            // Clear every bit that belongs to this character.
+            mask &= ~(((1u << sizeof(CharacterType)) - 1) << bit);
+        }
+    }
+
+    for (; i < positionCount; ++i) {
+        if (searchCharacters[i] == matchCharacters[0] && equal(searchCharacters + i + 1, matchCharacters + 1, matchLength - 1))
+            return index + i;
+    }
+    return notFound;
+}
+
+ALWAYS_INLINE static size_t findInner(const LChar* searchCharacters, const LChar* matchCharacters, unsigned index, unsigned searchLength, unsigned matchLength)
+{
+    return findInnerSSE2(searchCharacters, matchCharacters, index, searchLength, matchLength);
+}
+
+ALWAYS_INLINE static size_t findInner(const UChar* searchCharacters, const UChar* matchCharacters, unsigned index, unsigned searchLength, unsigned matchLength)
+{
+    return findInnerSSE2(searchCharacters, matchCharacters, index, searchLength, matchLength);
+}
+#endif
+
 size_t StringImpl::find(StringImpl* matchString)
 {
     // Check for null string to match against
@@ -29,6 +29,7 @@
 #include <wtf/StdLibExtras.h>
 #include <wtf/StringHasher.h>
 #include <wtf/Vector.h>
+#include <wtf/text/SSE2StringKernels.h>
 #include <wtf/unicode/Unicode.h>
 
 #if PLATFORM(QT)
@@ -550,6 +551,15 @@ public:
             m_hashAndFlags &= ~s_hashFlagIsAtomic;
     }
 
+    // Strings in the shared atomic string table are never destroyed, which is what makes
+    // it safe to ref and deref them from several threads.
+    bool isSharedAtomic() const { return isAtomic() && isStatic(); }
+    void setIsSharedAtomic()
+    {
+        ASSERT(isAtomic() && hasHash());
+        m_refCount |= s_refCountFlagIsStaticString;
+    }
+
 #ifdef STRING_STATS
     bool isSubString() const { return  bufferOwnership() == BufferSubstring; }
 #endif
@@ -883,10 +893,14 @@ inline bool equal(const LChar* a, StringImpl* b) { return equal(b, a); }
 inline bool equal(const char* a, StringImpl* b) { return equal(b, reinterpret_cast<const LChar*>(a)); }
 WTF_EXPORT_STRING_API bool equalNonNull(const StringImpl* a, const StringImpl* b);
 
-// Do comparisons 8 or 4 bytes-at-a-time on architectures where it's safe.
-#if CPU(X86_64)
+// Do comparisons 16 bytes-at-a-time with SSE2, and 8 or 4 bytes-at-a-time on
+// architectures where it's safe.
+#if CPU(X86_SSE2)
 ALWAYS_INLINE bool equal(const LChar* a, const LChar* b, unsigned length)
 {
+    if (!equalBlocksSSE2(a, b, length))
+        return false;
+
     unsigned dwordLength = length >> 3;
 
     if (dwordLength) {
@@ -926,6 +940,9 @@ ALWAYS_INLINE bool equal(const LChar* a, const LChar* b, unsigned length)
 
 ALWAYS_INLINE bool equal(const UChar* a, const UChar* b, unsigned length)
 {
+    if (!equalBlocksSSE2(a, b, length))
+        return false;
+
     unsigned dwordLength = length >> 2;
     
     if (dwordLength) {
@@ -1092,6 +1109,10 @@ ALWAYS_INLINE bool equal(const UChar* a, const UChar* b, unsigned length) { retu
 
 ALWAYS_INLINE bool equal(const LChar* a, const UChar* b, unsigned length)
 {
+#if CPU(X86_SSE2)
+    if (!equalBlocksSSE2(a, b, length))
+        return false;
+#endif
     for (unsigned i = 0; i < length; ++i) {
         if (a[i] != b[i])
             return false;
@@ -1130,6 +1151,18 @@ inline size_t find(const CharacterType* characters, unsigned length, CharacterTy
     return notFound;
 }
 
+#if CPU(X86_SSE2)
+template<> ALWAYS_INLINE size_t find<LChar>(const LChar* characters, unsigned length, LChar matchCharacter, unsigned index)
+{
+    return findCharacterSSE2(characters, length, matchCharacter, index);
+}
+
+template<> ALWAYS_INLINE size_t find<UChar>(const UChar* characters, unsigned length, UChar matchCharacter, unsigned index)
+{
+    return findCharacterSSE2(characters, length, matchCharacter, index);
+}
+#endif
+
 ALWAYS_INLINE size_t find(const UChar* characters, unsigned length, LChar matchCharacter, unsigned index = 0)
 {
     return find(characters, length, static_cast<UChar>(matchCharacter), index);
@@ -1223,6 +1256,18 @@ inline size_t reverseFind(const CharacterType* characters, unsigned length, Char
     return index;
 }
 
+#if CPU(X86_SSE2)
+template<> ALWAYS_INLINE size_t reverseFind<LChar>(const LChar* characters, unsigned length, LChar matchCharacter, unsigned index)
+{
+    return reverseFindCharacterSSE2(characters, length, matchCharacter, index);
+}
+
+template<> ALWAYS_INLINE size_t reverseFind<UChar>(const UChar* characters, unsigned length, UChar matchCharacter, unsigned index)
+{
+    return reverseFindCharacterSSE2(characters, length, matchCharacter, index);
+}
+#endif
+
 ALWAYS_INLINE size_t reverseFind(const UChar* characters, unsigned length, LChar matchCharacter, unsigned index = UINT_MAX)
 {
     return reverseFind(characters, length, static_cast<UChar>(matchCharacter), index);
@@ -697,7 +697,10 @@ bool String::isSafeToSendToAnotherThread() const
 {
     if (!impl())
         return true;
-    // AtomicStrings are not safe to send between threads as ~StringImpl()
+    // Strings in the shared atomic string table are immortal and atomic on every thread.
+    if (impl()->isSharedAtomic())
+        return true;
+    // Other AtomicStrings are not safe to send between threads as ~StringImpl()
     // will try to remove them from the wrong AtomicStringTable.
     if (impl()->isAtomic())
         return false;
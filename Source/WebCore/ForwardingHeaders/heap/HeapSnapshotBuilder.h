@@ -0,0 +1,4 @@
+#ifndef WebCore_FWD_HeapSnapshotBuilder_h
+#define WebCore_FWD_HeapSnapshotBuilder_h
+#include <JavaScriptCore/HeapSnapshotBuilder.h>
+#endif
@@ -46,6 +46,9 @@ public:
 
     const String& source() const { return m_cachedScript->script(); }
 
+    virtual JSC::SourceProviderCache* cache() const OVERRIDE { return m_cachedScript->sourceProviderCache(); }
+    virtual void notifyCacheSizeChanged(int delta) OVERRIDE { m_cachedScript->sourceProviderCacheSizeChanged(delta); }
+
 private:
     CachedScriptSourceProvider(CachedScript* cachedScript)
         : SourceProvider(cachedScript->response().url(), TextPosition::minimumPosition())
@@ -49,6 +49,7 @@
 #include "runtime_root.h"
 #include <debugger/Debugger.h>
 #include <heap/StrongInlines.h>
+#include <runtime/Completion.h>
 #include <runtime/InitializeThreading.h>
 #include <runtime/JSLock.h>
 #include <wtf/text/TextPosition.h>
@@ -153,6 +154,20 @@ ScriptValue ScriptController::evaluateInWorld(const ScriptSourceCode& sourceCode
     return ScriptValue(exec->vm(), returnValue);
 }
 
+// Below this length, handing the script to another thread costs more than parsing it.
+static const unsigned minimumPrecompiledScriptLength = 32 * 1024;
+
+void ScriptController::precompileScript(const ScriptSourceCode& sourceCode)
+{
+    if (sourceCode.jsSourceCode().length() < static_cast<int>(minimumPrecompiledScriptLength))
+        return;
+
+    if (!canExecuteScripts(NotAboutToExecuteScript))
+        return;
+
+    JSC::precompileProgram(*JSDOMWindowBase::commonVM(), sourceCode.jsSourceCode());
+}
+
 ScriptValue ScriptController::evaluate(const ScriptSourceCode& sourceCode) 
 {
     return evaluateInWorld(sourceCode, mainThreadNormalWorld());
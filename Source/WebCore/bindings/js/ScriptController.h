@@ -104,6 +104,9 @@ public:
     ScriptValue evaluate(const ScriptSourceCode&);
     ScriptValue evaluateInWorld(const ScriptSourceCode&, DOMWrapperWorld*);
 
+    // Starts compiling a large script on a background thread, ahead of its evaluation.
+    void precompileScript(const ScriptSourceCode&);
+
     WTF::TextPosition eventHandlerPosition() const;
 
     void enableEval();
@@ -1729,8 +1729,10 @@ static void neuterView(JSCell* jsView)
     
     switch (jsView->classInfo()->typedArrayStorageType) {
     case TypedArrayNone:
-        // This could be a DataView, for example. Assume that there are views that the
-        // DFG doesn't care about.
+        // DataView has no typed array storage type, but the DFG reads its byte length.
+        // Assume that any other view is one the DFG doesn't care about.
+        if (jsView->inherits(&JSDataView::s_info))
+            jsCast<JSDataView*>(jsView)->m_storageLength = 0;
         return;
     case TypedArrayInt8:
         jsCast<JSInt8Array*>(jsView)->m_storageLength = 0;
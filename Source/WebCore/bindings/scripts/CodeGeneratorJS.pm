@@ -363,7 +363,7 @@ sub GenerateGetOwnPropertySlotBody
         if ($requiresManualLookup) {
             push(@getOwnPropertySlotImpl, "    const ${namespaceMaybe}HashEntry* entry = getStaticValueSlotEntryWithoutCaching<$className>(exec, propertyName);\n");
             push(@getOwnPropertySlotImpl, "    if (entry) {\n");
-            push(@getOwnPropertySlotImpl, "        slot.setCustom(thisObject, entry->propertyGetter());\n");
+            push(@getOwnPropertySlotImpl, "        ${namespaceMaybe}setUpUncacheableStaticValueSlot(entry, thisObject, slot);\n");
             push(@getOwnPropertySlotImpl, "        return true;\n");
             push(@getOwnPropertySlotImpl, "    }\n");
         }
@@ -459,9 +459,7 @@ sub GenerateGetOwnPropertyDescriptorBody
         if ($requiresManualLookup) {
             push(@getOwnPropertyDescriptorImpl, "    const ${namespaceMaybe}HashEntry* entry = ${className}Table.entry(exec, propertyName);\n");
             push(@getOwnPropertyDescriptorImpl, "    if (entry) {\n");
-            push(@getOwnPropertyDescriptorImpl, "        PropertySlot slot;\n");
-            push(@getOwnPropertyDescriptorImpl, "        slot.setCustom(thisObject, entry->propertyGetter());\n");
-            push(@getOwnPropertyDescriptorImpl, "        descriptor.setDescriptor(slot.getValue(exec, propertyName), entry->attributes());\n");
+            push(@getOwnPropertyDescriptorImpl, "        ${namespaceMaybe}setUpStaticValueDescriptor(exec, entry, thisObject, propertyName, descriptor);\n");
             push(@getOwnPropertyDescriptorImpl, "        return true;\n");
             push(@getOwnPropertyDescriptorImpl, "    }\n");
         }
@@ -587,6 +585,27 @@ sub ShouldGenerateToJSImplementation
     return 0;
 }
 
+sub IsDirectGetter
+{
+    my ($interface, $attribute) = @_;
+    my $attrExt = $attribute->signature->extendedAttributes;
+    return 0 unless $attrExt->{"DirectGetter"};
+
+    # The JIT calls direct getters without a property name and without checking for
+    # exceptions, so only plain getters that go straight to the implementation qualify.
+    die "DirectGetter cannot be used on static attributes." if $attribute->isStatic;
+    die "DirectGetter cannot be used with a custom getter." if HasCustomGetter($attrExt);
+    die "DirectGetter cannot be used with GetterRaisesException." if $attrExt->{"GetterRaisesException"};
+    die "DirectGetter cannot be used with CallWith." if $attrExt->{"CallWith"};
+    die "DirectGetter cannot be used with CachedAttribute." if $attrExt->{"CachedAttribute"};
+    die "DirectGetter cannot be used with CheckSecurityForNode." if $attrExt->{"CheckSecurityForNode"};
+    die "DirectGetter cannot be used on constructor attributes." if $attribute->signature->type =~ /Constructor$/;
+    die "DirectGetter cannot be used on EventListener attributes." if $attribute->signature->type eq "EventListener";
+    die "DirectGetter cannot be used on SVG property wrappers." if $codeGenerator->IsSVGTypeNeedingTearOff($interface->name);
+    die "DirectGetter cannot be used on interfaces with security checks." if $interface->extendedAttributes->{"CheckSecurity"};
+    return 1;
+}
+
 sub GetAttributeGetterName
 {
     my ($interfaceName, $className, $attribute) = @_;
@@ -976,6 +995,10 @@ sub GenerateHeader
         push(@headerContent, ";\n");
         push(@headerContent, "    intptr_t m_storageLength;\n");
         push(@headerContent, "    void* m_storage;\n");
+    } elsif ($implType eq "DataView") {
+        # Read directly by the DFG's DataView intrinsics. The length is in bytes.
+        push(@headerContent, "    intptr_t m_storageLength;\n");
+        push(@headerContent, "    void* m_storage;\n");
     }
 
     push(@headerContent, "protected:\n");
@@ -1153,7 +1176,11 @@ sub GenerateHeader
             my $conditionalString = $codeGenerator->GenerateConditionalString($attribute->signature);
             push(@headerContent, "#if ${conditionalString}\n") if $conditionalString;
             my $getter = GetAttributeGetterName($interfaceName, $className, $attribute);
-            push(@headerContent, "JSC::JSValue ${getter}(JSC::ExecState*, JSC::JSValue, JSC::PropertyName);\n");
+            if (IsDirectGetter($interface, $attribute)) {
+                push(@headerContent, "JSC::EncodedJSValue ${getter}(JSC::ExecState*, JSC::JSObject*);\n");
+            } else {
+                push(@headerContent, "JSC::JSValue ${getter}(JSC::ExecState*, JSC::JSValue, JSC::PropertyName);\n");
+            }
             if (!IsReadonly($attribute)) {
                 my $setter = GetAttributeSetterName($interfaceName, $className, $attribute);
                 push(@headerContent, "void ${setter}(JSC::ExecState*, JSC::JSObject*, JSC::JSValue);\n");
@@ -1226,6 +1253,7 @@ sub GenerateAttributesHashTable($$)
         push(@specials, "DontDelete") unless ($attribute->signature->extendedAttributes->{"Deletable"} || $is_global_constructor);
         push(@specials, "DontEnum") if ($attribute->signature->extendedAttributes->{"NotEnumerable"} || $is_global_constructor);
         push(@specials, "ReadOnly") if IsReadonly($attribute);
+        push(@specials, "DirectGetter") if IsDirectGetter($interface, $attribute);
         my $special = (@specials > 0) ? join(" | ", @specials) : "0";
         push(@hashSpecials, $special);
 
@@ -1705,6 +1733,7 @@ sub GenerateImplementation
     my @hashValue2 = ();
     my @hashSpecials = ();
     my %conditionals = ();
+    my %intrinsics = ();
 
     # FIXME: we should not need a function for every constant.
     foreach my $constant (@{$interface->constants}) {
@@ -1744,12 +1773,19 @@ sub GenerateImplementation
         if ($conditional) {
             $conditionals{$name} = $conditional;
         }
+
+        my $intrinsic = $function->signature->extendedAttributes->{"Intrinsic"};
+        if ($intrinsic) {
+            # The DFG replaces calls with the intrinsic, so it has to match every way the function can be called.
+            die "[Intrinsic] is not supported on overloaded function ${interfaceName}.${name}.\n" if @{$function->{overloads}} > 1;
+            $intrinsics{$name} = $intrinsic;
+        }
     }
 
     $object->GenerateHashTable($hashName, $hashSize,
                                \@hashKeys, \@hashSpecials,
                                \@hashValue1, \@hashValue2,
-                               \%conditionals);
+                               \%conditionals, \%intrinsics);
 
     if ($interface->extendedAttributes->{"JSNoStaticTables"}) {
         push(@implContent, "static const HashTable* get${className}PrototypeTable(ExecState* exec)\n");
@@ -1871,6 +1907,10 @@ sub GenerateImplementation
             push(@implContent, "    vm.registerTypedArrayDescriptor(impl(), descriptor);\n");
             push(@implContent, "    m_storage = impl()->data();\n");
             push(@implContent, "    m_storageLength = impl()->length();\n");
+        } elsif ($implType eq "DataView") {
+            push(@implContent, "    vm.registerDataViewDescriptor(TypedArrayDescriptor(&${className}::s_info, OBJECT_OFFSETOF(${className}, m_storage), OBJECT_OFFSETOF(${className}, m_storageLength)));\n");
+            push(@implContent, "    m_storage = impl()->baseAddress();\n");
+            push(@implContent, "    m_storageLength = impl()->byteLength();\n");
         }
         push(@implContent, "    ASSERT(inherits(&s_info));\n");
         push(@implContent, "}\n\n");
@@ -1999,10 +2039,17 @@ sub GenerateImplementation
                 my $attributeConditionalString = $codeGenerator->GenerateConditionalString($attribute->signature);
                 push(@implContent, "#if ${attributeConditionalString}\n") if $attributeConditionalString;
 
-                push(@implContent, "JSValue ${getFunctionName}(ExecState* exec, JSValue slotBase, PropertyName)\n");
+                my $isDirectGetter = IsDirectGetter($interface, $attribute);
+                if ($isDirectGetter) {
+                    push(@implContent, "EncodedJSValue ${getFunctionName}(ExecState* exec, JSObject* slotBase)\n");
+                } else {
+                    push(@implContent, "JSValue ${getFunctionName}(ExecState* exec, JSValue slotBase, PropertyName)\n");
+                }
                 push(@implContent, "{\n");
 
-                if (!$attribute->isStatic || $attribute->signature->type =~ /Constructor$/) {
+                if ($isDirectGetter) {
+                    push(@implContent, "    ${className}* castedThis = jsCast<$className*>(slotBase);\n");
+                } elsif (!$attribute->isStatic || $attribute->signature->type =~ /Constructor$/) {
                     push(@implContent, "    ${className}* castedThis = jsCast<$className*>(asObject(slotBase));\n");
                 } else {
                     push(@implContent, "    UNUSED_PARAM(slotBase);\n");
@@ -2121,12 +2168,12 @@ sub GenerateImplementation
 
                         if ($isNullable) {
                             push(@implContent, "    if (isNull)\n");
-                            push(@implContent, "        return jsNull();\n");
+                            push(@implContent, $isDirectGetter ? "        return JSValue::encode(jsNull());\n" : "        return jsNull();\n");
                         }
                     }
 
                     push(@implContent, "    castedThis->m_" . $attribute->signature->name . ".set(exec->vm(), castedThis, result);\n") if ($attribute->signature->extendedAttributes->{"CachedAttribute"});
-                    push(@implContent, "    return result;\n");
+                    push(@implContent, $isDirectGetter ? "    return JSValue::encode(result);\n" : "    return result;\n");
 
                 } else {
                     my @arguments = ("ec");
@@ -3684,6 +3731,7 @@ sub GenerateHashTable
     my $value1 = shift;
     my $value2 = shift;
     my $conditionals = shift;
+    my $intrinsics = shift;
 
     # Generate size data for compact' size hash table
 
@@ -3757,10 +3805,13 @@ sub GenerateHashTable
         
         if ("@$specials[$i]" =~ m/Function/) {
             $targetType = "static_cast<NativeFunction>";
+        } elsif ("@$specials[$i]" =~ m/DirectGetter/) {
+            $targetType = "static_cast<PropertySlot::DirectGetValueFunc>";
         } else {
             $targetType = "static_cast<PropertySlot::GetValueFunc>";
         }
-        push(@implContent, "    { \"$key\", @$specials[$i], (intptr_t)" . $targetType . "(@$value1[$i]), (intptr_t)@$value2[$i], NoIntrinsic },\n");
+        my $intrinsic = ($intrinsics && $intrinsics->{$key}) ? $intrinsics->{$key} : "NoIntrinsic";
+        push(@implContent, "    { \"$key\", @$specials[$i], (intptr_t)" . $targetType . "(@$value1[$i]), (intptr_t)@$value2[$i], $intrinsic },\n");
         push(@implContent, "#endif\n") if $conditional;
         ++$i;
     }
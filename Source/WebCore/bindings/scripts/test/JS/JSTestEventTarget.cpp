@@ -147,7 +147,7 @@ bool JSTestEventTarget::getOwnPropertySlot(JSCell* cell, ExecState* exec, Proper
     ASSERT_GC_OBJECT_INHERITS(thisObject, &s_info);
     const HashEntry* entry = getStaticValueSlotEntryWithoutCaching<JSTestEventTarget>(exec, propertyName);
     if (entry) {
-        slot.setCustom(thisObject, entry->propertyGetter());
+        setUpUncacheableStaticValueSlot(entry, thisObject, slot);
         return true;
     }
     unsigned index = propertyName.asIndex();
@@ -168,9 +168,7 @@ bool JSTestEventTarget::getOwnPropertyDescriptor(JSObject* object, ExecState* ex
     ASSERT_GC_OBJECT_INHERITS(thisObject, &s_info);
     const HashEntry* entry = JSTestEventTargetTable.entry(exec, propertyName);
     if (entry) {
-        PropertySlot slot;
-        slot.setCustom(thisObject, entry->propertyGetter());
-        descriptor.setDescriptor(slot.getValue(exec, propertyName), entry->attributes());
+        setUpStaticValueDescriptor(exec, entry, thisObject, propertyName, descriptor);
         return true;
     }
     unsigned index = propertyName.asIndex();
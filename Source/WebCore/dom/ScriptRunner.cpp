@@ -29,8 +29,11 @@
 #include "CachedScript.h"
 #include "Document.h"
 #include "Element.h"
+#include "Frame.h"
 #include "PendingScript.h"
+#include "ScriptController.h"
 #include "ScriptElement.h"
+#include "ScriptSourceCode.h"
 
 namespace WebCore {
 
@@ -86,6 +89,12 @@ void ScriptRunner::resume()
 
 void ScriptRunner::notifyScriptReady(ScriptElement* scriptElement, ExecutionType executionType)
 {
+    // The script runs from a timer, so there is time to compile it on another thread.
+    if (Frame* frame = m_document->frame()) {
+        if (CachedScript* cachedScript = scriptElement->cachedScript().get())
+            frame->script()->precompileScript(ScriptSourceCode(cachedScript));
+    }
+
     switch (executionType) {
     case ASYNC_EXECUTION:
         ASSERT(m_pendingAsyncScripts.contains(scriptElement));
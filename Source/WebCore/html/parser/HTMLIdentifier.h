@@ -28,6 +28,7 @@
 
 #if ENABLE(THREADED_HTML_PARSER)
 
+#include <wtf/text/AtomicString.h>
 #include <wtf/text/WTFString.h>
 
 namespace WebCore {
@@ -50,9 +51,12 @@ public:
     {
         if (m_index != invalidIndex)
             return;
-        if (width == Likely8Bit)
-            m_string = StringImpl::create8BitIfPossible(vector);
-        else if (width == Force8Bit)
+        if (width == Likely8Bit) {
+            // Names atomized into the shared table can be used as-is by the main thread.
+            m_string = AtomicString::addToSharedTable(vector.data(), vector.size());
+            if (m_string.isNull())
+                m_string = StringImpl::create8BitIfPossible(vector);
+        } else if (width == Force8Bit)
             m_string = String::make8BitFrom16BitSource(vector);
         else
             m_string = String(vector);
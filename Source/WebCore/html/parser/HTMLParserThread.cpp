@@ -34,6 +34,8 @@
 
 #include "HTMLParserThread.h"
 
+#include <wtf/text/AtomicString.h>
+
 namespace WebCore {
 
 HTMLParserThread::HTMLParserThread()
@@ -65,6 +67,9 @@ HTMLParserThread* HTMLParserThread::shared()
 {
     static HTMLParserThread* thread;
     if (!thread) {
+        // Lets the parser thread hand atomic tag and attribute names to the main thread.
+        // This is only reached once a document is parsed with the threaded parser setting on.
+        AtomicString::enableSharedTable();
         thread = HTMLParserThread::create().leakPtr();
         thread->start();
     }
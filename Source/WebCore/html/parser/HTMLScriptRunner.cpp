@@ -40,6 +40,7 @@
 #include "MutationObserver.h"
 #include "NestingLevelIncrementer.h"
 #include "NotImplemented.h"
+#include "ScriptController.h"
 #include "ScriptElement.h"
 #include "ScriptSourceCode.h"
 
@@ -207,6 +208,13 @@ void HTMLScriptRunner::executeScriptsWaitingForLoad(CachedResource* cachedScript
     ASSERT(hasParserBlockingScript());
     ASSERT_UNUSED(cachedScript, m_parserBlockingScript.cachedScript() == cachedScript);
     ASSERT(m_parserBlockingScript.cachedScript()->isLoaded());
+
+    // If the script still has to wait for stylesheets, compile it in the meantime.
+    if (!m_document->haveStylesheetsLoaded()) {
+        if (Frame* frame = m_document->frame())
+            frame->script()->precompileScript(ScriptSourceCode(m_parserBlockingScript.cachedScript()));
+    }
+
     executeParsingBlockingScripts();
 }
 
@@ -44,12 +44,15 @@
 #include "InspectorState.h"
 #include "InspectorValues.h"
 #include "InstrumentingAgents.h"
+#include "JSDOMWindowBase.h"
 #include "MemoryCache.h"
 #include "Node.h"
 #include "NodeTraversal.h"
 #include "ScriptGCEvent.h"
 #include "ScriptProfiler.h"
 #include "StyledElement.h"
+#include <heap/HeapSnapshotBuilder.h>
+#include <runtime/JSLock.h>
 #include <wtf/ArrayBufferView.h>
 #include <wtf/HashSet.h>
 #include <wtf/NonCopyingSort.h>
@@ -77,6 +80,16 @@ void InspectorMemoryAgent::getDOMCounters(ErrorString*, int* documents, int* nod
     *jsEventListeners = ThreadLocalInspectorCounters::current().counterValue(ThreadLocalInspectorCounters::JSEventListenerCounter);
 }
 
+void InspectorMemoryAgent::takeHeapSnapshot(ErrorString*, String* snapshot)
+{
+    JSC::VM* vm = JSDOMWindowBase::commonVM();
+    JSC::JSLockHolder lock(vm);
+
+    JSC::HeapSnapshotBuilder builder(vm->heap);
+    builder.buildSnapshot();
+    *snapshot = builder.json();
+}
+
 InspectorMemoryAgent::InspectorMemoryAgent(InstrumentingAgents* instrumentingAgents, InspectorCompositeState* state)
     : InspectorBaseAgent<InspectorMemoryAgent>("Memory", instrumentingAgents, state)
     , m_frontend(0)
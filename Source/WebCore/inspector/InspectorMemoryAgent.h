@@ -55,6 +55,7 @@ public:
     virtual ~InspectorMemoryAgent();
 
     virtual void getDOMCounters(ErrorString*, int* documents, int* nodes, int* jsEventListeners);
+    virtual void takeHeapSnapshot(ErrorString*, String* snapshot);
 
     virtual void setFrontend(InspectorFrontend*);
     virtual void clearFrontend();
@@ -37,6 +37,10 @@
 #include "TextResourceDecoder.h"
 #include <wtf/Vector.h>
 
+#if USE(JSC)
+#include <parser/SourceProviderCache.h>
+#endif
+
 namespace WebCore {
 
 CachedScript::CachedScript(const ResourceRequest& resourceRequest, const String& charset)
@@ -75,7 +79,11 @@ const String& CachedScript::script()
     if (!m_script && m_data) {
         m_script = m_decoder->decode(m_data->data(), encodedSize());
         m_script.append(m_decoder->flush());
-        setDecodedSize(m_script.sizeInBytes());
+        unsigned extraSize = 0;
+#if USE(JSC)
+        extraSize = m_sourceProviderCache ? m_sourceProviderCache->byteSize() : 0;
+#endif
+        setDecodedSize(m_script.sizeInBytes() + extraSize);
     }
     m_decodedDataDeletionTimer.restart();
     
@@ -92,11 +100,33 @@ void CachedScript::finishLoading(ResourceBuffer* data)
 void CachedScript::destroyDecodedData()
 {
     m_script = String();
-    setDecodedSize(0);
+    unsigned extraSize = 0;
+#if USE(JSC)
+    // Decoding the same data again gives the same source, so the skip information is
+    // still good. Only throw it away when nobody is using this script.
+    if (m_sourceProviderCache && !hasClients())
+        m_sourceProviderCache->clear();
+    extraSize = m_sourceProviderCache ? m_sourceProviderCache->byteSize() : 0;
+#endif
+    setDecodedSize(extraSize);
     if (!MemoryCache::shouldMakeResourcePurgeableOnEviction() && isSafeToMakePurgeable())
         makePurgeable(true);
 }
 
+#if USE(JSC)
+JSC::SourceProviderCache* CachedScript::sourceProviderCache() const
+{
+    if (!m_sourceProviderCache)
+        m_sourceProviderCache = adoptRef(new JSC::SourceProviderCache);
+    return m_sourceProviderCache.get();
+}
+
+void CachedScript::sourceProviderCacheSizeChanged(int delta)
+{
+    setDecodedSize(decodedSize() + delta);
+}
+#endif
+
 #if ENABLE(NOSNIFF)
 bool CachedScript::mimeTypeAllowedByNosniff() const
 {
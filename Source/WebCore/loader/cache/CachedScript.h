@@ -28,6 +28,12 @@
 
 #include "CachedResource.h"
 
+#if USE(JSC)
+namespace JSC {
+    class SourceProviderCache;
+}
+#endif
+
 namespace WebCore {
 
     class CachedResourceLoader;
@@ -46,6 +52,13 @@ namespace WebCore {
         bool mimeTypeAllowedByNosniff() const;
 #endif
 
+#if USE(JSC)
+        // Function skip information gathered while parsing this script. It is shared by
+        // every evaluation of the script and dropped along with the decoded source.
+        JSC::SourceProviderCache* sourceProviderCache() const;
+        void sourceProviderCacheSizeChanged(int delta);
+#endif
+
     private:
         virtual PurgePriority purgePriority() const OVERRIDE { return PurgeLast; }
         virtual bool mayTryReplaceEncodedData() const OVERRIDE { return true; }
@@ -60,6 +73,9 @@ namespace WebCore {
 
         String m_script;
         RefPtr<TextResourceDecoder> m_decoder;
+#if USE(JSC)
+        mutable RefPtr<JSC::SourceProviderCache> m_sourceProviderCache;
+#endif
     };
 }
 
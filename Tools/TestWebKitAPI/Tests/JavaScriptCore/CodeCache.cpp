@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <parser/SourceCode.h>
+#include <runtime/CodeCache.h>
+#include <runtime/Completion.h>
+#include <runtime/JSLock.h>
+#include <runtime/VM.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+using namespace JSC;
+
+namespace TestWebKitAPI {
+
+static SourceCodeKey programKey(const SourceCode& source)
+{
+    return SourceCodeKey(source, String(), SourceCodeKey::ProgramType, JSParseNormal);
+}
+
+// CodeCache keeps 16 precompiled programs. Queuing one more evicts a single program,
+// never the one just queued, and queuing a program again evicts nothing.
+TEST(JSC, PrecompiledProgramEviction)
+{
+    RefPtr<VM> vm = VM::create();
+    JSLockHolder lock(vm.get());
+
+    Vector<SourceCode> sources;
+    for (unsigned i = 0; i < 17; ++i) {
+        sources.append(makeSource(String::format("var precompiled%u = %u;", i, i)));
+        precompileProgram(*vm, sources.last());
+    }
+    precompileProgram(*vm, sources.last());
+
+    EXPECT_TRUE(vm->codeCache()->takePrecompiledProgram(programKey(sources.last())));
+
+    unsigned remaining = 0;
+    for (unsigned i = 0; i < 16; ++i) {
+        if (vm->codeCache()->takePrecompiledProgram(programKey(sources[i])))
+            ++remaining;
+    }
+    EXPECT_EQ(15u, remaining);
+
+    // Taking a program removes it.
+    EXPECT_FALSE(vm->codeCache()->takePrecompiledProgram(programKey(sources.last())));
+}
+
+} // namespace TestWebKitAPI
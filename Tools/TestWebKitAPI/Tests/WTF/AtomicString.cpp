@@ -25,6 +25,7 @@
 
 #include "config.h"
 
+#include <wtf/Threading.h>
 #include <wtf/text/AtomicString.h>
 
 namespace TestWebKitAPI {
@@ -56,4 +57,80 @@ TEST(WTF, AtomicStringCreationFromLiteralUniqueness)
     ASSERT_EQ(string1.impl(), string3.impl());
 }
 
+static void atomizeOnSecondaryThread(void* context)
+{
+    AtomicString* result = static_cast<AtomicString*>(context);
+    String name("data-shared-name");
+    *result = AtomicString(name);
+}
+
+static void atomizeEarlyNameOnSecondaryThread(void* context)
+{
+    AtomicString* result = static_cast<AtomicString*>(context);
+    String name("data-atomized-before-sharing");
+    *result = AtomicString(name);
+}
+
+// Enabling the shared table cannot be undone, so this runs in a child process and reports
+// whether every check passed through its exit status.
+static bool sharedTableBehavesCorrectly()
+{
+    AtomicString atomizedBeforeSharing("data-atomized-before-sharing");
+
+    AtomicString::enableSharedTable();
+
+    // Strings atomized before the table was enabled stay in this thread's table, and are
+    // still destroyed once unused.
+    if (atomizedBeforeSharing.impl()->isSharedAtomic() || atomizedBeforeSharing.string().isSafeToSendToAnotherThread())
+        return false;
+    if (AtomicString("data-atomized-before-sharing").impl() != atomizedBeforeSharing.impl())
+        return false;
+
+    // Other threads share a different string with the same characters, which this thread
+    // maps back to its own.
+    AtomicString earlyNameFromSecondaryThread;
+    ThreadIdentifier thread = createThread(atomizeEarlyNameOnSecondaryThread, &earlyNameFromSecondaryThread, "AtomicStringSharedTable");
+    waitForThreadCompletion(thread);
+    if (!earlyNameFromSecondaryThread.impl()->isSharedAtomic() || earlyNameFromSecondaryThread.impl() == atomizedBeforeSharing.impl())
+        return false;
+    if (AtomicString(earlyNameFromSecondaryThread.impl()).impl() != atomizedBeforeSharing.impl())
+        return false;
+    if (AtomicString(earlyNameFromSecondaryThread.string()).impl() != atomizedBeforeSharing.impl())
+        return false;
+
+    AtomicString fromSecondaryThread;
+    thread = createThread(atomizeOnSecondaryThread, &fromSecondaryThread, "AtomicStringSharedTable");
+    waitForThreadCompletion(thread);
+
+    if (!fromSecondaryThread.impl()->isSharedAtomic() || !fromSecondaryThread.string().isSafeToSendToAnotherThread())
+        return false;
+
+    AtomicString fromMainThread("data-shared-name");
+    if (fromSecondaryThread.impl() != fromMainThread.impl())
+        return false;
+
+    String base("prefix-data-shared-name-suffix");
+    AtomicString fromSubstring(base.impl(), 7, 16);
+    if (fromMainThread.impl() != fromSubstring.impl())
+        return false;
+
+    Vector<UChar> characters;
+    characters.append(fromMainThread.characters(), fromMainThread.length());
+    if (fromMainThread.impl() != AtomicString::addToSharedTable(characters.data(), characters.size()).get())
+        return false;
+
+    String longName;
+    for (unsigned i = 0; i < 10; ++i)
+        longName.append("long-name-");
+    AtomicString longAtomicString(longName);
+    if (longAtomicString.impl()->isSharedAtomic() || longAtomicString.string().isSafeToSendToAnotherThread())
+        return false;
+    return !AtomicString::addToSharedTable(longName.characters(), longName.length());
+}
+
+TEST(WTF, AtomicStringSharedTable)
+{
+    ASSERT_EXIT(exit(sharedTableBehavesCorrectly() ? 0 : 1), ::testing::ExitedWithCode(0), "");
+}
+
 } // namespace TestWebKitAPI
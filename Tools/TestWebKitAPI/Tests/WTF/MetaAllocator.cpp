@@ -935,6 +935,38 @@ TEST_F(MetaAllocatorTest, ShrinkTwoPagesToTwoPagesLess32)
     testShrink(pageSize() * 2, pageSize() * 2 - 32);
 }
 
+TEST_F(MetaAllocatorTest, FreeSpaceStatistics)
+{
+    size_t heapSize = defaultPagesInHeap * pageSize();
+
+    MetaAllocator::FreeSpaceStatistics statistics = allocator->currentFreeSpaceStatistics();
+    EXPECT_EQ(heapSize, statistics.bytesFree);
+    EXPECT_EQ(heapSize, statistics.largestFreeChunk);
+    EXPECT_EQ(1u, statistics.numberOfFreeChunks);
+
+    MetaAllocatorHandle* first = allocate(32);
+    MetaAllocatorHandle* second = allocate(32);
+    MetaAllocatorHandle* third = allocate(32);
+    free(second);
+
+    // The hole left by the second allocation can't coalesce with the rest.
+    statistics = allocator->currentFreeSpaceStatistics();
+    EXPECT_EQ(heapSize - 64, statistics.bytesFree);
+    EXPECT_EQ(heapSize - 96, statistics.largestFreeChunk);
+    EXPECT_EQ(2u, statistics.numberOfFreeChunks);
+
+    free(first);
+    statistics = allocator->currentFreeSpaceStatistics();
+    EXPECT_EQ(heapSize - 32, statistics.bytesFree);
+    EXPECT_EQ(2u, statistics.numberOfFreeChunks);
+
+    free(third);
+    statistics = allocator->currentFreeSpaceStatistics();
+    EXPECT_EQ(heapSize, statistics.bytesFree);
+    EXPECT_EQ(heapSize, statistics.largestFreeChunk);
+    EXPECT_EQ(1u, statistics.numberOfFreeChunks);
+}
+
 TEST_F(MetaAllocatorTest, DemandAllocCoalescePageThenDoubleHeap)
 {
     testDemandAllocCoalesce(pageSize(), defaultPagesInHeap, defaultPagesInHeap * pageSize());
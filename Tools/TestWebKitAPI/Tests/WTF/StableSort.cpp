@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2013 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+
+#include <wtf/StableSort.h>
+#include <wtf/Vector.h>
+
+namespace TestWebKitAPI {
+
+struct KeyAndOrder {
+    int key;
+    unsigned order;
+};
+
+struct CompareKeys {
+    CompareKeys() : comparisons(0) { }
+
+    bool operator()(const KeyAndOrder& a, const KeyAndOrder& b)
+    {
+        ++comparisons;
+        return a.key < b.key;
+    }
+
+    unsigned comparisons;
+};
+
+TEST(WTF, StableSortKeepsEqualElementsInOrder)
+{
+    const unsigned size = 1000;
+    Vector<KeyAndOrder> values(size);
+    for (unsigned i = 0; i < size; ++i) {
+        values[i].key = (i * 7919) % 13;
+        values[i].order = i;
+    }
+    Vector<KeyAndOrder> buffer((size + 1) / 2);
+
+    CompareKeys compareKeys;
+    stableSort(values.data(), size, buffer.data(), compareKeys);
+
+    for (unsigned i = 1; i < size; ++i) {
+        EXPECT_LE(values[i - 1].key, values[i].key);
+        if (values[i - 1].key == values[i].key)
+            EXPECT_LT(values[i - 1].order, values[i].order);
+    }
+}
+
+TEST(WTF, StableSortSortedInput)
+{
+    const unsigned size = 1000;
+    Vector<KeyAndOrder> values(size);
+    for (unsigned i = 0; i < size; ++i) {
+        values[i].key = i;
+        values[i].order = i;
+    }
+    Vector<KeyAndOrder> buffer((size + 1) / 2);
+
+    CompareKeys compareKeys;
+    stableSort(values.data(), size, buffer.data(), compareKeys);
+
+    for (unsigned i = 0; i < size; ++i)
+        EXPECT_EQ(i, values[i].order);
+    // Sorted runs are never merged, so this stays linear.
+    EXPECT_LT(compareKeys.comparisons, 2 * size);
+}
+
+struct CompareInts {
+    bool operator()(int a, int b) { return a < b; }
+};
+
+TEST(WTF, StableSortOddSizes)
+{
+    for (unsigned size = 0; size < 70; ++size) {
+        Vector<int> values(size);
+        for (unsigned i = 0; i < size; ++i)
+            values[i] = size - i;
+        Vector<int> buffer((size + 1) / 2);
+
+        CompareInts compareInts;
+        stableSort(values.data(), size, buffer.data(), compareInts);
+
+        for (unsigned i = 0; i < size; ++i)
+            EXPECT_EQ(static_cast<int>(i + 1), values[i]);
+    }
+}
+
+} // namespace TestWebKitAPI
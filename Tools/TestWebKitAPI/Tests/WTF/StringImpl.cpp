@@ -113,4 +113,73 @@ TEST(WTF, StringImplReplaceWithLiteral)
     ASSERT_TRUE(equal(testStringImpl.get(), "r555sum555"));
 }
 
+static PassRefPtr<StringImpl> create16BitCopy(StringImpl* string)
+{
+    return StringImpl::create(string->characters(), string->length());
+}
+
+// The lengths below straddle the 16 byte blocks that the SIMD kernels work on.
+TEST(WTF, StringImplFindAcrossBlocks)
+{
+    RefPtr<StringImpl> haystack = StringImpl::createFromLiteral("The quick brown fox jumps over the lazy dog; 0123456789abcdefghij");
+    RefPtr<StringImpl> haystack16 = create16BitCopy(haystack.get());
+    ASSERT_FALSE(haystack16->is8Bit());
+
+    ASSERT_EQ(16u, haystack->find('f'));
+    ASSERT_EQ(16u, haystack16->find('f'));
+    ASSERT_EQ(64u, haystack->find('j', 21));
+    ASSERT_EQ(64u, haystack16->find('j', 21));
+    ASSERT_EQ(notFound, haystack->find('Z'));
+    ASSERT_EQ(notFound, haystack16->find('Z'));
+    ASSERT_EQ(41u, haystack->reverseFind('o'));
+    ASSERT_EQ(41u, haystack16->reverseFind('o'));
+    ASSERT_EQ(12u, haystack->reverseFind('o', 15));
+    ASSERT_EQ(12u, haystack16->reverseFind('o', 15));
+    ASSERT_EQ(20u, haystack->reverseFind('j', 63));
+    ASSERT_EQ(20u, haystack16->reverseFind('j', 63));
+
+    RefPtr<StringImpl> needle = StringImpl::createFromLiteral("lazy dog; 0123");
+    RefPtr<StringImpl> needle16 = create16BitCopy(needle.get());
+    ASSERT_EQ(35u, haystack->find(needle.get()));
+    ASSERT_EQ(35u, haystack16->find(needle16.get()));
+    ASSERT_EQ(35u, haystack16->find(needle.get()));
+    ASSERT_EQ(notFound, haystack->find(needle.get(), 36));
+
+    RefPtr<StringImpl> tail = StringImpl::createFromLiteral("hij");
+    ASSERT_EQ(62u, haystack->find(tail.get()));
+    ASSERT_EQ(62u, haystack16->find(create16BitCopy(tail.get()).get()));
+
+    RefPtr<StringImpl> nearMiss = StringImpl::createFromLiteral("dog; 0123456789abcdefghiJ");
+    ASSERT_EQ(notFound, haystack->find(nearMiss.get()));
+    ASSERT_EQ(notFound, haystack16->find(create16BitCopy(nearMiss.get()).get()));
+}
+
+TEST(WTF, StringImplEqualAcrossBlocks)
+{
+    RefPtr<StringImpl> a = StringImpl::createFromLiteral("Hello World, this is a Test of equality 1234567890 [x]");
+    RefPtr<StringImpl> b = StringImpl::createFromLiteral("Hello World, this is a Test of equality 1234567890 [y]");
+    RefPtr<StringImpl> upper = StringImpl::createFromLiteral("HELLO WORLD, THIS IS A TEST OF EQUALITY 1234567890 [X]");
+    RefPtr<StringImpl> bracket = StringImpl::createFromLiteral("Hello World, this is a Test of equality 1234567890 {x}");
+
+    ASSERT_TRUE(equal(a.get(), create16BitCopy(a.get()).get()));
+    ASSERT_FALSE(equal(a.get(), b.get()));
+    ASSERT_FALSE(equal(create16BitCopy(a.get()).get(), b.get()));
+    ASSERT_FALSE(equal(create16BitCopy(a.get()).get(), create16BitCopy(b.get()).get()));
+
+    ASSERT_TRUE(equalIgnoringCase(a.get(), upper.get()));
+    ASSERT_TRUE(equalIgnoringCase(create16BitCopy(a.get()).get(), upper.get()));
+    ASSERT_FALSE(equalIgnoringCase(a.get(), b.get()));
+    // '[' and '{' differ only in the 0x20 bit, but are not letters.
+    ASSERT_FALSE(equalIgnoringCase(a.get(), bracket.get()));
+    ASSERT_FALSE(equalIgnoringCase(create16BitCopy(a.get()).get(), bracket.get()));
+
+    // U+212A KELVIN SIGN folds to 'k', so blocks with non-ASCII characters must not be compared as ASCII.
+    Vector<UChar> kelvin;
+    kelvin.append(0x212A);
+    const char* rest = "ELVINELVINELVINELVINELVIN";
+    kelvin.append(rest, strlen(rest));
+    RefPtr<StringImpl> kelvin16 = StringImpl::create(kelvin.data(), kelvin.size());
+    ASSERT_TRUE(equalIgnoringCase(kelvin16.get(), StringImpl::createFromLiteral("kelvinelvinelvinelvinelvin").get()));
+}
+
 } // namespace TestWebKitAPI
@@ -16,6 +16,7 @@ SOURCES += \
     RedBlackTree.cpp \
     SHA1.cpp \
     SaturatedArithmeticOperations.cpp \
+    StableSort.cpp \
     StringBuilder.cpp \
     StringHasher.cpp \
     StringImpl.cpp \